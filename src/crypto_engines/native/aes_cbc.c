@@ -18,7 +18,7 @@
 #include <vlib/vlib.h>
 #include <vnet/plugin/plugin.h>
 #include <vppinfra/crypto/aes_cbc.h>
-#include <native/sha2.h>
+#include <native/sha_mb.h>
 
 #if __GNUC__ > 4  && !__clang__ && CLIB_DEBUG == 0
 #pragma GCC optimize ("O3")
@@ -27,8 +27,8 @@
 #define CRYPTO_NATIVE_AES_CBC_ENC_VEC_SIZE 256
 
 static_always_inline u32
-aes_ops_enc_aes_cbc (vlib_main_t * vm, vnet_crypto_op_t * ops[],
-		     u32 n_ops, aes_key_size_t ks)
+aes_ops_enc_aes_cbc (vlib_main_t *vm, vnet_crypto_op_t *ops[], u32 n_ops,
+		     aes_key_size_t ks, int is_linked)
 {
   crypto_native_main_t *cm = &crypto_native_main;
   u32 i, n_left = n_ops;
@@ -44,6 +44,8 @@ aes_ops_enc_aes_cbc (vlib_main_t * vm, vnet_crypto_op_t * ops[],
       while (n_left && i < CRYPTO_NATIVE_AES_CBC_ENC_VEC_SIZE)
 	{
 	  key_indices[i] = ops[0]->key_index;
+	  if (is_linked)
+	    key_indices[i] = vnet_crypto_get_key (key_indices[i])->index_crypto;
 	  plaintext[i] = ops[0]->src;
 	  ciphertext[i] = ops[0]->dst;
 	  oplen[i] = ops[0]->len;
@@ -63,35 +65,36 @@ aes_ops_enc_aes_cbc (vlib_main_t * vm, vnet_crypto_op_t * ops[],
 
 
 static_always_inline u32
-aes_ops_dec_aes_cbc (vlib_main_t * vm, vnet_crypto_op_t * ops[],
-		     u32 n_ops, aes_key_size_t ks)
+aes_ops_dec_aes_cbc (vlib_main_t *vm, vnet_crypto_op_t *ops[], u32 n_ops,
+		     aes_key_size_t ks, int is_linked)
 {
   crypto_native_main_t *cm = &crypto_native_main;
   int rounds = AES_KEY_ROUNDS (ks);
-  vnet_crypto_op_t *op = ops[0];
-  aes_cbc_key_data_t *kd = (aes_cbc_key_data_t *) cm->key_data[op->key_index];
-  u32 n_left = n_ops;
 
   ASSERT (n_ops >= 1);
 
-decrypt:
+  for (u32 i = 0; i < n_ops; i++)
+    {
+      vnet_crypto_op_t *op = ops[i];
+      u32 key_index = op->key_index;
+      aes_cbc_key_data_t *kd;
+
+      if (is_linked)
+	key_index = vnet_crypto_get_key (key_index)->index_crypto;
+
+      kd = (aes_cbc_key_data_t *) cm->key_data[key_index];
+
 #if defined(__VAES__) && defined(__AVX512F__)
-  aes4_cbc_dec (kd->decrypt_key, (u8x64u *) op->src, (u8x64u *) op->dst,
-		(u8x16u *) op->iv, op->len, rounds);
+      aes4_cbc_dec (kd->decrypt_key, (u8x64u *) op->src, (u8x64u *) op->dst,
+		    (u8x16u *) op->iv, op->len, rounds);
 #elif defined(__VAES__)
-  aes2_cbc_dec (kd->decrypt_key, (u8x32u *) op->src, (u8x32u *) op->dst,
-		(u8x16u *) op->iv, op->len, rounds);
+      aes2_cbc_dec (kd->decrypt_key, (u8x32u *) op->src, (u8x32u *) op->dst,
+		    (u8x16u *) op->iv, op->len, rounds);
 #else
-  aes_cbc_dec (kd->decrypt_key, (u8x16u *) op->src, (u8x16u *) op->dst,
-	       (u8x16u *) op->iv, op->len, rounds);
+      aes_cbc_dec (kd->decrypt_key, (u8x16u *) op->src, (u8x16u *) op->dst,
+		   (u8x16u *) op->iv, op->len, rounds);
 #endif
-  op->status = VNET_CRYPTO_OP_STATUS_COMPLETED;
-
-  if (--n_left)
-    {
-      op += 1;
-      kd = (aes_cbc_key_data_t *) cm->key_data[op->key_index];
-      goto decrypt;
+      op->status = VNET_CRYPTO_OP_STATUS_COMPLETED;
     }
 
   return n_ops;
@@ -155,7 +158,7 @@ aes_cbc_key_exp_256 (vnet_crypto_key_t *key)
   static u32 aes_ops_enc_aes_cbc_##x (vlib_main_t *vm,                        \
 				      vnet_crypto_op_t *ops[], u32 n_ops)     \
   {                                                                           \
-    return aes_ops_enc_aes_cbc (vm, ops, n_ops, AES_KEY_##x);                 \
+    return aes_ops_enc_aes_cbc (vm, ops, n_ops, AES_KEY_##x, 0);              \
   }                                                                           \
                                                                               \
   CRYPTO_NATIVE_OP_HANDLER (aes_##x##_cbc_enc) = {                            \
@@ -167,7 +170,7 @@ aes_cbc_key_exp_256 (vnet_crypto_key_t *key)
   static u32 aes_ops_dec_aes_cbc_##x (vlib_main_t *vm,                        \
 				      vnet_crypto_op_t *ops[], u32 n_ops)     \
   {                                                                           \
-    return aes_ops_dec_aes_cbc (vm, ops, n_ops, AES_KEY_##x);                 \
+    return aes_ops_dec_aes_cbc (vm, ops, n_ops, AES_KEY_##x, 0);              \
   }                                                                           \
                                                                               \
   CRYPTO_NATIVE_OP_HANDLER (aes_##x##_cbc_dec) = {                            \
@@ -185,29 +188,76 @@ aes_cbc_key_exp_256 (vnet_crypto_key_t *key)
 foreach_aes_cbc_handler_type;
 #undef _
 
+/*
+ * Linked AES-CBC + HMAC. Ops are taken in batches small enough that the
+ * HMAC pass finds the data the cipher pass just wrote (or is about to
+ * read) still in cache, both passes process all ops of a batch in
+ * parallel lanes.
+ */
+static_always_inline u32
+aes_ops_aes_cbc_hmac (vlib_main_t *vm, vnet_crypto_op_t *ops[], u32 n_ops,
+		      aes_key_size_t ks, clib_sha_mb_type_t type,
+		      u8 digest_len, int is_enc)
+{
+  u32 n_left = n_ops, n_fail = 0;
+
+  while (n_left)
+    {
+      u32 n = clib_min (n_left, CRYPTO_NATIVE_SHA_MB_BATCH_SIZE);
+
+      if (is_enc)
+	{
+	  aes_ops_enc_aes_cbc (vm, ops, n, ks, /* is_linked */ 1);
+	  crypto_native_linked_ops_hmac_mb (ops, n, type, digest_len, 0);
+	}
+      else
+	{
+	  vnet_crypto_op_t *ok[CRYPTO_NATIVE_SHA_MB_BATCH_SIZE];
+	  u32 n_ok = 0;
+
+	  n_fail +=
+	    crypto_native_linked_ops_hmac_mb (ops, n, type, digest_len, 1);
+
+	  /* don't decrypt forged packets */
+	  for (u32 i = 0; i < n; i++)
+	    if (ops[i]->status == VNET_CRYPTO_OP_STATUS_COMPLETED)
+	      ok[n_ok++] = ops[i];
+
+	  if (n_ok)
+	    aes_ops_dec_aes_cbc (vm, ok, n_ok, ks, /* is_linked */ 1);
+	}
+
+      ops += n;
+      n_left -= n;
+    }
+
+  return n_ops - n_fail;
+}
+
 #define foreach_crypto_native_cbc_hmac_op                                     \
-  _ (128, 224, CLIB_SHA2_224, 14)                                             \
-  _ (192, 224, CLIB_SHA2_224, 14)                                             \
-  _ (256, 224, CLIB_SHA2_224, 14)                                             \
-  _ (128, 256, CLIB_SHA2_256, 16)                                             \
-  _ (192, 256, CLIB_SHA2_256, 16)                                             \
-  _ (256, 256, CLIB_SHA2_256, 16)
-
-#define _(k, b, clib_sha2, t)                                                 \
+  _ (128, 1, 12)                                                              \
+  _ (192, 1, 12)                                                              \
+  _ (256, 1, 12)                                                              \
+  _ (128, 224, 14)                                                            \
+  _ (192, 224, 14)                                                            \
+  _ (256, 224, 14)                                                            \
+  _ (128, 256, 16)                                                            \
+  _ (192, 256, 16)                                                            \
+  _ (256, 256, 16)
+
+#define _(k, b, t)                                                            \
   static u32 crypto_native_ops_enc_aes_##k##_cbc_hmac_sha##b##_tag##t (       \
     vlib_main_t *vm, vnet_crypto_op_t *ops[], u32 n_ops)                      \
   {                                                                           \
-    aes_ops_enc_aes_cbc (vm, ops, n_ops, AES_KEY_##k);                        \
-    crypto_native_ops_hmac_sha2 (vm, ops, n_ops, 0, clib_sha2);               \
-    return n_ops;                                                             \
+    return aes_ops_aes_cbc_hmac (vm, ops, n_ops, AES_KEY_##k,                 \
+				 CLIB_SHA_MB_SHA##b, t, 1);                   \
   }                                                                           \
                                                                               \
   static u32 crypto_native_ops_dec_aes_##k##_cbc_hmac_sha##b##_tag##t (       \
     vlib_main_t *vm, vnet_crypto_op_t *ops[], u32 n_ops)                      \
   {                                                                           \
-    crypto_native_ops_hmac_sha2 (vm, ops, n_ops, 0, clib_sha2);               \
-    aes_ops_dec_aes_cbc (vm, ops, n_ops, AES_KEY_##k);                        \
-    return n_ops;                                                             \
+    return aes_ops_aes_cbc_hmac (vm, ops, n_ops, AES_KEY_##k,                 \
+				 CLIB_SHA_MB_SHA##b, t, 0);                   \
   }                                                                           \
                                                                               \
   CRYPTO_NATIVE_OP_HANDLER (aes_##k##_cbc_hmac_sha##b##_tag##t##_enc) = {     \
@@ -220,13 +270,7 @@ foreach_aes_cbc_handler_type;
     .op_id = VNET_CRYPTO_OP_AES_##k##_CBC_SHA##b##_TAG##t##_DEC,              \
     .fn = crypto_native_ops_dec_aes_##k##_cbc_hmac_sha##b##_tag##t,           \
     .probe = aes_cbc_cpu_probe,                                               \
-  };                                                                          \
-                                                                              \
-  CRYPTO_NATIVE_KEY_HANDLER (aes_##k##_cbc_hmac_sha##b##_tag##t) = {          \
-    .alg_id = VNET_CRYPTO_ALG_AES_##k##_CBC_SHA##b##_TAG##t,                  \
-    .key_fn = aes_cbc_key_exp_##k,                                            \
-    .probe = aes_cbc_cpu_probe,                                               \
   };
 
 foreach_crypto_native_cbc_hmac_op
-#undef _
\ No newline at end of file
+#undef _
@@ -5,7 +5,7 @@
 #include <vlib/vlib.h>
 #include <vnet/plugin/plugin.h>
 #include <vppinfra/crypto/aes_ctr.h>
-#include <native/sha2.h>
+#include <native/sha_mb.h>
 
 #if __GNUC__ > 4 && !__clang__ && CLIB_DEBUG == 0
 #pragma GCC optimize("O3")
@@ -14,33 +14,33 @@
 static_always_inline u32
 aes_ops_aes_ctr (vlib_main_t *vm, vnet_crypto_op_t *ops[], u32 n_ops,
 		 vnet_crypto_op_chunk_t *chunks, aes_key_size_t ks,
-		 int maybe_chained)
+		 int maybe_chained, int is_linked)
 {
   crypto_native_main_t *cm = &crypto_native_main;
-  vnet_crypto_op_t *op = ops[0];
   aes_ctr_key_data_t *kd;
   aes_ctr_ctx_t ctx;
-  u32 n_left = n_ops;
 
-next:
-  kd = (aes_ctr_key_data_t *) cm->key_data[op->key_index];
-
-  clib_aes_ctr_init (&ctx, kd, op->iv, ks);
-  if (op->flags & VNET_CRYPTO_OP_FLAG_CHAINED_BUFFERS)
+  for (u32 i = 0; i < n_ops; i++)
     {
-      vnet_crypto_op_chunk_t *chp = chunks + op->chunk_index;
-      for (int j = 0; j < op->n_chunks; j++, chp++)
-	clib_aes_ctr_transform (&ctx, chp->src, chp->dst, chp->len, ks);
-    }
-  else
-    clib_aes_ctr_transform (&ctx, op->src, op->dst, op->len, ks);
+      vnet_crypto_op_t *op = ops[i];
+      u32 key_index = op->key_index;
 
-  op->status = VNET_CRYPTO_OP_STATUS_COMPLETED;
+      if (is_linked)
+	key_index = vnet_crypto_get_key (key_index)->index_crypto;
 
-  if (--n_left)
-    {
-      op += 1;
-      goto next;
+      kd = (aes_ctr_key_data_t *) cm->key_data[key_index];
+
+      clib_aes_ctr_init (&ctx, kd, op->iv, ks);
+      if (maybe_chained && op->flags & VNET_CRYPTO_OP_FLAG_CHAINED_BUFFERS)
+	{
+	  vnet_crypto_op_chunk_t *chp = chunks + op->chunk_index;
+	  for (int j = 0; j < op->n_chunks; j++, chp++)
+	    clib_aes_ctr_transform (&ctx, chp->src, chp->dst, chp->len, ks);
+	}
+      else
+	clib_aes_ctr_transform (&ctx, op->src, op->dst, op->len, ks);
+
+      op->status = VNET_CRYPTO_OP_STATUS_COMPLETED;
     }
 
   return n_ops;
@@ -64,13 +64,13 @@ aes_ctr_key_exp (vnet_crypto_key_t *key, aes_key_size_t ks)
   static u32 aes_ops_aes_ctr_##x (vlib_main_t *vm, vnet_crypto_op_t *ops[],   \
 				  u32 n_ops)                                  \
   {                                                                           \
-    return aes_ops_aes_ctr (vm, ops, n_ops, 0, AES_KEY_##x, 0);               \
+    return aes_ops_aes_ctr (vm, ops, n_ops, 0, AES_KEY_##x, 0, 0);            \
   }                                                                           \
   static u32 aes_ops_aes_ctr_##x##_chained (                                  \
     vlib_main_t *vm, vnet_crypto_op_t *ops[], vnet_crypto_op_chunk_t *chunks, \
     u32 n_ops)                                                                \
   {                                                                           \
-    return aes_ops_aes_ctr (vm, ops, n_ops, chunks, AES_KEY_##x, 1);          \
+    return aes_ops_aes_ctr (vm, ops, n_ops, chunks, AES_KEY_##x, 1, 0);       \
   }                                                                           \
   static void *aes_ctr_key_exp_##x (vnet_crypto_key_t *key)                   \
   {                                                                           \
@@ -130,26 +130,68 @@ _ (192)
 _ (256)
 #undef _
 
-#define foreach_crypto_native_ctr_hmac_op                                     \
-  _ (128, 256, CLIB_SHA2_256, 16)                                             \
-  _ (192, 256, CLIB_SHA2_256, 16)                                             \
-  _ (256, 256, CLIB_SHA2_256, 16)
+/* linked AES-CTR + HMAC, see aes_ops_aes_cbc_hmac */
+static_always_inline u32
+aes_ops_aes_ctr_hmac (vlib_main_t *vm, vnet_crypto_op_t *ops[], u32 n_ops,
+		      aes_key_size_t ks, clib_sha_mb_type_t type,
+		      u8 digest_len, int is_enc)
+{
+  u32 n_left = n_ops, n_fail = 0;
 
-#define _(k, b, clib_sha2, t)                                                 \
+  while (n_left)
+    {
+      u32 n = clib_min (n_left, CRYPTO_NATIVE_SHA_MB_BATCH_SIZE);
+
+      if (is_enc)
+	{
+	  aes_ops_aes_ctr (vm, ops, n, 0, ks, 0, /* is_linked */ 1);
+	  crypto_native_linked_ops_hmac_mb (ops, n, type, digest_len, 0);
+	}
+      else
+	{
+	  vnet_crypto_op_t *ok[CRYPTO_NATIVE_SHA_MB_BATCH_SIZE];
+	  u32 n_ok = 0;
+
+	  n_fail +=
+	    crypto_native_linked_ops_hmac_mb (ops, n, type, digest_len, 1);
+
+	  /* don't decrypt forged packets */
+	  for (u32 i = 0; i < n; i++)
+	    if (ops[i]->status == VNET_CRYPTO_OP_STATUS_COMPLETED)
+	      ok[n_ok++] = ops[i];
+
+	  if (n_ok)
+	    aes_ops_aes_ctr (vm, ok, n_ok, 0, ks, 0, /* is_linked */ 1);
+	}
+
+      ops += n;
+      n_left -= n;
+    }
+
+  return n_ops - n_fail;
+}
+
+#define foreach_crypto_native_ctr_hmac_op                                     \
+  _ (128, 1, 12)                                                              \
+  _ (192, 1, 12)                                                              \
+  _ (256, 1, 12)                                                              \
+  _ (128, 256, 16)                                                            \
+  _ (192, 256, 16)                                                            \
+  _ (256, 256, 16)
+
+#define _(k, b, t)                                                            \
   static u32 crypto_native_ops_enc_aes_##k##_ctr_hmac_sha##b##_tag##t (       \
     vlib_main_t *vm, vnet_crypto_op_t *ops[], u32 n_ops)                      \
   {                                                                           \
-    aes_ops_aes_ctr (vm, ops, n_ops, 0, AES_KEY_##k, 0);                      \
-    crypto_native_ops_hmac_sha2 (vm, ops, n_ops, 0, clib_sha2);               \
-    return n_ops;                                                             \
+    return aes_ops_aes_ctr_hmac (vm, ops, n_ops, AES_KEY_##k,                 \
+				 CLIB_SHA_MB_SHA##b, t, 1);                   \
   }                                                                           \
                                                                               \
   static u32 crypto_native_ops_dec_aes_##k##_ctr_hmac_sha##b##_tag##t (       \
     vlib_main_t *vm, vnet_crypto_op_t *ops[], u32 n_ops)                      \
   {                                                                           \
-    crypto_native_ops_hmac_sha2 (vm, ops, n_ops, 0, clib_sha2);               \
-    aes_ops_aes_ctr (vm, ops, n_ops, 0, AES_KEY_##k, 0);                      \
-    return n_ops;                                                             \
+    return aes_ops_aes_ctr_hmac (vm, ops, n_ops, AES_KEY_##k,                 \
+				 CLIB_SHA_MB_SHA##b, t, 0);                   \
   }                                                                           \
                                                                               \
   CRYPTO_NATIVE_OP_HANDLER (aes_##k##_ctr_hmac_sha##b##_tag##t##_enc) = {     \
@@ -162,12 +204,6 @@ _ (256)
     .op_id = VNET_CRYPTO_OP_AES_##k##_CTR_SHA##b##_TAG##t##_DEC,              \
     .fn = crypto_native_ops_dec_aes_##k##_ctr_hmac_sha##b##_tag##t,           \
     .probe = probe,                                                           \
-  };                                                                          \
-                                                                              \
-  CRYPTO_NATIVE_KEY_HANDLER (aes_##k##_ctr_hmac_sha##b##_tag##t) = {          \
-    .alg_id = VNET_CRYPTO_ALG_AES_##k##_CTR_SHA##b##_TAG##t,                  \
-    .key_fn = aes_ctr_key_exp_##k,                                            \
-    .probe = probe,                                                           \
   };
 
 foreach_crypto_native_ctr_hmac_op
@@ -0,0 +1,137 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#include <vlib/vlib.h>
+#include <vnet/plugin/plugin.h>
+#include <vnet/crypto/crypto.h>
+#include <native/crypto_native.h>
+#include <vppinfra/crypto/chacha20_poly1305.h>
+
+#if __GNUC__ > 4 && !__clang__ && CLIB_DEBUG == 0
+#pragma GCC optimize("O3")
+#endif
+
+/* ops handed to the batch code at once */
+#define CHACHA20_POLY1305_BATCH_SIZE 64
+
+static_always_inline u32
+chacha20_poly1305_ops (vnet_crypto_op_t *ops[], u32 n_ops, int is_enc,
+		       u32 fixed, u32 aad_len)
+{
+  crypto_native_main_t *cm = &crypto_native_main;
+  clib_chacha20_poly1305_op_t b[CHACHA20_POLY1305_BATCH_SIZE];
+  u32 n_left = n_ops, n_fail = 0;
+
+  while (n_left)
+    {
+      u32 n = clib_min (n_left, CHACHA20_POLY1305_BATCH_SIZE);
+
+      for (u32 i = 0; i < n; i++)
+	{
+	  vnet_crypto_op_t *op = ops[i];
+	  b[i] = (clib_chacha20_poly1305_op_t){
+	    .key = cm->key_data[op->key_index],
+	    .nonce = op->iv,
+	    .aad = op->aad,
+	    .aad_len = fixed ? aad_len : op->aad_len,
+	    .src = op->src,
+	    .dst = op->dst,
+	    .len = op->len,
+	    .tag = op->tag,
+	    .tag_len = fixed ? 16 : op->tag_len,
+	  };
+	}
+
+      if (is_enc)
+	clib_chacha20_poly1305_enc_ops (b, n);
+      else
+	clib_chacha20_poly1305_dec_ops (b, n);
+
+      for (u32 i = 0; i < n; i++)
+	if (PREDICT_FALSE (b[i].is_bad))
+	  {
+	    ops[i]->status = VNET_CRYPTO_OP_STATUS_FAIL_BAD_HMAC;
+	    n_fail++;
+	  }
+	else
+	  ops[i]->status = VNET_CRYPTO_OP_STATUS_COMPLETED;
+
+      ops += n;
+      n_left -= n;
+    }
+
+  return n_ops - n_fail;
+}
+
+static void *
+chacha20_poly1305_key_exp (vnet_crypto_key_t *key)
+{
+  u8 *kd = clib_mem_alloc_aligned (32, CLIB_CACHE_LINE_BYTES);
+  clib_memcpy_fast (kd, key->data, 32);
+  return kd;
+}
+
+#define foreach_chacha20_poly1305_handler_type                                \
+  _ (, 0, 0)                                                                  \
+  _ (_TAG16_AAD0, 1, 0)                                                       \
+  _ (_TAG16_AAD8, 1, 8)                                                       \
+  _ (_TAG16_AAD12, 1, 12)
+
+#define _(s, f, a)                                                            \
+  static u32 chacha20_poly1305_enc##s (vlib_main_t *vm,                       \
+				       vnet_crypto_op_t *ops[], u32 n_ops)    \
+  {                                                                           \
+    return chacha20_poly1305_ops (ops, n_ops, 1, f, a);                       \
+  }                                                                           \
+  static u32 chacha20_poly1305_dec##s (vlib_main_t *vm,                       \
+				       vnet_crypto_op_t *ops[], u32 n_ops)    \
+  {                                                                           \
+    return chacha20_poly1305_ops (ops, n_ops, 0, f, a);                       \
+  }
+
+foreach_chacha20_poly1305_handler_type;
+#undef _
+
+static int
+probe ()
+{
+#if defined(CLIB_HAVE_VEC512)
+  if (clib_cpu_supports_avx512_bitalg ())
+    return 30;
+#elif defined(__AVX512F__)
+  if (clib_cpu_supports_avx512f ())
+    return 25;
+#elif defined(__AVX2__)
+  if (clib_cpu_supports_avx2 ())
+    return 20;
+#elif __aarch64__
+  if (clib_cpu_supports_aarch64_asimd ())
+    return 10;
+#elif defined(CLIB_HAVE_VEC128)
+  return 10;
+#endif
+  return -1;
+}
+
+#define _(s, f, a)                                                            \
+  CRYPTO_NATIVE_OP_HANDLER (chacha20_poly1305_enc##s) = {                     \
+    .op_id = VNET_CRYPTO_OP_CHACHA20_POLY1305##s##_ENC,                       \
+    .fn = chacha20_poly1305_enc##s,                                           \
+    .probe = probe,                                                           \
+  };                                                                          \
+                                                                              \
+  CRYPTO_NATIVE_OP_HANDLER (chacha20_poly1305_dec##s) = {                     \
+    .op_id = VNET_CRYPTO_OP_CHACHA20_POLY1305##s##_DEC,                       \
+    .fn = chacha20_poly1305_dec##s,                                           \
+    .probe = probe,                                                           \
+  };
+
+foreach_chacha20_poly1305_handler_type;
+#undef _
+
+CRYPTO_NATIVE_KEY_HANDLER (chacha20_poly1305) = {
+  .alg_id = VNET_CRYPTO_ALG_CHACHA20_POLY1305,
+  .key_fn = chacha20_poly1305_key_exp,
+  .probe = probe,
+};
@@ -0,0 +1,102 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#include <vlib/vlib.h>
+#include <vnet/plugin/plugin.h>
+#include <native/sha_mb.h>
+
+#if __GNUC__ > 4 && !__clang__ && CLIB_DEBUG == 0
+#pragma GCC optimize("O3")
+#endif
+
+static u32
+crypto_native_ops_hmac_sha1 (vlib_main_t *vm, vnet_crypto_op_t *ops[],
+			     u32 n_ops)
+{
+  return crypto_native_ops_hmac_mb (ops, n_ops, CLIB_SHA_MB_SHA1);
+}
+
+static u32
+crypto_native_ops_chained_hmac_sha1 (vlib_main_t *vm, vnet_crypto_op_t *ops[],
+				     vnet_crypto_op_chunk_t *chunks, u32 n_ops)
+{
+  crypto_native_main_t *cm = &crypto_native_main;
+  u32 n_fail = 0;
+
+  for (u32 i = 0; i < n_ops; i++)
+    {
+      vnet_crypto_op_t *op = ops[i];
+      vnet_crypto_op_chunk_t *chp = chunks + op->chunk_index;
+      clib_sha1_hmac_ctx_t ctx;
+      u8 digest[CLIB_SHA1_DIGEST_SIZE];
+      u32 sz = op->digest_len ? clib_min (op->digest_len, sizeof (digest)) :
+				sizeof (digest);
+
+      clib_sha1_hmac_init (&ctx, cm->key_data[op->key_index]);
+      for (int j = 0; j < op->n_chunks; j++, chp++)
+	clib_sha1_hmac_update (&ctx, chp->src, chp->len);
+      clib_sha1_hmac_final (&ctx, digest);
+
+      if (op->flags & VNET_CRYPTO_OP_FLAG_HMAC_CHECK)
+	{
+	  if (memcmp (op->digest, digest, sz))
+	    {
+	      n_fail++;
+	      op->status = VNET_CRYPTO_OP_STATUS_FAIL_BAD_HMAC;
+	      continue;
+	    }
+	}
+      else
+	clib_memcpy_fast (op->digest, digest, sz);
+
+      op->status = VNET_CRYPTO_OP_STATUS_COMPLETED;
+    }
+
+  return n_ops - n_fail;
+}
+
+static void *
+sha1_key_add (vnet_crypto_key_t *key)
+{
+  clib_sha1_hmac_key_data_t *kd;
+
+  kd = clib_mem_alloc_aligned (sizeof (*kd), CLIB_CACHE_LINE_BYTES);
+  clib_sha1_hmac_key_data (key->data, key->length, kd);
+
+  return kd;
+}
+
+static int
+probe ()
+{
+#if defined(CLIB_HAVE_VEC512)
+  if (clib_cpu_supports_avx512_bitalg ())
+    return 35;
+#elif defined(__AVX512F__)
+  if (clib_cpu_supports_avx512f ())
+    return 25;
+#elif defined(__AVX2__)
+  if (clib_cpu_supports_avx2 ())
+    return 15;
+#elif __aarch64__
+  if (clib_cpu_supports_aarch64_asimd ())
+    return 5;
+#elif defined(CLIB_HAVE_VEC128)
+  return 5;
+#endif
+  return -1;
+}
+
+CRYPTO_NATIVE_OP_HANDLER (crypto_native_hmac_sha1) = {
+  .op_id = VNET_CRYPTO_OP_SHA1_HMAC,
+  .fn = crypto_native_ops_hmac_sha1,
+  .cfn = crypto_native_ops_chained_hmac_sha1,
+  .probe = probe,
+};
+
+CRYPTO_NATIVE_KEY_HANDLER (crypto_native_hmac_sha1) = {
+  .alg_id = VNET_CRYPTO_ALG_HMAC_SHA1,
+  .key_fn = sha1_key_add,
+  .probe = probe,
+};
@@ -5,6 +5,7 @@
 #include <vlib/vlib.h>
 #include <vnet/plugin/plugin.h>
 #include <native/sha2.h>
+#include <native/sha_mb.h>
 
 static_always_inline u32
 crypto_native_ops_hash_sha2 (vlib_main_t *vm, vnet_crypto_op_t *ops[],
@@ -130,3 +131,63 @@ _ (224)
 _ (256)
 
 #undef _
+
+static_always_inline u32
+crypto_native_ops_hmac_sha2_mb (vlib_main_t *vm, vnet_crypto_op_t *ops[],
+				u32 n_ops, clib_sha2_type_t type,
+				clib_sha_mb_type_t mb_type)
+{
+#if defined(CLIB_HAVE_VEC512) && defined(CLIB_SHA256_ISA)
+  /* too few ops to fill the lanes, SHA extensions are faster */
+  if (n_ops < N_SHA_MB_LANES / 4)
+    return crypto_native_ops_hmac_sha2 (vm, ops, n_ops, 0, type);
+#endif
+  return crypto_native_ops_hmac_mb (ops, n_ops, mb_type);
+}
+
+/* multi-lane HMAC, wins over SHA extensions only with 16 lanes */
+static int
+mb_probe ()
+{
+#if defined(CLIB_HAVE_VEC512)
+  if (clib_cpu_supports_avx512_bitalg ())
+    return 35;
+#elif defined(__AVX512F__)
+  if (clib_cpu_supports_avx512f ())
+    return 25;
+#elif defined(__AVX2__)
+  if (clib_cpu_supports_avx2 ())
+    return 15;
+#elif __aarch64__
+  if (clib_cpu_supports_aarch64_asimd ())
+    return 5;
+#elif defined(CLIB_HAVE_VEC128)
+  return 5;
+#endif
+  return -1;
+}
+
+#define _(b)                                                                  \
+  static u32 crypto_native_ops_hmac_mb_sha##b (                               \
+    vlib_main_t *vm, vnet_crypto_op_t *ops[], u32 n_ops)                      \
+  {                                                                           \
+    return crypto_native_ops_hmac_sha2_mb (vm, ops, n_ops, CLIB_SHA2_##b,     \
+					   CLIB_SHA_MB_SHA##b);               \
+  }                                                                           \
+                                                                              \
+  CRYPTO_NATIVE_OP_HANDLER (crypto_native_hmac_mb_sha##b) = {                 \
+    .op_id = VNET_CRYPTO_OP_SHA##b##_HMAC,                                    \
+    .fn = crypto_native_ops_hmac_mb_sha##b,                                   \
+    .cfn = crypto_native_ops_chained_hmac_sha##b,                             \
+    .probe = mb_probe,                                                        \
+  };                                                                          \
+  CRYPTO_NATIVE_KEY_HANDLER (crypto_native_hmac_mb_sha##b) = {                \
+    .alg_id = VNET_CRYPTO_ALG_HMAC_SHA##b,                                    \
+    .key_fn = sha2_##b##_key_add,                                             \
+    .probe = mb_probe,                                                        \
+  };
+
+_ (224)
+_ (256)
+
+#undef _
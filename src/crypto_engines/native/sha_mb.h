@@ -0,0 +1,125 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#ifndef __crypto_native_sha_mb_h__
+#define __crypto_native_sha_mb_h__
+
+#include <vppinfra/crypto/sha_mb.h>
+#include <vnet/crypto/crypto.h>
+#include <native/crypto_native.h>
+
+/* ops handed to the multi-lane code at once */
+#define CRYPTO_NATIVE_SHA_MB_BATCH_SIZE 64
+
+static_always_inline void
+crypto_native_sha_mb_op (clib_sha_mb_hmac_op_t *b, clib_sha_mb_type_t type,
+			 u32 key_index, const u8 *src, u32 len, u8 *digest,
+			 u8 digest_len, int check)
+{
+  void *kd = crypto_native_main.key_data[key_index];
+
+  *b = (clib_sha_mb_hmac_op_t){
+    .src = src,
+    .len = len,
+    .digest = digest,
+    .digest_len = digest_len,
+    .check = check,
+  };
+
+  if (type == CLIB_SHA_MB_SHA1)
+    {
+      b->ipad_h = ((clib_sha1_hmac_key_data_t *) kd)->ipad_h;
+      b->opad_h = ((clib_sha1_hmac_key_data_t *) kd)->opad_h;
+    }
+  else
+    {
+      b->ipad_h = ((clib_sha2_hmac_key_data_t *) kd)->ipad_h.h32;
+      b->opad_h = ((clib_sha2_hmac_key_data_t *) kd)->opad_h.h32;
+    }
+}
+
+static_always_inline u32
+crypto_native_ops_hmac_mb (vnet_crypto_op_t *ops[], u32 n_ops,
+			   clib_sha_mb_type_t type)
+{
+  clib_sha_mb_hmac_op_t b[CRYPTO_NATIVE_SHA_MB_BATCH_SIZE];
+  u32 n_left = n_ops, n_fail = 0;
+
+  while (n_left)
+    {
+      u32 n = clib_min (n_left, CRYPTO_NATIVE_SHA_MB_BATCH_SIZE);
+
+      for (u32 i = 0; i < n; i++)
+	crypto_native_sha_mb_op (
+	  b + i, type, ops[i]->key_index, ops[i]->src, ops[i]->len,
+	  ops[i]->digest, ops[i]->digest_len,
+	  ops[i]->flags & VNET_CRYPTO_OP_FLAG_HMAC_CHECK);
+
+      clib_sha_mb_hmac (b, n, type);
+
+      for (u32 i = 0; i < n; i++)
+	if (PREDICT_FALSE (b[i].is_bad))
+	  {
+	    ops[i]->status = VNET_CRYPTO_OP_STATUS_FAIL_BAD_HMAC;
+	    n_fail++;
+	  }
+	else
+	  ops[i]->status = VNET_CRYPTO_OP_STATUS_COMPLETED;
+
+      ops += n;
+      n_left -= n;
+    }
+
+  return n_ops - n_fail;
+}
+
+/*
+ * Integrity part of linked (cipher + HMAC) ops, at most
+ * CRYPTO_NATIVE_SHA_MB_BATCH_SIZE of them. HMAC key is the integ key of
+ * the linked key and the authenticated region is aad / aad_len if aad is
+ * set, otherwise the ciphertext. On decrypt every op gets its check
+ * result as status, so the cipher pass can skip the failed ones.
+ */
+static_always_inline u32
+crypto_native_linked_ops_hmac_mb (vnet_crypto_op_t *ops[], u32 n_ops,
+				  clib_sha_mb_type_t type, u8 digest_len,
+				  int is_dec)
+{
+  clib_sha_mb_hmac_op_t b[CRYPTO_NATIVE_SHA_MB_BATCH_SIZE];
+  u32 n_fail = 0;
+
+  ASSERT (n_ops <= CRYPTO_NATIVE_SHA_MB_BATCH_SIZE);
+
+  for (u32 i = 0; i < n_ops; i++)
+    {
+      vnet_crypto_op_t *op = ops[i];
+      vnet_crypto_key_t *key = vnet_crypto_get_key (op->key_index);
+
+      if (op->aad)
+	crypto_native_sha_mb_op (b + i, type, key->index_integ, op->aad,
+				 op->aad_len, op->digest, digest_len, is_dec);
+      else
+	crypto_native_sha_mb_op (b + i, type, key->index_integ,
+				 is_dec ? op->src : op->dst, op->len,
+				 op->digest, digest_len, is_dec);
+    }
+
+  clib_sha_mb_hmac (b, n_ops, type);
+
+  if (is_dec == 0)
+    return 0;
+
+  for (u32 i = 0; i < n_ops; i++)
+    if (PREDICT_FALSE (b[i].is_bad))
+      {
+	ops[i]->status = VNET_CRYPTO_OP_STATUS_FAIL_BAD_HMAC;
+	n_fail++;
+      }
+    else
+      ops[i]->status = VNET_CRYPTO_OP_STATUS_COMPLETED;
+
+  return n_fail;
+}
+
+#endif /* __crypto_native_sha_mb_h__ */
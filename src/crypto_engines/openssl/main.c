@@ -645,24 +645,71 @@ crypto_openssl_key_handler (vnet_crypto_key_op_t kop,
 foreach_openssl_evp_op;
 #undef _
 
+/*
+ * Linked ops carry the linked key, cipher and HMAC use contexts of the
+ * crypto and integ keys it refers to. HMAC covers aad / aad_len if aad is
+ * set, otherwise the ciphertext, and on decrypt it is checked before the
+ * payload is decrypted.
+ */
+static_always_inline u32
+openssl_ops_linked (vlib_main_t *vm, vnet_crypto_op_t *ops[], u32 n_ops,
+		    const EVP_CIPHER *cipher, const EVP_MD *md, u8 digest_len,
+		    int is_enc)
+{
+  u32 n_fail = 0;
+
+  for (u32 i = 0; i < n_ops; i++)
+    {
+      vnet_crypto_op_t *op = ops[i], c = *op, h = *op, *p;
+      vnet_crypto_key_t *key = vnet_crypto_get_key (op->key_index);
+
+      c.key_index = key->index_crypto;
+      h.key_index = key->index_integ;
+      h.flags = is_enc ? 0 : VNET_CRYPTO_OP_FLAG_HMAC_CHECK;
+      h.digest_len = digest_len;
+      if (op->aad)
+	{
+	  h.src = op->aad;
+	  h.len = op->aad_len;
+	}
+      else
+	h.src = is_enc ? op->dst : op->src;
+
+      if (is_enc)
+	{
+	  p = &c;
+	  openssl_ops_enc_cbc (vm, &p, 0, 1, cipher, 1, 16);
+	  p = &h;
+	  openssl_ops_hmac (vm, &p, 0, 1, md);
+	}
+      else
+	{
+	  p = &h;
+	  if (openssl_ops_hmac (vm, &p, 0, 1, md) == 0)
+	    {
+	      op->status = VNET_CRYPTO_OP_STATUS_FAIL_BAD_HMAC;
+	      n_fail++;
+	      continue;
+	    }
+	  p = &c;
+	  openssl_ops_dec_cbc (vm, &p, 0, 1, cipher, 1, 16);
+	}
+      op->status = VNET_CRYPTO_OP_STATUS_COMPLETED;
+    }
+
+  return n_ops - n_fail;
+}
+
 #define _(n, c, m, t)                                                         \
   static u32 openssl_ops_enc_##n (vlib_main_t *vm, vnet_crypto_op_t *ops[],   \
 				  u32 n_ops)                                  \
   {                                                                           \
-    for (u32 i = 0; i < n_ops; i++)                                           \
-      ops[i]->digest_len = t;                                                 \
-    openssl_ops_enc_cbc (vm, ops, 0, n_ops, c (), 1, 16);                     \
-    openssl_ops_hmac (vm, ops, 0, n_ops, m ());                               \
-    return n_ops;                                                             \
+    return openssl_ops_linked (vm, ops, n_ops, c (), m (), t, 1);             \
   }                                                                           \
   static u32 openssl_ops_dec_##n (vlib_main_t *vm, vnet_crypto_op_t *ops[],   \
 				  u32 n_ops)                                  \
   {                                                                           \
-    for (u32 i = 0; i < n_ops; i++)                                           \
-      ops[i]->digest_len = t;                                                 \
-    openssl_ops_dec_cbc (vm, ops, 0, n_ops, c (), 1, 16);                     \
-    openssl_ops_hmac (vm, ops, 0, n_ops, m ());                               \
-    return n_ops;                                                             \
+    return openssl_ops_linked (vm, ops, n_ops, c (), m (), t, 0);             \
   }                                                                           \
   static u32 openssl_ops_enc_chained_##n (                                    \
     vlib_main_t *vm, vnet_crypto_op_t *ops[], vnet_crypto_op_chunk_t *chunks, \
@@ -28,6 +28,7 @@
 #include <vnet/ip/format.h>
 #include <vnet/ethernet/ethernet.h>
 #include <vnet/ip/ip_types_api.h>
+#include <vppinfra/random.h>
 
 #include <vlibapi/api.h>
 #include <vlibmemory/api.h>
@@ -310,14 +311,19 @@ acl_api_invalid_prefix (const vl_api_prefix_t * prefix)
   return (!valid_af) || ip_prefix_decode2 (prefix, &ip_prefix);
 }
 
+/*
+ * Validate and decode the rules of an ACL being added or replaced.
+ * Nothing used by the workers is touched here, so this part runs
+ * without the worker barrier.
+ */
 static int
-acl_add_list (u32 count, vl_api_acl_rule_t rules[],
-	      u32 * acl_list_index, u8 * tag)
+acl_add_list_prepare (u32 count, vl_api_acl_rule_t rules[],
+		      u32 acl_list_index, u8 * tag,
+		      acl_rule_t ** acl_new_rules)
 {
   acl_main_t *am = &acl_main;
   acl_list_t *a;
   acl_rule_t *r;
-  acl_rule_t *acl_new_rules = 0;
   size_t tag_len;
   int i;
 
@@ -326,7 +332,7 @@ acl_add_list (u32 count, vl_api_acl_rule_t rules[],
     return VNET_API_ERROR_INVALID_VALUE;
 
   if (am->trace_acl > 255)
-    clib_warning ("API dbg: acl_add_list index %d tag %s", *acl_list_index,
+    clib_warning ("API dbg: acl_add_list index %d tag %s", acl_list_index,
 		  tag);
 
   /* check if what they request is consistent */
@@ -346,15 +352,15 @@ acl_add_list (u32 count, vl_api_acl_rule_t rules[],
 	return VNET_API_ERROR_INVALID_VALUE_2;
     }
 
-  if (*acl_list_index != ~0)
+  if (acl_list_index != ~0)
     {
       /* They supplied some number, let's see if this ACL exists */
-      if (pool_is_free_index (am->acls, *acl_list_index))
+      if (pool_is_free_index (am->acls, acl_list_index))
 	{
 	  /* tried to replace a non-existent ACL, no point doing anything */
 	  clib_warning
 	    ("acl-plugin-error: Trying to replace nonexistent ACL %d (tag %s)",
-	     *acl_list_index, tag);
+	     acl_list_index, tag);
 	  return VNET_API_ERROR_NO_SUCH_ENTRY;
 	}
     }
@@ -362,16 +368,16 @@ acl_add_list (u32 count, vl_api_acl_rule_t rules[],
     {
       clib_warning
 	("acl-plugin-warning: supplied no rules for ACL %d (tag %s)",
-	 *acl_list_index, tag);
+	 acl_list_index, tag);
     }
 
   /* Create and populate the rules */
   if (count > 0)
-    vec_validate (acl_new_rules, count - 1);
+    vec_validate (*acl_new_rules, count - 1);
 
   for (i = 0; i < count; i++)
     {
-      r = vec_elt_at_index (acl_new_rules, i);
+      r = vec_elt_at_index (*acl_new_rules, i);
       clib_memset (r, 0, sizeof (*r));
       r->is_permit = rules[i].is_permit;
       r->is_ipv6 = rules[i].src_prefix.address.af;
@@ -387,8 +393,24 @@ acl_add_list (u32 count, vl_api_acl_rule_t rules[],
       r->tcp_flags_value = rules[i].tcp_flags_value;
       r->tcp_flags_mask = rules[i].tcp_flags_mask;
     }
+  return 0;
+}
 
-  if (~0 == *acl_list_index)
+/*
+ * Install the rules decoded by acl_add_list_prepare (), with the workers
+ * stopped. On a replace only the ACEs which changed are updated in the
+ * lookup contexts, unless the delta replace is disabled.
+ */
+static void
+acl_add_list_commit (u32 * acl_list_index, acl_rule_t * acl_new_rules,
+		     u8 * tag)
+{
+  acl_main_t *am = &acl_main;
+  acl_list_t *a;
+  acl_rule_t *old_rules = 0;
+  int is_replace = (~0 != *acl_list_index);
+
+  if (!is_replace)
     {
       /* Get ACL index */
       pool_get_aligned (am->acls, a, CLIB_CACHE_LINE_BYTES);
@@ -399,12 +421,12 @@ acl_add_list (u32 count, vl_api_acl_rule_t rules[],
   else
     {
       a = am->acls + *acl_list_index;
-      /* Get rid of the old rules */
-      if (a->rules)
-	vec_free (a->rules);
+      /* Keep the old rules around to find what changed */
+      old_rules = a->rules;
     }
   a->rules = acl_new_rules;
-  memcpy (a->tag, tag, tag_len + 1);
+  memcpy (a->tag, tag,
+	  clib_strnlen ((const char *) tag, sizeof (a->tag) - 1) + 1);
   if (am->trace_acl > 255)
     warning_acl_print_acl (am->vlib_main, am, *acl_list_index);
   if (am->reclassify_sessions)
@@ -413,7 +435,30 @@ acl_add_list (u32 count, vl_api_acl_rule_t rules[],
       policy_notify_acl_change (am, *acl_list_index);
     }
   validate_and_reset_acl_counters (am, *acl_list_index);
-  acl_plugin_lookup_context_notify_acl_change (*acl_list_index);
+  if (is_replace)
+    acl_plugin_lookup_context_notify_acl_replace (*acl_list_index,
+						  old_rules);
+  else
+    acl_plugin_lookup_context_notify_acl_change (*acl_list_index);
+  vec_free (old_rules);
+}
+
+static int
+acl_add_list (u32 count, vl_api_acl_rule_t rules[],
+	      u32 * acl_list_index, u8 * tag)
+{
+  vlib_main_t *vm = vlib_get_main ();
+  acl_rule_t *acl_new_rules = 0;
+  int rv;
+
+  rv = acl_add_list_prepare (count, rules, *acl_list_index, tag,
+			     &acl_new_rules);
+  if (rv)
+    return rv;
+
+  vlib_worker_thread_barrier_sync (vm);
+  acl_add_list_commit (acl_list_index, acl_new_rules, tag);
+  vlib_worker_thread_barrier_release (vm);
   return 0;
 }
 
@@ -2560,6 +2605,32 @@ acl_set_aclplugin_fn (vlib_main_t * vm,
       am->use_hash_acl_matching = (val != 0);
       goto done;
     }
+  if (unformat (input, "lookup-context %u engine", &val))
+    {
+      acl_lookup_engine_t engine;
+      int rv;
+
+      if (unformat (input, "simd"))
+	engine = ACL_LOOKUP_ENGINE_SIMD;
+      else if (unformat (input, "hash"))
+	engine = ACL_LOOKUP_ENGINE_HASH;
+      else
+	{
+	  error = clib_error_return (0, "expecting simd or hash, got `%U`",
+				     format_unformat_error, input);
+	  goto done;
+	}
+      rv = acl_plugin_lookup_context_set_engine (val, engine);
+      if (rv)
+	error = clib_error_return (0, "lookup context %u: error %U", val,
+				   format_vnet_api_errno, rv);
+      goto done;
+    }
+  if (unformat (input, "delta-replace %u", &val))
+    {
+      am->use_delta_replace = (val != 0);
+      goto done;
+    }
   if (unformat (input, "l4-match-nonfirst-fragment %u", &val))
     {
       am->l4_match_nonfirst_fragment = (val != 0);
@@ -3680,9 +3751,492 @@ acl_clear_aclplugin_fn (vlib_main_t * vm,
   return error;
 }
 
+/*
+ * A rule set generator in the spirit of ClassBench: the prefix lengths,
+ * protocols and port range classes (wildcard, low, high, arbitrary range,
+ * exact match) follow the distributions of the ACL seed files, addresses
+ * are drawn from a small set of networks so the rules overlap. Packets
+ * are mostly generated from within a randomly picked rule.
+ */
+static u8
+acl_bench_pick (u32 * seed, const u8 * values, const u8 * weights, int n)
+{
+  u32 r = random_u32 (seed) % 100;
+  int i;
+
+  for (i = 0; i < n - 1; i++)
+    {
+      if (r < weights[i])
+	break;
+      r -= weights[i];
+    }
+  return values[i];
+}
+
+static void
+acl_bench_port_range (u32 * seed, int is_dst, u16 * first, u16 * last)
+{
+  u32 r = random_u32 (seed) % 100;
+  u32 p = random_u32 (seed) & 0xffff;
+  /* wildcard, exact, arbitrary range, low, high */
+  const u8 *weights = is_dst ? (u8[]) { 10, 50, 20, 10, 10 } :
+    (u8[]) { 80, 10, 4, 2, 4 };
+
+  if (r < weights[0])
+    *first = 0, *last = 65535;
+  else if ((r -= weights[0]) < weights[1])
+    *first = *last = p;
+  else if ((r -= weights[1]) < weights[2])
+    {
+      *first = p;
+      *last = clib_min (p + (random_u32 (seed) & 0x3ff), 65535);
+    }
+  else if ((r -= weights[2]) < weights[3])
+    *first = 0, *last = 1023;
+  else
+    *first = 1024, *last = 65535;
+}
+
+static void
+acl_bench_make_rules (u32 * seed, u32 n_rules, vl_api_acl_rule_t ** rules)
+{
+  static const u8 plen_values[] = { 0, 8, 16, 24, 28, 32 };
+  static const u8 src_plen_weights[] = { 10, 5, 15, 30, 10, 30 };
+  static const u8 dst_plen_weights[] = { 5, 5, 10, 25, 10, 45 };
+  static const u8 proto_values[] = { IP_PROTOCOL_TCP, IP_PROTOCOL_UDP,
+    IP_PROTOCOL_ICMP, 0
+  };
+  static const u8 proto_weights[] = { 70, 20, 5, 5 };
+  u32 nets[32];
+  u32 i;
+
+  for (i = 0; i < ARRAY_LEN (nets); i++)
+    nets[i] = random_u32 (seed) & 0xffff0000;
+
+  vec_validate (*rules, n_rules - 1);
+  for (i = 0; i < n_rules; i++)
+    {
+      vl_api_acl_rule_t *r = vec_elt_at_index (*rules, i);
+      u8 src_len, dst_len, proto;
+      u32 src, dst;
+      u16 first, last;
+
+      clib_memset (r, 0, sizeof (*r));
+      r->is_permit = random_u32 (seed) % 3 ? ACL_ACTION_API_PERMIT :
+	ACL_ACTION_API_DENY;
+
+      src_len = acl_bench_pick (seed, plen_values, src_plen_weights,
+				ARRAY_LEN (plen_values));
+      dst_len = acl_bench_pick (seed, plen_values, dst_plen_weights,
+				ARRAY_LEN (plen_values));
+      src = nets[random_u32 (seed) % ARRAY_LEN (nets)] |
+	(random_u32 (seed) & 0xffff);
+      dst = nets[random_u32 (seed) % ARRAY_LEN (nets)] |
+	(random_u32 (seed) & 0xffff);
+      src &= src_len ? ~0U << (32 - src_len) : 0;
+      dst &= dst_len ? ~0U << (32 - dst_len) : 0;
+
+      r->src_prefix.address.af = ADDRESS_IP4;
+      r->src_prefix.len = src_len;
+      *(u32 *) r->src_prefix.address.un.ip4 = clib_host_to_net_u32 (src);
+      r->dst_prefix.address.af = ADDRESS_IP4;
+      r->dst_prefix.len = dst_len;
+      *(u32 *) r->dst_prefix.address.un.ip4 = clib_host_to_net_u32 (dst);
+
+      proto = acl_bench_pick (seed, proto_values, proto_weights,
+			      ARRAY_LEN (proto_values));
+      r->proto = proto;
+      if (proto == IP_PROTOCOL_ICMP)
+	{
+	  /* echo request or any type, any code */
+	  first = last = 8;
+	  if (random_u32 (seed) & 1)
+	    first = 0, last = 255;
+	  r->srcport_or_icmptype_first = htons (first);
+	  r->srcport_or_icmptype_last = htons (last);
+	  r->dstport_or_icmpcode_first = htons (0);
+	  r->dstport_or_icmpcode_last = htons (255);
+	}
+      else if (proto)
+	{
+	  acl_bench_port_range (seed, 0, &first, &last);
+	  r->srcport_or_icmptype_first = htons (first);
+	  r->srcport_or_icmptype_last = htons (last);
+	  acl_bench_port_range (seed, 1, &first, &last);
+	  r->dstport_or_icmpcode_first = htons (first);
+	  r->dstport_or_icmpcode_last = htons (last);
+	  if (proto == IP_PROTOCOL_TCP && (random_u32 (seed) % 10) == 0)
+	    {
+	      /* established */
+	      r->tcp_flags_mask = TCP_FLAG_ACK;
+	      r->tcp_flags_value = TCP_FLAG_ACK;
+	    }
+	}
+    }
+}
+
+static void
+acl_bench_make_packets (u32 * seed, u32 lc_index, vl_api_acl_rule_t * rules,
+			u32 n_packets, fa_5tuple_t ** packets)
+{
+  u32 i;
+
+  vec_validate_aligned (*packets, n_packets - 1, CLIB_CACHE_LINE_BYTES);
+  for (i = 0; i < n_packets; i++)
+    {
+      fa_5tuple_t *t = vec_elt_at_index (*packets, i);
+      vl_api_acl_rule_t *r = vec_elt_at_index (rules,
+					       random_u32 (seed) %
+					       vec_len (rules));
+      u32 rnd = random_u32 (seed);
+      u32 src_mask, dst_mask;
+      u16 first, last;
+
+      clib_memset (t, 0, sizeof (*t));
+      t->pkt.lc_index = lc_index;
+      t->pkt.l4_valid = 1;
+
+      if (random_u32 (seed) % 10 == 0)
+	{
+	  /* one in ten is not generated from a rule */
+	  t->ip4_addr[0].as_u32 = random_u32 (seed);
+	  t->ip4_addr[1].as_u32 = random_u32 (seed);
+	  t->l4.proto = rnd & 1 ? IP_PROTOCOL_TCP : IP_PROTOCOL_UDP;
+	  t->l4.port[0] = random_u32 (seed);
+	  t->l4.port[1] = random_u32 (seed);
+	}
+      else
+	{
+	  src_mask = r->src_prefix.len ?
+	    clib_host_to_net_u32 (~0U << (32 - r->src_prefix.len)) : 0;
+	  dst_mask = r->dst_prefix.len ?
+	    clib_host_to_net_u32 (~0U << (32 - r->dst_prefix.len)) : 0;
+	  t->ip4_addr[0].as_u32 = (*(u32 *) r->src_prefix.address.un.ip4) |
+	    (random_u32 (seed) & ~src_mask);
+	  t->ip4_addr[1].as_u32 = (*(u32 *) r->dst_prefix.address.un.ip4) |
+	    (random_u32 (seed) & ~dst_mask);
+	  t->l4.proto = r->proto ? r->proto : IP_PROTOCOL_UDP;
+	  first = ntohs (r->srcport_or_icmptype_first);
+	  last = ntohs (r->srcport_or_icmptype_last);
+	  t->l4.port[0] = first + random_u32 (seed) % (last - first + 1);
+	  first = ntohs (r->dstport_or_icmpcode_first);
+	  last = ntohs (r->dstport_or_icmpcode_last);
+	  t->l4.port[1] = first + random_u32 (seed) % (last - first + 1);
+	}
+      if (t->l4.proto == IP_PROTOCOL_TCP)
+	{
+	  t->pkt.tcp_flags_valid = 1;
+	  t->pkt.tcp_flags = rnd & 2 ? TCP_FLAG_ACK : TCP_FLAG_SYN;
+	}
+    }
+}
+
+static clib_error_t *
+acl_test_aclplugin_lookup_bench_fn (vlib_main_t * vm,
+				    unformat_input_t * input,
+				    vlib_cli_command_t * cmd)
+{
+  acl_main_t *am = &acl_main;
+  vl_api_acl_rule_t *rules = 0;
+  fa_5tuple_t *packets = 0;
+  u32 *hash_results = 0, *simd_results = 0, *acl_vec = 0;
+  u32 n_rules = 1000, n_packets = 4096, n_iter = 20;
+  u32 seed = 0xdeadbeef;
+  u32 acl_index = ~0, user_id, i, j, n_mismatch = 0, n_matched = 0;
+  f64 spc = vm->clib_time.seconds_per_clock;
+  u64 t0, hash_clocks = 0, simd_clocks = 0, build_clocks;
+  acl_simd_classifier_t *sc;
+  int lc_index, rv;
+
+  while (unformat_check_input (input) != UNFORMAT_END_OF_INPUT)
+    {
+      if (unformat (input, "rules %u", &n_rules))
+	;
+      else if (unformat (input, "packets %u", &n_packets))
+	;
+      else if (unformat (input, "iterations %u", &n_iter))
+	;
+      else if (unformat (input, "seed %u", &seed))
+	;
+      else
+	return clib_error_return (0, "unknown input `%U'",
+				  format_unformat_error, input);
+    }
+
+  if (n_rules == 0 || n_packets == 0 || n_iter == 0)
+    return clib_error_return (0, "rules, packets and iterations must be "
+			      "non-zero");
+  n_packets = round_pow2 (n_packets, ACL_SIMD_N_LANES);
+
+  acl_bench_make_rules (&seed, n_rules, &rules);
+  rv = acl_add_list (n_rules, rules, &acl_index, (u8 *) "lookup-bench");
+  if (rv)
+    {
+      vec_free (rules);
+      return clib_error_return (0, "failed to add the ACL: %U",
+				format_vnet_api_errno, rv);
+    }
+
+  user_id = acl_plugin.register_user_module ("ACL lookup bench", "unused",
+					     "unused");
+  lc_index = acl_plugin.get_lookup_context_index (user_id, 0, 0);
+  vec_add1 (acl_vec, acl_index);
+  acl_plugin.set_acl_vec_for_context (lc_index, acl_vec);
+
+  acl_bench_make_packets (&seed, lc_index, rules, n_packets, &packets);
+  vec_validate (hash_results, n_packets - 1);
+  vec_validate (simd_results, n_packets - 1);
+
+  for (i = 0; i < n_iter; i++)
+    {
+      t0 = clib_cpu_time_now ();
+      for (j = 0; j < n_packets; j++)
+	{
+	  u8 action;
+	  u32 acl_pos, acl_match, rule_match = ~0, trace_bitmap = 0;
+
+	  if (!acl_plugin_match_5tuple_inline (am, lc_index,
+					       (fa_5tuple_opaque_t *) &
+					       packets[j], 0, &action,
+					       &acl_pos, &acl_match,
+					       &rule_match, &trace_bitmap))
+	    rule_match = ~0;
+	  hash_results[j] = rule_match;
+	}
+      hash_clocks += clib_cpu_time_now () - t0;
+    }
+
+  t0 = clib_cpu_time_now ();
+  acl_plugin_lookup_context_set_engine (lc_index, ACL_LOOKUP_ENGINE_SIMD);
+  build_clocks = clib_cpu_time_now () - t0;
+  sc = vec_elt_at_index (am->simd_classifier_by_lc_index, lc_index);
+
+  for (i = 0; i < n_iter; i++)
+    {
+      t0 = clib_cpu_time_now ();
+      for (j = 0; j < n_packets; j += ACL_SIMD_N_LANES)
+	{
+	  u32 result[ACL_SIMD_N_LANES];
+	  u16 matched;
+	  u32 k;
+
+	  matched = acl_simd_classify_fn (sc, &packets[j], 0xffff, result);
+	  for (k = 0; k < ACL_SIMD_N_LANES; k++)
+	    simd_results[j + k] = matched & (1 << k) ? result[k] : ~0;
+	}
+      simd_clocks += clib_cpu_time_now () - t0;
+    }
+
+  for (j = 0; j < n_packets; j++)
+    {
+      u32 rule_match = ~0;
+
+      if (simd_results[j] != ~0)
+	{
+	  rule_match = am->hash_entry_vec_by_lc_index[lc_index]
+	    [simd_results[j]].ace_index;
+	  n_matched++;
+	}
+      if (rule_match != hash_results[j])
+	n_mismatch++;
+    }
+
+  vlib_cli_output (vm, "%u rules, %u packets, %u iterations", n_rules,
+		   n_packets, n_iter);
+  vlib_cli_output (vm, "  %-6s %8.2f ns/packet, %u mask types",
+		   am->use_hash_acl_matching ? "hash" : "linear",
+		   hash_clocks * spc * 1e9 / ((f64) n_packets * n_iter),
+		   vec_len (am->hash_applied_mask_info_vec_by_lc_index
+			    [lc_index]));
+  vlib_cli_output (vm, "  %-6s %8.2f ns/packet, built in %.3f ms",
+		   "simd", simd_clocks * spc * 1e9 /
+		   ((f64) n_packets * n_iter), build_clocks * spc * 1e3);
+  vlib_cli_output (vm, "  %u packets matched, %u results differ", n_matched,
+		   n_mismatch);
+
+  acl_plugin.put_lookup_context_index (lc_index);
+  acl_del_list (acl_index);
+  vec_free (rules);
+  vec_free (packets);
+  vec_free (hash_results);
+  vec_free (simd_results);
+  vec_free (acl_vec);
+
+  if (n_mismatch)
+    return clib_error_return (0, "%u packets classified differently",
+			      n_mismatch);
+  return 0;
+}
+
+/*
+ * Time the replace of an ACL applied to a number of lookup contexts,
+ * each followed by another ACL, when a few of its rules change per
+ * replace. The barrier hold time is the time spent installing the rules
+ * with the workers stopped, the apply time adds the validation and
+ * decoding done beforehand.
+ */
+static clib_error_t *
+acl_test_aclplugin_replace_bench_fn (vlib_main_t * vm,
+				     unformat_input_t * input,
+				     vlib_cli_command_t * cmd)
+{
+  acl_main_t *am = &acl_main;
+  vl_api_acl_rule_t *base_rules = 0, *rules = 0, *tail_rules = 0;
+  vl_api_acl_rule_t *changed = 0;
+  fa_5tuple_t *packets = 0;
+  u32 *lc_indices = 0, *acl_vec = 0, *results = 0;
+  u32 n_rules = 1000, n_changes = 1, n_contexts = 4, n_iter = 20;
+  u32 seed = 0xdeadbeef, run_seed;
+  u32 acl_index = ~0, tail_acl_index = ~0, user_id, i, j, n_mismatch = 0;
+  int saved_use_delta_replace = am->use_delta_replace;
+  f64 spc = vm->clib_time.seconds_per_clock;
+  u64 t0, t1, apply_clocks[2] = { 0 }, hold_clocks[2] = { 0 };
+  int delta, rv;
+
+  while (unformat_check_input (input) != UNFORMAT_END_OF_INPUT)
+    {
+      if (unformat (input, "rules %u", &n_rules))
+	;
+      else if (unformat (input, "changes %u", &n_changes))
+	;
+      else if (unformat (input, "contexts %u", &n_contexts))
+	;
+      else if (unformat (input, "iterations %u", &n_iter))
+	;
+      else if (unformat (input, "seed %u", &seed))
+	;
+      else
+	return clib_error_return (0, "unknown input `%U'",
+				  format_unformat_error, input);
+    }
+
+  if (n_rules == 0 || n_contexts == 0 || n_iter == 0)
+    return clib_error_return (0, "rules, contexts and iterations must be "
+			      "non-zero");
+  if (n_changes == 0 || n_changes > n_rules)
+    return clib_error_return (0, "changes must be between 1 and %u",
+			      n_rules);
+
+  acl_bench_make_rules (&seed, n_rules, &base_rules);
+  acl_bench_make_rules (&seed, 64, &tail_rules);
+  rv = acl_add_list (n_rules, base_rules, &acl_index, (u8 *) "replace-bench");
+  if (!rv)
+    rv = acl_add_list (vec_len (tail_rules), tail_rules, &tail_acl_index,
+		       (u8 *) "replace-bench tail");
+  if (rv)
+    {
+      if (acl_index != ~0)
+	acl_del_list (acl_index);
+      vec_free (base_rules);
+      vec_free (tail_rules);
+      return clib_error_return (0, "failed to add the ACLs: %U",
+				format_vnet_api_errno, rv);
+    }
+
+  user_id = acl_plugin.register_user_module ("ACL replace bench", "context",
+					     "unused");
+  vec_add1 (acl_vec, acl_index);
+  vec_add1 (acl_vec, tail_acl_index);
+  for (i = 0; i < n_contexts; i++)
+    {
+      int lc_index = acl_plugin.get_lookup_context_index (user_id, i, 0);
+      acl_plugin.set_acl_vec_for_context (lc_index, acl_vec);
+      vec_add1 (lc_indices, lc_index);
+    }
+
+  /* the same sequence of changes with a full rebuild, then a delta one */
+  for (delta = 0; delta < 2; delta++)
+    {
+      am->use_delta_replace = 0;
+      vec_free (rules);
+      rules = vec_dup (base_rules);
+      acl_add_list (n_rules, rules, &acl_index, (u8 *) "replace-bench");
+      am->use_delta_replace = delta;
+      run_seed = seed;
+
+      for (i = 0; i < n_iter; i++)
+	{
+	  acl_rule_t *acl_new_rules = 0;
+
+	  acl_bench_make_rules (&run_seed, n_changes, &changed);
+	  for (j = 0; j < n_changes; j++)
+	    rules[random_u32 (&run_seed) % n_rules] = changed[j];
+
+	  t0 = clib_cpu_time_now ();
+	  acl_add_list_prepare (n_rules, rules, acl_index,
+				(u8 *) "replace-bench", &acl_new_rules);
+	  vlib_worker_thread_barrier_sync (vm);
+	  t1 = clib_cpu_time_now ();
+	  acl_add_list_commit (&acl_index, acl_new_rules,
+			       (u8 *) "replace-bench");
+	  hold_clocks[delta] += clib_cpu_time_now () - t1;
+	  vlib_worker_thread_barrier_release (vm);
+	  apply_clocks[delta] += clib_cpu_time_now () - t0;
+	}
+    }
+
+  /* the lookup after the delta updates must match a full rebuild */
+  acl_bench_make_packets (&seed, lc_indices[0], rules, 4096, &packets);
+  vec_validate (results, vec_len (packets) - 1);
+  for (delta = 1; delta >= 0; delta--)
+    {
+      if (!delta)
+	{
+	  am->use_delta_replace = 0;
+	  acl_add_list (n_rules, rules, &acl_index, (u8 *) "replace-bench");
+	}
+      for (j = 0; j < vec_len (packets); j++)
+	{
+	  u8 action;
+	  u32 acl_pos, acl_match, rule_match = ~0, trace_bitmap = 0;
+
+	  if (!acl_plugin_match_5tuple_inline (am, lc_indices[0],
+					       (fa_5tuple_opaque_t *) &
+					       packets[j], 0, &action,
+					       &acl_pos, &acl_match,
+					       &rule_match, &trace_bitmap))
+	    rule_match = acl_match = ~0;
+	  rule_match ^= acl_match << 16;
+	  if (delta)
+	    results[j] = rule_match;
+	  else if (results[j] != rule_match)
+	    n_mismatch++;
+	}
+    }
+  am->use_delta_replace = saved_use_delta_replace;
+
+  vlib_cli_output (vm, "%u rules, %u changed per replace, %u contexts, "
+		   "%u iterations", n_rules, n_changes, n_contexts, n_iter);
+  for (delta = 0; delta < 2; delta++)
+    vlib_cli_output (vm, "  %-6s apply %9.3f ms, barrier held %9.3f ms",
+		     delta ? "delta" : "full",
+		     apply_clocks[delta] * spc * 1e3 / n_iter,
+		     hold_clocks[delta] * spc * 1e3 / n_iter);
+  vlib_cli_output (vm, "  %u packets checked, %u results differ",
+		   vec_len (packets), n_mismatch);
+
+  vec_foreach_index (i, lc_indices)
+    acl_plugin.put_lookup_context_index (lc_indices[i]);
+  acl_del_list (acl_index);
+  acl_del_list (tail_acl_index);
+  vec_free (base_rules);
+  vec_free (rules);
+  vec_free (tail_rules);
+  vec_free (changed);
+  vec_free (packets);
+  vec_free (results);
+  vec_free (lc_indices);
+  vec_free (acl_vec);
+
+  if (n_mismatch)
+    return clib_error_return (0, "%u packets classified differently",
+			      n_mismatch);
+  return 0;
+}
+
 VLIB_CLI_COMMAND (aclplugin_set_command, static) = {
     .path = "set acl-plugin",
-    .short_help = "set acl-plugin session timeout {{udp idle}|tcp {idle|transient}} <seconds>",
+    .short_help = "set acl-plugin session timeout {{udp idle}|tcp {idle|transient}} <seconds> | lookup-context <index> engine {simd|hash} | delta-replace <0|1>",
     .function = acl_set_aclplugin_fn,
 };
 
@@ -3734,6 +4288,18 @@ VLIB_CLI_COMMAND (aclplugin_show_tables_command, static) = {
     .function = acl_show_aclplugin_tables_fn,
 };
 
+VLIB_CLI_COMMAND (aclplugin_test_lookup_bench_command, static) = {
+    .path = "test acl-plugin lookup-bench",
+    .short_help = "test acl-plugin lookup-bench [rules <n>] [packets <n>] [iterations <n>] [seed <n>]",
+    .function = acl_test_aclplugin_lookup_bench_fn,
+};
+
+VLIB_CLI_COMMAND (aclplugin_test_replace_bench_command, static) = {
+    .path = "test acl-plugin replace-bench",
+    .short_help = "test acl-plugin replace-bench [rules <n>] [changes <n>] [contexts <n>] [iterations <n>] [seed <n>]",
+    .function = acl_test_aclplugin_replace_bench_fn,
+};
+
 VLIB_CLI_COMMAND (aclplugin_show_macip_acl_command, static) = {
     .path = "show acl-plugin macip acl",
     .short_help = "show acl-plugin macip acl [index N]",
@@ -3941,6 +4507,9 @@ acl_init (vlib_main_t * vm)
 
   /* Ask for a correctly-sized block of API message decode slots */
   am->msg_id_base = setup_message_id_table ();
+  /* acl_add_replace takes the worker barrier only to install the rules */
+  vl_api_set_msg_thread_safe (vlibapi_get_main (),
+			      am->msg_id_base + VL_API_ACL_ADD_REPLACE, 1);
 
   error = acl_plugin_exports_init (&acl_plugin);
 
@@ -4011,6 +4580,8 @@ acl_init (vlib_main_t * vm)
   am->use_hash_acl_matching = 1;
   /* use tuplemerge by default */
   am->use_tuple_merge = 1;
+  /* only update the changed ACEs when an ACL is replaced */
+  am->use_delta_replace = 1;
   /* Set the default threshold */
   am->tuple_merge_split_threshold = TM_SPLIT_THRESHOLD;
 
@@ -33,6 +33,7 @@
 #include "fa_node.h"
 #include "hash_lookup_types.h"
 #include "lookup_context.h"
+#include "simd_lookup.h"
 
 #define  ACL_PLUGIN_VERSION_MAJOR 1
 #define  ACL_PLUGIN_VERSION_MINOR 4
@@ -179,6 +180,9 @@ typedef struct {
   /* Do we use the TupleMerge for hash ACLs or not */
   int use_tuple_merge;
 
+  /* Do we update only the changed ACEs when an ACL is replaced */
+  int use_delta_replace;
+
   /* Max collision vector length before splitting the tuple */
 #define TM_SPLIT_THRESHOLD 39
   int tuple_merge_split_threshold;
@@ -189,6 +193,9 @@ typedef struct {
   /* vec of vectors of all info of all mask types present in ACEs contained in each lc_index */
   hash_applied_mask_info_t **hash_applied_mask_info_vec_by_lc_index;
 
+  /* compiled classifiers for the lookup contexts using the SIMD engine */
+  acl_simd_classifier_t *simd_classifier_by_lc_index;
+
   /*
    * Classify tables used to grab the packets for the ACL check,
    * and serving as the 5-tuple session tables at the same time
@@ -316,6 +316,67 @@ acl_fa_node_common_prepare_fn (vlib_main_t * vm,
     }
 }
 
+/*
+ * Match the IPv4 5-tuple at fa_5tuple[0] using the SIMD engine of the
+ * lookup context. The first packet that needs it classifies a batch made
+ * of itself and the following packets of the frame in the same lookup
+ * context, the following packets then pick up their result from the batch.
+ */
+always_inline int
+acl_fa_simd_match_5tuple (acl_main_t * am, acl_simd_batch_t * sb,
+			  u32 lc_index, int is_input, fa_5tuple_t * fa_5tuple,
+			  u32 * sw_if_index, u32 n_left, u8 * r_action,
+			  u32 * r_acl_pos_p, u32 * r_acl_match_p,
+			  u32 * r_rule_match_p)
+{
+  applied_hash_ace_entry_t *pae;
+  u32 lane = sb->base ? fa_5tuple - sb->base : ~0;
+
+  fa_5tuple->pkt.lc_index = lc_index;
+
+  if (lane >= ACL_SIMD_N_LANES || sb->lc_index != lc_index
+      || !(sb->valid & (1 << lane)))
+    {
+      u32 *lc_index_by_sw_if_index = is_input ?
+	am->input_lc_index_by_sw_if_index :
+	am->output_lc_index_by_sw_if_index;
+      u32 i, n = clib_min (n_left, ACL_SIMD_N_LANES);
+      u16 lanes = 1;
+
+      for (i = 1; i < n; i++)
+	if (lc_index_by_sw_if_index[sw_if_index[i]] == lc_index
+	    && !fa_5tuple[i].pkt.is_nonfirst_fragment)
+	  lanes |= 1 << i;
+
+      sb->base = fa_5tuple;
+      sb->lc_index = lc_index;
+      sb->valid = lanes;
+      sb->matched =
+	acl_simd_classify (vec_elt_at_index
+			   (am->simd_classifier_by_lc_index, lc_index),
+			   fa_5tuple, lanes, sb->result);
+      lane = 0;
+    }
+
+  if (!(sb->matched & (1 << lane)))
+    return 0;
+
+  pae = vec_elt_at_index (am->hash_entry_vec_by_lc_index[lc_index],
+			  sb->result[lane]);
+  pae->hitcount++;
+  *r_acl_pos_p = pae->acl_position;
+  *r_acl_match_p = pae->acl_index;
+  *r_rule_match_p = pae->ace_index;
+  *r_action = pae->action;
+  return 1;
+}
+
+always_inline int
+acl_fa_lc_uses_simd (acl_main_t * am, u32 lc_index)
+{
+  return lc_index < vec_len (am->simd_classifier_by_lc_index)
+    && am->simd_classifier_by_lc_index[lc_index].enabled;
+}
 
 always_inline uword
 acl_fa_inner_node_fn (vlib_main_t * vm,
@@ -346,6 +407,7 @@ acl_fa_inner_node_fn (vlib_main_t * vm,
   u32 saved_matched_ace_index = 0;
   u32 saved_packet_count = 0;
   u32 saved_byte_count = 0;
+  acl_simd_batch_t simd_batch = { 0 };
 
   error_node = vlib_node_get_runtime (vm, node->node_index);
   no_error_existing_session =
@@ -470,13 +532,25 @@ acl_fa_inner_node_fn (vlib_main_t * vm,
 		  am->output_lc_index_by_sw_if_index[sw_if_index[0]];
 
 	      action = 0;	/* deny by default */
-	      int is_match = acl_plugin_match_5tuple_inline (am, lc_index0,
-							     (fa_5tuple_opaque_t *) & fa_5tuple[0], is_ip6,
-							     &action,
-							     &match_acl_pos,
-							     &match_acl_in_index,
-							     &match_rule_index,
-							     &trace_bitmap);
+	      int is_match;
+	      if (!is_ip6 && acl_fa_lc_uses_simd (am, lc_index0)
+		  && !fa_5tuple[0].pkt.is_nonfirst_fragment)
+		is_match = acl_fa_simd_match_5tuple (am, &simd_batch,
+						     lc_index0, is_input,
+						     &fa_5tuple[0],
+						     &sw_if_index[0], n_left,
+						     &action,
+						     &match_acl_pos,
+						     &match_acl_in_index,
+						     &match_rule_index);
+	      else
+		is_match = acl_plugin_match_5tuple_inline (am, lc_index0,
+							   (fa_5tuple_opaque_t *) & fa_5tuple[0], is_ip6,
+							   &action,
+							   &match_acl_pos,
+							   &match_acl_in_index,
+							   &match_rule_index,
+							   &trace_bitmap);
 	      if (PREDICT_FALSE
 		  (is_match && am->interface_acl_counters_enabled))
 		{
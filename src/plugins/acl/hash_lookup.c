@@ -434,6 +434,10 @@ remake_hash_applied_mask_info_vec (acl_main_t * am,
       applied_hash_ace_entry_t *pae =
         vec_elt_at_index ((*applied_hash_aces), i);
 
+      /* an entry not yet activated by hash_acl_replace() */
+      if (pae->mask_type_index == ~0)
+        continue;
+
       /* check if mask_type_index is already there */
       u32 new_pointer = vec_len (new_hash_applied_mask_info_vec);
       int search;
@@ -710,6 +714,7 @@ hash_acl_apply(acl_main_t *am, u32 lc_index, int acl_index, u32 acl_position)
       check_collision_count_and_maybe_split(am, lc_index, is_ip6, first_index);
   }
   remake_hash_applied_mask_info_vec(am, applied_hash_aces, lc_index);
+  acl_simd_classifier_rebuild(lc_index);
 }
 
 static u32
@@ -908,6 +913,7 @@ hash_acl_unapply(acl_main_t *am, u32 lc_index, int acl_index)
   if (vec_len((*applied_hash_aces)) == 0) {
     vec_free((*applied_hash_aces));
   }
+  acl_simd_classifier_rebuild(lc_index);
 }
 
 /*
@@ -1032,6 +1038,22 @@ make_mask_and_match_from_rule(fa_5tuple_t *mask, acl_rule_t *r, hash_ace_info_t
 }
 
 
+static void
+make_hash_ace_info(acl_main_t *am, int acl_index, u32 ace_index, acl_rule_t *r, hash_ace_info_t *ace_info)
+{
+  fa_5tuple_t mask;
+  clib_memset(ace_info, 0, sizeof(*ace_info));
+  ace_info->acl_index = acl_index;
+  ace_info->ace_index = ace_index;
+
+  make_mask_and_match_from_rule(&mask, r, ace_info);
+  mask.pkt.flags_reserved = 0b000;
+  ace_info->base_mask_type_index = assign_mask_type_index(am, &mask);
+  /* assign the mask type index for matching itself */
+  ace_info->match.pkt.mask_type_index_lsb = ace_info->base_mask_type_index;
+  DBG("ACE: %d mask_type_index: %d", ace_index, ace_info->base_mask_type_index);
+}
+
 int hash_acl_exists(acl_main_t *am, int acl_index)
 {
   if (acl_index >= vec_len(am->hash_acl_infos))
@@ -1062,17 +1084,7 @@ void hash_acl_add(acl_main_t *am, int acl_index)
 
   for(i=0; i < vec_len(acl_rules); i++) {
     hash_ace_info_t ace_info;
-    fa_5tuple_t mask;
-    clib_memset(&ace_info, 0, sizeof(ace_info));
-    ace_info.acl_index = acl_index;
-    ace_info.ace_index = i;
-
-    make_mask_and_match_from_rule(&mask, &acl_rules[i], &ace_info);
-    mask.pkt.flags_reserved = 0b000;
-    ace_info.base_mask_type_index = assign_mask_type_index(am, &mask);
-    /* assign the mask type index for matching itself */
-    ace_info.match.pkt.mask_type_index_lsb = ace_info.base_mask_type_index;
-    DBG("ACE: %d mask_type_index: %d", i, ace_info.base_mask_type_index);
+    make_hash_ace_info(am, acl_index, i, &acl_rules[i], &ace_info);
     vec_add1(ha->rules, ace_info);
   }
   /*
@@ -1125,6 +1137,202 @@ void hash_acl_delete(acl_main_t *am, int acl_index)
   vec_free(ha->rules);
 }
 
+/* offset of the first applied entry of the ACL within the lookup context */
+static u32
+applied_acl_base_offset(acl_main_t *am, u32 lc_index, int acl_index, u32 *acl_position)
+{
+  acl_lookup_context_t *acontext = pool_elt_at_index(am->acl_lookup_contexts, lc_index);
+  u32 base_offset = 0;
+  u32 i;
+
+  for(i=0; i < vec_len(acontext->acl_indices); i++) {
+    u32 applied_acl = acontext->acl_indices[i];
+    if (applied_acl == acl_index)
+      break;
+    base_offset += vec_len(vec_elt_at_index(am->hash_acl_infos, applied_acl)->rules);
+  }
+  ASSERT(i < vec_len(acontext->acl_indices));
+  *acl_position = i;
+  return base_offset;
+}
+
+static void
+update_colliding_rule_ace_index(applied_hash_ace_entry_t **applied_hash_aces, u32 index)
+{
+  applied_hash_ace_entry_t *pae = vec_elt_at_index((*applied_hash_aces), index);
+  u32 head_index = find_head_applied_ace_index(applied_hash_aces, index);
+  applied_hash_ace_entry_t *head_pae = vec_elt_at_index((*applied_hash_aces), head_index);
+  collision_match_rule_t *cr;
+
+  vec_foreach(cr, head_pae->colliding_rules) {
+    if (cr->applied_entry_index == index)
+      cr->ace_index = pae->ace_index;
+  }
+}
+
+/*
+ * Replace the rule set of an ACL which is already hashed, touching only
+ * the ACEs which changed. The rules common to the head and to the tail of
+ * the old and new rule sets keep their applied entries (and hit counts),
+ * the ones in between are deactivated, the rest of each applied vector is
+ * shifted by the difference in length, and the new ACEs are activated
+ * in the gap.
+ *
+ * The new rules must be in am->acls[acl_index] already, old_rules are the
+ * ones they replace.
+ */
+void
+hash_acl_replace(acl_main_t *am, int acl_index, acl_rule_t *old_rules)
+{
+  acl_rule_t *new_rules = am->acls[acl_index].rules;
+  hash_acl_info_t *ha = vec_elt_at_index(am->hash_acl_infos, acl_index);
+  hash_ace_info_t *new_hash_rules = 0;
+  uword *changed = 0;
+  u32 old_len = vec_len(old_rules);
+  u32 new_len = vec_len(new_rules);
+  u32 head = 0, tail = 0;
+  u32 old_mid, new_mid;
+  int delta;
+  u32 *lc_index;
+  int i;
+
+  ASSERT(old_len == vec_len(ha->rules));
+
+  /* the rules are zeroed before being filled in, so memcmp() is fine */
+  while ((head < old_len) && (head < new_len) &&
+         (0 == memcmp(&old_rules[head], &new_rules[head], sizeof(acl_rule_t))))
+    head++;
+  while ((tail < old_len - head) && (tail < new_len - head) &&
+         (0 == memcmp(&old_rules[old_len - 1 - tail], &new_rules[new_len - 1 - tail],
+                      sizeof(acl_rule_t))))
+    tail++;
+  old_mid = old_len - head - tail;
+  new_mid = new_len - head - tail;
+  delta = (int)new_mid - (int)old_mid;
+  DBG0("HASH ACL replace: acl %d head %d tail %d old %d new %d", acl_index,
+       head, tail, old_mid, new_mid);
+
+  if (old_mid == 0 && new_mid == 0)
+    return;
+
+  /* if the count did not change, only the differing ACEs are replaced */
+  for(i=0; i < new_mid; i++) {
+    if ((delta != 0) ||
+        memcmp(&old_rules[head + i], &new_rules[head + i], sizeof(acl_rule_t)))
+      changed = clib_bitmap_set(changed, i, 1);
+  }
+  for(i=new_mid; i < old_mid; i++)
+    changed = clib_bitmap_set(changed, i, 1);
+
+  /*
+   * Take the changed entries out and make room for the new ones.
+   * This runs with the old hash ACE info in place, as the moved
+   * entries still refer to it.
+   */
+  vec_foreach(lc_index, ha->lc_index_list) {
+    applied_hash_ace_entry_t **applied_hash_aces = get_applied_hash_aces(am, *lc_index);
+    u32 acl_position;
+    u32 base_offset = applied_acl_base_offset(am, *lc_index, acl_index, &acl_position);
+    u32 tail_offset = base_offset + head + old_mid;
+    u32 old_vec_len = vec_len((*applied_hash_aces));
+
+    clib_bitmap_foreach (i, changed) {
+      if (i < old_mid)
+        deactivate_applied_ace_hash_entry(am, *lc_index,
+                                          applied_hash_aces, base_offset + head + i);
+    }
+    if (delta > 0) {
+      vec_resize((*applied_hash_aces), delta);
+      for(i = old_vec_len; i > tail_offset; i--) {
+        move_applied_ace_hash_entry(am, *lc_index, applied_hash_aces, i - 1, i - 1 + delta);
+      }
+    } else if (delta < 0) {
+      for(i = tail_offset; i < old_vec_len; i++) {
+        move_applied_ace_hash_entry(am, *lc_index, applied_hash_aces, i, i + delta);
+      }
+      vec_dec_len ((*applied_hash_aces), -delta);
+    }
+    /* the gap is not part of the lookup until activated */
+    clib_bitmap_foreach (i, changed) {
+      if (i >= new_mid)
+        break;
+      applied_hash_ace_entry_t *pae = vec_elt_at_index((*applied_hash_aces), base_offset + head + i);
+      pae->mask_type_index = ~0;
+      pae->collision_head_ae_index = ~0;
+      pae->colliding_rules = NULL;
+    }
+    /* deactivation may have released mask types still listed there */
+    remake_hash_applied_mask_info_vec(am, applied_hash_aces, *lc_index);
+  }
+
+  /* build the new hash ACE info, reusing the unchanged head and tail */
+  if (new_len > 0)
+    vec_validate(new_hash_rules, new_len - 1);
+  for(i=0; i < head; i++)
+    new_hash_rules[i] = ha->rules[i];
+  for(i=0; i < new_mid; i++) {
+    if (clib_bitmap_get(changed, i))
+      make_hash_ace_info(am, acl_index, head + i, &new_rules[head + i], &new_hash_rules[head + i]);
+    else
+      new_hash_rules[head + i] = ha->rules[head + i];
+  }
+  for(i=0; i < tail; i++) {
+    new_hash_rules[head + new_mid + i] = ha->rules[head + old_mid + i];
+    new_hash_rules[head + new_mid + i].ace_index = head + new_mid + i;
+  }
+  clib_bitmap_foreach (i, changed) {
+    if (i < old_mid)
+      release_mask_type_index(am, ha->rules[head + i].base_mask_type_index);
+  }
+  vec_free(ha->rules);
+  ha->rules = new_hash_rules;
+
+  vec_foreach(lc_index, ha->lc_index_list) {
+    applied_hash_ace_entry_t **applied_hash_aces = get_applied_hash_aces(am, *lc_index);
+    u32 acl_position;
+    u32 base_offset = applied_acl_base_offset(am, *lc_index, acl_index, &acl_position);
+
+    /* the unchanged tail of the ACL moved within the rule vector */
+    if (delta != 0) {
+      for(i=0; i < tail; i++) {
+        u32 index = base_offset + head + new_mid + i;
+        applied_hash_ace_entry_t *pae = vec_elt_at_index((*applied_hash_aces), index);
+        pae->hash_ace_info_index = head + new_mid + i;
+        pae->ace_index = ha->rules[pae->hash_ace_info_index].ace_index;
+        update_colliding_rule_ace_index(applied_hash_aces, index);
+      }
+    }
+
+    clib_bitmap_foreach (i, changed) {
+      if (i >= new_mid)
+        break;
+      u32 new_index = base_offset + head + i;
+      int is_ip6 = ha->rules[head + i].match.pkt.is_ip6;
+      applied_hash_ace_entry_t *pae = vec_elt_at_index((*applied_hash_aces), new_index);
+      pae->acl_index = acl_index;
+      pae->ace_index = ha->rules[head + i].ace_index;
+      pae->acl_position = acl_position;
+      pae->action = ha->rules[head + i].action;
+      pae->hitcount = 0;
+      pae->hash_ace_info_index = head + i;
+      pae->collision_head_ae_index = ~0;
+      pae->colliding_rules = NULL;
+      pae->mask_type_index = ~0;
+      assign_mask_type_index_to_pae(am, *lc_index, is_ip6, pae);
+      u32 first_index = activate_applied_ace_hash_entry(am, *lc_index, applied_hash_aces, new_index);
+      if (am->use_tuple_merge)
+        check_collision_count_and_maybe_split(am, *lc_index, is_ip6, first_index);
+    }
+    remake_hash_applied_mask_info_vec(am, applied_hash_aces, *lc_index);
+
+    if (vec_len((*applied_hash_aces)) == 0) {
+      vec_free((*applied_hash_aces));
+    }
+    acl_simd_classifier_rebuild(*lc_index);
+  }
+  clib_bitmap_free(changed);
+}
+
 
 void
 show_hash_acl_hash (vlib_main_t * vm, acl_main_t *am, u32 verbose)
@@ -41,6 +41,13 @@ void hash_acl_unapply(acl_main_t *am, u32 lc_index, int acl_index);
 void hash_acl_add(acl_main_t *am, int acl_index);
 void hash_acl_delete(acl_main_t *am, int acl_index);
 
+/*
+ * Replace the rules of an existing hash ACL, updating only the ACEs which
+ * differ from old_rules in the lookup contexts it is applied to.
+ */
+
+void hash_acl_replace(acl_main_t *am, int acl_index, acl_rule_t *old_rules);
+
 /* return if there is already a filled-in hash acl info */
 int hash_acl_exists(acl_main_t *am, int acl_index);
 
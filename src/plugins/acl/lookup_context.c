@@ -114,6 +114,7 @@ static int acl_plugin_get_lookup_context_index (u32 acl_user_id, u32 val1, u32 v
   acontext->context_user_id = acl_user_id;
   acontext->user_val1 = val1;
   acontext->user_val2 = val2;
+  acontext->engine = ACL_LOOKUP_ENGINE_HASH;
 
   u32 new_context_id = acontext - am->acl_lookup_contexts;
   vec_add1(am->acl_users[acl_user_id].lookup_contexts, new_context_id);
@@ -206,6 +207,8 @@ static void acl_plugin_put_lookup_context_index (u32 lc_index)
   unapply_acl_vec(lc_index, acontext->acl_indices);
   unlock_acl_vec(lc_index, acontext->acl_indices);
   vec_free(acontext->acl_indices);
+  acontext->engine = ACL_LOOKUP_ENGINE_HASH;
+  acl_simd_classifier_rebuild(lc_index);
   pool_put(am->acl_lookup_contexts, acontext);
 }
 
@@ -282,6 +285,44 @@ void acl_plugin_lookup_context_notify_acl_change(u32 acl_num)
   }
 }
 
+/*
+ * The rules of an existing ACL were replaced, old_rules is the previous
+ * rule set. Unless disabled, only the ACEs which differ are updated in
+ * the lookup contexts, rather than unapplying and reapplying all of them.
+ */
+void acl_plugin_lookup_context_notify_acl_replace(u32 acl_num, acl_rule_t *old_rules)
+{
+  acl_main_t *am = &acl_main;
+  if (am->use_delta_replace && hash_acl_exists(am, acl_num)) {
+    hash_acl_replace(am, acl_num, old_rules);
+  } else {
+    acl_plugin_lookup_context_notify_acl_change(acl_num);
+  }
+}
+
+
+/*
+ * Select the engine the ACL plugin datapath uses to match the packets
+ * within a given context. The SIMD engine handles the IPv4 packets,
+ * IPv6 and non-first fragments are still matched by the hash/linear path.
+ */
+int acl_plugin_lookup_context_set_engine (u32 lc_index, acl_lookup_engine_t engine)
+{
+  acl_main_t *am = &acl_main;
+  acl_lookup_context_t *acontext;
+
+  if (!acl_lc_index_valid(am, lc_index))
+    return VNET_API_ERROR_NO_SUCH_ENTRY;
+  if (engine > ACL_LOOKUP_ENGINE_SIMD)
+    return VNET_API_ERROR_INVALID_VALUE;
+
+  elog_acl_cond_trace_X2(am, (am->trace_acl), "LOOKUP-CONTEXT: set-engine lc_index %d engine %d", "i4i4", lc_index, engine);
+  acontext = pool_elt_at_index(am->acl_lookup_contexts, lc_index);
+  acontext->engine = engine;
+  acl_simd_classifier_rebuild(lc_index);
+  return 0;
+}
+
 
 /* Fill the 5-tuple from the packet */
 
@@ -349,6 +390,9 @@ acl_plugin_show_lookup_context (u32 lc_index)
                        acontext->user_val1, acontext->user_val2,
                        format_vec32, acontext->acl_indices, "%d");
       }
+      if (acontext->engine == ACL_LOOKUP_ENGINE_SIMD)
+        vlib_cli_output (vm, "  %U", format_acl_simd_classifier,
+                         vec_elt_at_index(am->simd_classifier_by_lc_index, curr_lc_index));
     }
   }
 }
@@ -27,6 +27,13 @@ typedef struct {
   u32 *lookup_contexts;
 } acl_lookup_context_user_t;
 
+typedef enum {
+  /* bihash (TupleMerge) or linear lookup, as per use_hash_acl_matching */
+  ACL_LOOKUP_ENGINE_HASH = 0,
+  /* batched SIMD matching of the IPv4 packets, see simd_lookup.h */
+  ACL_LOOKUP_ENGINE_SIMD,
+} acl_lookup_engine_t;
+
 typedef struct {
   /* vector of acl #s within this context */
   u32 *acl_indices;
@@ -36,9 +43,13 @@ typedef struct {
   u32 user_val1;
   /* per-instance user value 2 */
   u32 user_val2;
+  /* acl_lookup_engine_t used by the ACL plugin datapath */
+  u8 engine;
 } acl_lookup_context_t;
 
 void acl_plugin_lookup_context_notify_acl_change(u32 acl_num);
+void acl_plugin_lookup_context_notify_acl_replace(u32 acl_num, acl_rule_t *old_rules);
+int acl_plugin_lookup_context_set_engine (u32 lc_index, acl_lookup_engine_t engine);
 
 void acl_plugin_show_lookup_context (u32 lc_index);
 void acl_plugin_show_lookup_user (u32 user_index);
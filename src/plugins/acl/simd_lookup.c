@@ -0,0 +1,122 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#include <vlib/vlib.h>
+#include <vnet/vnet.h>
+#include <acl/acl.h>
+#include <acl/simd_lookup.h>
+
+CLIB_MARCH_FN (acl_simd_classify_batch, u16, acl_simd_classifier_t *sc,
+	       fa_5tuple_t *t, u16 lanes, u32 *result)
+{
+  return acl_simd_classify (sc, t, lanes, result);
+}
+
+#ifndef CLIB_MARCH_VARIANT
+
+u16
+acl_simd_classify_fn (acl_simd_classifier_t *sc, fa_5tuple_t *t, u16 lanes,
+		      u32 *result)
+{
+  return CLIB_MARCH_FN_SELECT (acl_simd_classify_batch) (sc, t, lanes,
+							 result);
+}
+
+static u32
+acl_simd_prefix_mask (u8 prefixlen)
+{
+  if (prefixlen == 0)
+    return 0;
+  return clib_host_to_net_u32 (~0U << (32 - clib_min (prefixlen, 32)));
+}
+
+static void
+acl_simd_rule_compile (acl_simd_rule_t *sr, acl_rule_t *r,
+		       u32 applied_entry_index)
+{
+  clib_memset (sr, 0, sizeof (*sr));
+  sr->applied_entry_index = applied_entry_index;
+
+  /*
+   * Same semantics as single_rule_match_5tuple (): the packet address is
+   * masked but the rule address is not, a rule address with the host bits
+   * set never matches; a zero prefix length matches any address.
+   */
+  sr->src_mask = acl_simd_prefix_mask (r->src_prefixlen);
+  sr->src = sr->src_mask ? r->src.ip4.as_u32 : 0;
+  sr->dst_mask = acl_simd_prefix_mask (r->dst_prefixlen);
+  sr->dst = sr->dst_mask ? r->dst.ip4.as_u32 : 0;
+
+  if (r->proto == 0)
+    return;
+
+  sr->proto = r->proto | 1 << 8;
+  sr->proto_mask = 0x1ff;
+  sr->sport_first = r->src_port_or_type_first;
+  sr->sport_last = r->src_port_or_type_last;
+  sr->dport_first = r->dst_port_or_code_first;
+  sr->dport_last = r->dst_port_or_code_last;
+  sr->tcp_flags = r->tcp_flags_value | 1 << 8;
+  sr->tcp_flags_mask = r->tcp_flags_mask | 1 << 8;
+
+  if (sr->sport_first > sr->sport_last || sr->dport_first > sr->dport_last)
+    {
+      /* an empty range can not match, make the protocol never match */
+      sr->proto = 1 << 9;
+      sr->sport_first = sr->sport_last = 0;
+      sr->dport_first = sr->dport_last = 0;
+    }
+}
+
+void
+acl_simd_classifier_rebuild (u32 lc_index)
+{
+  acl_main_t *am = &acl_main;
+  acl_lookup_context_t *acontext;
+  acl_simd_classifier_t *sc;
+  applied_hash_ace_entry_t *pae;
+  acl_simd_rule_t *sr;
+  acl_rule_t *r;
+  u32 i;
+
+  vec_validate (am->simd_classifier_by_lc_index, lc_index);
+  sc = vec_elt_at_index (am->simd_classifier_by_lc_index, lc_index);
+  acontext = pool_elt_at_index (am->acl_lookup_contexts, lc_index);
+
+  sc->enabled = (acontext->engine == ACL_LOOKUP_ENGINE_SIMD);
+  if (!sc->enabled)
+    {
+      vec_free (sc->rules);
+      return;
+    }
+
+  vec_reset_length (sc->rules);
+  if (lc_index >= vec_len (am->hash_entry_vec_by_lc_index))
+    return;
+
+  vec_foreach_index (i, am->hash_entry_vec_by_lc_index[lc_index])
+    {
+      pae = vec_elt_at_index (am->hash_entry_vec_by_lc_index[lc_index], i);
+      if (pool_is_free_index (am->acls, pae->acl_index) ||
+	  pae->ace_index >= vec_len (am->acls[pae->acl_index].rules))
+	continue;
+      r = vec_elt_at_index (am->acls[pae->acl_index].rules, pae->ace_index);
+      if (r->is_ipv6)
+	continue;
+      vec_add2 (sc->rules, sr, 1);
+      acl_simd_rule_compile (sr, r, i);
+    }
+}
+
+u8 *
+format_acl_simd_classifier (u8 *s, va_list *args)
+{
+  acl_simd_classifier_t *sc = va_arg (*args, acl_simd_classifier_t *);
+
+  s = format (s, "simd engine: %u ipv4 rules, %U", vec_len (sc->rules),
+	      format_memory_size, vec_mem_size (sc->rules));
+  return s;
+}
+
+#endif /* CLIB_MARCH_VARIANT */
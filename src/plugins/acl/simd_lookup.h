@@ -0,0 +1,154 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#ifndef included_acl_simd_lookup_h
+#define included_acl_simd_lookup_h
+
+#include <vppinfra/vector/mask_compare.h>
+#include "fa_node.h"
+
+/*
+ * The SIMD lookup engine matches a batch of ACL_SIMD_N_LANES IPv4 packets
+ * at once against the ACEs applied to a lookup context. The ACEs are
+ * compiled, in the order of the applied hash entries, into a table of
+ * fixed size records; each record is compared against all the lanes of
+ * the batch with vector mask compares, the first matching ACE wins for a
+ * given lane and the walk stops as soon as every lane has matched.
+ *
+ * The result for a lane is the index into the applied hash entries of
+ * the lookup context, same as the hash lookup produces, so the action,
+ * hitcount and counters are handled identically by either engine.
+ */
+
+#define ACL_SIMD_N_LANES 16
+
+typedef struct
+{
+  /* addresses in network byte order, value is not pre-masked */
+  u32 src;
+  u32 src_mask;
+  u32 dst;
+  u32 dst_mask;
+  /* proto | 1 << 8 for l4_valid, mask is zero for "any protocol" */
+  u32 proto;
+  u32 proto_mask;
+  u32 sport_first;
+  u32 sport_last;
+  u32 dport_first;
+  u32 dport_last;
+  /* tcp_flags | 1 << 8 for tcp_flags_valid */
+  u32 tcp_flags;
+  u32 tcp_flags_mask;
+  /* index into hash_entry_vec_by_lc_index[lc_index] */
+  u32 applied_entry_index;
+  u32 pad[3];
+} acl_simd_rule_t;
+
+STATIC_ASSERT_SIZEOF (acl_simd_rule_t, 64);
+
+typedef struct
+{
+  /* the lookup context uses the SIMD engine */
+  u8 enabled;
+  /* compiled IPv4 ACEs, in the order of the applied hash entries */
+  acl_simd_rule_t *rules;
+} acl_simd_classifier_t;
+
+/* The packet fields of a batch, one array per field */
+typedef struct
+{
+  u32 src[ACL_SIMD_N_LANES];
+  u32 dst[ACL_SIMD_N_LANES];
+  u32 proto[ACL_SIMD_N_LANES];
+  u32 sport[ACL_SIMD_N_LANES];
+  u32 dport[ACL_SIMD_N_LANES];
+  u32 tcp_flags[ACL_SIMD_N_LANES];
+} acl_simd_keys_t;
+
+/* The last classified batch, kept by the ACL node for the frame */
+typedef struct
+{
+  fa_5tuple_t *base;
+  u32 lc_index;
+  /* lanes which were part of the batch */
+  u16 valid;
+  /* lanes which matched an ACE */
+  u16 matched;
+  u32 result[ACL_SIMD_N_LANES];
+} acl_simd_batch_t;
+
+/*
+ * Classify the packets of the lanes set in the "lanes" bitmap, with
+ * t[i] being the 5-tuple of lane i. For each matching lane the applied
+ * entry index is stored in result[i]. Returns the bitmap of the lanes
+ * which matched.
+ */
+static_always_inline u16
+acl_simd_classify (acl_simd_classifier_t *sc, fa_5tuple_t *t, u16 lanes,
+		   u32 *result)
+{
+  acl_simd_keys_t k = {};
+  acl_simd_rule_t *r;
+  u16 tcp_invalid = 0;
+  u16 pending = lanes;
+  u16 m;
+  u32 i;
+
+  foreach_set_bit_index (i, lanes)
+    {
+      k.src[i] = t[i].ip4_addr[0].as_u32;
+      k.dst[i] = t[i].ip4_addr[1].as_u32;
+      k.proto[i] = t[i].l4.proto | t[i].pkt.l4_valid << 8;
+      k.sport[i] = t[i].l4.port[0];
+      k.dport[i] = t[i].l4.port[1];
+      k.tcp_flags[i] = t[i].pkt.tcp_flags | t[i].pkt.tcp_flags_valid << 8;
+      if (!t[i].pkt.tcp_flags_valid)
+	tcp_invalid |= 1 << i;
+    }
+
+  vec_foreach (r, sc->rules)
+    {
+      m = pending &
+	  clib_mask_compare_u32_x16_masked (r->src, r->src_mask, k.src);
+      if (!m)
+	continue;
+      m &= clib_mask_compare_u32_x16_masked (r->dst, r->dst_mask, k.dst);
+      if (!m)
+	continue;
+      if (r->proto_mask)
+	{
+	  m &= clib_mask_compare_u32_x16_masked (r->proto, r->proto_mask,
+						  k.proto);
+	  m &= clib_mask_compare_u32_x16_range (r->sport_first, r->sport_last,
+						 k.sport);
+	  m &= clib_mask_compare_u32_x16_range (r->dport_first, r->dport_last,
+						 k.dport);
+	  if (!m)
+	    continue;
+	  m &= tcp_invalid | clib_mask_compare_u32_x16_masked (
+			       r->tcp_flags, r->tcp_flags_mask, k.tcp_flags);
+	  if (!m)
+	    continue;
+	}
+
+      pending ^= m;
+      foreach_set_bit_index (i, m)
+	result[i] = r->applied_entry_index;
+
+      if (!pending)
+	break;
+    }
+
+  return lanes ^ pending;
+}
+
+/* Recompile the classifier of a lookup context from its applied entries */
+void acl_simd_classifier_rebuild (u32 lc_index);
+
+/* Out of line acl_simd_classify (), built for the best CPU variant */
+u16 acl_simd_classify_fn (acl_simd_classifier_t *sc, fa_5tuple_t *t,
+			  u16 lanes, u32 *result);
+format_function_t format_acl_simd_classifier;
+
+#endif /* included_acl_simd_lookup_h */
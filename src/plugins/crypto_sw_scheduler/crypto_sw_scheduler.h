@@ -55,10 +55,41 @@ typedef struct
   u8 self_crypto_enabled;
 } crypto_sw_scheduler_per_thread_data_t;
 
+/* elements a thread processes per dequeue call in work-stealing mode,
+ * small frames are batched until this many */
+#define CRYPTO_SW_SCHEDULER_WS_BATCH_SIZE VNET_CRYPTO_FRAME_SIZE
+
+/*
+ * Per-thread frame queue of the work-stealing engine. Only the owner
+ * enqueues (head) and hands completed frames back in submission order
+ * (tail). Frames between tail and head are claimed for processing by
+ * moving top with compare-and-swap, by the owner or by any other thread
+ * which steals from it, so tail <= top <= head.
+ */
+typedef struct
+{
+  CLIB_CACHE_LINE_ALIGN_MARK (cacheline0);
+  u32 head;
+  vnet_crypto_async_frame_t **jobs;
+
+  CLIB_CACHE_LINE_ALIGN_MARK (cacheline1);
+  u32 top;
+
+  CLIB_CACHE_LINE_ALIGN_MARK (cacheline2);
+  u32 tail;
+  /* other threads, same core first, then same numa node, then the rest */
+  clib_thread_index_t *steal_order;
+  u64 n_own_frames;
+  u64 n_stolen_frames;
+  u64 n_elts;
+} crypto_sw_scheduler_ws_queue_t;
+
 typedef struct
 {
   u32 crypto_engine_index;
+  u32 ws_crypto_engine_index;
   crypto_sw_scheduler_per_thread_data_t *per_thread_data;
+  crypto_sw_scheduler_ws_queue_t *ws_queues;
   vnet_crypto_key_t *keys;
   u32 crypto_sw_scheduler_queue_mask;
 } crypto_sw_scheduler_main_t;
@@ -67,6 +98,12 @@ extern crypto_sw_scheduler_main_t crypto_sw_scheduler_main;
 
 extern int crypto_sw_scheduler_set_worker_crypto (u32 worker_idx, u8 enabled);
 
+void crypto_sw_scheduler_process_frame (
+  vlib_main_t *vm, crypto_sw_scheduler_per_thread_data_t *ptd,
+  vnet_crypto_async_frame_t *f);
+
+clib_error_t *crypto_sw_scheduler_ws_init (vlib_main_t *vm);
+
 extern clib_error_t *crypto_sw_scheduler_api_init (vlib_main_t * vm);
 
 #endif // __crypto_native_h__
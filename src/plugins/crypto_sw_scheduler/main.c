@@ -345,7 +345,7 @@ crypto_sw_scheduler_process_aead (vlib_main_t *vm,
       process_ops (vm, f, ptd->crypto_ops, &state);
       process_chained_ops (vm, f, ptd->chained_crypto_ops, ptd->chunks,
 			   &state);
-      f->state = state;
+      clib_atomic_store_rel_n (&f->state, state);
 }
 
 static_always_inline void
@@ -397,7 +397,7 @@ crypto_sw_scheduler_process_link (vlib_main_t *vm,
 			   &state);
     }
 
-  f->state = state;
+  clib_atomic_store_rel_n (&f->state, state);
 }
 
 static_always_inline int
@@ -444,6 +444,28 @@ convert_async_crypto_id (vnet_crypto_op_id_t async_op_id, u32 *crypto_op,
   return -1;
 }
 
+void
+crypto_sw_scheduler_process_frame (vlib_main_t *vm,
+				   crypto_sw_scheduler_per_thread_data_t *ptd,
+				   vnet_crypto_async_frame_t *f)
+{
+  crypto_sw_scheduler_main_t *cm = &crypto_sw_scheduler_main;
+  u32 crypto_op, auth_op_or_aad_len;
+  u16 digest_len;
+  u8 is_enc;
+  int ret;
+
+  ret = convert_async_crypto_id (f->op, &crypto_op, &auth_op_or_aad_len,
+				 &digest_len, &is_enc);
+
+  if (ret == 1)
+    crypto_sw_scheduler_process_aead (vm, ptd, f, crypto_op,
+				      auth_op_or_aad_len, digest_len);
+  else if (ret == 0)
+    crypto_sw_scheduler_process_link (vm, cm, ptd, f, crypto_op,
+				      auth_op_or_aad_len, digest_len, is_enc);
+}
+
 static_always_inline vnet_crypto_async_frame_t *
 crypto_sw_scheduler_dequeue (vlib_main_t *vm, u32 *nb_elts_processed,
 			     clib_thread_index_t *enqueue_thread_idx)
@@ -523,21 +545,7 @@ run_next_queues:
 
   if (found)
     {
-      u32 crypto_op, auth_op_or_aad_len;
-      u16 digest_len;
-      u8 is_enc;
-      int ret;
-
-      ret = convert_async_crypto_id (f->op, &crypto_op, &auth_op_or_aad_len,
-				     &digest_len, &is_enc);
-
-      if (ret == 1)
-	crypto_sw_scheduler_process_aead (vm, ptd, f, crypto_op,
-					  auth_op_or_aad_len, digest_len);
-      else if (ret == 0)
-	crypto_sw_scheduler_process_link (
-	  vm, cm, ptd, f, crypto_op, auth_op_or_aad_len, digest_len, is_enc);
-
+      crypto_sw_scheduler_process_frame (vm, ptd, f);
       *enqueue_thread_idx = f->enqueue_thread_index;
       *nb_elts_processed = f->n_elts;
     }
@@ -697,6 +705,9 @@ crypto_sw_scheduler_init (vlib_main_t * vm)
 
   crypto_sw_scheduler_api_init (vm);
 
+  if ((error = crypto_sw_scheduler_ws_init (vm)))
+    return error;
+
 #define _(n, s, k, t, a)                                                      \
   vnet_crypto_register_enqueue_handler (                                      \
     vm, cm->crypto_engine_index, VNET_CRYPTO_OP_##n##_TAG##t##_AAD##a##_ENC,  \
@@ -791,6 +802,14 @@ crypto_sw_scheduler_config (vlib_main_t *vm, unformat_input_t *input)
 	CRYPTO_SW_SCHEDULER_QUEUE_SIZE - 1, CLIB_CACHE_LINE_BYTES);
     }
 
+  vec_validate_aligned (cm->ws_queues, tm->n_vlib_mains - 1,
+			CLIB_CACHE_LINE_BYTES);
+
+  for (i = 0; i < tm->n_vlib_mains; i++)
+    vec_validate_aligned (cm->ws_queues[i].jobs,
+			  crypto_sw_scheduler_queue_size - 1,
+			  CLIB_CACHE_LINE_BYTES);
+
   if (error)
     vec_free (cm->per_thread_data);
 
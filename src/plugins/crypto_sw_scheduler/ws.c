@@ -0,0 +1,272 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+/*
+ * Work-stealing variant of the sw scheduler, registered as a separate
+ * async engine ("sw_scheduler_ws").
+ *
+ * Instead of every thread scanning the queues of all other threads, a
+ * thread first processes the frames it submitted itself, oldest first.
+ * Only if it has budget left it steals from other threads, nearest first
+ * (same physical core, then same numa node), and only from threads which
+ * have a backlog of more than one frame or don't process crypto at all.
+ * Frames are claimed by moving the queue top with compare-and-swap, so
+ * there are no locks and a frame is never looked at by two threads.
+ * The per call budget is counted in elements, so a thread submitting
+ * partially filled frames processes several of them in one go.
+ */
+
+#include <vlib/vlib.h>
+#include <vnet/plugin/plugin.h>
+
+#include "crypto_sw_scheduler.h"
+
+static int
+crypto_sw_scheduler_ws_frame_enqueue (vlib_main_t *vm,
+				      vnet_crypto_async_frame_t *frame)
+{
+  crypto_sw_scheduler_main_t *cm = &crypto_sw_scheduler_main;
+  crypto_sw_scheduler_ws_queue_t *q =
+    vec_elt_at_index (cm->ws_queues, vm->thread_index);
+  u32 head = q->head;
+
+  if (head - q->tail > cm->crypto_sw_scheduler_queue_mask)
+    {
+      u32 n_elts = frame->n_elts, i;
+      for (i = 0; i < n_elts; i++)
+	frame->elts[i].status = VNET_CRYPTO_OP_STATUS_FAIL_ENGINE_ERR;
+      return -1;
+    }
+
+  q->jobs[head & cm->crypto_sw_scheduler_queue_mask] = frame;
+  clib_atomic_store_rel_n (&q->head, head + 1);
+  return 0;
+}
+
+/* claim the oldest unclaimed frame of the queue if more than min_backlog - 1
+ * frames are waiting */
+static_always_inline vnet_crypto_async_frame_t *
+crypto_sw_scheduler_ws_claim (crypto_sw_scheduler_main_t *cm,
+			      crypto_sw_scheduler_ws_queue_t *q,
+			      u32 min_backlog)
+{
+  vnet_crypto_async_frame_t *f;
+  u32 top = clib_atomic_load_acq_n (&q->top);
+
+  while (clib_atomic_load_acq_n (&q->head) - top >= min_backlog)
+    {
+      /* slot can't be reused before top moves past it, so if the swap
+       * succeeds f is the frame we claimed */
+      f = q->jobs[top & cm->crypto_sw_scheduler_queue_mask];
+      if (clib_atomic_cmp_and_swap_acq_relax_n (&q->top, &top, top + 1, 0))
+	{
+	  f->state = VNET_CRYPTO_FRAME_STATE_WORK_IN_PROGRESS;
+	  return f;
+	}
+      /* top now holds the current value, try again */
+    }
+
+  return 0;
+}
+
+static vnet_crypto_async_frame_t *
+crypto_sw_scheduler_ws_dequeue (vlib_main_t *vm, u32 *nb_elts_processed,
+				clib_thread_index_t *enqueue_thread_idx)
+{
+  crypto_sw_scheduler_main_t *cm = &crypto_sw_scheduler_main;
+  crypto_sw_scheduler_per_thread_data_t *ptd =
+    cm->per_thread_data + vm->thread_index;
+  crypto_sw_scheduler_ws_queue_t *q = cm->ws_queues + vm->thread_index;
+  vnet_crypto_async_frame_t *f;
+  u32 n_elts = 0, tail;
+
+  if (ptd->self_crypto_enabled)
+    {
+      while (n_elts < CRYPTO_SW_SCHEDULER_WS_BATCH_SIZE &&
+	     (f = crypto_sw_scheduler_ws_claim (cm, q, 1)))
+	{
+	  crypto_sw_scheduler_process_frame (vm, ptd, f);
+	  n_elts += f->n_elts;
+	  q->n_own_frames++;
+	}
+
+      if (n_elts)
+	*enqueue_thread_idx = vm->thread_index;
+
+      /* help a single other thread per call, so the thread to be notified
+       * about completed frames is known */
+      for (u32 i = 0; i < vec_len (q->steal_order) &&
+		      n_elts < CRYPTO_SW_SCHEDULER_WS_BATCH_SIZE;
+	   i++)
+	{
+	  clib_thread_index_t ti = q->steal_order[i];
+	  crypto_sw_scheduler_ws_queue_t *vq = cm->ws_queues + ti;
+	  u32 min_backlog =
+	    cm->per_thread_data[ti].self_crypto_enabled ? 2 : 1;
+	  u32 n_stolen = 0;
+
+	  while (n_elts < CRYPTO_SW_SCHEDULER_WS_BATCH_SIZE &&
+		 (f = crypto_sw_scheduler_ws_claim (cm, vq, min_backlog)))
+	    {
+	      crypto_sw_scheduler_process_frame (vm, ptd, f);
+	      n_elts += f->n_elts;
+	      n_stolen++;
+	    }
+
+	  if (n_stolen)
+	    {
+	      q->n_stolen_frames += n_stolen;
+	      *enqueue_thread_idx = ti;
+	      break;
+	    }
+	}
+
+      q->n_elts += n_elts;
+      *nb_elts_processed = n_elts;
+    }
+
+  /* hand back own frames in submission order */
+  tail = q->tail;
+  if (tail != q->head)
+    {
+      f = q->jobs[tail & cm->crypto_sw_scheduler_queue_mask];
+      if (tail != clib_atomic_load_acq_n (&q->top) &&
+	  clib_atomic_load_acq_n (&f->state) >=
+	    VNET_CRYPTO_FRAME_STATE_SUCCESS)
+	{
+	  q->tail = tail + 1;
+	  return f;
+	}
+    }
+
+  return 0;
+}
+
+static clib_error_t *
+crypto_sw_scheduler_ws_main_loop_enter (vlib_main_t *vm)
+{
+  crypto_sw_scheduler_main_t *cm = &crypto_sw_scheduler_main;
+  u32 n_threads = vec_len (cm->ws_queues);
+
+  /* core and numa ids of workers are known once they are started */
+  for (u32 i = 0; i < n_threads; i++)
+    {
+      crypto_sw_scheduler_ws_queue_t *q = cm->ws_queues + i;
+      vlib_worker_thread_t *w = vlib_worker_threads + i;
+
+      vec_reset_length (q->steal_order);
+
+      /* distance 0 - same core, 1 - same numa node, 2 - any, each class
+       * starts after thread i so threads don't all go to the same victim */
+      for (int d = 0; d < 3; d++)
+	for (u32 j = (i + 1) % n_threads; j != i; j = (j + 1) % n_threads)
+	  {
+	    vlib_worker_thread_t *o = vlib_worker_threads + j;
+	    int same_numa = o->numa_id == w->numa_id;
+	    int same_core = same_numa && w->core_id >= 0 &&
+			    o->core_id == w->core_id;
+
+	    if ((d == 0 && same_core) || (d == 1 && same_numa && !same_core) ||
+		(d == 2 && !same_numa))
+	      vec_add1 (q->steal_order, j);
+	  }
+    }
+
+  return 0;
+}
+
+VLIB_MAIN_LOOP_ENTER_FUNCTION (crypto_sw_scheduler_ws_main_loop_enter) = {
+  .runs_after = VLIB_INITS ("start_workers"),
+};
+
+static u8 *
+format_crypto_sw_scheduler_ws_steal_order (u8 *s, va_list *args)
+{
+  clib_thread_index_t *order = va_arg (*args, clib_thread_index_t *);
+  u32 i;
+
+  vec_foreach_index (i, order)
+    s = format (s, "%s%u", i ? " " : "", order[i]);
+
+  return s;
+}
+
+static clib_error_t *
+sw_scheduler_show_work_stealing (vlib_main_t *vm, unformat_input_t *input,
+				 vlib_cli_command_t *cmd)
+{
+  crypto_sw_scheduler_main_t *cm = &crypto_sw_scheduler_main;
+  u32 i;
+
+  vlib_cli_output (vm, "%-8s%-20s%-8s%-14s%-14s%-14s%s", "Thread", "Name",
+		   "Crypto", "Own frames", "Stolen frames", "Elements",
+		   "Steal order");
+  vec_foreach_index (i, cm->ws_queues)
+    {
+      crypto_sw_scheduler_ws_queue_t *q = cm->ws_queues + i;
+      vlib_cli_output (vm, "%-8u%-20s%-8s%-14lu%-14lu%-14lu%U", i,
+		       vlib_worker_threads[i].name,
+		       cm->per_thread_data[i].self_crypto_enabled ? "on" :
+								    "off",
+		       q->n_own_frames, q->n_stolen_frames, q->n_elts,
+		       format_crypto_sw_scheduler_ws_steal_order,
+		       q->steal_order);
+    }
+
+  return 0;
+}
+
+/*?
+ * This command displays per thread counters of the work-stealing
+ * scheduler engine: frames processed from own queue, frames stolen from
+ * other threads, processed elements and the order in which other threads
+ * are visited when stealing.
+ *
+ * @cliexpar
+ * @cliexstart{show sw_scheduler work-stealing}
+ * @cliexend
+ ?*/
+VLIB_CLI_COMMAND (cmd_show_sw_scheduler_work_stealing, static) = {
+  .path = "show sw_scheduler work-stealing",
+  .short_help = "show sw_scheduler work-stealing",
+  .function = sw_scheduler_show_work_stealing,
+  .is_mp_safe = 1,
+};
+
+clib_error_t *
+crypto_sw_scheduler_ws_init (vlib_main_t *vm)
+{
+  crypto_sw_scheduler_main_t *cm = &crypto_sw_scheduler_main;
+  u32 ei;
+
+  /* lower priority than sw_scheduler, selected with
+   * 'set crypto handler all sw_scheduler_ws async' */
+  ei = cm->ws_crypto_engine_index = vnet_crypto_register_engine (
+    vm, "sw_scheduler_ws", 90, "SW Work-Stealing Scheduler Async Engine");
+
+#define _(n, s, k, t, a)                                                      \
+  vnet_crypto_register_enqueue_handler (                                      \
+    vm, ei, VNET_CRYPTO_OP_##n##_TAG##t##_AAD##a##_ENC,                       \
+    crypto_sw_scheduler_ws_frame_enqueue);                                    \
+  vnet_crypto_register_enqueue_handler (                                      \
+    vm, ei, VNET_CRYPTO_OP_##n##_TAG##t##_AAD##a##_DEC,                       \
+    crypto_sw_scheduler_ws_frame_enqueue);
+  foreach_crypto_aead_async_alg
+#undef _
+
+#define _(c, h, s, k, d)                                                      \
+  vnet_crypto_register_enqueue_handler (                                      \
+    vm, ei, VNET_CRYPTO_OP_##c##_##h##_TAG##d##_ENC,                          \
+    crypto_sw_scheduler_ws_frame_enqueue);                                    \
+  vnet_crypto_register_enqueue_handler (                                      \
+    vm, ei, VNET_CRYPTO_OP_##c##_##h##_TAG##d##_DEC,                          \
+    crypto_sw_scheduler_ws_frame_enqueue);
+    foreach_crypto_link_async_alg
+#undef _
+
+    vnet_crypto_register_dequeue_handler (vm, ei,
+					  crypto_sw_scheduler_ws_dequeue);
+
+  return 0;
+}
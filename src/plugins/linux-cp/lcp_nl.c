@@ -350,7 +350,9 @@ nl_route_process_msgs (void)
 
   lcp_set_netlink_processing_active (1);
 
-  /* process a batch of messages. break if we hit our limit */
+  /* process a batch of messages. break if we hit our limit. The routes
+   * of the batch are programmed as a FIB batch */
+  fib_table_batch_begin (0);
   vec_foreach (msg_info, nm->nl_msg_queue)
     {
       if ((err = nl_msg_parse (msg_info->msg, nl_route_dispatch, msg_info)) <
@@ -360,6 +362,7 @@ nl_route_process_msgs (void)
       if (++n_msgs >= nm->batch_size)
 	break;
     }
+  fib_table_batch_end ();
 
   /* remove the messages we processed from the head of the queue */
   if (n_msgs)
@@ -640,8 +643,10 @@ nl_route_process (vlib_main_t *vm, vlib_node_runtime_t *node,
   is_done = 0;                                                                \
   do                                                                          \
     {                                                                         \
+      fib_table_batch_begin (0);                                              \
       n_msgs =                                                                \
 	lcp_nl_recv_dump_replies (stype, nm->sync_batch_limit, &is_done);     \
+      fib_table_batch_end ();                                                 \
       if (n_msgs < 0)                                                         \
 	{                                                                     \
 	  NL_ERROR ("Error receiving dump replies of type " tname             \
@@ -203,18 +203,10 @@ nat44_ed_sm_o2i_del (snat_main_t *sm, ip4_address_t addr, u16 port,
   return clib_bihash_add_del_16_8 (&sm->flow_hash, &kv, 0 /*is_add*/);
 }
 
-void
-nat44_ed_free_session_data (snat_main_t *sm, snat_session_t *s,
-			    u32 thread_index, u8 is_ha)
+static void
+nat44_ed_free_session_state (snat_main_t *sm, snat_session_t *s,
+			     u32 thread_index, u8 is_ha)
 {
-  per_vrf_sessions_unregister_session (s, thread_index);
-
-  if (nat_ed_ses_i2o_flow_hash_add_del (sm, thread_index, s, 0))
-    nat_elog_warn (sm, "flow hash del failed");
-
-  if (nat_ed_ses_o2i_flow_hash_add_del (sm, thread_index, s, 0))
-    nat_elog_warn (sm, "flow hash del failed");
-
   if (na44_ed_is_fwd_bypass_session (s))
     {
       return;
@@ -240,6 +232,187 @@ nat44_ed_free_session_data (snat_main_t *sm, snat_session_t *s,
     }
 }
 
+void
+nat44_ed_free_session_data (snat_main_t *sm, snat_session_t *s,
+			    u32 thread_index, u8 is_ha)
+{
+  per_vrf_sessions_unregister_session (s, thread_index);
+
+  if (nat_ed_ses_i2o_flow_hash_add_del (sm, thread_index, s, 0))
+    nat_elog_warn (sm, "flow hash del failed");
+
+  if (nat_ed_ses_o2i_flow_hash_add_del (sm, thread_index, s, 0))
+    nat_elog_warn (sm, "flow hash del failed");
+
+  nat44_ed_free_session_state (sm, s, thread_index, is_ha);
+}
+
+#define NAT44_ED_FREE_BATCH 64
+
+void
+nat44_ed_sessions_free_batch (snat_main_t *sm, u32 thread_index,
+			      u32 *session_indices)
+{
+  snat_main_per_thread_data_t *tsm =
+    vec_elt_at_index (sm->per_thread_data, thread_index);
+  clib_bihash_kv_16_8_t kv[2 * NAT44_ED_FREE_BATCH];
+  u64 hash[2 * NAT44_ED_FREE_BATCH];
+  snat_session_t *s;
+  u32 i, j, n, n_left = vec_len (session_indices);
+  u32 *si = session_indices;
+
+  while (n_left)
+    {
+      n = clib_min (n_left, NAT44_ED_FREE_BATCH);
+
+      /* hash both directions up front so the bucket misses overlap */
+      for (i = 0; i < n; i++)
+	{
+	  s = pool_elt_at_index (tsm->sessions, si[i]);
+	  nat_6t_flow_to_ed_k (&kv[2 * i], &s->i2o);
+	  nat_6t_flow_to_ed_k (&kv[2 * i + 1], &s->o2i);
+	  for (j = 2 * i; j < 2 * i + 2; j++)
+	    {
+	      hash[j] = clib_bihash_hash_16_8 (&kv[j]);
+	      clib_bihash_prefetch_bucket_16_8 (&sm->flow_hash, hash[j]);
+	    }
+	}
+
+      for (i = 0; i < n; i++)
+	{
+	  s = pool_elt_at_index (tsm->sessions, si[i]);
+	  ASSERT (thread_index == s->thread_index);
+	  per_vrf_sessions_unregister_session (s, thread_index);
+	  for (j = 2 * i; j < 2 * i + 2; j++)
+	    if (clib_bihash_add_del_with_hash_16_8 (&sm->flow_hash, &kv[j],
+						    hash[j], 0 /* is_add */))
+	      nat_elog_warn (sm, "flow hash del failed");
+	  nat44_ed_free_session_state (sm, s, thread_index, 0);
+	  nat44_ed_session_timer_stop (tsm, s);
+	  pool_put (tsm->sessions, s);
+	}
+
+      si += n;
+      n_left -= n;
+    }
+
+  vlib_set_simple_counter (&sm->total_sessions, thread_index, 0,
+			   pool_elts (tsm->sessions));
+}
+
+u32
+nat44_ed_expire_sessions (snat_main_t *sm, u32 thread_index, f64 now, u32 max)
+{
+  snat_main_per_thread_data_t *tsm =
+    vec_elt_at_index (sm->per_thread_data, thread_index);
+  u32 i, n_old, n, si, n_freed;
+  snat_session_t *s;
+
+  /* timers left over from an earlier, capped walk come first */
+  n_old = vec_len (tsm->expired_timers);
+  tsm->expired_timers = tw_timer_expire_timers_vec_2t_1w_2048sl (
+    &tsm->expire_wheel, now, tsm->expired_timers);
+  for (i = n_old; i < vec_len (tsm->expired_timers); i++)
+    {
+      si = tsm->expired_timers[i] & 0x7FFFFFFF;
+      if (!pool_is_free_index (tsm->sessions, si))
+	pool_elt_at_index (tsm->sessions, si)->expire_timer_handle = ~0;
+    }
+
+  n = clib_min (max, vec_len (tsm->expired_timers));
+  vec_reset_length (tsm->expired_sessions);
+  for (i = 0; i < n; i++)
+    {
+      si = tsm->expired_timers[i] & 0x7FFFFFFF;
+      /* freed, or freed and reused, since the timer fired */
+      if (pool_is_free_index (tsm->sessions, si))
+	continue;
+      s = pool_elt_at_index (tsm->sessions, si);
+      if (s->expire_timer_handle != ~0)
+	continue;
+
+      if (now >= s->last_heard + (f64) nat44_session_get_timeout (sm, s))
+	vec_add1 (tsm->expired_sessions, si);
+      else
+	{
+	  nat44_ed_session_timer_start (
+	    tsm, s, now,
+	    s->last_heard + nat44_session_get_timeout (sm, s) - now);
+	  tsm->n_expire_rearmed++;
+	}
+    }
+  vec_delete (tsm->expired_timers, n, 0);
+
+  n_freed = vec_len (tsm->expired_sessions);
+  nat44_ed_sessions_free_batch (sm, thread_index, tsm->expired_sessions);
+  tsm->n_expired += n_freed;
+  return n_freed;
+}
+
+/* per thread session expiry, raised every second by the process below */
+static uword
+nat44_ed_expire_walk_fn (vlib_main_t *vm, vlib_node_runtime_t *rt,
+			 vlib_frame_t *f)
+{
+  snat_main_t *sm = &snat_main;
+  snat_main_per_thread_data_t *tsm;
+  u32 thread_index = vm->thread_index;
+  u32 n_freed;
+
+  if (!sm->enabled || thread_index >= vec_len (sm->per_thread_data))
+    return 0;
+
+  n_freed = nat44_ed_expire_sessions (sm, thread_index, vlib_time_now (vm),
+				      NAT44_ED_EXPIRE_BATCH);
+
+  /* come back for the rest without waiting for the next tick */
+  tsm = vec_elt_at_index (sm->per_thread_data, thread_index);
+  if (vec_len (tsm->expired_timers))
+    vlib_node_set_interrupt_pending (vm, rt->node_index);
+
+  return n_freed;
+}
+
+VLIB_REGISTER_NODE (nat44_ed_expire_walk_node) = {
+  .function = nat44_ed_expire_walk_fn,
+  .type = VLIB_NODE_TYPE_INPUT,
+  .state = VLIB_NODE_STATE_INTERRUPT,
+  .name = "nat44-ed-expire-walk",
+};
+
+/* periodically send interrupt to each thread */
+static uword
+nat44_ed_expire_process (vlib_main_t *vm, vlib_node_runtime_t *rt,
+			 vlib_frame_t *f)
+{
+  snat_main_t *sm = &snat_main;
+  u32 ti;
+
+  while (1)
+    {
+      vlib_process_wait_for_event_or_clock (vm, 1.0);
+      vlib_process_get_events (vm, 0);
+      if (!sm->enabled)
+	continue;
+      for (ti = 0; ti < vlib_get_n_threads (); ti++)
+	{
+	  if (ti >= vec_len (sm->per_thread_data))
+	    continue;
+
+	  vlib_node_set_interrupt_pending (vlib_get_main_by_index (ti),
+					   nat44_ed_expire_walk_node.index);
+	}
+    }
+
+  return 0;
+}
+
+VLIB_REGISTER_NODE (nat44_ed_expire_process_node) = {
+  .function = nat44_ed_expire_process,
+  .type = VLIB_NODE_TYPE_PROCESS,
+  .name = "nat44-ed-expire-process",
+};
+
 static ip_interface_address_t *
 nat44_ed_get_ip_interface_address (u32 sw_if_index, ip4_address_t addr)
 {
@@ -598,7 +771,7 @@ nat44_ed_del_address (ip4_address_t addr, u8 twice_nat)
       vec_foreach (ses_index, ses_to_be_removed)
 	{
 	  ses = pool_elt_at_index (tsm->sessions, ses_index[0]);
-	  nat_ed_session_delete (sm, ses, tsm - sm->per_thread_data, 1);
+	  nat_ed_session_delete (sm, ses, tsm - sm->per_thread_data);
 	}
       vec_free (ses_to_be_removed);
     }
@@ -805,7 +978,7 @@ nat_ed_static_mapping_del_sessions (snat_main_t * sm,
   vec_foreach (ses_index, indexes_to_free)
   {
     s = pool_elt_at_index (tsm->sessions, *ses_index);
-    nat_ed_session_delete (sm, s, tsm - sm->per_thread_data, 1);
+    nat_ed_session_delete (sm, s, tsm - sm->per_thread_data);
   }
   vec_free (indexes_to_free);
 }
@@ -1458,7 +1631,7 @@ nat44_ed_del_lb_static_mapping (ip4_address_t e_addr, u16 e_port,
 	    continue;
 
 	  nat44_ed_free_session_data (sm, s, tsm - sm->per_thread_data, 0);
-	  nat_ed_session_delete (sm, s, tsm - sm->per_thread_data, 1);
+	  nat_ed_session_delete (sm, s, tsm - sm->per_thread_data);
 	}
     }
 
@@ -1585,7 +1758,7 @@ nat44_ed_add_del_lb_static_mapping_local (ip4_address_t e_addr, u16 e_port,
 	    continue;
 
 	  nat44_ed_free_session_data (sm, s, tsm - sm->per_thread_data, 0);
-	  nat_ed_session_delete (sm, s, tsm - sm->per_thread_data, 1);
+	  nat_ed_session_delete (sm, s, tsm - sm->per_thread_data);
       }
 
       pool_put (m->locals, match_local);
@@ -2736,7 +2909,7 @@ nat44_ed_forwarding_enable_disable (u8 is_enable)
 	{
 	  s = pool_elt_at_index (tsm->sessions, ses_index[0]);
 	  nat44_ed_free_session_data (sm, s, tsm - sm->per_thread_data, 0);
-	  nat_ed_session_delete (sm, s, tsm - sm->per_thread_data, 1);
+	  nat_ed_session_delete (sm, s, tsm - sm->per_thread_data);
 	}
 
       vec_free (ses_to_be_removed);
@@ -3272,31 +3445,18 @@ nat44_update_session_limit (u32 session_limit, u32 vrf_id)
 static void
 nat44_ed_worker_db_init (snat_main_per_thread_data_t *tsm, u32 translations)
 {
-  dlist_elt_t *head;
-
   pool_alloc (tsm->per_vrf_sessions_pool, translations);
   pool_alloc (tsm->sessions, translations);
-  pool_alloc (tsm->lru_pool, translations);
-
-  pool_get (tsm->lru_pool, head);
-  tsm->tcp_trans_lru_head_index = head - tsm->lru_pool;
-  clib_dlist_init (tsm->lru_pool, tsm->tcp_trans_lru_head_index);
-
-  pool_get (tsm->lru_pool, head);
-  tsm->tcp_estab_lru_head_index = head - tsm->lru_pool;
-  clib_dlist_init (tsm->lru_pool, tsm->tcp_estab_lru_head_index);
-
-  pool_get (tsm->lru_pool, head);
-  tsm->udp_lru_head_index = head - tsm->lru_pool;
-  clib_dlist_init (tsm->lru_pool, tsm->udp_lru_head_index);
-
-  pool_get (tsm->lru_pool, head);
-  tsm->icmp_lru_head_index = head - tsm->lru_pool;
-  clib_dlist_init (tsm->lru_pool, tsm->icmp_lru_head_index);
 
-  pool_get (tsm->lru_pool, head);
-  tsm->unk_proto_lru_head_index = head - tsm->lru_pool;
-  clib_dlist_init (tsm->lru_pool, tsm->unk_proto_lru_head_index);
+  /* harvesting is cheap, the walk bounds the work done per run instead */
+  tw_timer_wheel_init_2t_1w_2048sl (&tsm->expire_wheel, 0 /* callback */,
+				    1.0 /* timer interval */,
+				    ~0 /* max expirations */);
+  pool_alloc (tsm->expire_wheel.timers, translations);
+  vec_validate (tsm->expired_timers, NAT44_ED_EXPIRE_BATCH - 1);
+  vec_reset_length (tsm->expired_timers);
+  vec_validate (tsm->expired_sessions, NAT44_ED_EXPIRE_BATCH - 1);
+  vec_reset_length (tsm->expired_sessions);
 }
 
 static void
@@ -3327,7 +3487,9 @@ nat44_ed_db_init ()
 static void
 nat44_ed_worker_db_free (snat_main_per_thread_data_t *tsm)
 {
-  pool_free (tsm->lru_pool);
+  tw_timer_wheel_free_2t_1w_2048sl (&tsm->expire_wheel);
+  vec_free (tsm->expired_timers);
+  vec_free (tsm->expired_sessions);
   pool_free (tsm->sessions);
   pool_free (tsm->per_vrf_sessions_pool);
 }
@@ -3641,7 +3803,7 @@ nat44_ed_del_session (snat_main_t *sm, ip4_address_t *addr, u16 port,
     return VNET_API_ERROR_UNSPECIFIED;
   s = pool_elt_at_index (tsm->sessions, ed_value_get_session_index (&value));
   nat44_ed_free_session_data (sm, s, tsm - sm->per_thread_data, 0);
-  nat_ed_session_delete (sm, s, tsm - sm->per_thread_data, 1);
+  nat_ed_session_delete (sm, s, tsm - sm->per_thread_data);
   return 0;
 }
 
@@ -28,6 +28,7 @@
 #include <vppinfra/hash.h>
 #include <vppinfra/dlist.h>
 #include <vppinfra/error.h>
+#include <vppinfra/tw_timer_2t_1w_2048sl.h>
 #include <vlibapi/api.h>
 
 #include <nat/lib/lib.h>
@@ -35,6 +36,12 @@
 /* default number of worker handoff frame queue elements */
 #define NAT_FQ_NELTS_DEFAULT 64
 
+/* session expiry wheel: a single 2048 slot ring of one second ticks, longer
+ * timeouts are re-armed when they fire */
+#define NAT44_ED_EXPIRE_MAX_TICKS 2047
+/* upper bound on sessions reclaimed per walk, bounds the worker stall */
+#define NAT44_ED_EXPIRE_BATCH 2048
+
 /* number of attempts to get a port for ED overloading algorithm, if rolling
  * a dice this many times doesn't produce a free port, it's treated
  * as if there were no free ports available to conserve resources */
@@ -304,11 +311,8 @@ typedef CLIB_PACKED(struct
   /* Flags */
   u32 flags;
 
-  /* head of LRU list in which this session is tracked */
-  u32 lru_head_index;
-  /* index in global LRU list */
-  u32 lru_index;
-  f64 last_lru_update;
+  /* expiry timer in the per-thread wheel */
+  u32 expire_timer_handle;
 
   /* Last heard timer */
   f64 last_heard;
@@ -454,13 +458,14 @@ typedef struct
   /* Pool of doubly-linked list elements */
   dlist_elt_t *list_pool;
 
-  /* LRU session list - head is stale, tail is fresh */
-  dlist_elt_t *lru_pool;
-  u32 tcp_trans_lru_head_index;
-  u32 tcp_estab_lru_head_index;
-  u32 udp_lru_head_index;
-  u32 icmp_lru_head_index;
-  u32 unk_proto_lru_head_index;
+  /* Session expiry, one timer per session, one second ticks */
+  tw_timer_wheel_2t_1w_2048sl_t expire_wheel;
+  /* expired timer handles not yet processed */
+  u32 *expired_timers;
+  /* scratch for batched session free */
+  u32 *expired_sessions;
+  u64 n_expired;
+  u64 n_expire_rearmed;
 
   /* NAT thread index */
   u32 snat_thread_index;
@@ -890,6 +895,28 @@ int nat44_ed_del_session (snat_main_t *sm, ip4_address_t *addr, u16 port,
 void nat44_ed_free_session_data (snat_main_t *sm, snat_session_t *s,
 				 u32 thread_index, u8 is_ha);
 
+/**
+ * @brief Free a batch of sessions of one thread, removing their flow hash
+ * entries with the bucket prefetches pipelined across the batch
+ *
+ * @param thread_index     thread owning the sessions
+ * @param session_indices  indices into the thread session pool
+ */
+void nat44_ed_sessions_free_batch (snat_main_t *sm, u32 thread_index,
+				   u32 *session_indices);
+
+/**
+ * @brief Reclaim sessions whose expiry timers have fired
+ *
+ * @param thread_index  thread owning the sessions
+ * @param now           current time
+ * @param max           maximum number of expired timers to process
+ *
+ * @return number of sessions freed
+ */
+u32 nat44_ed_expire_sessions (snat_main_t *sm, u32 thread_index, f64 now,
+			      u32 max);
+
 /**
  * @brief Set NAT44 session limit (session limit, vrf id)
  *
@@ -428,37 +428,21 @@ done:
 }
 
 static void
-nat44_show_lru_summary (vlib_main_t * vm, snat_main_per_thread_data_t * tsm,
-			u64 now, u64 sess_timeout_time)
+nat44_show_expire_summary (vlib_main_t *vm, snat_main_per_thread_data_t *tsm)
 {
-  snat_main_t *sm = &snat_main;
-  dlist_elt_t *oldest_elt;
-  snat_session_t *s;
-  u32 oldest_index;
-
-  if (tsm->lru_pool)
-    {
-#define _(n, d)                                                               \
-  oldest_index =                                                              \
-    clib_dlist_remove_head (tsm->lru_pool, tsm->n##_lru_head_index);          \
-  if (~0 != oldest_index)                                                     \
-    {                                                                         \
-      oldest_elt = pool_elt_at_index (tsm->lru_pool, oldest_index);           \
-      s = pool_elt_at_index (tsm->sessions, oldest_elt->value);               \
-      sess_timeout_time =                                                     \
-	s->last_heard + (f64) nat44_session_get_timeout (sm, s);              \
-      vlib_cli_output (vm, d " LRU min session timeout %llu (now %llu)",      \
-		       sess_timeout_time, now);                               \
-      clib_dlist_addhead (tsm->lru_pool, tsm->n##_lru_head_index,             \
-			  oldest_index);                                      \
-    }
-      _ (tcp_estab, "established tcp");
-      _ (tcp_trans, "transitory tcp");
-      _ (udp, "udp");
-      _ (unk_proto, "unknown protocol");
-      _ (icmp, "icmp");
-#undef _
-    }
+  tw_timer_wheel_2t_1w_2048sl_t *tw = &tsm->expire_wheel;
+  u32 n_pending;
+
+  if (!tw->timers)
+    return;
+
+  /* the wheel keeps one list head per slot in the timer pool */
+  n_pending = pool_elts (tw->timers) - ARRAY_LEN (tw->w[0]);
+  vlib_cli_output (vm,
+		   "expiry wheel: %u timers pending, %u fired not yet "
+		   "processed, %llu sessions expired, %llu timers re-armed",
+		   n_pending, vec_len (tsm->expired_timers), tsm->n_expired,
+		   tsm->n_expire_rearmed);
 }
 
 static clib_error_t *
@@ -532,7 +516,7 @@ nat44_show_summary_command_fn (vlib_main_t * vm, unformat_input_t * input,
 		 break;
 	       }
 	   }
-	  nat44_show_lru_summary (vm, tsm, now, sess_timeout_time);
+	  nat44_show_expire_summary (vm, tsm);
 	  count += pool_elts (tsm->sessions);
 	}
     }
@@ -580,7 +564,7 @@ nat44_show_summary_command_fn (vlib_main_t * vm, unformat_input_t * input,
 	    break;
 	  }
       }
-      nat44_show_lru_summary (vm, tsm, now, sess_timeout_time);
+      nat44_show_expire_summary (vm, tsm);
       count = pool_elts (tsm->sessions);
     }
 
@@ -450,7 +450,8 @@ slow_path_ed (vlib_main_t *vm, snat_main_t *sm, vlib_buffer_t *b,
   if (PREDICT_FALSE
       (nat44_ed_maximum_sessions_exceeded (sm, rx_fib_index, thread_index)))
     {
-      if (!nat_lru_free_one (sm, thread_index, now))
+      if (!nat44_ed_expire_sessions (sm, thread_index, now,
+				     NAT44_ED_EXPIRE_BATCH))
 	{
 	  b->error = node->errors[NAT_IN2OUT_ED_ERROR_MAX_SESSIONS_EXCEEDED];
 	  nat_ipfix_logging_max_sessions (thread_index,
@@ -531,7 +532,7 @@ slow_path_ed (vlib_main_t *vm, snat_main_t *sm, vlib_buffer_t *b,
 	{
 	  nat_elog_notice (sm, "addresses exhausted");
 	  b->error = node->errors[NAT_IN2OUT_ED_ERROR_OUT_OF_PORTS];
-	  nat_ed_session_delete (sm, s, thread_index, 1);
+	  nat_ed_session_delete (sm, s, thread_index);
 	  return NAT_NEXT_DROP;
 	}
       s->out2in.addr = outside_addr;
@@ -620,7 +621,7 @@ slow_path_ed (vlib_main_t *vm, snat_main_t *sm, vlib_buffer_t *b,
 error:
   if (s)
     {
-      nat_ed_session_delete (sm, s, thread_index, 1);
+      nat_ed_session_delete (sm, s, thread_index);
     }
   *sessionp = s = NULL;
   return NAT_NEXT_DROP;
@@ -733,8 +734,6 @@ nat_not_translate_output_feature_fwd (snat_main_t * sm, ip4_header_t * ip,
 	  nat44_session_update_counters (s, now,
 					 vlib_buffer_length_in_chain (vm, b),
 					 thread_index);
-	  /* Per-user LRU list maintenance */
-	  nat44_session_update_lru (sm, s, thread_index);
 	  return 1;
 	}
       else
@@ -894,8 +893,6 @@ out:
       /* Accounting */
       nat44_session_update_counters (
 	s, now, vlib_buffer_length_in_chain (vm, b), thread_index);
-      /* Per-user LRU list maintenance */
-      nat44_session_update_lru (sm, s, thread_index);
     }
   *s_p = s;
   return next;
@@ -1013,14 +1010,14 @@ nat44_ed_in2out_slowpath_unknown_proto (snat_main_t *sm, vlib_buffer_t *b,
   if (nat_ed_ses_i2o_flow_hash_add_del (sm, thread_index, s, 1))
     {
       nat_elog_notice (sm, "in2out flow hash add failed");
-      nat_ed_session_delete (sm, s, thread_index, 1);
+      nat_ed_session_delete (sm, s, thread_index);
       return NULL;
     }
 
   if (nat_ed_ses_o2i_flow_hash_add_del (sm, thread_index, s, 1))
     {
       nat_elog_notice (sm, "out2in flow hash add failed");
-      nat_ed_session_delete (sm, s, thread_index, 1);
+      nat_ed_session_delete (sm, s, thread_index);
       return NULL;
     }
 
@@ -1029,12 +1026,48 @@ nat44_ed_in2out_slowpath_unknown_proto (snat_main_t *sm, vlib_buffer_t *b,
   /* Accounting */
   nat44_session_update_counters (s, now, vlib_buffer_length_in_chain (vm, b),
 				 thread_index);
-  /* Per-user LRU list maintenance */
-  nat44_session_update_lru (sm, s, thread_index);
 
   return s;
 }
 
+/* Look up flows of all non-icmp packets of the frame in one batch, keys as
+ * built by the fast path. icmp packets get a dummy lookup, their keys
+ * depend on the icmp header and are looked up one by one */
+static_always_inline void
+nat44_ed_in2out_lookup_frame (snat_main_t *sm, vlib_buffer_t **b,
+			      clib_bihash_kv_16_8_t *kvs, u8 *is_found,
+			      u32 n_bufs, int is_output_feature)
+{
+  u32 i, iph_offset = 0, rx_fib_index;
+  ip4_header_t *ip;
+
+  for (i = 0; i < n_bufs; i++)
+    {
+      if (is_output_feature)
+	iph_offset = vnet_buffer (b[i])->ip.reass.save_rewrite_length;
+
+      ip = (ip4_header_t *) ((u8 *) vlib_buffer_get_current (b[i]) +
+			     iph_offset);
+
+      if (PREDICT_FALSE (ip->protocol == IP_PROTOCOL_ICMP))
+	{
+	  kvs[i].key[0] = kvs[i].key[1] = 0;
+	  continue;
+	}
+
+      rx_fib_index = fib_table_get_index_for_sw_if_index (
+	FIB_PROTOCOL_IP4, vnet_buffer (b[i])->sw_if_index[VLIB_RX]);
+      init_ed_k (&kvs[i], ip->src_address.as_u32,
+		 vnet_buffer (b[i])->ip.reass.l4_src_port,
+		 ip->dst_address.as_u32,
+		 vnet_buffer (b[i])->ip.reass.l4_dst_port, rx_fib_index,
+		 ip->protocol);
+    }
+
+  clib_bihash_search_batch_16_8 (&sm->flow_hash, kvs, 0, kvs, is_found,
+				 n_bufs);
+}
+
 static inline uword
 nat44_ed_in2out_fast_path_node_fn_inline (vlib_main_t *vm,
 					  vlib_node_runtime_t *node,
@@ -1055,11 +1088,17 @@ nat44_ed_in2out_fast_path_node_fn_inline (vlib_main_t *vm,
 
   vlib_buffer_t *bufs[VLIB_FRAME_SIZE], **b = bufs;
   u16 nexts[VLIB_FRAME_SIZE], *next = nexts;
+  clib_bihash_kv_16_8_t kvs[VLIB_FRAME_SIZE];
+  u8 is_found[VLIB_FRAME_SIZE];
   vlib_get_buffers (vm, from, b, n_left_from);
 
+  nat44_ed_in2out_lookup_frame (sm, bufs, kvs, is_found, n_left_from,
+				is_output_feature);
+
   while (n_left_from > 0)
     {
       vlib_buffer_t *b0;
+      u32 bi = b - bufs;
       u32 rx_sw_if_index0, rx_fib_index0, iph_offset0 = 0;
       u32 tx_sw_if_index0;
       u32 cntr_sw_if_index0;
@@ -1071,6 +1110,7 @@ nat44_ed_in2out_fast_path_node_fn_inline (vlib_main_t *vm,
       nat_6t_flow_t *f = 0;
       nat_6t_t lookup;
       int lookup_skipped = 0;
+      int found0;
 
       b0 = *b;
       b++;
@@ -1182,8 +1222,22 @@ nat44_ed_in2out_fast_path_node_fn_inline (vlib_main_t *vm,
       init_ed_k (&kv0, lookup.saddr.as_u32, lookup.sport, lookup.daddr.as_u32,
 		 lookup.dport, lookup.fib_index, lookup.proto);
 
-      // lookup flow
-      if (clib_bihash_search_16_8 (&sm->flow_hash, &kv0, &value0))
+      // lookup flow, all but icmp flows were looked up with the frame
+      if (PREDICT_TRUE (proto0 != IP_PROTOCOL_ICMP))
+	{
+	  found0 = is_found[bi];
+	  value0 = kvs[bi];
+	  // session may have been deleted by a packet earlier in the frame
+	  if (PREDICT_FALSE (found0 &&
+			     pool_is_free_index (
+			       tsm->sessions,
+			       ed_value_get_session_index (&value0))))
+	    found0 = 0;
+	}
+      else
+	found0 = !clib_bihash_search_16_8 (&sm->flow_hash, &kv0, &value0);
+
+      if (!found0)
 	{
 	  // flow does not exist go slow path
 	  next[0] = def_slow;
@@ -1203,7 +1257,7 @@ nat44_ed_in2out_fast_path_node_fn_inline (vlib_main_t *vm,
 	{
 	  // session is closed, go slow path
 	  nat44_ed_free_session_data (sm, s0, thread_index, 0);
-	  nat_ed_session_delete (sm, s0, thread_index, 1);
+	  nat_ed_session_delete (sm, s0, thread_index);
 	  s0 = 0;
 	  next[0] = def_slow;
 	  goto trace0;
@@ -1216,7 +1270,7 @@ nat44_ed_in2out_fast_path_node_fn_inline (vlib_main_t *vm,
       if (now >= sess_timeout_time)
 	{
 	  nat44_ed_free_session_data (sm, s0, thread_index, 0);
-	  nat_ed_session_delete (sm, s0, thread_index, 1);
+	  nat_ed_session_delete (sm, s0, thread_index);
 	  s0 = 0;
 	  // session is closed, go slow path
 	  next[0] = def_slow;
@@ -1238,7 +1292,7 @@ nat44_ed_in2out_fast_path_node_fn_inline (vlib_main_t *vm,
 	{
 	  translation_error = NAT_ED_TRNSL_ERR_FLOW_MISMATCH;
 	  nat44_ed_free_session_data (sm, s0, thread_index, 0);
-	  nat_ed_session_delete (sm, s0, thread_index, 1);
+	  nat_ed_session_delete (sm, s0, thread_index);
 	  s0 = 0;
 	  next[0] = NAT_NEXT_DROP;
 	  b0->error = node->errors[NAT_IN2OUT_ED_ERROR_TRNSL_FAILED];
@@ -1250,7 +1304,7 @@ nat44_ed_in2out_fast_path_node_fn_inline (vlib_main_t *vm,
 	     vm, sm, b0, ip0, f, proto0, is_output_feature)))
 	{
 	  nat44_ed_free_session_data (sm, s0, thread_index, 0);
-	  nat_ed_session_delete (sm, s0, thread_index, 1);
+	  nat_ed_session_delete (sm, s0, thread_index);
 	  s0 = 0;
 	  next[0] = NAT_NEXT_DROP;
 	  b0->error = node->errors[NAT_IN2OUT_ED_ERROR_TRNSL_FAILED];
@@ -1284,8 +1338,6 @@ nat44_ed_in2out_fast_path_node_fn_inline (vlib_main_t *vm,
       nat44_session_update_counters (s0, now,
 				     vlib_buffer_length_in_chain (vm, b0),
 				     thread_index);
-      /* Per-user LRU list maintenance */
-      nat44_session_update_lru (sm, s0, thread_index);
 
     trace0:
       if (PREDICT_FALSE
@@ -1408,7 +1460,7 @@ nat44_ed_in2out_slow_path_node_fn_inline (vlib_main_t *vm,
 		   vm, sm, b0, ip0, &s0->i2o, proto0, is_output_feature)))
 	    {
 	      nat44_ed_free_session_data (sm, s0, thread_index, 0);
-	      nat_ed_session_delete (sm, s0, thread_index, 1);
+	      nat_ed_session_delete (sm, s0, thread_index);
 	      s0 = 0;
 	      next[0] = NAT_NEXT_DROP;
 	      b0->error = node->errors[NAT_IN2OUT_ED_ERROR_TRNSL_FAILED];
@@ -1432,7 +1484,7 @@ nat44_ed_in2out_slow_path_node_fn_inline (vlib_main_t *vm,
 		   vm, sm, b0, ip0, &s0->i2o, proto0, is_output_feature)))
 	    {
 	      nat44_ed_free_session_data (sm, s0, thread_index, 0);
-	      nat_ed_session_delete (sm, s0, thread_index, 1);
+	      nat_ed_session_delete (sm, s0, thread_index);
 	      s0 = 0;
 	      next[0] = NAT_NEXT_DROP;
 	      b0->error = node->errors[NAT_IN2OUT_ED_ERROR_TRNSL_FAILED];
@@ -1511,7 +1563,7 @@ nat44_ed_in2out_slow_path_node_fn_inline (vlib_main_t *vm,
 	     vm, sm, b0, ip0, &s0->i2o, proto0, is_output_feature)))
 	{
 	  nat44_ed_free_session_data (sm, s0, thread_index, 0);
-	  nat_ed_session_delete (sm, s0, thread_index, 1);
+	  nat_ed_session_delete (sm, s0, thread_index);
 	  s0 = 0;
 	  next[0] = NAT_NEXT_DROP;
 	  b0->error = node->errors[NAT_IN2OUT_ED_ERROR_TRNSL_FAILED];
@@ -1536,8 +1588,6 @@ nat44_ed_in2out_slow_path_node_fn_inline (vlib_main_t *vm,
       nat44_session_update_counters (s0, now,
 				     vlib_buffer_length_in_chain
 				     (vm, b0), thread_index);
-      /* Per-user LRU list maintenance */
-      nat44_session_update_lru (sm, s0, thread_index);
 
     trace0:
       if (PREDICT_FALSE ((node->flags & VLIB_NODE_FLAG_TRACE)
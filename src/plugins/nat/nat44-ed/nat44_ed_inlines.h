@@ -216,32 +216,33 @@ nat44_ed_maximum_sessions_exceeded (snat_main_t *sm, u32 fib_index,
   return translations >= sm->max_translations_per_fib[fib_index];
 }
 
-static_always_inline int
-nat_ed_lru_insert (snat_main_per_thread_data_t *tsm, snat_session_t *s,
-		   f64 now, u8 proto)
+static_always_inline void
+nat44_ed_session_timer_start (snat_main_per_thread_data_t *tsm,
+			      snat_session_t *s, f64 now, f64 timeout)
+{
+  tw_timer_wheel_2t_1w_2048sl_t *tw = &tsm->expire_wheel;
+  f64 base = tw->last_run_time != 0.0 ? tw->last_run_time : now;
+  u64 ticks;
+
+  /* a timer N ticks out fires once the wheel is N + 1 ticks past its last
+   * run, so count from there to fire within a tick after the timeout;
+   * timeouts beyond the wheel horizon are re-armed when they fire */
+  ticks = clib_max (now + timeout - base, 1.0);
+  ticks = clib_min (ticks, NAT44_ED_EXPIRE_MAX_TICKS);
+
+  s->expire_timer_handle =
+    tw_timer_start_2t_1w_2048sl (tw, s - tsm->sessions, 0, ticks);
+}
+
+static_always_inline void
+nat44_ed_session_timer_stop (snat_main_per_thread_data_t *tsm,
+			     snat_session_t *s)
 {
-  dlist_elt_t *lru_list_elt;
-  pool_get (tsm->lru_pool, lru_list_elt);
-  s->lru_index = lru_list_elt - tsm->lru_pool;
-  switch (proto)
+  if (s->expire_timer_handle != ~0)
     {
-    case IP_PROTOCOL_UDP:
-      s->lru_head_index = tsm->udp_lru_head_index;
-      break;
-    case IP_PROTOCOL_TCP:
-      s->lru_head_index = tsm->tcp_trans_lru_head_index;
-      break;
-    case IP_PROTOCOL_ICMP:
-      s->lru_head_index = tsm->icmp_lru_head_index;
-      break;
-    default:
-      s->lru_head_index = tsm->unk_proto_lru_head_index;
-      break;
+      tw_timer_stop_2t_1w_2048sl (&tsm->expire_wheel, s->expire_timer_handle);
+      s->expire_timer_handle = ~0;
     }
-  clib_dlist_addtail (tsm->lru_pool, s->lru_head_index, s->lru_index);
-  lru_list_elt->value = s - tsm->sessions;
-  s->last_lru_update = now;
-  return 1;
 }
 
 static_always_inline void
@@ -311,18 +312,12 @@ nat_ed_ses_o2i_flow_hash_add_del (snat_main_t *sm, u32 thread_idx,
 }
 
 always_inline void
-nat_ed_session_delete (snat_main_t *sm, snat_session_t *ses, u32 thread_index,
-		       int lru_delete
-		       /* delete from global LRU list */)
+nat_ed_session_delete (snat_main_t *sm, snat_session_t *ses, u32 thread_index)
 {
   snat_main_per_thread_data_t *tsm =
     vec_elt_at_index (sm->per_thread_data, thread_index);
 
-  if (lru_delete)
-    {
-      clib_dlist_remove (tsm->lru_pool, ses->lru_index);
-    }
-  pool_put_index (tsm->lru_pool, ses->lru_index);
+  nat44_ed_session_timer_stop (tsm, ses);
   if (nat_ed_ses_i2o_flow_hash_add_del (sm, thread_index, ses, 0))
     nat_elog_warn (sm, "flow hash del failed");
   if (nat_ed_ses_o2i_flow_hash_add_del (sm, thread_index, ses, 0))
@@ -332,69 +327,19 @@ nat_ed_session_delete (snat_main_t *sm, snat_session_t *ses, u32 thread_index,
 			   pool_elts (tsm->sessions));
 }
 
-static_always_inline int
-nat_lru_free_one_with_head (snat_main_t *sm, int thread_index, f64 now,
-			    u32 head_index)
-{
-  snat_session_t *s = NULL;
-  dlist_elt_t *oldest_elt;
-  f64 sess_timeout_time;
-  u32 oldest_index;
-  snat_main_per_thread_data_t *tsm = &sm->per_thread_data[thread_index];
-  oldest_index = clib_dlist_remove_head (tsm->lru_pool, head_index);
-  if (~0 != oldest_index)
-    {
-      oldest_elt = pool_elt_at_index (tsm->lru_pool, oldest_index);
-      s = pool_elt_at_index (tsm->sessions, oldest_elt->value);
-
-      sess_timeout_time =
-	s->last_heard + (f64) nat44_session_get_timeout (sm, s);
-      if (now >= sess_timeout_time)
-	{
-	  nat44_ed_free_session_data (sm, s, thread_index, 0);
-	  nat_ed_session_delete (sm, s, thread_index, 0);
-	  return 1;
-	}
-      else
-	{
-	  clib_dlist_addhead (tsm->lru_pool, head_index, oldest_index);
-	}
-    }
-  return 0;
-}
-
-static_always_inline int
-nat_lru_free_one (snat_main_t *sm, int thread_index, f64 now)
-{
-  snat_main_per_thread_data_t *tsm = &sm->per_thread_data[thread_index];
-  int rc = 0;
-#define _(p)                                                                  \
-  if ((rc = nat_lru_free_one_with_head (sm, thread_index, now,                \
-					tsm->p##_lru_head_index)))            \
-    {                                                                         \
-      return rc;                                                              \
-    }
-  _ (tcp_trans);
-  _ (udp);
-  _ (unk_proto);
-  _ (icmp);
-  _ (tcp_estab);
-#undef _
-  return 0;
-}
-
 static_always_inline snat_session_t *
 nat_ed_session_alloc (snat_main_t *sm, u32 thread_index, f64 now, u8 proto)
 {
   snat_session_t *s;
   snat_main_per_thread_data_t *tsm = &sm->per_thread_data[thread_index];
 
-  nat_lru_free_one (sm, thread_index, now);
-
   pool_get (tsm->sessions, s);
   clib_memset (s, 0, sizeof (*s));
 
-  nat_ed_lru_insert (tsm, s, now, proto);
+  s->proto = proto;
+  s->last_heard = now;
+  nat44_ed_session_timer_start (tsm, s, now,
+				nat44_session_get_timeout (sm, s));
 
   s->ha_last_refreshed = now;
   vlib_set_simple_counter (&sm->total_sessions, thread_index, 0,
@@ -758,7 +703,6 @@ nat44_set_tcp_session_state (snat_main_t *sm, f64 now, snat_session_t *ses,
 	   ses->tcp_flags[NAT44_ED_DIR_O2I]) == (TCP_FLAG_SYN | TCP_FLAG_ACK))
 	{
 	  ses->tcp_state = NAT44_ED_TCP_STATE_ESTABLISHED;
-	  ses->lru_head_index = tsm->tcp_estab_lru_head_index;
 	}
       break;
     case NAT44_ED_TCP_STATE_ESTABLISHED:
@@ -773,7 +717,6 @@ nat44_set_tcp_session_state (snat_main_t *sm, f64 now, snat_session_t *ses,
 	  // immediately timed out if it has been idle longer than
 	  // transitory timeout
 	  ses->last_heard = now;
-	  ses->lru_head_index = tsm->tcp_trans_lru_head_index;
 	}
       break;
     case NAT44_ED_TCP_STATE_CLOSING:
@@ -783,15 +726,16 @@ nat44_set_tcp_session_state (snat_main_t *sm, f64 now, snat_session_t *ses,
 	{
 	  nat44_ed_session_reopen (thread_index, ses);
 	  ses->tcp_state = NAT44_ED_TCP_STATE_ESTABLISHED;
-	  ses->lru_head_index = tsm->tcp_estab_lru_head_index;
 	}
       break;
     }
-  if (old_state == ses->tcp_state)
+  /* a longer timeout is picked up when the timer fires, a shorter one
+   * needs the timer pulled in */
+  if (old_state == ses->tcp_state ||
+      ses->tcp_state != NAT44_ED_TCP_STATE_CLOSING)
     return;
-  ses->last_lru_update = now;
-  clib_dlist_remove (tsm->lru_pool, ses->lru_index);
-  clib_dlist_addtail (tsm->lru_pool, ses->lru_head_index, ses->lru_index);
+  nat44_ed_session_timer_stop (tsm, ses);
+  nat44_ed_session_timer_start (tsm, ses, now, sm->timeouts.tcp.transitory);
 }
 
 always_inline void
@@ -820,21 +764,6 @@ nat44_session_update_counters (snat_session_t *s, f64 now, uword bytes,
   s->total_bytes += bytes;
 }
 
-/** \brief Per-user LRU list maintenance */
-always_inline void
-nat44_session_update_lru (snat_main_t *sm, snat_session_t *s, u32 thread_index)
-{
-  /* don't update too often - timeout is in magnitude of seconds anyway */
-  if (s->last_heard > s->last_lru_update + 1)
-    {
-      clib_dlist_remove (sm->per_thread_data[thread_index].lru_pool,
-			 s->lru_index);
-      clib_dlist_addtail (sm->per_thread_data[thread_index].lru_pool,
-			  s->lru_head_index, s->lru_index);
-      s->last_lru_update = s->last_heard;
-    }
-}
-
 static_always_inline int
 nat44_ed_is_unk_proto (u8 proto)
 {
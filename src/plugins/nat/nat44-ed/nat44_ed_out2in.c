@@ -254,13 +254,11 @@ icmp_out2in_ed_slow_path (snat_main_t *sm, vlib_buffer_t *b, ip4_header_t *ip,
       /* Accounting */
       nat44_session_update_counters (
 	s, now, vlib_buffer_length_in_chain (vm, b), thread_index);
-      /* Per-user LRU list maintenance */
-      nat44_session_update_lru (sm, s, thread_index);
     }
 out:
   if (NAT_NEXT_DROP == next && s)
     {
-      nat_ed_session_delete (sm, s, thread_index, 1);
+      nat_ed_session_delete (sm, s, thread_index);
       s = 0;
     }
   *s_p = s;
@@ -422,7 +420,7 @@ create_session_for_static_mapping_ed (
   if (nat_ed_ses_o2i_flow_hash_add_del (sm, thread_index, s, 1))
     {
       b->error = node->errors[NAT_OUT2IN_ED_ERROR_HASH_ADD_FAILED];
-      nat_ed_session_delete (sm, s, thread_index, 1);
+      nat_ed_session_delete (sm, s, thread_index);
       nat_elog_warn (sm, "out2in flow hash add failed");
       return 0;
     }
@@ -466,7 +464,7 @@ create_session_for_static_mapping_ed (
       if (rc)
 	{
 	  b->error = node->errors[NAT_OUT2IN_ED_ERROR_OUT_OF_PORTS];
-	  nat_ed_session_delete (sm, s, thread_index, 1);
+	  nat_ed_session_delete (sm, s, thread_index);
 	  return 0;
 	}
 
@@ -537,7 +535,7 @@ create_session_for_static_mapping_ed (
 	{
 	  nat_elog_warn (sm, "out2in flow hash del failed");
 	}
-      nat_ed_session_delete (sm, s, thread_index, 1);
+      nat_ed_session_delete (sm, s, thread_index);
       return 0;
     }
     }
@@ -640,7 +638,7 @@ create_bypass_for_fwd (snat_main_t *sm, vlib_buffer_t *b, snat_session_t *s,
       if (nat_ed_ses_i2o_flow_hash_add_del (sm, thread_index, s, 1))
 	{
 	  nat_elog_notice (sm, "in2out flow add failed");
-	  nat_ed_session_delete (sm, s, thread_index, 1);
+	  nat_ed_session_delete (sm, s, thread_index);
 	  return;
 	}
 
@@ -656,8 +654,6 @@ create_bypass_for_fwd (snat_main_t *sm, vlib_buffer_t *b, snat_session_t *s,
 
   /* Accounting */
   nat44_session_update_counters (s, now, 0, thread_index);
-  /* Per-user LRU list maintenance */
-  nat44_session_update_lru (sm, s, thread_index);
 }
 
 static snat_session_t *
@@ -708,7 +704,7 @@ nat44_ed_out2in_slowpath_unknown_proto (snat_main_t *sm, vlib_buffer_t *b,
   if (nat_ed_ses_i2o_flow_hash_add_del (sm, thread_index, s, 1))
     {
       nat_elog_notice (sm, "in2out key add failed");
-      nat_ed_session_delete (sm, s, thread_index, 1);
+      nat_ed_session_delete (sm, s, thread_index);
       return NULL;
     }
 
@@ -719,7 +715,7 @@ nat44_ed_out2in_slowpath_unknown_proto (snat_main_t *sm, vlib_buffer_t *b,
   if (nat_ed_ses_o2i_flow_hash_add_del (sm, thread_index, s, 1))
     {
       nat_elog_notice (sm, "out2in flow hash add failed");
-      nat_ed_session_delete (sm, s, thread_index, 1);
+      nat_ed_session_delete (sm, s, thread_index);
       return NULL;
     }
 
@@ -728,8 +724,6 @@ nat44_ed_out2in_slowpath_unknown_proto (snat_main_t *sm, vlib_buffer_t *b,
   /* Accounting */
   nat44_session_update_counters (s, now, vlib_buffer_length_in_chain (vm, b),
 				 thread_index);
-  /* Per-user LRU list maintenance */
-  nat44_session_update_lru (sm, s, thread_index);
 
   return s;
 }
@@ -880,7 +874,7 @@ nat44_ed_out2in_fast_path_node_fn_inline (vlib_main_t * vm,
 	{
 	  // session is closed, go slow path
 	  nat44_ed_free_session_data (sm, s0, thread_index, 0);
-	  nat_ed_session_delete (sm, s0, thread_index, 1);
+	  nat_ed_session_delete (sm, s0, thread_index);
 	  s0 = 0;
 	  slow_path_reason = NAT_ED_SP_REASON_VRF_EXPIRED;
 	  next[0] = NAT_NEXT_OUT2IN_ED_SLOW_PATH;
@@ -895,7 +889,7 @@ nat44_ed_out2in_fast_path_node_fn_inline (vlib_main_t * vm,
 	{
 	  // session is closed, go slow path
 	  nat44_ed_free_session_data (sm, s0, thread_index, 0);
-	  nat_ed_session_delete (sm, s0, thread_index, 1);
+	  nat_ed_session_delete (sm, s0, thread_index);
 	  s0 = 0;
 	  slow_path_reason = NAT_ED_SP_SESS_EXPIRED;
 	  next[0] = NAT_NEXT_OUT2IN_ED_SLOW_PATH;
@@ -944,7 +938,7 @@ nat44_ed_out2in_fast_path_node_fn_inline (vlib_main_t * vm,
 		  //                       thread_index);
 		  translation_error = NAT_ED_TRNSL_ERR_FLOW_MISMATCH;
 		  nat44_ed_free_session_data (sm, s0, thread_index, 0);
-		  nat_ed_session_delete (sm, s0, thread_index, 1);
+		  nat_ed_session_delete (sm, s0, thread_index);
 		  s0 = 0;
 		  next[0] = NAT_NEXT_DROP;
 		  b0->error = node->errors[NAT_OUT2IN_ED_ERROR_TRNSL_FAILED];
@@ -990,8 +984,6 @@ nat44_ed_out2in_fast_path_node_fn_inline (vlib_main_t * vm,
       nat44_session_update_counters (s0, now,
 				     vlib_buffer_length_in_chain (vm, b0),
 				     thread_index);
-      /* Per-user LRU list maintenance */
-      nat44_session_update_lru (sm, s0, thread_index);
 
     trace0:
       if (PREDICT_FALSE ((node->flags & VLIB_NODE_FLAG_TRACE)
@@ -1258,8 +1250,6 @@ nat44_ed_out2in_slow_path_node_fn_inline (vlib_main_t * vm,
       nat44_session_update_counters (s0, now,
 				     vlib_buffer_length_in_chain (vm, b0),
 				     thread_index);
-      /* Per-user LRU list maintenance */
-      nat44_session_update_lru (sm, s0, thread_index);
 
     trace0:
       if (PREDICT_FALSE ((node->flags & VLIB_NODE_FLAG_TRACE)
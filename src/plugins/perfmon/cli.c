@@ -592,3 +592,107 @@ VLIB_CLI_COMMAND (perfmon_stop_command, static) = {
   .function = perfmon_stop_command_fn,
   .is_mp_safe = 1,
 };
+
+static clib_error_t *
+perfmon_sampling_command_fn (vlib_main_t *vm, unformat_input_t *input,
+			     vlib_cli_command_t *cmd)
+{
+  perfmon_sample_main_t *psm = &perfmon_sample_main;
+  unformat_input_t _line_input, *line_input = &_line_input;
+  u32 interval = psm->interval;
+  u8 use_pmu = 1;
+  int enable = -1;
+
+  if (unformat_user (input, unformat_line_input, line_input) == 0)
+    return clib_error_return (0, "please specify enable or disable");
+
+  while (unformat_check_input (line_input) != UNFORMAT_END_OF_INPUT)
+    {
+      if (unformat (line_input, "enable"))
+	enable = 1;
+      else if (unformat (line_input, "disable"))
+	enable = 0;
+      else if (unformat (line_input, "interval %u", &interval))
+	;
+      else if (unformat (line_input, "no-pmu"))
+	use_pmu = 0;
+      else
+	return clib_error_return (0, "unknown input '%U'",
+				  format_unformat_error, line_input);
+    }
+  unformat_free (line_input);
+
+  if (enable == -1)
+    return clib_error_return (0, "please specify enable or disable");
+
+  if (enable == 0)
+    {
+      perfmon_sample_disable (vm);
+      return 0;
+    }
+
+  return perfmon_sample_enable (vm, interval, use_pmu);
+}
+
+VLIB_CLI_COMMAND (perfmon_sampling_command, static) = {
+  .path = "perfmon sampling",
+  .short_help = "perfmon sampling <enable|disable> [interval <n>] [no-pmu]",
+  .function = perfmon_sampling_command_fn,
+};
+
+static clib_error_t *
+show_runtime_histogram_command_fn (vlib_main_t *vm, unformat_input_t *input,
+				   vlib_cli_command_t *cmd)
+{
+  perfmon_sample_main_t *psm = &perfmon_sample_main;
+  perfmon_sample_thread_t *st;
+  perfmon_sample_node_t *n;
+  u32 node_index = ~0;
+  u64 n_dropped = 0;
+  int verbose = 0;
+
+  while (unformat_check_input (input) != UNFORMAT_END_OF_INPUT)
+    {
+      if (unformat (input, "verbose"))
+	verbose = 1;
+      else if (unformat (input, "%U", unformat_vlib_node, vm, &node_index))
+	verbose = 1;
+      else
+	return clib_error_return (0, "unknown input '%U'",
+				  format_unformat_error, input);
+    }
+
+  if (psm->enabled)
+    perfmon_sample_drain (vm);
+  else if (vec_len (psm->nodes) == 0)
+    {
+      /* Not an error, that would fall back to plain "show runtime" */
+      vlib_cli_output (vm, "sampling not enabled");
+      return 0;
+    }
+
+  vec_foreach (st, psm->threads)
+    n_dropped += st->n_dropped;
+
+  vlib_cli_output (vm, "Sampling %s, 1 in %u dispatches, %lu samples dropped",
+		   psm->enabled ? "enabled" : "disabled", psm->interval,
+		   n_dropped);
+  vlib_cli_output (vm, "%U", format_perfmon_sample_node, vm, 0, 0);
+
+  vec_foreach (n, psm->nodes)
+    {
+      if (n->n_samples == 0)
+	continue;
+      if (node_index != ~0 && n - psm->nodes != node_index)
+	continue;
+      vlib_cli_output (vm, "%U", format_perfmon_sample_node, vm, n, verbose);
+    }
+
+  return 0;
+}
+
+VLIB_CLI_COMMAND (show_runtime_histogram_command, static) = {
+  .path = "show runtime histogram",
+  .short_help = "show runtime histogram [<node-name>] [verbose]",
+  .function = show_runtime_histogram_command_fn,
+};
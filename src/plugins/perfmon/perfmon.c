@@ -49,7 +49,12 @@ perfmon_reset (vlib_main_t *vm)
 
   if (pm->is_running)
     for (int i = 0; i < vlib_get_n_threads (); i++)
-      vlib_node_set_dispatch_wrapper (vlib_get_main_by_index (i), 0);
+      {
+	vlib_main_t *ovm = vlib_get_main_by_index (i);
+	vlib_node_set_dispatch_wrapper (ovm, 0);
+	vlib_node_set_dispatch_wrapper (ovm,
+					perfmon_sample_dispatch_wrapper ());
+      }
 
   for (int i = 0; i < vec_len (pm->fds_to_close); i++)
     close (pm->fds_to_close[i]);
@@ -262,9 +267,13 @@ perfmon_start (vlib_main_t *vm, perfmon_bundle_t *b)
 	  return err;
 	}
 
+      /* Sampling, if enabled, pauses while a node bundle runs */
       for (int i = 0; i < vlib_get_n_threads (); i++)
-	vlib_node_set_dispatch_wrapper (vlib_get_main_by_index (i),
-					dispatch_wrapper);
+	{
+	  vlib_main_t *ovm = vlib_get_main_by_index (i);
+	  vlib_node_set_dispatch_wrapper (ovm, 0);
+	  vlib_node_set_dispatch_wrapper (ovm, dispatch_wrapper);
+	}
     }
   pm->sample_time = vlib_time_now (vm);
   pm->is_running = 1;
@@ -284,7 +293,12 @@ perfmon_stop (vlib_main_t *vm)
   if (pm->active_bundle->active_type == PERFMON_BUNDLE_TYPE_NODE)
     {
       for (int i = 0; i < vlib_get_n_threads (); i++)
-	vlib_node_set_dispatch_wrapper (vlib_get_main_by_index (i), 0);
+	{
+	  vlib_main_t *ovm = vlib_get_main_by_index (i);
+	  vlib_node_set_dispatch_wrapper (ovm, 0);
+	  vlib_node_set_dispatch_wrapper (ovm,
+					  perfmon_sample_dispatch_wrapper ());
+	}
     }
 
   for (int i = 0; i < n_groups; i++)
@@ -275,6 +275,71 @@ void perfmon_reset (vlib_main_t *vm);
 clib_error_t *perfmon_start (vlib_main_t *vm, perfmon_bundle_t *);
 clib_error_t *perfmon_stop (vlib_main_t *vm);
 
+/* Always-on node dispatch sampling, see sample.c */
+
+#define PERFMON_SAMPLE_DEFAULT_INTERVAL	 1024
+#define PERFMON_SAMPLE_DEFAULT_RING_SIZE 16384
+#define PERFMON_SAMPLE_N_BINS		 20
+
+typedef struct
+{
+  u32 node_index;
+  u32 n_vectors;
+  u32 clocks;
+  u32 cache_misses;
+} perfmon_sample_t;
+
+typedef struct
+{
+  CLIB_CACHE_LINE_ALIGN_MARK (cacheline0);
+  /* written by the worker */
+  u32 countdown;
+  u32 pmc_index; /* rdpmc index + 1, 0 if cache misses are not counted */
+  u64 pmc_mask;
+  volatile u32 head;
+  u32 n_dropped;
+  perfmon_sample_t *ring;
+
+  CLIB_CACHE_LINE_ALIGN_MARK (cacheline1);
+  /* written by the main thread */
+  volatile u32 tail;
+  int fd;
+  struct perf_event_mmap_page *mmap_page;
+} perfmon_sample_thread_t;
+
+typedef struct
+{
+  u64 n_samples;
+  u64 n_packets;
+  u64 clocks;
+  u64 cache_misses;
+  u64 clocks_per_packet[PERFMON_SAMPLE_N_BINS];
+  u64 cache_misses_per_dispatch[PERFMON_SAMPLE_N_BINS];
+} perfmon_sample_node_t;
+
+typedef struct
+{
+  perfmon_sample_thread_t *threads;
+  perfmon_sample_node_t *nodes;
+  u32 interval;
+  u32 ring_size;
+  u8 enabled;
+  u8 use_pmu;
+  u8 config_enable;
+  u32 process_node_index;
+  u32 clocks_stats_index;
+  u32 cache_misses_stats_index;
+} perfmon_sample_main_t;
+
+extern perfmon_sample_main_t perfmon_sample_main;
+
+clib_error_t *perfmon_sample_enable (vlib_main_t *vm, u32 interval,
+				     u8 use_pmu);
+void perfmon_sample_disable (vlib_main_t *vm);
+void perfmon_sample_drain (vlib_main_t *vm);
+vlib_node_function_t *perfmon_sample_dispatch_wrapper (void);
+format_function_t format_perfmon_sample_node;
+
 #define PERFMON_STRINGS(...)                                                  \
   (char *[]) { __VA_ARGS__, 0 }
 
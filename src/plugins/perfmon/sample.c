@@ -0,0 +1,497 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+/*
+ * Always-on node dispatch sampling.
+ *
+ * Unlike node bundles, which read all counters around every dispatch,
+ * the sampling dispatch wrapper only decrements a per-thread countdown for
+ * most dispatches. Every interval-th dispatch is timed with the tsc and,
+ * if the pmu allows user space reads, the number of last level cache
+ * misses is read with rdpmc around it. Dispatches which process no packets
+ * are not recorded. Samples go to a per-thread single producer, single
+ * consumer ring which the main thread drains into per-node log2 histograms
+ * of clocks per packet and cache misses per dispatch. The histograms are
+ * shown by "show runtime histogram" and exported to the stats segment.
+ */
+
+#include <vnet/vnet.h>
+#include <vlib/stats/stats.h>
+#include <linux/limits.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+
+#include <perfmon/perfmon.h>
+
+#define PERFMON_SAMPLE_DRAIN_INTERVAL 0.5
+
+perfmon_sample_main_t perfmon_sample_main = {
+  .interval = PERFMON_SAMPLE_DEFAULT_INTERVAL,
+  .ring_size = PERFMON_SAMPLE_DEFAULT_RING_SIZE,
+  .use_pmu = 1,
+  .clocks_stats_index = ~0,
+  .cache_misses_stats_index = ~0,
+};
+
+VLIB_REGISTER_LOG_CLASS (perfmon_sample_log, static) = {
+  .class_name = "perfmon",
+  .subclass_name = "sample",
+};
+
+#define log_debug(fmt, ...)                                                   \
+  vlib_log_debug (perfmon_sample_log.class, fmt, __VA_ARGS__)
+#define log_warn(fmt, ...)                                                    \
+  vlib_log_warn (perfmon_sample_log.class, fmt, __VA_ARGS__)
+
+static_always_inline u64
+perfmon_sample_read_pmc (u32 pmc_index)
+{
+#if defined(__x86_64__)
+  return _rdpmc (pmc_index - 1);
+#else
+  return 0;
+#endif
+}
+
+static uword
+perfmon_sample_dispatch (vlib_main_t *vm, vlib_node_runtime_t *node,
+			 vlib_frame_t *frame)
+{
+  perfmon_sample_main_t *psm = &perfmon_sample_main;
+  perfmon_sample_thread_t *st = psm->threads + vm->thread_index;
+  perfmon_sample_t *s;
+  u64 t0, t1, m0 = 0, m1 = 0;
+  u32 head;
+  uword rv;
+
+  if (PREDICT_TRUE (--st->countdown))
+    return node->function (vm, node, frame);
+
+  if (st->pmc_index)
+    m0 = perfmon_sample_read_pmc (st->pmc_index);
+  t0 = clib_cpu_time_now ();
+  rv = node->function (vm, node, frame);
+  t1 = clib_cpu_time_now ();
+  if (st->pmc_index)
+    m1 = perfmon_sample_read_pmc (st->pmc_index);
+
+  /*
+   * Idle polls say nothing about per packet cost, drop them. Sampling the
+   * next dispatch instead would favour whichever node runs after a poll.
+   */
+  st->countdown = psm->interval;
+  if (rv == 0)
+    return rv;
+
+  head = st->head;
+  if (PREDICT_FALSE (head - clib_atomic_load_acq_n (&st->tail) >=
+		     psm->ring_size))
+    {
+      st->n_dropped++;
+      return rv;
+    }
+
+  s = st->ring + (head & (psm->ring_size - 1));
+  s->node_index = node->node_index;
+  s->n_vectors = rv;
+  s->clocks = clib_min (t1 - t0, CLIB_U32_MAX);
+  s->cache_misses = (m1 - m0) & st->pmc_mask;
+  clib_atomic_store_rel_n (&st->head, head + 1);
+
+  return rv;
+}
+
+vlib_node_function_t *
+perfmon_sample_dispatch_wrapper (void)
+{
+  return perfmon_sample_main.enabled ? perfmon_sample_dispatch : 0;
+}
+
+static void
+perfmon_sample_pmu_close (perfmon_sample_thread_t *st)
+{
+  if (st->mmap_page)
+    munmap (st->mmap_page, clib_mem_get_page_size ());
+  if (st->fd != -1)
+    close (st->fd);
+  st->mmap_page = 0;
+  st->fd = -1;
+  st->pmc_index = 0;
+  st->pmc_mask = 0;
+}
+
+/*
+ * Count user space last level cache misses of worker thread w. Leaves
+ * pmc_index at 0 if the event can't be opened or read with rdpmc, so
+ * the thread samples clocks only.
+ */
+static void
+perfmon_sample_pmu_open (perfmon_sample_thread_t *st, vlib_worker_thread_t *w)
+{
+  struct perf_event_mmap_page *mp;
+  struct perf_event_attr pe = {
+    .size = sizeof (struct perf_event_attr),
+    .type = PERF_TYPE_HARDWARE,
+    .config = PERF_COUNT_HW_CACHE_MISSES,
+    .exclude_kernel = 1,
+  };
+  u32 seq, idx;
+  int fd;
+
+  st->fd = -1;
+
+  /* pid 0 would be the calling thread */
+  if (w->lwp == 0)
+    return;
+
+  fd = syscall (__NR_perf_event_open, &pe, w->lwp, -1, -1, 0);
+  if (fd == -1)
+    {
+      log_debug ("thread %s: perf_event_open failed, errno %d", w->name,
+		 errno);
+      return;
+    }
+  st->fd = fd;
+
+  mp = mmap (0, clib_mem_get_page_size (), PROT_READ, MAP_SHARED, fd, 0);
+  if (mp == MAP_FAILED)
+    {
+      perfmon_sample_pmu_close (st);
+      return;
+    }
+  st->mmap_page = mp;
+
+  do
+    {
+      seq = mp->lock;
+      CLIB_COMPILER_BARRIER ();
+      idx = mp->index;
+      CLIB_COMPILER_BARRIER ();
+    }
+  while (mp->lock != seq);
+
+  if (!mp->cap_user_rdpmc || idx == 0)
+    {
+      log_debug ("thread %s: rdpmc not available", w->name);
+      perfmon_sample_pmu_close (st);
+      return;
+    }
+
+  st->pmc_index = idx;
+  st->pmc_mask = pow2_mask (mp->pmc_width);
+}
+
+static void
+perfmon_sample_stats_update (perfmon_sample_main_t *psm)
+{
+  u32 n_nodes = vec_len (psm->nodes);
+  counter_t **clocks, **misses;
+
+  if (n_nodes == 0)
+    return;
+
+  vlib_stats_validate (psm->clocks_stats_index, n_nodes - 1,
+		       PERFMON_SAMPLE_N_BINS - 1);
+  vlib_stats_validate (psm->cache_misses_stats_index, n_nodes - 1,
+		       PERFMON_SAMPLE_N_BINS - 1);
+  clocks = vlib_stats_get_entry_data_pointer (psm->clocks_stats_index);
+  misses = vlib_stats_get_entry_data_pointer (psm->cache_misses_stats_index);
+
+  for (u32 i = 0; i < n_nodes; i++)
+    {
+      perfmon_sample_node_t *n = psm->nodes + i;
+      clib_memcpy_fast (clocks[i], n->clocks_per_packet,
+			sizeof (n->clocks_per_packet));
+      clib_memcpy_fast (misses[i], n->cache_misses_per_dispatch,
+			sizeof (n->cache_misses_per_dispatch));
+    }
+}
+
+static_always_inline u32
+perfmon_sample_bin (u64 v)
+{
+  return v ? clib_min (min_log2 (v) + 1, PERFMON_SAMPLE_N_BINS - 1) : 0;
+}
+
+void
+perfmon_sample_drain (vlib_main_t *vm)
+{
+  perfmon_sample_main_t *psm = &perfmon_sample_main;
+  perfmon_sample_thread_t *st;
+  perfmon_sample_node_t *n;
+  perfmon_sample_t *s;
+  u32 head, tail;
+
+  ASSERT (vlib_get_thread_index () == 0);
+
+  vec_foreach (st, psm->threads)
+    {
+      if (st->ring == 0)
+	continue;
+
+      head = clib_atomic_load_acq_n (&st->head);
+      for (tail = st->tail; tail != head; tail++)
+	{
+	  s = st->ring + (tail & (psm->ring_size - 1));
+	  vec_validate (psm->nodes, s->node_index);
+	  n = psm->nodes + s->node_index;
+	  n->n_samples++;
+	  n->n_packets += s->n_vectors;
+	  n->clocks += s->clocks;
+	  n->cache_misses += s->cache_misses;
+	  n->clocks_per_packet[perfmon_sample_bin (s->clocks /
+						   s->n_vectors)]++;
+	  n->cache_misses_per_dispatch[perfmon_sample_bin (
+	    s->cache_misses)]++;
+	}
+      clib_atomic_store_rel_n (&st->tail, tail);
+    }
+
+  perfmon_sample_stats_update (psm);
+}
+
+clib_error_t *
+perfmon_sample_enable (vlib_main_t *vm, u32 interval, u8 use_pmu)
+{
+  perfmon_sample_main_t *psm = &perfmon_sample_main;
+  perfmon_main_t *pm = &perfmon_main;
+  perfmon_sample_thread_t *st;
+  u32 n_pmu = 0;
+
+  if (pm->is_running &&
+      pm->active_bundle->active_type == PERFMON_BUNDLE_TYPE_NODE)
+    return clib_error_return (0, "node bundle '%s' is running, stop it first",
+			      pm->active_bundle->name);
+
+#if !defined(__x86_64__)
+  use_pmu = 0;
+#endif
+
+  vlib_worker_thread_barrier_sync (vm);
+
+  if (psm->enabled)
+    perfmon_sample_disable (vm);
+
+  if (psm->clocks_stats_index == ~0)
+    {
+      psm->clocks_stats_index =
+	vlib_stats_add_counter_vector ("/perfmon/sample/clocks-per-packet");
+      psm->cache_misses_stats_index =
+	vlib_stats_add_counter_vector ("/perfmon/sample/cache-misses");
+    }
+
+  vec_free (psm->nodes);
+  psm->interval = clib_max (interval, 1);
+  psm->use_pmu = use_pmu;
+  vec_validate_aligned (psm->threads, vlib_get_n_threads () - 1,
+			CLIB_CACHE_LINE_BYTES);
+
+  vec_foreach (st, psm->threads)
+    {
+      u32 thread_index = st - psm->threads;
+
+      clib_memset (st, 0, sizeof (*st));
+      st->fd = -1;
+      st->countdown = psm->interval;
+      st->ring = clib_mem_alloc_aligned (psm->ring_size * sizeof (st->ring[0]),
+					 CLIB_CACHE_LINE_BYTES);
+      if (use_pmu)
+	perfmon_sample_pmu_open (st, vlib_worker_threads + thread_index);
+      n_pmu += st->pmc_index != 0;
+    }
+
+  if (use_pmu && n_pmu < vec_len (psm->threads))
+    log_warn ("cache misses counted on %u of %u threads", n_pmu,
+	      vec_len (psm->threads));
+
+  psm->enabled = 1;
+
+  for (int i = 0; i < vlib_get_n_threads (); i++)
+    vlib_node_set_dispatch_wrapper (vlib_get_main_by_index (i),
+				    perfmon_sample_dispatch);
+
+  vlib_worker_thread_barrier_release (vm);
+
+  vlib_process_signal_event (vm, psm->process_node_index, 0, 0);
+  return 0;
+}
+
+void
+perfmon_sample_disable (vlib_main_t *vm)
+{
+  perfmon_sample_main_t *psm = &perfmon_sample_main;
+  perfmon_sample_thread_t *st;
+
+  if (!psm->enabled)
+    return;
+
+  vlib_worker_thread_barrier_sync (vm);
+
+  for (int i = 0; i < vlib_get_n_threads (); i++)
+    {
+      vlib_main_t *ovm = vlib_get_main_by_index (i);
+      if (ovm->dispatch_wrapper_fn == perfmon_sample_dispatch)
+	vlib_node_set_dispatch_wrapper (ovm, 0);
+    }
+
+  /* Keep what was collected so far for show runtime histogram */
+  perfmon_sample_drain (vm);
+
+  vec_foreach (st, psm->threads)
+    {
+      perfmon_sample_pmu_close (st);
+      clib_mem_free (st->ring);
+      st->ring = 0;
+    }
+
+  psm->enabled = 0;
+
+  vlib_worker_thread_barrier_release (vm);
+}
+
+static uword
+perfmon_sample_process (vlib_main_t *vm, vlib_node_runtime_t *rt,
+			vlib_frame_t *f)
+{
+  perfmon_sample_main_t *psm = &perfmon_sample_main;
+
+  while (1)
+    {
+      if (psm->enabled)
+	vlib_process_wait_for_event_or_clock (vm,
+					      PERFMON_SAMPLE_DRAIN_INTERVAL);
+      else
+	vlib_process_wait_for_event (vm);
+
+      vlib_process_get_events (vm, 0);
+
+      if (psm->enabled)
+	perfmon_sample_drain (vm);
+    }
+
+  return 0;
+}
+
+VLIB_REGISTER_NODE (perfmon_sample_process_node) = {
+  .function = perfmon_sample_process,
+  .type = VLIB_NODE_TYPE_PROCESS,
+  .name = "perfmon-sample-process",
+};
+
+static u64
+perfmon_sample_percentile (u64 *hist, u64 n_samples, u32 pct)
+{
+  u64 sum = 0;
+  u32 i;
+
+  for (i = 0; i < PERFMON_SAMPLE_N_BINS - 1; i++)
+    {
+      sum += hist[i];
+      if (sum * 100 >= n_samples * pct)
+	break;
+    }
+
+  /* Upper bound of the bin */
+  return i ? 1ULL << i : 0;
+}
+
+u8 *
+format_perfmon_sample_node (u8 *s, va_list *args)
+{
+  vlib_main_t *vm = va_arg (*args, vlib_main_t *);
+  perfmon_sample_node_t *n = va_arg (*args, perfmon_sample_node_t *);
+  int verbose = va_arg (*args, int);
+  perfmon_sample_main_t *psm = &perfmon_sample_main;
+  u32 indent = format_get_indent (s);
+  u32 node_index;
+
+  if (n == 0)
+    return format (s, "%-30s%=12s%=12s%=10s%=10s%=10s%=10s%=12s", "Name",
+		   "Samples", "Packets", "Clk/Pkt", "p50", "p90", "p99",
+		   "Misses/Pkt");
+
+  node_index = n - psm->nodes;
+
+  s = format (s, "%-30U%=12lu%=12lu%=10.1f%=10lu%=10lu%=10lu%=12.2f",
+	      format_vlib_node_name, vm, node_index, n->n_samples,
+	      n->n_packets, (f64) n->clocks / n->n_packets,
+	      perfmon_sample_percentile (n->clocks_per_packet, n->n_samples,
+					 50),
+	      perfmon_sample_percentile (n->clocks_per_packet, n->n_samples,
+					 90),
+	      perfmon_sample_percentile (n->clocks_per_packet, n->n_samples,
+					 99),
+	      (f64) n->cache_misses / n->n_packets);
+
+  if (!verbose)
+    return s;
+
+  s = format (s, "\n%U%-16s%=16s%=16s", format_white_space, indent + 2,
+	      "Bin", "Clocks/Pkt", "Misses/Dispatch");
+  for (u32 i = 0; i < PERFMON_SAMPLE_N_BINS; i++)
+    {
+      if (n->clocks_per_packet[i] + n->cache_misses_per_dispatch[i] == 0)
+	continue;
+      if (i == 0)
+	s = format (s, "\n%U%-16s", format_white_space, indent + 2, "0");
+      else if (i == PERFMON_SAMPLE_N_BINS - 1)
+	s = format (s, "\n%U>= %-13lu", format_white_space, indent + 2,
+		    1ULL << (i - 1));
+      else
+	s = format (s, "\n%U%-7lu- %-7lu", format_white_space, indent + 2,
+		    1ULL << (i - 1), (1ULL << i) - 1);
+      s = format (s, "%=16lu%=16lu", n->clocks_per_packet[i],
+		  n->cache_misses_per_dispatch[i]);
+    }
+
+  return s;
+}
+
+static clib_error_t *
+perfmon_sample_init (vlib_main_t *vm)
+{
+  perfmon_sample_main.process_node_index = perfmon_sample_process_node.index;
+  return 0;
+}
+
+VLIB_INIT_FUNCTION (perfmon_sample_init);
+
+static clib_error_t *
+perfmon_sample_main_loop_enter (vlib_main_t *vm)
+{
+  perfmon_sample_main_t *psm = &perfmon_sample_main;
+
+  if (!psm->config_enable)
+    return 0;
+
+  return perfmon_sample_enable (vm, psm->interval, psm->use_pmu);
+}
+
+VLIB_MAIN_LOOP_ENTER_FUNCTION (perfmon_sample_main_loop_enter);
+
+static clib_error_t *
+perfmon_config (vlib_main_t *vm, unformat_input_t *input)
+{
+  perfmon_sample_main_t *psm = &perfmon_sample_main;
+  u32 ring_size;
+
+  while (unformat_check_input (input) != UNFORMAT_END_OF_INPUT)
+    {
+      if (unformat (input, "sampling"))
+	psm->config_enable = 1;
+      else if (unformat (input, "sample-interval %u", &psm->interval))
+	;
+      else if (unformat (input, "sample-ring-size %u", &ring_size))
+	psm->ring_size = max_pow2 (clib_max (ring_size, 64));
+      else if (unformat (input, "sample-no-pmu"))
+	psm->use_pmu = 0;
+      else
+	return clib_error_return (0, "unknown input '%U'",
+				  format_unformat_error, input);
+    }
+
+  return 0;
+}
+
+VLIB_CONFIG_FUNCTION (perfmon_config, "perfmon");
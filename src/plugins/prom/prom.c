@@ -97,6 +97,94 @@ dump_counter_vector_combined (stat_segment_data_t *res, u8 *s, u8 used_only)
   return s;
 }
 
+/*
+ * Index j of a histogram counter vector is bin j % n_bins of histogram
+ * j / n_bins, the "le" vector holds the inclusive upper bound of each bin,
+ * ~0 for no bound. Histograms without samples are skipped.
+ */
+static u8 *
+dump_histogram (stat_segment_data_t *res, stat_segment_data_t *le, u8 *s)
+{
+  counter_t *bounds = le->simple_counter_vec[0];
+  u32 n_bins = vec_len (bounds);
+  u8 need_header = 1;
+  int j, k, b;
+  u8 *name;
+
+  name = make_stat_name (res->name);
+
+  for (k = 0; k < vec_len (res->simple_counter_vec); k++)
+    for (j = 0; j + n_bins <= vec_len (res->simple_counter_vec[k]);
+	 j += n_bins)
+      {
+	counter_t *c = res->simple_counter_vec[k] + j;
+	u64 sum = 0;
+
+	for (b = 0; b < n_bins; b++)
+	  sum += c[b];
+	if (!sum)
+	  continue;
+
+	if (need_header)
+	  {
+	    s = format (s, "# TYPE %v histogram\n", name);
+	    need_header = 0;
+	  }
+
+	sum = 0;
+	for (b = 0; b < n_bins; b++)
+	  {
+	    sum += c[b];
+	    if (bounds[b] == ~0ULL)
+	      break;
+	    s = format (s,
+			"%v_bucket{thread=\"%d\",interface=\"%d\",le=\"%llu\"} "
+			"%lld\n",
+			name, k, j / n_bins, bounds[b], sum);
+	  }
+	for (b++; b < n_bins; b++)
+	  sum += c[b];
+	s = format (s,
+		    "%v_bucket{thread=\"%d\",interface=\"%d\",le=\"+Inf\"} "
+		    "%lld\n",
+		    name, k, j / n_bins, sum);
+	s = format (s, "%v_count{thread=\"%d\",interface=\"%d\"} %lld\n",
+		    name, k, j / n_bins, sum);
+      }
+
+  return s;
+}
+
+/*
+ * A simple counter vector is a histogram if it has a sibling named "le"
+ * with the bin bounds, e.g. "/latency/tx-interface" and "/latency/le".
+ * Returns the sibling, or 0.
+ */
+static stat_segment_data_t *
+histogram_bounds (stat_segment_data_t *res, int i)
+{
+  char *name = res[i].name, *slash = strrchr (name, '/');
+  int j, len;
+
+  if (res[i].type != STAT_DIR_TYPE_COUNTER_VECTOR_SIMPLE || !slash ||
+      !strcmp (slash, "/le"))
+    return 0;
+
+  len = slash - name;
+  for (j = 0; j < vec_len (res); j++)
+    {
+      if (res[j].type != STAT_DIR_TYPE_COUNTER_VECTOR_SIMPLE ||
+	  strncmp (res[j].name, name, len) || strcmp (res[j].name + len, "/le"))
+	continue;
+      if (vec_len (res[j].simple_counter_vec) == 0 ||
+	  vec_len (res[j].simple_counter_vec[0]) == 0)
+	return 0;
+      return res + j;
+    }
+
+  return 0;
+}
+
 static u8 *
 dump_scalar_index (stat_segment_data_t *res, u8 *s, u8 used_only)
 {
@@ -132,7 +220,7 @@ dump_name_vector (stat_segment_data_t *res, u8 *s, u8 used_only)
 static u8 *
 scrape_stats_segment (u8 *s, u8 **patterns, u8 used_only)
 {
-  stat_segment_data_t *res;
+  stat_segment_data_t *res, **bounds = 0;
   static u32 *stats = 0;
   int i;
 
@@ -148,12 +236,20 @@ retry:
       goto retry;
     }
 
+  /* Before make_stat_name () rewrites the names */
+  vec_validate (bounds, vec_len (res));
+  for (i = 0; i < vec_len (res); i++)
+    bounds[i] = histogram_bounds (res, i);
+
   for (i = 0; i < vec_len (res); i++)
     {
       switch (res[i].type)
 	{
 	case STAT_DIR_TYPE_COUNTER_VECTOR_SIMPLE:
-	  s = dump_counter_vector_simple (&res[i], s, used_only);
+	  if (bounds[i])
+	    s = dump_histogram (&res[i], bounds[i], s);
+	  else
+	    s = dump_counter_vector_simple (&res[i], s, used_only);
 	  break;
 
 	case STAT_DIR_TYPE_COUNTER_VECTOR_COMBINED:
@@ -177,6 +273,7 @@ retry:
 	}
     }
   stat_segment_data_free (res);
+  vec_free (bounds);
   vec_free (stats);
 
   return s;
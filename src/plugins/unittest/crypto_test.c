@@ -651,9 +651,201 @@ static u32
 test_crypto_get_key_sz (vnet_crypto_alg_t alg)
 {
   vnet_crypto_main_t *cm = &crypto_main;
+  /* HMAC keys can be of any length */
+  if (cm->algs[alg].variable_key_length)
+    return 32;
   return cm->algs[alg].key_length;
 }
 
+typedef struct
+{
+  vnet_crypto_alg_t alg;
+  vnet_crypto_alg_t crypto_alg;
+  vnet_crypto_alg_t integ_alg;
+  vnet_crypto_op_id_t crypto_op;
+  vnet_crypto_op_id_t integ_op;
+  u8 digest_len;
+} crypto_test_linked_alg_t;
+
+static const crypto_test_linked_alg_t crypto_test_linked_algs[] = {
+#define _(c, h, s, k, d)                                                      \
+  {                                                                           \
+    .alg = VNET_CRYPTO_ALG_##c##_##h##_TAG##d,                                \
+    .crypto_alg = VNET_CRYPTO_ALG_##c,                                        \
+    .integ_alg = VNET_CRYPTO_ALG_HMAC_##h,                                    \
+    .crypto_op = VNET_CRYPTO_OP_##c##_ENC,                                    \
+    .integ_op = VNET_CRYPTO_OP_##h##_HMAC,                                    \
+    .digest_len = d,                                                          \
+  },
+  foreach_crypto_link_async_alg
+#undef _
+};
+
+static const crypto_test_linked_alg_t *
+test_crypto_get_linked_alg (vnet_crypto_alg_t alg)
+{
+  FOREACH_ARRAY_ELT (la, crypto_test_linked_algs)
+    if (la->alg == alg)
+      return la;
+  return 0;
+}
+
+static void
+test_crypto_linked_keys_add (vlib_main_t *vm,
+			     const crypto_test_linked_alg_t *la, u8 *key,
+			     u32 keys[3])
+{
+  keys[0] = vnet_crypto_key_add (vm, la->crypto_alg, key,
+				 test_crypto_get_key_sz (la->crypto_alg));
+  keys[1] = vnet_crypto_key_add (vm, la->integ_alg, key + 32, 20);
+  keys[2] = vnet_crypto_key_add_linked (vm, keys[0], keys[1]);
+}
+
+#define CRYPTO_TEST_LINKED_N_OPS  67
+#define CRYPTO_TEST_LINKED_OP_MEM 2048
+
+/*
+ * Linked (cipher + HMAC) ops of every alg some engine has a handler for,
+ * checked against separate cipher and HMAC ops. Data is laid out like ESP,
+ * 8 byte header, 16 byte IV, payload and ICV, every other op authenticates
+ * header and IV through aad, the others only the ciphertext.
+ */
+static clib_error_t *
+test_crypto_linked (vlib_main_t *vm, crypto_test_main_t *tm)
+{
+  vnet_crypto_main_t *cm = &crypto_main;
+  const u32 n_ops = CRYPTO_TEST_LINKED_N_OPS;
+  const u32 sz = CRYPTO_TEST_LINKED_OP_MEM;
+  vnet_crypto_op_t *ops = 0, *crypto_ops = 0, *integ_ops = 0, *op;
+  u8 *pt = 0, *data = 0, *ref = 0, *s = 0, *err = 0;
+  u8 key[64];
+  u32 i;
+
+  for (i = 0; i < sizeof (key); i++)
+    key[i] = 0x40 + i;
+
+  vec_validate_aligned (ops, n_ops - 1, CLIB_CACHE_LINE_BYTES);
+  vec_validate_aligned (crypto_ops, n_ops - 1, CLIB_CACHE_LINE_BYTES);
+  vec_validate_aligned (integ_ops, n_ops - 1, CLIB_CACHE_LINE_BYTES);
+  vec_validate_aligned (pt, n_ops * sz - 1, CLIB_CACHE_LINE_BYTES);
+  vec_validate_aligned (data, n_ops * sz - 1, CLIB_CACHE_LINE_BYTES);
+  vec_validate_aligned (ref, n_ops * sz - 1, CLIB_CACHE_LINE_BYTES);
+
+  FOREACH_ARRAY_ELT (la, crypto_test_linked_algs)
+    {
+      vnet_crypto_alg_data_t *ad = cm->algs + la->alg;
+      u32 keys[3];
+
+      if (!vnet_crypto_is_set_handler (la->alg))
+	continue;
+
+      test_crypto_linked_keys_add (vm, la, key, keys);
+      vec_reset_length (err);
+
+      for (i = 0; i < n_ops * sz; i++)
+	pt[i] = i * 13 + la->alg;
+      clib_memcpy_fast (data, pt, n_ops * sz);
+      clib_memcpy_fast (ref, pt, n_ops * sz);
+
+      for (i = 0; i < n_ops; i++)
+	{
+	  u32 len = 16 * (1 + (i * 7) % 96);
+	  u8 *p = ref + i * sz;
+
+	  op = crypto_ops + i;
+	  vnet_crypto_op_init (op, la->crypto_op);
+	  op->key_index = keys[0];
+	  op->iv = p + 8;
+	  op->src = op->dst = p + 24;
+	  op->len = len;
+
+	  op = integ_ops + i;
+	  vnet_crypto_op_init (op, la->integ_op);
+	  op->key_index = keys[1];
+	  op->src = i & 1 ? p : p + 24;
+	  op->len = i & 1 ? len + 24 : len;
+	  op->digest = p + 24 + len;
+	  op->digest_len = la->digest_len;
+
+	  p = data + i * sz;
+	  op = ops + i;
+	  vnet_crypto_op_init (op, ad->op_by_type[VNET_CRYPTO_OP_TYPE_ENCRYPT]);
+	  op->key_index = keys[2];
+	  op->iv = p + 8;
+	  op->src = op->dst = p + 24;
+	  op->len = len;
+	  op->aad = i & 1 ? p : 0;
+	  op->aad_len = len + 24;
+	  op->digest = p + 24 + len;
+	  op->digest_len = la->digest_len;
+	  op->user_data = i;
+	}
+
+      vnet_crypto_process_ops (vm, crypto_ops, n_ops);
+      vnet_crypto_process_ops (vm, integ_ops, n_ops);
+      vnet_crypto_process_ops (vm, ops, n_ops);
+
+      vec_foreach (op, ops)
+	if (op->status != VNET_CRYPTO_OP_STATUS_COMPLETED)
+	  err = format (err, "%sencrypt op %u: %U", vec_len (err) ? ", " : "",
+			op->user_data, format_vnet_crypto_op_status,
+			op->status);
+
+      if (memcmp (data, ref, n_ops * sz))
+	err = format (err, "%sencrypt mismatch", vec_len (err) ? ", " : "");
+
+      /* decrypt, every 5th op with corrupted ICV must fail and stay
+       * encrypted */
+      vec_foreach (op, ops)
+	{
+	  op->op = ad->op_by_type[VNET_CRYPTO_OP_TYPE_DECRYPT];
+	  op->flags = VNET_CRYPTO_OP_FLAG_HMAC_CHECK;
+	  if (op->user_data % 5 == 0)
+	    op->digest[0] ^= 1;
+	}
+
+      vnet_crypto_process_ops (vm, ops, n_ops);
+
+      vec_foreach (op, ops)
+	{
+	  vnet_crypto_op_status_t status = VNET_CRYPTO_OP_STATUS_COMPLETED;
+	  u8 *exp = pt + (op->src - data);
+
+	  if (op->user_data % 5 == 0)
+	    {
+	      status = VNET_CRYPTO_OP_STATUS_FAIL_BAD_HMAC;
+	      exp = ref + (op->src - data);
+	    }
+
+	  if (op->status != status)
+	    err = format (err, "%sdecrypt op %u: %U", vec_len (err) ? ", " : "",
+			  op->user_data, format_vnet_crypto_op_status,
+			  op->status);
+	  else if (memcmp (op->dst, exp, op->len))
+	    err = format (err, "%sdecrypt op %u: data mismatch",
+			  vec_len (err) ? ", " : "", op->user_data);
+	}
+
+      vec_reset_length (s);
+      s = format (s, "%U (linked)", format_vnet_crypto_alg, la->alg);
+      vlib_cli_output (vm, "%-65v%s%v", s, vec_len (err) ? "FAIL: " : "OK",
+		       err);
+
+      for (i = 0; i < 3; i++)
+	vnet_crypto_key_del (vm, keys[2 - i]);
+    }
+
+  vec_free (ops);
+  vec_free (crypto_ops);
+  vec_free (integ_ops);
+  vec_free (pt);
+  vec_free (data);
+  vec_free (ref);
+  vec_free (s);
+  vec_free (err);
+  return 0;
+}
+
 static clib_error_t *
 test_crypto (vlib_main_t * vm, crypto_test_main_t * tm)
 {
@@ -794,6 +986,8 @@ test_crypto (vlib_main_t * vm, crypto_test_main_t * tm)
 
   err = test_crypto_incremental (vm, tm, inc_tests, n_ops_incr,
 				 computed_data_total_incr_len);
+  if (err == 0)
+    err = test_crypto_linked (vm, tm);
 
   r = tm->test_registrations;
   while (r)
@@ -818,8 +1012,10 @@ test_crypto_perf (vlib_main_t * vm, crypto_test_main_t * tm)
   u32 *buffer_indices = 0;
   vnet_crypto_op_t *ops1 = 0, *ops2 = 0, *op1, *op2;
   vnet_crypto_alg_data_t *ad = cm->algs + tm->alg;
+  const crypto_test_linked_alg_t *la = test_crypto_get_linked_alg (tm->alg);
   vnet_crypto_key_index_t key_index = ~0;
-  u8 key[64];
+  u32 linked_keys[3] = { ~0, ~0, ~0 };
+  u8 key[64], *dec_data = 0;
   int buffer_size = vlib_buffer_get_default_data_size (vm);
   u64 seed = clib_cpu_time_now ();
   u64 t0[5], t1[5], t2[5], n_bytes = 0;
@@ -861,8 +1057,16 @@ test_crypto_perf (vlib_main_t * vm, crypto_test_main_t * tm)
   for (i = 0; i < sizeof (key); i++)
     key[i] = i;
 
-  key_index = vnet_crypto_key_add (vm, tm->alg, key,
-				   test_crypto_get_key_sz (tm->alg));
+  if (la)
+    {
+      test_crypto_linked_keys_add (vm, la, key, linked_keys);
+      key_index = linked_keys[2];
+      vec_validate_aligned (dec_data, n_buffers * buffer_size - 1,
+			    CLIB_CACHE_LINE_BYTES);
+    }
+  else
+    key_index = vnet_crypto_key_add (vm, tm->alg, key,
+				     test_crypto_get_key_sz (tm->alg));
 
   for (i = 0; i < VNET_CRYPTO_OP_N_TYPES; i++)
     {
@@ -899,6 +1103,17 @@ test_crypto_perf (vlib_main_t * vm, crypto_test_main_t * tm)
 	      op1->tag_len = op2->tag_len = 16;
 	    }
 
+	  if (la)
+	    {
+	      /* decrypt elsewhere so ciphertext and ICV stay valid for the
+	       * next round */
+	      op2->dst = dec_data + i * buffer_size;
+	      op1->aad = op2->aad = 0;
+	      op1->digest = op2->digest = b->data - 32;
+	      op1->digest_len = op2->digest_len = la->digest_len;
+	      op2->flags = VNET_CRYPTO_OP_FLAG_HMAC_CHECK;
+	    }
+
 	  n_bytes += op1->len = op2->len = buffer_size;
 	  break;
 	case VNET_CRYPTO_OP_TYPE_HMAC:
@@ -968,9 +1183,14 @@ done:
   if (key_index != ~0)
     vnet_crypto_key_del (vm, key_index);
 
+  for (i = 1; i >= 0; i--)
+    if (linked_keys[i] != ~0)
+      vnet_crypto_key_del (vm, linked_keys[i]);
+
   vec_free (buffer_indices);
   vec_free (ops1);
   vec_free (ops2);
+  vec_free (dec_data);
   return err;
 }
 
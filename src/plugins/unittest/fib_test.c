@@ -40,6 +40,8 @@
 #include <vnet/fib/fib_walk.h>
 #include <vnet/fib/fib_node_list.h>
 #include <vnet/fib/fib_urpf_list.h>
+#include <vnet/fib/fib_epoch.h>
+#include <vnet/fib/fib_api.h>
 
 #include <vlib/unix/plugin.h>
 
@@ -10860,6 +10862,823 @@ fib_test_sticky (void)
     return 0;
 }
 
+/*
+ * The approximate prefix length distribution of the IPv6 DFZ, in percent.
+ */
+static const struct {
+    u8 len;
+    u8 weight;
+} fib_test_ip6_bgp_lens[] = {
+    { 48, 42 }, { 32, 12 }, { 44, 8 }, { 40, 7 }, { 36, 4 }, { 29, 3 },
+    { 46, 3 }, { 47, 2 }, { 42, 2 }, { 45, 2 }, { 38, 2 }, { 34, 2 },
+    { 33, 2 }, { 35, 1 }, { 28, 1 }, { 30, 1 }, { 31, 1 }, { 37, 1 },
+    { 39, 1 }, { 41, 1 }, { 43, 1 }, { 64, 1 },
+};
+
+static void
+fib_test_ip6_mk_bgp_prefix (fib_prefix_t *pfx, u32 *seed)
+{
+    u32 ii, pick;
+
+    pick = random_u32(seed) % 100;
+    for (ii = 0; ii < ARRAY_LEN(fib_test_ip6_bgp_lens) - 1; ii++)
+    {
+        if (pick < fib_test_ip6_bgp_lens[ii].weight)
+            break;
+        pick -= fib_test_ip6_bgp_lens[ii].weight;
+    }
+
+    pfx->fp_proto = FIB_PROTOCOL_IP6;
+    pfx->fp_len = fib_test_ip6_bgp_lens[ii].len;
+    /* global unicast, 2000::/3 */
+    pfx->fp_addr.ip6.as_u32[0] =
+        clib_host_to_net_u32(0x20000000 | (random_u32(seed) & 0x1fffffff));
+    pfx->fp_addr.ip6.as_u32[1] = random_u32(seed);
+    pfx->fp_addr.ip6.as_u64[1] = 0;
+    ip6_address_mask(&pfx->fp_addr.ip6, &ip6_main.fib_masks[pfx->fp_len]);
+}
+
+/*
+ * Lookup addresses; mostly within the installed prefixes, so the walk goes
+ * as deep as the table does, and some at random.
+ */
+static ip6_address_t *
+fib_test_ip6_mk_lookups (const fib_prefix_t *pfxs, u32 n_lookups, u32 *seed)
+{
+    ip6_address_t *addrs = NULL, *addr;
+    u32 ii;
+
+    vec_validate(addrs, n_lookups - 1);
+
+    for (ii = 0; ii < n_lookups; ii++)
+    {
+        addr = &addrs[ii];
+        addr->as_u32[0] = clib_host_to_net_u32(0x20000000 |
+                                               (random_u32(seed) & 0x1fffffff));
+        addr->as_u32[1] = random_u32(seed);
+        addr->as_u32[2] = random_u32(seed);
+        addr->as_u32[3] = random_u32(seed);
+
+        if (vec_len(pfxs) && (ii % 8))
+        {
+            const fib_prefix_t *pfx;
+            ip6_address_t host;
+
+            pfx = &pfxs[random_u32(seed) % vec_len(pfxs)];
+            host = *addr;
+            addr->as_u64[0] =
+                (pfx->fp_addr.ip6.as_u64[0] |
+                 (host.as_u64[0] & ~ip6_main.fib_masks[pfx->fp_len].as_u64[0]));
+            addr->as_u64[1] =
+                (pfx->fp_addr.ip6.as_u64[1] |
+                 (host.as_u64[1] & ~ip6_main.fib_masks[pfx->fp_len].as_u64[1]));
+        }
+    }
+
+    return (addrs);
+}
+
+static int
+fib_test_ip6_mtrie_validate (u32 fib_index, const ip6_address_t *addrs)
+{
+    const ip6_mtrie_t *mtrie;
+    u32 ii, lbi0, lbi1;
+    int res = 0;
+
+    mtrie = ip6_fib_get(fib_index)->mtrie;
+
+    vec_foreach_index(ii, addrs)
+    {
+        lbi0 = ip6_fib_table_fwding_hash_lookup(fib_index, &addrs[ii]);
+        lbi1 = ip6_mtrie_lookup(mtrie, &addrs[ii]);
+
+        FIB_TEST((lbi0 == lbi1), "%U: hash:%d mtrie:%d",
+                 format_ip6_address, &addrs[ii], lbi0, lbi1);
+    }
+    return (res);
+}
+
+/*
+ * Compare the results of the IPv6 mtrie and the forwarding hash over a
+ * BGP-like table and report the per-core lookup rate of each.
+ */
+static int
+fib_test_ip6_mtrie (u32 n_routes, u32 n_lookups)
+{
+    vlib_main_t *vm = vlib_get_main();
+    fib_prefix_t *pfxs = NULL, pfx;
+    u32 fib_index, ii, n_plies, seed;
+    ip6_address_t *addrs;
+    u64 t0, t1, sum;
+    f64 per_sec[3];
+    int res = 0;
+
+    seed = 0xdeadbeef;
+    n_plies = pool_elts(ip6_ply_pool);
+    fib_index = fib_table_find_or_create_and_lock(FIB_PROTOCOL_IP6, 1001,
+                                                  FIB_SOURCE_API);
+
+    /*
+     * half the table goes in before the trie is built, so it's populated
+     * from the forwarding hash, the other half incrementally after.
+     */
+    for (ii = 0; ii < n_routes; ii++)
+    {
+        if (ii == n_routes / 2)
+            ip6_fib_table_mtrie_enable(fib_index);
+
+        fib_test_ip6_mk_bgp_prefix(&pfx, &seed);
+
+        if (FIB_NODE_INDEX_INVALID !=
+            fib_table_lookup_exact_match(fib_index, &pfx))
+            continue;
+
+        fib_table_entry_special_add(fib_index, &pfx,
+                                    FIB_SOURCE_API,
+                                    FIB_ENTRY_FLAG_DROP);
+        vec_add1(pfxs, pfx);
+    }
+    ip6_fib_table_mtrie_enable(fib_index);
+    FIB_TEST((NULL != ip6_fib_get(fib_index)->mtrie), "mtrie enabled");
+
+    addrs = fib_test_ip6_mk_lookups(pfxs, n_lookups, &seed);
+    res += fib_test_ip6_mtrie_validate(fib_index, addrs);
+
+    /*
+     * time the lookups of the two schemes
+     */
+    t0 = clib_cpu_time_now();
+    for (sum = ii = 0; ii < n_lookups; ii++)
+        sum += ip6_fib_table_fwding_hash_lookup(fib_index, &addrs[ii]);
+    t1 = clib_cpu_time_now();
+    per_sec[0] = n_lookups * vm->clib_time.clocks_per_second / (t1 - t0);
+
+    t0 = clib_cpu_time_now();
+    for (ii = 0; ii < n_lookups; ii++)
+        sum -= ip6_fib_table_fwding_lookup(fib_index, &addrs[ii]);
+    t1 = clib_cpu_time_now();
+    per_sec[1] = n_lookups * vm->clib_time.clocks_per_second / (t1 - t0);
+
+    t0 = clib_cpu_time_now();
+    for (ii = 0; ii + 1 < n_lookups; ii += 2)
+    {
+        u32 lbi0, lbi1;
+
+        ip6_fib_table_fwding_lookup_x2(fib_index, fib_index,
+                                       &addrs[ii], &addrs[ii + 1],
+                                       &lbi0, &lbi1);
+        sum += lbi0 + lbi1;
+    }
+    t1 = clib_cpu_time_now();
+    per_sec[2] = (ii * vm->clib_time.clocks_per_second / (t1 - t0));
+
+    vlib_cli_output(vm, "IPv6 %d routes, %d lookups (checksum %lx)",
+                    vec_len(pfxs), n_lookups, sum);
+    vlib_cli_output(vm, "  hash:      %.2f Mlookups/sec", per_sec[0] * 1e-6);
+    vlib_cli_output(vm, "  mtrie:     %.2f Mlookups/sec", per_sec[1] * 1e-6);
+    vlib_cli_output(vm, "  mtrie-x2:  %.2f Mlookups/sec", per_sec[2] * 1e-6);
+    vlib_cli_output(vm, "  %U", format_ip6_mtrie,
+                    ip6_fib_get(fib_index)->mtrie, 0);
+
+    /*
+     * remove every other route, the trie reverts those slots to the cover
+     */
+    for (ii = 0; ii < vec_len(pfxs); ii += 2)
+        fib_table_entry_special_remove(fib_index, &pfxs[ii], FIB_SOURCE_API);
+
+    res += fib_test_ip6_mtrie_validate(fib_index, addrs);
+
+    for (ii = 1; ii < vec_len(pfxs); ii += 2)
+        fib_table_entry_special_remove(fib_index, &pfxs[ii], FIB_SOURCE_API);
+
+    res += fib_test_ip6_mtrie_validate(fib_index, addrs);
+
+    fib_table_unlock(fib_index, FIB_PROTOCOL_IP6, FIB_SOURCE_API);
+
+    FIB_TEST((n_plies == pool_elts(ip6_ply_pool)),
+             "no leaked plies: %d", pool_elts(ip6_ply_pool) - n_plies);
+
+    vec_free(addrs);
+    vec_free(pfxs);
+
+    return (res);
+}
+
+/*
+ * The approximate prefix length distribution of the IPv4 DFZ, in percent.
+ */
+static const struct {
+    u8 len;
+    u8 weight;
+} fib_test_ip4_bgp_lens[] = {
+    { 24, 60 }, { 22, 10 }, { 23, 8 }, { 21, 5 }, { 20, 5 }, { 19, 3 },
+    { 16, 3 }, { 18, 2 }, { 17, 2 }, { 28, 1 }, { 32, 1 },
+};
+
+static void
+fib_test_ip4_mk_bgp_prefix (fib_prefix_t *pfx, u32 *seed)
+{
+    u32 ii, pick;
+
+    pick = random_u32(seed) % 100;
+    for (ii = 0; ii < ARRAY_LEN(fib_test_ip4_bgp_lens) - 1; ii++)
+    {
+        if (pick < fib_test_ip4_bgp_lens[ii].weight)
+            break;
+        pick -= fib_test_ip4_bgp_lens[ii].weight;
+    }
+
+    clib_memset(pfx, 0, sizeof(*pfx));
+    pfx->fp_proto = FIB_PROTOCOL_IP4;
+    pfx->fp_len = fib_test_ip4_bgp_lens[ii].len;
+    /* 1.0.0.0 -> 223.255.255.255 */
+    pfx->fp_addr.ip4.as_u32 =
+        clib_host_to_net_u32((1 + (random_u32(seed) % 223)) << 24 |
+                             (random_u32(seed) & 0xffffff));
+    pfx->fp_addr.ip4.as_u32 &= ip4_main.fib_masks[pfx->fp_len];
+}
+
+/*
+ * Lookup addresses within the first n_pfxs of the installed prefixes. With
+ * all of them the lookups are spread over the whole table, with only a few
+ * they hit the same plies again and again.
+ */
+static ip4_address_t *
+fib_test_ip4_mk_lookups (const fib_prefix_t *pfxs, u32 n_pfxs,
+                         u32 n_lookups, u32 *seed)
+{
+    ip4_address_t *addrs = NULL;
+    const fib_prefix_t *pfx;
+    u32 ii;
+
+    vec_validate(addrs, n_lookups - 1);
+
+    for (ii = 0; ii < n_lookups; ii++)
+    {
+        pfx = &pfxs[random_u32(seed) % n_pfxs];
+        addrs[ii].as_u32 = (pfx->fp_addr.ip4.as_u32 |
+                            (random_u32(seed) &
+                             ~ip4_main.fib_masks[pfx->fp_len]));
+    }
+
+    return (addrs);
+}
+
+static int
+fib_test_ip4_mtrie_validate (u32 fib_index, const ip4_address_t *addrs)
+{
+    u32 ii, *fib_indices = NULL;
+    index_t *lbis = NULL;
+    int res = 0;
+
+    vec_validate_init_empty(fib_indices, vec_len(addrs) - 1, fib_index);
+    vec_validate(lbis, vec_len(addrs) - 1);
+
+    ip4_fib_forwarding_lookup_frame(fib_indices, addrs, lbis, vec_len(addrs));
+
+    vec_foreach_index(ii, addrs)
+    {
+        FIB_TEST((lbis[ii] == ip4_fib_forwarding_lookup(fib_index,
+                                                        &addrs[ii])),
+                 "%U: frame:%d single:%d",
+                 format_ip4_address, &addrs[ii], lbis[ii],
+                 ip4_fib_forwarding_lookup(fib_index, &addrs[ii]));
+    }
+
+    vec_free(fib_indices);
+    vec_free(lbis);
+
+    return (res);
+}
+
+/*
+ * Report the cost, in clocks per lookup, of resolving a frame's worth of
+ * addresses one at a time, four at a time, and as a vector.
+ */
+static void
+fib_test_ip4_mtrie_time (u32 fib_index, const ip4_address_t *addrs,
+                         const char *what)
+{
+    vlib_main_t *vm = vlib_get_main();
+    u32 ii, jj, n, n_lookups, fib_indices[VLIB_FRAME_SIZE];
+    index_t lbis[VLIB_FRAME_SIZE];
+    u64 t[3], sum = 0;
+
+    for (ii = 0; ii < VLIB_FRAME_SIZE; ii++)
+        fib_indices[ii] = fib_index;
+
+    /* whole frames only, so each scheme does the same work */
+    n_lookups = vec_len(addrs) - (vec_len(addrs) % VLIB_FRAME_SIZE);
+    n = VLIB_FRAME_SIZE;
+
+    /*
+     * each scheme makes its own pass over the addresses, so they all
+     * start with the same (cold) cache
+     */
+    t[0] = clib_cpu_time_now();
+    for (ii = 0; ii < n_lookups; ii += n)
+    {
+        for (jj = 0; jj < n; jj++)
+            lbis[jj] = ip4_fib_forwarding_lookup(fib_index, &addrs[ii + jj]);
+        sum += lbis[0];
+    }
+    t[0] = clib_cpu_time_now() - t[0];
+
+    t[1] = clib_cpu_time_now();
+    for (ii = 0; ii < n_lookups; ii += n)
+    {
+        for (jj = 0; jj < n; jj += 4)
+            ip4_fib_forwarding_lookup_x4(fib_index, fib_index,
+                                         fib_index, fib_index,
+                                         &addrs[ii + jj], &addrs[ii + jj + 1],
+                                         &addrs[ii + jj + 2],
+                                         &addrs[ii + jj + 3],
+                                         &lbis[jj], &lbis[jj + 1],
+                                         &lbis[jj + 2], &lbis[jj + 3]);
+        sum += lbis[1];
+    }
+    t[1] = clib_cpu_time_now() - t[1];
+
+    t[2] = clib_cpu_time_now();
+    for (ii = 0; ii < n_lookups; ii += n)
+    {
+        ip4_fib_forwarding_lookup_frame(fib_indices, &addrs[ii], lbis, n);
+        sum += lbis[2];
+    }
+    t[2] = clib_cpu_time_now() - t[2];
+
+    if (!n_lookups)
+        return;
+
+    vlib_cli_output(vm, "  %s: %d lookups (checksum %lx)",
+                    what, n_lookups, sum);
+    vlib_cli_output(vm, "    single: %.2f clocks/lookup",
+                    (f64) t[0] / n_lookups);
+    vlib_cli_output(vm, "    x4:     %.2f clocks/lookup",
+                    (f64) t[1] / n_lookups);
+    vlib_cli_output(vm, "    frame:  %.2f clocks/lookup",
+                    (f64) t[2] / n_lookups);
+}
+
+/*
+ * Check the vector lookup of the IPv4 mtrie against the single lookup,
+ * for lookups spread across a BGP-like table and for lookups that
+ * are concentrated on a few of its prefixes.
+ */
+static int
+fib_test_ip4_mtrie (u32 n_routes, u32 n_lookups)
+{
+    vlib_main_t *vm = vlib_get_main();
+    fib_prefix_t *pfxs = NULL, pfx;
+    ip4_address_t *spread, *local;
+    u32 fib_index, ii, n_plies, seed;
+    int res = 0;
+
+    seed = 0xdeadbeef;
+    n_plies = pool_elts(ip4_ply_pool);
+    fib_index = fib_table_find_or_create_and_lock(FIB_PROTOCOL_IP4, 1002,
+                                                  FIB_SOURCE_API);
+
+    for (ii = 0; ii < n_routes; ii++)
+    {
+        fib_test_ip4_mk_bgp_prefix(&pfx, &seed);
+
+        if (FIB_NODE_INDEX_INVALID !=
+            fib_table_lookup_exact_match(fib_index, &pfx))
+            continue;
+
+        fib_table_entry_special_add(fib_index, &pfx,
+                                    FIB_SOURCE_API,
+                                    FIB_ENTRY_FLAG_DROP);
+        vec_add1(pfxs, pfx);
+    }
+
+    spread = fib_test_ip4_mk_lookups(pfxs, vec_len(pfxs), n_lookups, &seed);
+    local = fib_test_ip4_mk_lookups(pfxs, clib_min(16, vec_len(pfxs)),
+                                    n_lookups, &seed);
+
+    res += fib_test_ip4_mtrie_validate(fib_index, spread);
+    res += fib_test_ip4_mtrie_validate(fib_index, local);
+
+    vlib_cli_output(vm, "IPv4 %d routes, %d plies",
+                    vec_len(pfxs), pool_elts(ip4_ply_pool) - n_plies);
+    fib_test_ip4_mtrie_time(fib_index, spread, "random");
+    fib_test_ip4_mtrie_time(fib_index, local, "local");
+
+    /*
+     * remove every other route, then the rest
+     */
+    for (ii = 0; ii < vec_len(pfxs); ii += 2)
+        fib_table_entry_special_remove(fib_index, &pfxs[ii], FIB_SOURCE_API);
+
+    res += fib_test_ip4_mtrie_validate(fib_index, spread);
+
+    for (ii = 1; ii < vec_len(pfxs); ii += 2)
+        fib_table_entry_special_remove(fib_index, &pfxs[ii], FIB_SOURCE_API);
+
+    res += fib_test_ip4_mtrie_validate(fib_index, spread);
+
+    fib_table_unlock(fib_index, FIB_PROTOCOL_IP4, FIB_SOURCE_API);
+
+    FIB_TEST((n_plies == pool_elts(ip4_ply_pool)),
+             "no leaked plies: %d", pool_elts(ip4_ply_pool) - n_plies);
+
+    vec_free(spread);
+    vec_free(local);
+    vec_free(pfxs);
+
+    return (res);
+}
+
+static void
+fib_test_bulk_report (const char *what, u32 n_routes, f64 t,
+                      const fib_epoch_stats_t *before)
+{
+    vlib_main_t *vm = vlib_get_main();
+    fib_epoch_stats_t stats;
+
+    fib_epoch_get_stats(&stats);
+
+    vlib_cli_output(vm, "  %-18s %.0f routes/sec, barrier syncs:%lld",
+                    what, n_routes / t,
+                    stats.fes_n_barriers - before->fes_n_barriers);
+}
+
+/*
+ * Program a table's worth of routes with the same paths, one at a time as
+ * the API does for each ip_route_add_del, then as a batch. Report the
+ * rate of each and check the batch has the same result.
+ */
+static int
+fib_test_bulk (u32 n_routes)
+{
+    fib_route_path_t *rpaths = NULL, *extra = NULL, *paths = NULL;
+    u32 fib_index, ii, n_entries, n_path_lists, n_lbs;
+    vlib_main_t *vm = vlib_get_main();
+    test_main_t *tm = &test_main;
+    fib_prefix_t *pfxs = NULL, *pfx;
+    fib_node_index_t fei = FIB_NODE_INDEX_INVALID, pli;
+    fib_epoch_stats_t stats;
+    int res = 0;
+    f64 t;
+
+    fib_route_path_t rpath = {
+        .frp_proto = DPO_PROTO_IP4,
+        .frp_fib_index = ~0,
+        .frp_weight = 1,
+    };
+
+    for (ii = 0; ii < 3; ii++)
+    {
+        rpath.frp_addr.ip4.as_u32 = clib_host_to_net_u32(0x0a0a0a01 +
+                                                         (ii << 8));
+        rpath.frp_sw_if_index = tm->hw[ii]->sw_if_index;
+        if (ii < 2)
+            vec_add1(rpaths, rpath);
+        else
+            vec_add1(extra, rpath);
+    }
+
+    vec_validate(pfxs, n_routes - 1);
+    vec_foreach_index(ii, pfxs)
+    {
+        pfxs[ii].fp_len = 24;
+        pfxs[ii].fp_proto = FIB_PROTOCOL_IP4;
+        pfxs[ii].fp_addr.ip4.as_u32 =
+            clib_host_to_net_u32(0x20000000 + (ii << 8));
+    }
+
+    n_entries = fib_entry_pool_size();
+    n_path_lists = fib_path_list_pool_size();
+    n_lbs = pool_elts(load_balance_pool);
+    fib_index = fib_table_find_or_create_and_lock(FIB_PROTOCOL_IP4, 1004,
+                                                  FIB_SOURCE_API);
+
+    vlib_cli_output(vm, "IPv4 %d routes, %d paths", n_routes,
+                    vec_len(rpaths));
+
+    /*
+     * one route at a time; each is given its own copy of the paths,
+     * as each message is decoded
+     */
+    fib_epoch_get_stats(&stats);
+    t = vlib_time_now(vm);
+    vec_foreach(pfx, pfxs)
+    {
+        vec_reset_length(paths);
+        vec_append(paths, rpaths);
+        fib_api_route_add_del(1, 0, fib_index, pfx, FIB_SOURCE_API,
+                              FIB_ENTRY_FLAG_NONE, paths);
+    }
+    fib_test_bulk_report("add", n_routes, vlib_time_now(vm) - t, &stats);
+
+    fib_epoch_get_stats(&stats);
+    t = vlib_time_now(vm);
+    vec_foreach(pfx, pfxs)
+    {
+        fib_api_route_add_del(0, 0, fib_index, pfx, FIB_SOURCE_API,
+                              FIB_ENTRY_FLAG_NONE, NULL);
+    }
+    fib_test_bulk_report("delete", n_routes, vlib_time_now(vm) - t, &stats);
+
+    /*
+     * as a batch
+     */
+    fib_epoch_get_stats(&stats);
+    t = vlib_time_now(vm);
+    FIB_TEST(!fib_api_route_add_del_bulk(1, 0, fib_index, pfxs,
+                                         FIB_SOURCE_API,
+                                         FIB_ENTRY_FLAG_NONE, rpaths),
+             "bulk add");
+    fib_test_bulk_report("bulk add", n_routes, vlib_time_now(vm) - t, &stats);
+
+    pli = FIB_NODE_INDEX_INVALID;
+    vec_foreach(pfx, pfxs)
+    {
+        fei = fib_table_lookup_exact_match(fib_index, pfx);
+        if (FIB_NODE_INDEX_INVALID == pli && FIB_NODE_INDEX_INVALID != fei)
+            pli = fib_entry_get_path_list(fei);
+
+        FIB_TEST((FIB_NODE_INDEX_INVALID != fei &&
+                  pli == fib_entry_get_path_list(fei)),
+                 "%U added with the shared path-list",
+                 format_fib_prefix, pfx);
+    }
+    FIB_TEST((2 == fib_path_list_get_n_paths(pli)), "2 paths");
+    FIB_TEST((2 == load_balance_n_buckets(
+                  fib_entry_contribute_ip_forwarding(fei)->dpoi_index)),
+             "2 buckets");
+
+    /*
+     * a batch of path additions and removals
+     */
+    fib_epoch_get_stats(&stats);
+    t = vlib_time_now(vm);
+    FIB_TEST(!fib_api_route_add_del_bulk(1, 1, fib_index, pfxs,
+                                         FIB_SOURCE_API,
+                                         FIB_ENTRY_FLAG_NONE, extra),
+             "bulk path add");
+    fib_test_bulk_report("bulk path add", n_routes,
+                         vlib_time_now(vm) - t, &stats);
+
+    fei = fib_table_lookup_exact_match(fib_index, &pfxs[n_routes - 1]);
+    FIB_TEST((3 == fib_path_list_get_n_paths(fib_entry_get_path_list(fei))),
+             "3 paths");
+
+    fib_epoch_get_stats(&stats);
+    t = vlib_time_now(vm);
+    FIB_TEST(!fib_api_route_add_del_bulk(0, 1, fib_index, pfxs,
+                                         FIB_SOURCE_API,
+                                         FIB_ENTRY_FLAG_NONE, extra),
+             "bulk path remove");
+    fib_test_bulk_report("bulk path remove", n_routes,
+                         vlib_time_now(vm) - t, &stats);
+
+    fei = fib_table_lookup_exact_match(fib_index, &pfxs[0]);
+    FIB_TEST((2 == fib_path_list_get_n_paths(fib_entry_get_path_list(fei))),
+             "2 paths");
+
+    fib_epoch_get_stats(&stats);
+    t = vlib_time_now(vm);
+    FIB_TEST(!fib_api_route_add_del_bulk(0, 0, fib_index, pfxs,
+                                         FIB_SOURCE_API,
+                                         FIB_ENTRY_FLAG_NONE, NULL),
+             "bulk delete");
+    fib_test_bulk_report("bulk delete", n_routes,
+                         vlib_time_now(vm) - t, &stats);
+
+    vec_foreach(pfx, pfxs)
+    {
+        FIB_TEST((FIB_NODE_INDEX_INVALID ==
+                  fib_table_lookup_exact_match(fib_index, pfx)),
+                 "%U removed", format_fib_prefix, pfx);
+    }
+
+    /*
+     * a bad prefix and nothing is done
+     */
+    pfxs[n_routes - 1].fp_len = 33;
+    FIB_TEST((VNET_API_ERROR_INVALID_PREFIX_LENGTH ==
+              fib_api_route_add_del_bulk(1, 0, fib_index, pfxs,
+                                         FIB_SOURCE_API,
+                                         FIB_ENTRY_FLAG_NONE, rpaths)),
+             "bulk add invalid prefix");
+    FIB_TEST((FIB_NODE_INDEX_INVALID ==
+              fib_table_lookup_exact_match(fib_index, &pfxs[0])),
+             "bulk add invalid prefix, nothing added");
+
+    fib_table_unlock(fib_index, FIB_PROTOCOL_IP4, FIB_SOURCE_API);
+    fib_epoch_flush();
+
+    FIB_TEST((n_entries == fib_entry_pool_size()),
+             "entry pool size is %d", fib_entry_pool_size());
+    FIB_TEST((n_path_lists == fib_path_list_pool_size()),
+             "path list pool size is %d", fib_path_list_pool_size());
+    FIB_TEST((n_lbs == pool_elts(load_balance_pool)),
+             "load-balance pool size is %d", pool_elts(load_balance_pool));
+
+    vec_free(rpaths);
+    vec_free(extra);
+    vec_free(paths);
+    vec_free(pfxs);
+
+    return (res);
+}
+
+/*
+ * The state at the start of a phase of the convergence test
+ */
+typedef struct fib_test_conv_t_
+{
+    f64 fc_time;
+    u32 *fc_loops;
+    fib_epoch_stats_t fc_stats;
+} fib_test_conv_t;
+
+static void
+fib_test_conv_start (fib_test_conv_t *fc)
+{
+    vlib_global_main_t *vgm = vlib_get_global_main();
+    u32 ii;
+
+    vec_reset_length(fc->fc_loops);
+    for (ii = 1; ii < vec_len(vgm->vlib_mains); ii++)
+        vec_add1(fc->fc_loops, vgm->vlib_mains[ii]->main_loop_count);
+
+    fib_epoch_get_stats(&fc->fc_stats);
+    fc->fc_time = vlib_time_now(vlib_get_main());
+}
+
+/*
+ * Report the rate at which the routes were updated, the time the FIB held
+ * the workers for it, and how fast the workers went round their loop
+ * in the meantime.
+ */
+static void
+fib_test_conv_stop (fib_test_conv_t *fc, const char *what, u32 n_routes)
+{
+    vlib_global_main_t *vgm = vlib_get_global_main();
+    vlib_main_t *vm = vlib_get_main();
+    fib_epoch_stats_t stats;
+    u64 n_loops = 0;
+    u32 ii;
+    f64 t;
+
+    t = vlib_time_now(vm) - fc->fc_time;
+    fib_epoch_get_stats(&stats);
+
+    vec_foreach_index(ii, fc->fc_loops)
+    {
+        n_loops += (u32) (vgm->vlib_mains[ii + 1]->main_loop_count -
+                          fc->fc_loops[ii]);
+    }
+
+    vlib_cli_output(vm, "  %-6s %.0f routes/sec, barrier syncs:%lld "
+                    "held:%.3fms, retired:%lld, worker loops/sec:%.0f",
+                    what, n_routes / t,
+                    stats.fes_n_barriers - fc->fc_stats.fes_n_barriers,
+                    (stats.fes_barrier_time -
+                     fc->fc_stats.fes_barrier_time) * 1e3,
+                    stats.fes_n_retired - fc->fc_stats.fes_n_retired,
+                    (vec_len(fc->fc_loops) ?
+                     n_loops / t / vec_len(fc->fc_loops) : 0));
+}
+
+/*
+ * Add, re-path and remove a set of routes as fast as the main thread
+ * can, with or without the epoch based reclamation of the forwarding
+ * objects.
+ */
+static int
+fib_test_convergence_run (u32 n_routes, int epoch)
+{
+    const ip46_address_t nh_10_10_10_1 = {
+        .ip4.as_u32 = clib_host_to_net_u32(0x0a0a0a01),
+    };
+    const ip46_address_t nh_10_10_11_1 = {
+        .ip4.as_u32 = clib_host_to_net_u32(0x0a0a0b01),
+    };
+    fib_prefix_t pfx = {
+        .fp_len = 24,
+        .fp_proto = FIB_PROTOCOL_IP4,
+    };
+    vlib_main_t *vm = vlib_get_main();
+    test_main_t *tm = &test_main;
+    fib_test_conv_t fc = { 0 };
+    u32 fib_index, ii, n_lbs, n_plies;
+    int res = 0;
+
+    fib_epoch_enable_disable(epoch);
+
+    n_lbs = pool_elts(load_balance_pool);
+    n_plies = pool_elts(ip4_ply_pool);
+    fib_index = fib_table_find_or_create_and_lock(FIB_PROTOCOL_IP4, 1003,
+                                                  FIB_SOURCE_API);
+
+    vlib_cli_output(vm, "epoch-reclaim %s: %d routes, %d workers",
+                    (epoch ? "on" : "off"), n_routes,
+                    vlib_get_n_threads() - 1);
+
+    fib_test_conv_start(&fc);
+    for (ii = 0; ii < n_routes; ii++)
+    {
+        pfx.fp_addr.ip4.as_u32 = clib_host_to_net_u32(0x10000000 + (ii << 8));
+        fib_table_entry_path_add(fib_index, &pfx,
+                                 FIB_SOURCE_API,
+                                 FIB_ENTRY_FLAG_NONE,
+                                 DPO_PROTO_IP4,
+                                 &nh_10_10_10_1,
+                                 tm->hw[0]->sw_if_index,
+                                 ~0, 1, NULL,
+                                 FIB_ROUTE_PATH_FLAG_NONE);
+    }
+    fib_test_conv_stop(&fc, "add", n_routes);
+
+    /*
+     * a second path, each route's load-balance gets new buckets
+     */
+    fib_test_conv_start(&fc);
+    for (ii = 0; ii < n_routes; ii++)
+    {
+        pfx.fp_addr.ip4.as_u32 = clib_host_to_net_u32(0x10000000 + (ii << 8));
+        fib_table_entry_path_add(fib_index, &pfx,
+                                 FIB_SOURCE_API,
+                                 FIB_ENTRY_FLAG_NONE,
+                                 DPO_PROTO_IP4,
+                                 &nh_10_10_11_1,
+                                 tm->hw[1]->sw_if_index,
+                                 ~0, 1, NULL,
+                                 FIB_ROUTE_PATH_FLAG_NONE);
+    }
+    fib_test_conv_stop(&fc, "modify", n_routes);
+
+    fib_test_conv_start(&fc);
+    for (ii = 0; ii < n_routes; ii++)
+    {
+        pfx.fp_addr.ip4.as_u32 = clib_host_to_net_u32(0x10000000 + (ii << 8));
+        fib_table_entry_delete(fib_index, &pfx, FIB_SOURCE_API);
+    }
+    fib_test_conv_stop(&fc, "delete", n_routes);
+
+    fib_table_unlock(fib_index, FIB_PROTOCOL_IP4, FIB_SOURCE_API);
+
+    /*
+     * once the workers have moved on, nothing is left behind
+     */
+    fib_epoch_flush();
+    FIB_TEST((n_lbs == pool_elts(load_balance_pool)),
+             "no leaked load-balances: %d",
+             pool_elts(load_balance_pool) - n_lbs);
+    FIB_TEST((n_plies == pool_elts(ip4_ply_pool)),
+             "no leaked plies: %d", pool_elts(ip4_ply_pool) - n_plies);
+
+    vec_free(fc.fc_loops);
+
+    return (res);
+}
+
+static clib_error_t *
+fib_test_convergence (vlib_main_t * vm,
+                      unformat_input_t * input,
+                      vlib_cli_command_t * cmd_arg)
+{
+    u32 n_routes = 10000;
+    int res = 0, enabled;
+
+    while (unformat_check_input (input) != UNFORMAT_END_OF_INPUT)
+    {
+        if (unformat (input, "routes %d", &n_routes))
+            ;
+        else
+            return clib_error_return(0, "unknown input '%U'",
+                                     format_unformat_error, input);
+    }
+
+    /*
+     * the command is mp-safe, so the workers run while the routes churn;
+     * the FIB takes the barrier itself when it needs to.
+     */
+    vlib_worker_thread_barrier_sync(vm);
+    res += fib_test_mk_intf(4);
+    vlib_worker_thread_barrier_release(vm);
+
+    enabled = fib_epoch_is_enabled();
+    res += fib_test_convergence_run(n_routes, 0);
+    res += fib_test_convergence_run(n_routes, 1);
+    fib_epoch_enable_disable(enabled);
+
+    if (res)
+        return clib_error_return(0, "FIB Convergence Test Failed");
+    return (NULL);
+}
+
+VLIB_CLI_COMMAND (test_fib_convergence_command, static) = {
+    .path = "test fib convergence",
+    .short_help = "test fib convergence [routes <n>]",
+    .function = fib_test_convergence,
+    .is_mp_safe = 1,
+};
+
 static clib_error_t *
 fib_test (vlib_main_t * vm,
           unformat_input_t * input,
@@ -10876,7 +11695,50 @@ fib_test (vlib_main_t * vm,
         fib_test_do_debug = 1;
     }
 
-    if (unformat (input, "ip4"))
+    if (unformat (input, "ip4-mtrie"))
+    {
+        u32 n_routes = 1000, n_lookups = 100000;
+
+        while (unformat_check_input (input) != UNFORMAT_END_OF_INPUT)
+        {
+            if (unformat (input, "routes %d", &n_routes))
+                ;
+            else if (unformat (input, "lookups %d", &n_lookups))
+                ;
+            else
+                break;
+        }
+        res += fib_test_ip4_mtrie(n_routes, n_lookups);
+    }
+    else if (unformat (input, "ip6-mtrie"))
+    {
+        u32 n_routes = 1000, n_lookups = 100000;
+
+        while (unformat_check_input (input) != UNFORMAT_END_OF_INPUT)
+        {
+            if (unformat (input, "routes %d", &n_routes))
+                ;
+            else if (unformat (input, "lookups %d", &n_lookups))
+                ;
+            else
+                break;
+        }
+        res += fib_test_ip6_mtrie(n_routes, n_lookups);
+    }
+    else if (unformat (input, "bulk"))
+    {
+        u32 n_routes = 10000;
+
+        while (unformat_check_input (input) != UNFORMAT_END_OF_INPUT)
+        {
+            if (unformat (input, "routes %d", &n_routes))
+                ;
+            else
+                break;
+        }
+        res += fib_test_bulk(n_routes);
+    }
+    else if (unformat (input, "ip4"))
     {
         res += fib_test_v4();
     }
@@ -10930,6 +11792,9 @@ fib_test (vlib_main_t * vm,
         res += fib_test_pref();
         res += fib_test_label();
         res += fib_test_inherit();
+        res += fib_test_ip4_mtrie(1000, 10000);
+        res += fib_test_ip6_mtrie(1000, 10000);
+        res += fib_test_bulk(1000);
         res += lfib_test();
 
         /*
@@ -12,6 +12,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <pthread.h>
 #include <vnet/policer/policer.h>
 
 #define PKT_LEN 500
@@ -64,6 +65,259 @@ VLIB_CLI_COMMAND (test_policer_command, static) = {
   .function = policer_test,
 };
 
+/*
+ * Distributed policing.
+ *
+ * Accuracy: packets offered at twice the committed rate are spread
+ * round-robin over simulated workers, each with its own local buckets.
+ * The bytes that conform must be those that conform to the same policer
+ * owned by one thread, give or take a quantum per worker.
+ *
+ * Throughput: real threads police as fast as they can, either through
+ * their local buckets or, as the alternative to handing off, by taking a
+ * lock around the policer's own buckets.
+ */
+typedef struct policer_test_thread_t_
+{
+  CLIB_CACHE_LINE_ALIGN_MARK (cacheline0);
+  policer_t *policer;
+  policer_shared_t *shared;
+  policer_local_t *local;
+  clib_spinlock_t *lock;
+  volatile u32 *go;
+  u32 n_pkts;
+  u64 n_conform;
+  u64 cpu_ticks;
+} policer_test_thread_t;
+
+static void *
+policer_test_thread_fn (void *arg)
+{
+  policer_test_thread_t *t = arg;
+  policer_result_e result;
+  u64 start;
+  u32 i;
+
+  while (!*t->go)
+    CLIB_PAUSE ();
+
+  start = clib_cpu_time_now ();
+
+  for (i = 0; i < t->n_pkts; i++)
+    {
+      u64 time = clib_cpu_time_now () >> POLICER_TICKS_PER_PERIOD_SHIFT;
+
+      if (t->lock)
+	{
+	  clib_spinlock_lock (t->lock);
+	  result =
+	    vnet_police_packet (t->policer, PKT_LEN, POLICE_CONFORM, time);
+	  clib_spinlock_unlock (t->lock);
+	}
+      else
+	result = vnet_police_packet_distributed (
+	  t->policer, t->shared, t->local, PKT_LEN, POLICE_CONFORM, time);
+
+      t->n_conform += (result == POLICE_CONFORM);
+    }
+
+  t->cpu_ticks = clib_cpu_time_now () - start;
+
+  return NULL;
+}
+
+static f64
+policer_test_threads (policer_t *pol, policer_shared_t *shared,
+		      clib_spinlock_t *lock, u32 n_threads, u32 n_pkts)
+{
+  policer_test_thread_t *threads = 0, *t;
+  pthread_t *handles = 0;
+  volatile u32 go = 0;
+  u64 max_ticks = 0;
+  u32 i;
+
+  vec_validate_aligned (threads, n_threads - 1, CLIB_CACHE_LINE_BYTES);
+  vec_validate (handles, n_threads - 1);
+
+  vec_foreach_index (i, threads)
+    {
+      t = &threads[i];
+      t->policer = pol;
+      t->shared = shared;
+      t->local = &shared->locals[i];
+      t->lock = lock;
+      t->go = &go;
+      t->n_pkts = n_pkts;
+
+      if (pthread_create (&handles[i], NULL, policer_test_thread_fn, t))
+	{
+	  clib_unix_warning ("pthread_create");
+	  n_threads = i;
+	  break;
+	}
+    }
+
+  go = 1;
+
+  for (i = 0; i < n_threads; i++)
+    {
+      pthread_join (handles[i], NULL);
+      max_ticks = clib_max (max_ticks, threads[i].cpu_ticks);
+    }
+
+  vec_free (threads);
+  vec_free (handles);
+
+  /* million packets per second, over all threads */
+  return ((f64) n_threads * n_pkts * os_cpu_clock_frequency () /
+	  ((f64) max_ticks * 1e6));
+}
+
+static clib_error_t *
+policer_test_distributed (vlib_main_t *vm, unformat_input_t *input,
+			  vlib_cli_command_t *cmd_arg)
+{
+  u32 n_workers = 4, quantum = 0, rate_kbps = 100000, n_pkts = 1000000;
+  u32 burst = 1000, n_threads = 0, i, pi;
+  u64 central_bytes = 0, distributed_bytes = 0, error, bound;
+  f64 cpu_ticks_per_pkt, time = 0, mpps[2];
+  vnet_policer_main_t *pm = &vnet_policer_main;
+  policer_shared_t shared = {}, *sp;
+  clib_error_t *err = NULL;
+  qos_pol_cfg_params_st cfg;
+  policer_t central, *pol;
+  clib_spinlock_t lock;
+  u64 policer_time;
+
+  while (unformat_check_input (input) != UNFORMAT_END_OF_INPUT)
+    {
+      if (unformat (input, "workers %u", &n_workers))
+	;
+      else if (unformat (input, "quantum %u", &quantum))
+	;
+      else if (unformat (input, "rate %u", &rate_kbps))
+	;
+      else if (unformat (input, "burst %u", &burst))
+	;
+      else if (unformat (input, "threads %u", &n_threads))
+	;
+      else if (unformat (input, "packets %u", &n_pkts))
+	;
+      else
+	return clib_error_return (0, "unknown input `%U'",
+				  format_unformat_error, input);
+    }
+
+  if (!n_workers)
+    return clib_error_return (0, "workers must be > 0");
+
+  clib_memset (&cfg, 0, sizeof (cfg));
+  cfg.rate_type = QOS_RATE_KBPS;
+  cfg.rnd_type = QOS_ROUND_TO_CLOSEST;
+  cfg.rfc = QOS_POLICER_TYPE_1R2C;
+  cfg.rb.kbps.cir_kbps = rate_kbps;
+  cfg.rb.kbps.cb_bytes = burst;
+  cfg.conform_action.action_type = QOS_ACTION_TRANSMIT;
+  cfg.exceed_action.action_type = QOS_ACTION_DROP;
+  cfg.violate_action.action_type = QOS_ACTION_DROP;
+
+  if (policer_add (vm, (u8 *) "distributed-test", &cfg, &pi))
+    return clib_error_return (0, "policer add failed");
+
+  /* the control plane sizes the local buckets to the real threads */
+  if (policer_distribute (pi, true, quantum))
+    {
+      err = clib_error_return (0, "policer distribute failed");
+      goto done;
+    }
+  pol = &pm->policers[pi];
+  sp = &pm->shared_policers[pi];
+  if (!pol->distributed || vec_len (sp->locals) != vlib_get_n_threads () ||
+      !sp->quantum)
+    {
+      err = clib_error_return (0, "policer not distributed");
+      goto done;
+    }
+  vlib_cli_output (vm, "%U", format_policer_instance, pol);
+
+  /* simulate n_workers, whatever the real number of threads */
+  central = *pol;
+  shared.quantum = sp->quantum;
+  vec_validate_aligned (shared.locals, clib_max (n_workers, n_threads) - 1,
+			CLIB_CACHE_LINE_BYTES);
+
+  /* twice the committed rate, for one second */
+  cpu_ticks_per_pkt =
+    os_cpu_clock_frequency () * PKT_LEN / ((f64) rate_kbps * 125 / 2);
+
+  for (i = 0; time < os_cpu_clock_frequency (); i++)
+    {
+      time += cpu_ticks_per_pkt;
+      policer_time = ((u64) time) >> POLICER_TICKS_PER_PERIOD_SHIFT;
+
+      if (POLICE_CONFORM == vnet_police_packet (&central, PKT_LEN,
+						POLICE_CONFORM, policer_time))
+	central_bytes += PKT_LEN;
+      if (POLICE_CONFORM ==
+	  vnet_police_packet_distributed (pol, &shared,
+					  &shared.locals[i % n_workers],
+					  PKT_LEN, POLICE_CONFORM,
+					  policer_time))
+	distributed_bytes += PKT_LEN;
+    }
+
+  error = (distributed_bytes > central_bytes ?
+	     distributed_bytes - central_bytes :
+	     central_bytes - distributed_bytes);
+  bound = (u64) n_workers * ((shared.quantum >> pol->scale) + PKT_LEN);
+
+  vlib_cli_output (vm,
+		   "%u packets over %u workers, quantum %u: conform "
+		   "central %llu distributed %llu bytes, error %llu bound %llu",
+		   i, n_workers, shared.quantum >> pol->scale, central_bytes,
+		   distributed_bytes, error, bound);
+
+  if (error > bound)
+    {
+      err = clib_error_return (0, "distributed policer error %llu > %llu",
+			       error, bound);
+      goto done;
+    }
+
+  if (n_threads)
+    {
+      clib_spinlock_init (&lock);
+
+      policer_reset (vm, pi);
+      mpps[0] = policer_test_threads (pol, &shared, &lock, n_threads, n_pkts);
+
+      clib_memset (&shared.current_clock, 0, 2 * sizeof (u64));
+      mpps[1] = policer_test_threads (pol, &shared, NULL, n_threads, n_pkts);
+
+      clib_spinlock_free (&lock);
+
+      vlib_cli_output (vm, "%u threads: locked %.2f Mpps, distributed %.2f Mpps",
+		       n_threads, mpps[0], mpps[1]);
+    }
+
+  policer_distribute (pi, false, 0);
+  if (pol->distributed || vec_len (sp->locals))
+    err = clib_error_return (0, "policer still distributed");
+
+done:
+  vec_free (shared.locals);
+  policer_del (vm, pi);
+
+  return err;
+}
+
+VLIB_CLI_COMMAND (test_policer_distributed_command, static) = {
+  .path = "test policing distributed",
+  .short_help = "test policing distributed [workers <n>] [quantum <bytes>] "
+		"[rate <kbps>] [burst <bytes>] [threads <n>] [packets <n>]",
+  .function = policer_test_distributed,
+};
+
 clib_error_t *
 policer_test_init (vlib_main_t *vm)
 {
@@ -1545,6 +1545,141 @@ tcp_test_bt (vlib_main_t * vm, unformat_input_t * input)
   return 0;
 }
 
+static void
+tcp_test_bbr_ack (tcp_connection_t *tc, tcp_rate_sample_t *rs, f64 now,
+		  f64 bw, int lost)
+{
+  tcp_set_time_now (&tcp_main.wrk[tc->c_thread_index], now);
+  memset (rs, 0, sizeof (*rs));
+  rs->prior_delivered = tc->delivered;
+  rs->delivered = bw * 0.01;
+  rs->interval_time = 0.01;
+  rs->rtt_time = 0.01;
+  rs->acked_and_sacked = rs->delivered;
+  rs->lost = lost;
+  tc->delivered += rs->delivered;
+  tcp_cc_rcv_ack (tc, rs);
+}
+
+static int
+tcp_test_bbr_rate_is (tcp_connection_t *tc, f64 gain, f64 bw)
+{
+  f64 rate = tcp_cc_get_pacing_rate (tc);
+  return rate > 0.99 * gain * bw && rate < 1.01 * gain * bw;
+}
+
+static int
+tcp_test_bbr (vlib_main_t *vm, unformat_input_t *input)
+{
+  tcp_rate_sample_t _rs = { 0 }, *rs = &_rs;
+  tcp_connection_t _tc, *tc = &_tc;
+  f64 bw = 1e6, path_bw = 1e7, now = 1;
+  u32 target, prior_cwnd;
+  int i;
+
+  /* 10MB/s path with 10ms rtt, so bdp is 100kB */
+  memset (tc, 0, sizeof (*tc));
+  tc->snd_mss = 1000;
+  tc->tx_fifo_size = 10 << 20;
+  tc->srtt = 10000;
+  tc->mrtt_us = 0.01;
+  tc->cc_algo = tcp_cc_algo_get (TCP_CC_BBR);
+  tcp_set_time_now (&tcp_main.wrk[0], now);
+  tc->cc_algo->init (tc);
+
+  TCP_TEST ((tc->cfg_flags & TCP_CFG_F_RATE_SAMPLE), "rate samples on");
+  TCP_TEST ((tc->cwnd == tcp_initial_cwnd (tc)), "cwnd %u is initial",
+	    tc->cwnd);
+  TCP_TEST ((tcp_test_bbr_rate_is (tc, 2.885, tc->cwnd / 0.01)),
+	    "no bw sample, pacing at high gain cwnd/srtt %lu",
+	    tcp_cc_get_pacing_rate (tc));
+
+  /*
+   * Startup, bw doubles every round until it plateaus at the path bw
+   */
+  for (i = 0; i < 5; i++)
+    {
+      tcp_test_bbr_ack (tc, rs, now += 0.01, bw, 0);
+      TCP_TEST ((tcp_test_bbr_rate_is (tc, 2.885, bw)),
+		"startup round %d pacing %lu at high gain of bw %.0f", i,
+		tcp_cc_get_pacing_rate (tc), bw);
+      bw = clib_min (2 * bw, path_bw);
+    }
+
+  /* Still in startup while the plateau lasts less than 3 rounds */
+  for (i = 0; i < 2; i++)
+    tcp_test_bbr_ack (tc, rs, now += 0.01, bw, 0);
+  TCP_TEST ((tcp_test_bbr_rate_is (tc, 2.885, bw)), "still startup");
+
+  /* Pipe full, drain is immediately done as nothing is in flight */
+  tcp_test_bbr_ack (tc, rs, now += 0.01, bw, 0);
+  TCP_TEST ((tcp_test_bbr_rate_is (tc, 1, bw) ||
+	     tcp_test_bbr_rate_is (tc, 1.25, bw)),
+	    "probe bw pacing %lu", tcp_cc_get_pacing_rate (tc));
+
+  /* cwnd is bound by twice the bdp */
+  target = 2 * 100000 + 3 * tc->snd_mss;
+  tcp_test_bbr_ack (tc, rs, now += 0.001, bw, 0);
+  TCP_TEST ((tc->cwnd == target), "cwnd %u is 2 bdp %u", tc->cwnd, target);
+
+  /*
+   * Probe bw gain cycle. Probing up only ends with losses or inflight at
+   * 1.25 bdp, probing down ends as soon as inflight is bdp
+   */
+  for (i = 0; i < 8; i++)
+    {
+      if (tcp_test_bbr_rate_is (tc, 1.25, bw))
+	break;
+      tcp_test_bbr_ack (tc, rs, now += 0.011, bw, 0);
+    }
+  TCP_TEST ((tcp_test_bbr_rate_is (tc, 1.25, bw)), "probing up");
+  tcp_test_bbr_ack (tc, rs, now += 0.011, bw, 0);
+  TCP_TEST ((tcp_test_bbr_rate_is (tc, 1.25, bw)), "probing up w/o loss");
+  tcp_test_bbr_ack (tc, rs, now += 0.011, bw, 1);
+  TCP_TEST ((tcp_test_bbr_rate_is (tc, 0.75, bw)), "probing down");
+  tcp_test_bbr_ack (tc, rs, now += 0.001, bw, 0);
+  TCP_TEST ((tcp_test_bbr_rate_is (tc, 1, bw)), "cruising");
+
+  /*
+   * Probe rtt once the min rtt is 10s old
+   */
+  tcp_test_bbr_ack (tc, rs, now += 10, bw, 0);
+  TCP_TEST ((tc->cwnd == 4 * tc->snd_mss), "probe rtt cwnd %u", tc->cwnd);
+  tcp_test_bbr_ack (tc, rs, now += 0.1, bw, 0);
+  TCP_TEST ((tc->cwnd == 4 * tc->snd_mss), "probe rtt lasts 200ms");
+  tcp_test_bbr_ack (tc, rs, now += 0.11, bw, 0);
+  TCP_TEST ((tc->cwnd == target), "cwnd %u restored after probe rtt",
+	    tc->cwnd);
+
+  /*
+   * Recovery does not reduce the rate, prr conserves packets
+   */
+  tcp_cc_congestion (tc);
+  TCP_TEST ((tc->ssthresh == 4 * tc->snd_mss), "ssthresh %u is flight",
+	    tc->ssthresh);
+  prior_cwnd = tc->cwnd;
+  tc->cwnd = 10 * tc->snd_mss;
+  tcp_cc_recovered (tc);
+  TCP_TEST ((tc->cwnd == prior_cwnd), "cwnd %u restored after recovery",
+	    tc->cwnd);
+  TCP_TEST ((tc->ssthresh == 0x7FFFFFFF), "ssthresh infinite");
+
+  /* Timeout collapses cwnd but it grows back from bw model */
+  tcp_cc_loss (tc);
+  TCP_TEST ((tc->cwnd == tc->snd_mss), "cwnd %u after rto", tc->cwnd);
+  tcp_test_bbr_ack (tc, rs, now += 0.01, bw, 0);
+  TCP_TEST ((tc->cwnd == tc->snd_mss + 100000), "cwnd %u grows by acked",
+	    tc->cwnd);
+
+  /* Restarting from idle paces at bw */
+  tc->app_limited = tc->delivered;
+  tcp_cc_event (tc, TCP_CC_EVT_START_TX);
+  TCP_TEST ((tcp_test_bbr_rate_is (tc, 1, bw)), "idle restart pacing %lu",
+	    tcp_cc_get_pacing_rate (tc));
+
+  return 0;
+}
+
 static clib_error_t *
 tcp_test (vlib_main_t * vm,
 	  unformat_input_t * input, vlib_cli_command_t * cmd_arg)
@@ -1578,6 +1713,10 @@ tcp_test (vlib_main_t * vm,
 	{
 	  res = tcp_test_bt (vm, input);
 	}
+      else if (unformat (input, "bbr"))
+	{
+	  res = tcp_test_bbr (vm, input);
+	}
       else if (unformat (input, "all"))
 	{
 	  if ((res = tcp_test_sack (vm, input)))
@@ -1586,6 +1725,8 @@ tcp_test (vlib_main_t * vm,
 	    goto done;
 	  if ((res = tcp_test_delivery (vm, input)))
 	    goto done;
+	  if ((res = tcp_test_bbr (vm, input)))
+	    goto done;
 	}
       else
 	break;
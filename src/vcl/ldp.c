@@ -25,8 +25,11 @@
 #include <time.h>
 #include <stdarg.h>
 #include <sys/resource.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
 #include <netinet/tcp.h>
 #include <netinet/udp.h>
+#include <linux/io_uring.h>
 
 #include <vcl/ldp_socket_wrapper.h>
 #include <vcl/ldp.h>
@@ -72,6 +75,32 @@
 #define SO_ORIGINAL_DST 80
 #endif
 
+/*
+ * Ring used to poll the libc epoll fd without syscalls, see use-io-uring
+ */
+typedef struct ldp_uring_
+{
+  int fd;
+  u8 failed;
+  u8 poll_ready;		/**< poll on poll_fd completed */
+  int poll_fd;			/**< libc epoll fd polled, 0 if none */
+  u32 *sq_tail;
+  u32 *sq_mask;
+  u32 *sq_array;
+  u32 *cq_head;
+  u32 *cq_tail;
+  u32 *cq_mask;
+  struct io_uring_sqe *sqes;
+  struct io_uring_cqe *cqes;
+  u8 *sq_ring;
+  u8 *cq_ring;
+  size_t sq_ring_sz;
+  size_t cq_ring_sz;
+  size_t sqes_sz;
+} ldp_uring_t;
+
+#define LDP_URING_N_ENTRIES 8
+
 typedef struct ldp_worker_ctx_
 {
   u8 *io_buffer;
@@ -103,6 +132,7 @@ typedef struct ldp_worker_ctx_
   u8 epoll_wait_vcl;
   u8 mq_epfd_added;
   int vcl_mq_epfd;
+  ldp_uring_t uring;
 } ldp_worker_ctx_t;
 
 __thread ldp_worker_ctx_t _ldp_worker = {};
@@ -155,6 +185,193 @@ ldp_worker_get_current (void)
   return &_ldp_worker;
 }
 
+static void
+ldp_uring_free (ldp_uring_t *r)
+{
+  if (r->sqes)
+    munmap (r->sqes, r->sqes_sz);
+  if (r->cq_ring && r->cq_ring != r->sq_ring)
+    munmap (r->cq_ring, r->cq_ring_sz);
+  if (r->sq_ring)
+    munmap (r->sq_ring, r->sq_ring_sz);
+  if (r->fd > 0)
+    libc_close (r->fd);
+  clib_memset (r, 0, sizeof (*r));
+}
+
+static void *
+ldp_uring_mmap (ldp_uring_t *r, size_t size, off_t offset)
+{
+  void *p;
+
+  p = mmap (0, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, r->fd,
+	    offset);
+  return p == MAP_FAILED ? 0 : p;
+}
+
+static int
+ldp_uring_init (ldp_uring_t *r)
+{
+  struct io_uring_params p = {};
+
+  r->fd = syscall (__NR_io_uring_setup, LDP_URING_N_ENTRIES, &p);
+  if (r->fd < 0)
+    {
+      LDBG (0, "io_uring_setup failed: %s", strerror (errno));
+      r->fd = 0;
+      goto error;
+    }
+
+  r->sq_ring_sz = p.sq_off.array + p.sq_entries * sizeof (u32);
+  r->cq_ring_sz = p.cq_off.cqes + p.cq_entries * sizeof (struct io_uring_cqe);
+  if (p.features & IORING_FEAT_SINGLE_MMAP)
+    r->sq_ring_sz = r->cq_ring_sz = clib_max (r->sq_ring_sz, r->cq_ring_sz);
+
+  if (!(r->sq_ring = ldp_uring_mmap (r, r->sq_ring_sz, IORING_OFF_SQ_RING)))
+    goto error;
+  if (p.features & IORING_FEAT_SINGLE_MMAP)
+    r->cq_ring = r->sq_ring;
+  else if (!(r->cq_ring =
+	       ldp_uring_mmap (r, r->cq_ring_sz, IORING_OFF_CQ_RING)))
+    goto error;
+  r->sqes_sz = p.sq_entries * sizeof (struct io_uring_sqe);
+  if (!(r->sqes = ldp_uring_mmap (r, r->sqes_sz, IORING_OFF_SQES)))
+    goto error;
+
+  r->sq_tail = (u32 *) (r->sq_ring + p.sq_off.tail);
+  r->sq_mask = (u32 *) (r->sq_ring + p.sq_off.ring_mask);
+  r->sq_array = (u32 *) (r->sq_ring + p.sq_off.array);
+  r->cq_head = (u32 *) (r->cq_ring + p.cq_off.head);
+  r->cq_tail = (u32 *) (r->cq_ring + p.cq_off.tail);
+  r->cq_mask = (u32 *) (r->cq_ring + p.cq_off.ring_mask);
+  r->cqes = (struct io_uring_cqe *) (r->cq_ring + p.cq_off.cqes);
+
+  return 0;
+
+error:
+  ldp_uring_free (r);
+  r->failed = 1;
+  return -1;
+}
+
+static struct io_uring_sqe *
+ldp_uring_get_sqe (ldp_uring_t *r, u32 *tail)
+{
+  struct io_uring_sqe *sqe;
+  u32 idx = *tail & *r->sq_mask;
+
+  sqe = &r->sqes[idx];
+  clib_memset (sqe, 0, sizeof (*sqe));
+  r->sq_array[idx] = idx;
+  *tail += 1;
+  return sqe;
+}
+
+/**
+ * Poll libc epoll fd through the ring, replacing a poll on another fd if
+ * any. Completion is observed by ldp_uring_poll_ready without syscalls.
+ */
+static int
+ldp_uring_poll_arm (ldp_uring_t *r, int fd)
+{
+  struct io_uring_sqe *sqe;
+  u32 tail, n_sqes;
+  int rv;
+
+  if (r->poll_fd == fd)
+    return 0;
+
+  if (PREDICT_FALSE (!r->fd))
+    {
+      if (r->failed || ldp_uring_init (r))
+	return -1;
+    }
+
+  tail = *r->sq_tail;
+  if (r->poll_fd)
+    {
+      sqe = ldp_uring_get_sqe (r, &tail);
+      sqe->opcode = IORING_OP_POLL_REMOVE;
+      sqe->addr = r->poll_fd;
+    }
+  sqe = ldp_uring_get_sqe (r, &tail);
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = fd;
+  sqe->poll32_events = POLLIN;
+  sqe->user_data = fd;
+
+  n_sqes = tail - *r->sq_tail;
+  __atomic_store_n (r->sq_tail, tail, __ATOMIC_RELEASE);
+  rv = syscall (__NR_io_uring_enter, r->fd, n_sqes, 0, 0, NULL, 0);
+  if (rv < 0)
+    {
+      LDBG (0, "io_uring_enter failed: %s", strerror (errno));
+      return -1;
+    }
+
+  r->poll_fd = fd;
+  r->poll_ready = 0;
+  return 0;
+}
+
+static void
+ldp_uring_poll_remove (ldp_uring_t *r, int fd)
+{
+  struct io_uring_sqe *sqe;
+  u32 tail;
+
+  if (r->poll_fd != fd)
+    return;
+
+  tail = *r->sq_tail;
+  sqe = ldp_uring_get_sqe (r, &tail);
+  sqe->opcode = IORING_OP_POLL_REMOVE;
+  sqe->addr = fd;
+  __atomic_store_n (r->sq_tail, tail, __ATOMIC_RELEASE);
+  syscall (__NR_io_uring_enter, r->fd, 1, 0, 0, NULL, 0);
+  r->poll_fd = 0;
+}
+
+/**
+ * Consume all completions and report if libc epoll fd is readable. Polls
+ * are one-shot, so fd must be re-armed after it is reported ready.
+ */
+static inline int
+ldp_uring_poll_ready (ldp_uring_t *r)
+{
+  struct io_uring_cqe *cqe;
+  u32 head, tail;
+
+  head = *r->cq_head;
+  tail = __atomic_load_n (r->cq_tail, __ATOMIC_ACQUIRE);
+  if (head == tail)
+    return 0;
+
+  for (; head != tail; head++)
+    {
+      cqe = &r->cqes[head & *r->cq_mask];
+      /* Removed polls complete with an error, removals with user_data 0 */
+      if (cqe->res >= 0 && cqe->user_data && cqe->user_data == r->poll_fd)
+	{
+	  r->poll_ready = 1;
+	  r->poll_fd = 0;
+	}
+    }
+  __atomic_store_n (r->cq_head, head, __ATOMIC_RELEASE);
+
+  return r->poll_ready;
+}
+
+static void
+ldp_uring_fork_child (void)
+{
+  ldp_worker_ctx_t *ldpw = ldp_worker_get_current ();
+
+  /* Child must not consume completions of parent's ring */
+  if (ldpw->uring.fd)
+    ldp_uring_free (&ldpw->uring);
+}
+
 /*
  * RETURN:  0 on success or -1 on error.
  * */
@@ -330,6 +547,8 @@ close (int fd)
 
 	  LDBG (0, "fd %d: calling libc_close: epfd %u", fd, epfd);
 
+	  if (ldpw->uring.fd)
+	    ldp_uring_poll_remove (&ldpw->uring, epfd);
 	  libc_close (epfd);
 	  ldpw->mq_epfd_added = 0;
 
@@ -2502,7 +2721,7 @@ ldp_epoll_pwait (int epfd, struct epoll_event *events, int maxevents,
 {
   ldp_worker_ctx_t *ldpw;
   double time_to_wait = (double) 0, max_time;
-  int libc_epfd, rv = 0;
+  int libc_epfd, rv = 0, use_uring = 0;
   vls_handle_t ep_vlsh;
 
   ldp_init_check ();
@@ -2541,6 +2760,12 @@ ldp_epoll_pwait (int epfd, struct epoll_event *events, int maxevents,
   LDBG (2, "epfd %d: vep_idx %d, libc_epfd %d, events %p, maxevents %d, "
 	"timeout %d, sigmask %p: time_to_wait %.02f", epfd, ep_vlsh,
 	libc_epfd, events, maxevents, timeout, sigmask, time_to_wait);
+
+  /* Spin on the ring's completion queue instead of calling epoll_pwait for
+   * libc fds every iteration. Fall back to the latter if the ring fails */
+  if (libc_epfd > 0 && vls_use_io_uring ())
+    use_uring = !ldp_uring_poll_arm (&ldpw->uring, libc_epfd);
+
   do
     {
       if (!ldpw->epoll_wait_vcl)
@@ -2561,11 +2786,14 @@ ldp_epoll_pwait (int epfd, struct epoll_event *events, int maxevents,
       else
 	ldpw->epoll_wait_vcl = 0;
 
-      if (libc_epfd > 0)
+      if (libc_epfd > 0
+	  && (!use_uring || ldp_uring_poll_ready (&ldpw->uring)))
 	{
 	  rv = libc_epoll_pwait (libc_epfd, events, maxevents, 0, sigmask);
 	  if (rv != 0)
 	    goto done;
+	  if (use_uring)
+	    use_uring = !ldp_uring_poll_arm (&ldpw->uring, libc_epfd);
 	}
     }
   while ((timeout == -1) || (clib_time_now (&ldpw->clib_time) < max_time));
@@ -2860,6 +3088,7 @@ void
 ldp_constructor (void)
 {
   swrap_constructor ();
+  pthread_atfork (NULL, NULL, ldp_uring_fork_child);
   if (ldp_init () != 0)
     {
       fprintf (stderr, "\nLDP<%d>: ERROR: ldp_constructor: failed!\n",
@@ -452,6 +452,12 @@ vppcom_cfg_read_file (char *conf_fname)
 	      VCFG_DBG (0, "VCL<%d>: configured with mq with eventfd",
 			getpid ());
 	    }
+	  else if (unformat (line_input, "use-io-uring"))
+	    {
+	      vcl_cfg->use_io_uring = 1;
+	      VCFG_DBG (0, "VCL<%d>: configured ldp epoll with io_uring",
+			getpid ());
+	    }
 	  else if (unformat (line_input, "tls-engine %u",
 			     &vcl_cfg->tls_engine))
 	    {
@@ -609,6 +615,13 @@ vppcom_cfg (vppcom_cfg_t * vcl_cfg)
       VCFG_DBG (0, "VCL<%d>: configured " VPPCOM_ENV_APP_USE_MQ_EVENTFD,
 		getpid ());
     }
+  env_var_str = getenv (VPPCOM_ENV_APP_USE_IO_URING);
+  if (env_var_str)
+    {
+      vcm->cfg.use_io_uring = 1;
+      VCFG_DBG (0, "VCL<%d>: configured " VPPCOM_ENV_APP_USE_IO_URING,
+		getpid ());
+    }
 }
 
 /*
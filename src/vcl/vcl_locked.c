@@ -2301,6 +2301,12 @@ vls_use_eventfd (void)
   return vcm->cfg.use_mq_eventfd;
 }
 
+unsigned char
+vls_use_io_uring (void)
+{
+  return vcm->cfg.use_io_uring;
+}
+
 unsigned char
 vls_mt_wrk_supported (void)
 {
@@ -63,6 +63,7 @@ void vlsh_to_session_and_worker_index (vls_handle_t vlsh,
 vls_handle_t vls_session_index_to_vlsh (uint32_t session_index);
 int vls_app_create (char *app_name);
 unsigned char vls_use_eventfd (void);
+unsigned char vls_use_io_uring (void);
 unsigned char vls_mt_wrk_supported (void);
 int vls_set_libc_epfd (vls_handle_t ep_vlsh, int libc_epfd);
 int vls_get_libc_epfd (vls_handle_t ep_vlsh);
@@ -220,6 +220,7 @@ typedef struct vppcom_cfg_t_
   u8 mt_wrk_supported;
   u8 huge_page;
   u8 app_original_dst;
+  u8 use_io_uring;
 } vppcom_cfg_t;
 
 void vppcom_cfg (vppcom_cfg_t * vcl_cfg);
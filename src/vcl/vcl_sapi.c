@@ -122,6 +122,7 @@ vcl_api_send_attach (clib_socket_t * cs)
   clib_memcpy (&mp->name, vcm->app_name, vec_len (vcm->app_name));
   mp->options[APP_OPTIONS_FLAGS] =
     APP_OPTIONS_FLAGS_ACCEPT_REDIRECT | APP_OPTIONS_FLAGS_ADD_SEGMENT |
+    APP_OPTIONS_FLAGS_EVT_MQ_VEC_EVTS |
     (vcm->cfg.app_scope_local ? APP_OPTIONS_FLAGS_USE_LOCAL_SCOPE : 0) |
     (vcm->cfg.app_scope_global ? APP_OPTIONS_FLAGS_USE_GLOBAL_SCOPE : 0) |
     (app_is_proxy ? APP_OPTIONS_FLAGS_IS_PROXY : 0) |
@@ -1026,18 +1026,46 @@ vcl_session_transport_attr_reply_handler (vcl_worker_t *wrk, void *data)
   wrk->session_attr_rv = mp->attr;
 }
 
+/**
+ * Build plain io event out of the i-th element of a vectored io event
+ */
+static inline void
+vcl_io_evt_vec_elt (session_event_t *vec_evt, u32 i, session_event_t *e)
+{
+  session_io_evt_vec_t *ev = (session_io_evt_vec_t *) vec_evt->data;
+
+  e->event_type = ev->evt_types[i];
+  e->postponed = 0;
+  e->as_u64[0] = 0;
+  e->as_u64[1] = 0;
+  e->session_index = ev->session_indices[i];
+}
+
+static inline u32
+vcl_io_evt_vec_len (session_event_t *vec_evt)
+{
+  return ((session_io_evt_vec_t *) vec_evt->data)->n_evts;
+}
+
 static int
 vcl_handle_mq_event (vcl_worker_t * wrk, session_event_t * e)
 {
   session_disconnected_msg_t *disconnected_msg;
   session_connected_msg_t *connected_msg;
   session_reset_msg_t *reset_msg;
-  session_event_t *ecpy;
+  session_event_t *ecpy, io_evt;
   vcl_session_t *s;
-  u32 sid;
+  u32 sid, i;
 
   switch (e->event_type)
     {
+    case SESSION_IO_EVT_VEC:
+      for (i = 0; i < vcl_io_evt_vec_len (e); i++)
+	{
+	  vcl_io_evt_vec_elt (e, i, &io_evt);
+	  vcl_handle_mq_event (wrk, &io_evt);
+	}
+      break;
     case SESSION_IO_EVT_RX:
     case SESSION_IO_EVT_TX:
       s = vcl_session_get (wrk, e->session_index);
@@ -2572,11 +2600,20 @@ vcl_select_handle_mq_event (vcl_worker_t * wrk, session_event_t * e,
 {
   session_disconnected_msg_t *disconnected_msg;
   session_connected_msg_t *connected_msg;
+  session_event_t io_evt;
   vcl_session_t *s;
-  u32 sid;
+  u32 sid, i;
 
   switch (e->event_type)
     {
+    case SESSION_IO_EVT_VEC:
+      for (i = 0; i < vcl_io_evt_vec_len (e); i++)
+	{
+	  vcl_io_evt_vec_elt (e, i, &io_evt);
+	  vcl_select_handle_mq_event (wrk, &io_evt, n_bits, read_map,
+				      write_map, except_map, bits_set);
+	}
+      break;
     case SESSION_IO_EVT_RX:
       sid = e->session_index;
       s = vcl_session_get (wrk, sid);
@@ -3526,9 +3563,9 @@ vcl_epoll_wait_handle_mq (vcl_worker_t * wrk, svm_msg_q_t * mq,
 			  struct epoll_event *events, u32 maxevents,
 			  double wait_for_time, u32 * num_ev)
 {
+  session_event_t *e, io_evt;
   svm_msg_q_msg_t *msg;
-  session_event_t *e;
-  int i;
+  int i, j;
 
   if (vec_len (wrk->mq_msg_vector) && svm_msg_q_is_empty (mq))
     goto handle_dequeued;
@@ -3553,7 +3590,18 @@ handle_dequeued:
     {
       msg = vec_elt_at_index (wrk->mq_msg_vector, i);
       e = svm_msg_q_msg_data (mq, msg);
-      if (*num_ev < maxevents)
+      if (e->event_type == SESSION_IO_EVT_VEC)
+	{
+	  for (j = 0; j < vcl_io_evt_vec_len (e); j++)
+	    {
+	      vcl_io_evt_vec_elt (e, j, &io_evt);
+	      if (*num_ev < maxevents)
+		vcl_epoll_wait_handle_mq_event (wrk, &io_evt, events, num_ev);
+	      else
+		vcl_handle_mq_event (wrk, &io_evt);
+	    }
+	}
+      else if (*num_ev < maxevents)
 	vcl_epoll_wait_handle_mq_event (wrk, e, events, num_ev);
       else
 	vcl_handle_mq_event (wrk, e);
@@ -119,6 +119,7 @@ vlib_stats_init (vlib_main_t *vm)
     shared_header->directory_vector = sm->directory_vector;
 
   vlib_stats_register_mem_heap (heap);
+  vlib_stats_register_bihash ();
 
   reg.collect_fn = vector_rate_collector_fn;
   reg.private_data = vlib_stats_add_gauge ("/sys/vector_rate");
@@ -0,0 +1,69 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#include <vlib/vlib.h>
+#include <vlib/stats/stats.h>
+#include <vppinfra/bihash_8_8.h>
+#include <vppinfra/bihash_template.h>
+
+static vlib_stats_string_vector_t bihash_names;
+static void **bihash_tables;
+
+/*
+ * Called from the stats periodic process to snapshot the probe depth
+ * histograms of all tables on clib_all_bihashes. Row i of
+ * /bihash/probe-depth belongs to table /bihash/names[i].
+ */
+static void
+stat_provider_bihash_update_fn (vlib_stats_collector_data_t *d)
+{
+  u32 i, n_tables = vec_len (clib_all_bihashes);
+  clib_bihash_8_8_t *h;
+  counter_t **counters;
+
+  if (n_tables == 0)
+    return;
+
+  vlib_stats_validate (d->entry_index, n_tables - 1,
+		       BIHASH_PROBE_DEPTH_N_BINS - 1);
+  counters = vlib_stats_get_entry_data_pointer (d->entry_index);
+
+  /* Tables went away, so did their rows */
+  for (i = n_tables; i < vec_len (bihash_tables); i++)
+    {
+      clib_memset (counters[i], 0,
+		   BIHASH_PROBE_DEPTH_N_BINS * sizeof (counter_t));
+      vlib_stats_set_string_vector (&bihash_names, i, "");
+    }
+  vec_validate (bihash_tables, n_tables - 1);
+  vec_set_len (bihash_tables, n_tables);
+
+  for (i = 0; i < n_tables; i++)
+    {
+      /* Header layout is the same for all types, as in "show bihash" */
+      h = clib_all_bihashes[i];
+
+      if (bihash_tables[i] != h)
+	{
+	  bihash_tables[i] = h;
+	  vlib_stats_set_string_vector (&bihash_names, i, "%s",
+					h->name ? (char *) h->name :
+						  "(unnamed)");
+	}
+
+      clib_memcpy_fast (counters[i], h->probe_depth_histogram,
+			sizeof (h->probe_depth_histogram));
+    }
+}
+
+void
+vlib_stats_register_bihash (void)
+{
+  vlib_stats_collector_reg_t r = {};
+
+  bihash_names = vlib_stats_add_string_vector ("/bihash/names");
+  r.entry_index = vlib_stats_add_counter_vector ("/bihash/probe-depth");
+  r.collect_fn = stat_provider_bihash_update_fn;
+  vlib_stats_register_collector_fn (&r);
+}
@@ -65,15 +65,15 @@
   _ (16, IS_DVR, "dvr", 1)                                                    \
   _ (17, QOS_DATA_VALID, "qos-data-valid", 0)                                 \
   _ (18, GSO, "gso", 0)                                                       \
-  _ (19, AVAIL1, "avail1", 1)                                                 \
-  _ (20, AVAIL2, "avail2", 1)                                                 \
-  _ (21, AVAIL3, "avail3", 1)                                                 \
-  _ (22, AVAIL4, "avail4", 1)                                                 \
-  _ (23, AVAIL5, "avail5", 1)                                                 \
-  _ (24, AVAIL6, "avail6", 1)                                                 \
-  _ (25, AVAIL7, "avail7", 1)                                                 \
-  _ (26, AVAIL8, "avail8", 1)                                                 \
-  _ (27, AVAIL9, "avail9", 1)
+  _ (19, LATENCY_VALID, "latency-valid", 0)                                  \
+  _ (20, AVAIL1, "avail1", 1)                                                 \
+  _ (21, AVAIL2, "avail2", 1)                                                 \
+  _ (22, AVAIL3, "avail3", 1)                                                 \
+  _ (23, AVAIL4, "avail4", 1)                                                 \
+  _ (24, AVAIL5, "avail5", 1)                                                 \
+  _ (25, AVAIL6, "avail6", 1)                                                 \
+  _ (26, AVAIL7, "avail7", 1)                                                 \
+  _ (27, AVAIL8, "avail8", 1)
 
 /*
  * Please allocate the FIRST available bit, redefine
@@ -84,7 +84,7 @@
 #define VNET_BUFFER_FLAGS_ALL_AVAIL                                           \
   (VNET_BUFFER_F_AVAIL1 | VNET_BUFFER_F_AVAIL2 | VNET_BUFFER_F_AVAIL3 |       \
    VNET_BUFFER_F_AVAIL4 | VNET_BUFFER_F_AVAIL5 | VNET_BUFFER_F_AVAIL6 |       \
-   VNET_BUFFER_F_AVAIL7 | VNET_BUFFER_F_AVAIL8 | VNET_BUFFER_F_AVAIL9)
+   VNET_BUFFER_F_AVAIL7 | VNET_BUFFER_F_AVAIL8)
 
 #define VNET_BUFFER_FLAGS_VLAN_BITS \
   (VNET_BUFFER_F_VLAN_1_DEEP | VNET_BUFFER_F_VLAN_2_DEEP)
@@ -474,7 +474,11 @@ typedef struct
   } qos;
 
   u8 loop_counter;
-  u8 pad[5]; /* unused */
+  u8 pad[1]; /* unused */
+
+  /* Thread which set latency_rx_time */
+  clib_thread_index_t latency_rx_thread_index;
+  u8 pad2[2]; /* unused */
 
   /**
    * The L4 payload size set on input on GSO enabled interfaces
@@ -517,7 +521,13 @@ typedef struct
     } reass;
   } ip;
 
-  u32 unused[5];
+  /**
+   * Receive timestamp, the low 32 bits of the cpu clock, set by the
+   * latency-rx feature. Valid if VNET_BUFFER_F_LATENCY_VALID is set.
+   */
+  u32 latency_rx_time;
+
+  u32 unused[4];
 } vnet_buffer_opaque2_t;
 
 #define vnet_buffer2(b) ((vnet_buffer_opaque2_t *) (b)->opaque2)
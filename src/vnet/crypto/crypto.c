@@ -134,6 +134,8 @@ vnet_crypto_register_engine (vlib_main_t * vm, char *name, int prio,
   return p - cm->engines;
 }
 
+static void vnet_crypto_update_cm_dequeue_handlers (void);
+
 static_always_inline void
 crypto_set_active_engine (vnet_crypto_op_data_t *od, vnet_crypto_op_id_t id,
 			  u32 ei, vnet_crypto_handler_type_t t)
@@ -185,6 +187,11 @@ vnet_crypto_set_handlers (vnet_crypto_set_handlers_args_t *a)
 				  VNET_CRYPTO_HANDLER_TYPE_CHAINED);
     }
 
+  /* dequeue handlers of engines which are no longer active for any op
+   * are not called anymore, newly selected ones are */
+  if (a->set_async)
+    vnet_crypto_update_cm_dequeue_handlers ();
+
   return 0;
 }
 
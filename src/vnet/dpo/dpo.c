@@ -446,7 +446,7 @@ dpo_get_next_node (dpo_type_t child_type,
         cc = 0;
         parent_indices = dpo_vfts[parent_type].dv_get_next_node(parent_dpo);
 
-        vlib_worker_thread_barrier_sync(vm);
+        fib_barrier_sync(vm);
 
         /*
          * create a graph arc from each of the child's registered node types,
@@ -474,7 +474,7 @@ dpo_get_next_node (dpo_type_t child_type,
             cc++;
         }
 
-        vlib_worker_thread_barrier_release(vm);
+        fib_barrier_release(vm);
         vec_free(parent_indices);
     }
 
@@ -577,11 +577,11 @@ dpo_stack_from_node (u32 child_node_index,
 
         if (~0 == edge)
         {
-            vlib_worker_thread_barrier_sync(vm);
+            fib_barrier_sync(vm);
 
             edge = vlib_node_add_next(vm, child_node_index, *pi);
 
-            vlib_worker_thread_barrier_release(vm);
+            fib_barrier_release(vm);
         }
     }
     dpo_stack_i(edge, dpo, parent);
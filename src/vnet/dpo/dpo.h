@@ -30,6 +30,7 @@
 #define __DPO_H__
 
 #include <vnet/vnet.h>
+#include <vnet/fib/fib_epoch.h>
 
 /**
  * @brief An index for adjacencies.
@@ -549,7 +550,7 @@ do {                                                                    \
     {                                                                   \
         VM = vlib_get_main();                                           \
         ASSERT ((VM)->thread_index == 0);                               \
-        vlib_worker_thread_barrier_sync((VM));                          \
+        fib_barrier_sync((VM));                                         \
     }                                                                   \
 } while(0);
 
@@ -566,7 +567,7 @@ do {                                                                    \
  */
 
 #define dpo_pool_barrier_release(VM,YESNO) \
-    if ((YESNO)) vlib_worker_thread_barrier_release((VM));
+    if ((YESNO)) fib_barrier_release((VM));
 
 #endif
 
@@ -20,6 +20,7 @@
 #include <vnet/adj/adj.h>
 #include <vnet/adj/adj_internal.h>
 #include <vnet/fib/fib_urpf_list.h>
+#include <vnet/fib/fib_epoch.h>
 #include <vnet/bier/bier_fwd.h>
 #include <vnet/fib/mpls_fib.h>
 #include <vnet/ip/ip4_inlines.h>
@@ -103,7 +104,7 @@ load_balance_alloc_i (void)
     need_barrier_sync = pool_get_will_expand (load_balance_pool);
 
     if (need_barrier_sync)
-        vlib_worker_thread_barrier_sync (vm);
+        fib_barrier_sync (vm);
 
     pool_get_aligned(load_balance_pool, lb, CLIB_CACHE_LINE_BYTES);
     clib_memset(lb, 0, sizeof(*lb));
@@ -120,7 +121,7 @@ load_balance_alloc_i (void)
             (&(load_balance_main.lbm_via_counters),
              load_balance_get_index(lb));
         if (need_barrier_sync)
-            vlib_worker_thread_barrier_sync (vm);
+            fib_barrier_sync (vm);
     }
 
     vlib_validate_combined_counter(&(load_balance_main.lbm_to_counters),
@@ -133,7 +134,7 @@ load_balance_alloc_i (void)
                                load_balance_get_index(lb));
 
     if (need_barrier_sync)
-        vlib_worker_thread_barrier_release (vm);
+        fib_barrier_release (vm);
 
     return (lb);
 }
@@ -646,16 +647,64 @@ load_balance_set_n_buckets (load_balance_t *lb,
     lb->lb_n_buckets_minus_1 = n_buckets-1;
 }
 
+static void
+load_balance_buckets_reclaim (uword data)
+{
+    dpo_id_t *buckets, *tmp_dpo;
+
+    buckets = uword_to_pointer(data, dpo_id_t *);
+
+    vec_foreach(tmp_dpo, buckets)
+    {
+        dpo_reset(tmp_dpo);
+    }
+    vec_free(buckets);
+}
+
+/**
+ * Retire a vector of buckets the workers may still be reading. The DPOs
+ * are released once no worker can see them.
+ */
+static void
+load_balance_buckets_retire (dpo_id_t *buckets)
+{
+    fib_epoch_retire(load_balance_buckets_reclaim,
+                     pointer_to_uword(buckets));
+}
+
+/**
+ * Retire a copy of buckets no longer in use, and invalidate them.
+ */
+static void
+load_balance_buckets_retire_copy (dpo_id_t *buckets,
+                                  u32 n_buckets)
+{
+    dpo_id_t tmp = DPO_INVALID, *copy = NULL;
+    u32 ii;
+
+    vec_add(copy, buckets, n_buckets);
+    for (ii = 0; ii < n_buckets; ii++)
+    {
+        buckets[ii].as_u64 = tmp.as_u64;
+    }
+    load_balance_buckets_retire(copy);
+}
+
+static void
+load_balance_map_reclaim (uword lbmi)
+{
+    load_balance_map_unlock(lbmi);
+}
+
 void
 load_balance_multipath_update (const dpo_id_t *dpo,
                                const load_balance_path_t * raw_nhs,
                                load_balance_flags_t flags)
 {
     load_balance_path_t *nh, *nhs, *fixed_nhs;
-    u32 sum_of_weights, n_buckets, ii;
+    u32 sum_of_weights, n_buckets;
     index_t lbmi, old_lbmi;
     load_balance_t *lb;
-    dpo_id_t *tmp_dpo;
 
     nhs = NULL;
 
@@ -751,10 +800,8 @@ load_balance_multipath_update (const dpo_id_t *dpo,
 
                 CLIB_MEMORY_BARRIER();
 
-                for (ii = 0; ii < LB_NUM_INLINE_BUCKETS; ii++)
-                {
-                    dpo_reset(&lb->lb_buckets_inline[ii]);
-                }
+                load_balance_buckets_retire_copy(lb->lb_buckets_inline,
+                                                 LB_NUM_INLINE_BUCKETS);
             }
             else
             {
@@ -776,7 +823,7 @@ load_balance_multipath_update (const dpo_id_t *dpo,
                      * we are not crossing the threshold. We need a new bucket array to
                      * hold the increased number of choices.
                      */
-                    dpo_id_t *new_buckets, *old_buckets, *tmp_dpo;
+                    dpo_id_t *new_buckets, *old_buckets;
 
                     new_buckets = NULL;
                     old_buckets = load_balance_get_buckets(lb);
@@ -792,11 +839,7 @@ load_balance_multipath_update (const dpo_id_t *dpo,
                     CLIB_MEMORY_BARRIER();
                     load_balance_set_n_buckets(lb, n_buckets);
 
-                    vec_foreach(tmp_dpo, old_buckets)
-                    {
-                        dpo_reset(tmp_dpo);
-                    }
-                    vec_free(old_buckets);
+                    load_balance_buckets_retire(old_buckets);
                 }
             }
 
@@ -835,11 +878,8 @@ load_balance_multipath_update (const dpo_id_t *dpo,
                 load_balance_set_n_buckets(lb, n_buckets);
                 CLIB_MEMORY_BARRIER();
 
-                vec_foreach(tmp_dpo, lb->lb_buckets)
-                {
-                    dpo_reset(tmp_dpo);
-                }
-                vec_free(lb->lb_buckets);
+                load_balance_buckets_retire(lb->lb_buckets);
+                lb->lb_buckets = NULL;
             }
             else
             {
@@ -861,10 +901,12 @@ load_balance_multipath_update (const dpo_id_t *dpo,
                 load_balance_fill_buckets(lb, nhs, buckets,
                                           n_buckets, flags);
 
-                for (ii = n_buckets; ii < old_n_buckets; ii++)
-                {
-                    dpo_reset(&buckets[ii]);
-                }
+                /*
+                 * a worker that read the old number may still use
+                 * the buckets beyond the new one
+                 */
+                load_balance_buckets_retire_copy(buckets + n_buckets,
+                                                 old_n_buckets - n_buckets);
             }
         }
     }
@@ -876,7 +918,10 @@ load_balance_multipath_update (const dpo_id_t *dpo,
     vec_free(nhs);
     vec_free(fixed_nhs);
 
-    load_balance_map_unlock(old_lbmi);
+    if (INDEX_INVALID != old_lbmi)
+    {
+        fib_epoch_retire(load_balance_map_reclaim, old_lbmi);
+    }
 }
 
 static void
@@ -890,11 +935,13 @@ load_balance_lock (dpo_id_t *dpo)
 }
 
 static void
-load_balance_destroy (load_balance_t *lb)
+load_balance_reclaim (uword lbi)
 {
+    load_balance_t *lb;
     dpo_id_t *buckets;
     int i;
 
+    lb = load_balance_get(lbi);
     buckets = load_balance_get_buckets(lb);
 
     for (i = 0; i < lb->lb_n_buckets; i++)
@@ -914,6 +961,15 @@ load_balance_destroy (load_balance_t *lb)
     pool_put(load_balance_pool, lb);
 }
 
+static void
+load_balance_destroy (load_balance_t *lb)
+{
+    /*
+     * the workers may still be forwarding through it
+     */
+    fib_epoch_retire(load_balance_reclaim, load_balance_get_index(lb));
+}
+
 static void
 load_balance_unlock (dpo_id_t *dpo)
 {
@@ -1045,6 +1101,46 @@ load_balance_pool_alloc (uword size)
   pool_alloc_aligned(load_balance_pool, size, CLIB_CACHE_LINE_BYTES);
 }
 
+void
+load_balance_pool_reserve (uword n_lbs)
+{
+    vlib_main_t *vm = vlib_get_main();
+    uword n_free, n_grow, max;
+
+    if (0 == n_lbs)
+        return;
+
+    /*
+     * grow by at least the current size, so reservations made a batch at
+     * a time keep the cost of the pool's geometric growth
+     */
+    n_free = pool_free_elts(load_balance_pool);
+    n_grow = (n_free < n_lbs ?
+              clib_max(n_lbs - n_free, pool_len(load_balance_pool)) :
+              0);
+    max = pool_max_len(load_balance_pool) + n_grow;
+
+    if (0 == n_grow &&
+        !vlib_validate_combined_counter_will_expand(
+            &load_balance_main.lbm_to_counters, max - 1) &&
+        !vlib_validate_combined_counter_will_expand(
+            &load_balance_main.lbm_via_counters, max - 1))
+        return;
+
+    fib_barrier_sync(vm);
+
+    if (n_grow)
+        pool_alloc_aligned(load_balance_pool, n_grow, CLIB_CACHE_LINE_BYTES);
+
+    max = pool_max_len(load_balance_pool);
+    vlib_validate_combined_counter(&load_balance_main.lbm_to_counters,
+                                   max - 1);
+    vlib_validate_combined_counter(&load_balance_main.lbm_via_counters,
+                                   max - 1);
+
+    fib_barrier_release(vm);
+}
+
 static clib_error_t *
 load_balance_show (vlib_main_t * vm,
                    unformat_input_t * input,
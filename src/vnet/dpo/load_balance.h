@@ -262,4 +262,10 @@ load_balance_get_bucket_i (const load_balance_t *lb,
 extern void load_balance_module_init(void);
 extern void load_balance_pool_alloc (uword size);
 
+/**
+ * @brief Ensure the next n_lbs load-balances are allocated without
+ * expanding the pool or the counters, i.e. without the worker barrier.
+ */
+extern void load_balance_pool_reserve (uword n_lbs);
+
 #endif
@@ -494,6 +494,65 @@ fib_api_route_add_del (u8 is_add,
     return (0);
 }
 
+int
+fib_api_route_add_del_bulk (u8 is_add,
+                            u8 is_multipath,
+                            u32 fib_index,
+                            const fib_prefix_t *prefixes,
+                            fib_source_t src,
+                            fib_entry_flag_t entry_flags,
+                            const fib_route_path_t *rpaths)
+{
+    const fib_prefix_t *prefix;
+    fib_route_path_t *paths;
+
+    /*
+     * all or nothing
+     */
+    vec_foreach(prefix, prefixes)
+    {
+        if (!fib_prefix_validate(prefix))
+            return (VNET_API_ERROR_INVALID_PREFIX_LENGTH);
+    }
+    if ((is_multipath || is_add) && 0 == vec_len(rpaths))
+        return (VNET_API_ERROR_NO_PATHS_IN_ROUTE);
+
+    if (!is_multipath)
+    {
+        if (is_add)
+            fib_table_entry_bulk_update(fib_index, prefixes, src,
+                                        entry_flags, rpaths);
+        else
+            fib_table_entry_bulk_delete(fib_index, prefixes, src);
+
+        return (0);
+    }
+
+    /*
+     * Iterative path add/remove; each route is given a copy of the paths
+     * since they are fixed up for its prefix.
+     */
+    paths = NULL;
+    fib_table_batch_begin(is_add ? vec_len(prefixes) : 0);
+
+    vec_foreach(prefix, prefixes)
+    {
+        vec_reset_length(paths);
+        vec_append(paths, rpaths);
+
+        if (is_add)
+            fib_table_entry_path_add2(fib_index, prefix, src,
+                                      entry_flags, paths);
+        else
+            fib_table_entry_path_remove2(fib_index, prefix, src, paths);
+    }
+
+    fib_table_batch_end();
+    vec_free(paths);
+
+    return (0);
+}
+
 u8 *
 format_vl_api_address_union (u8 * s, va_list * args)
 {
@@ -51,6 +51,17 @@ extern int fib_api_route_add_del (u8 is_add,
                                   fib_entry_flag_t entry_flags,
                                   fib_route_path_t *rpaths);
 
+/**
+ * Adding a batch of routes, with the same paths, from the API
+ */
+extern int fib_api_route_add_del_bulk (u8 is_add,
+                                       u8 is_multipath,
+                                       u32 fib_index,
+                                       const fib_prefix_t *prefixes,
+                                       fib_source_t src,
+                                       fib_entry_flag_t entry_flags,
+                                       const fib_route_path_t *rpaths);
+
 extern u8 *format_vl_api_address_union (u8 * s, va_list * args);
 extern u8* format_vl_api_fib_path(u8 * s, va_list * args);
 
@@ -30,6 +30,7 @@
 #include <vnet/fib/fib_path_ext.h>
 #include <vnet/fib/fib_entry_delegate.h>
 #include <vnet/fib/fib_entry_track.h>
+#include <vnet/fib/fib_epoch.h>
 
 /*
  * Array of strings/names for the FIB sources
@@ -530,6 +531,52 @@ fib_entry_child_remove (fib_node_index_t fib_entry_index,
     }
 }
 
+/**
+ * The entries updated during a batch, whose children are yet to be walked
+ */
+typedef struct fib_entry_batch_t_
+{
+    int feb_active;
+    fib_node_index_t *feb_walks;
+    uword *feb_walked;
+} fib_entry_batch_t;
+
+static fib_entry_batch_t fib_entry_batch;
+
+void
+fib_entry_batch_begin (void)
+{
+    fib_entry_batch.feb_active = 1;
+}
+
+void
+fib_entry_batch_end (void)
+{
+    fib_node_back_walk_ctx_t bw_ctx = {
+	.fnbw_reason = FIB_NODE_BW_REASON_FLAG_EVALUATE,
+    };
+    fib_node_index_t *fib_entry_index, *walks;
+
+    /*
+     * the walks can update other entries, these are walked as they go
+     */
+    fib_entry_batch.feb_active = 0;
+    walks = fib_entry_batch.feb_walks;
+    fib_entry_batch.feb_walks = NULL;
+
+    vec_foreach(fib_entry_index, walks)
+    {
+        /*
+         * the entry may since have been removed
+         */
+        if (!pool_is_free_index(fib_entry_pool, *fib_entry_index))
+            fib_walk_sync(FIB_NODE_TYPE_ENTRY, *fib_entry_index, &bw_ctx);
+    }
+
+    clib_bitmap_zero(fib_entry_batch.feb_walked);
+    vec_free(walks);
+}
+
 static fib_entry_t *
 fib_entry_alloc (u32 fib_index,
 		 const fib_prefix_t *prefix,
@@ -542,12 +589,12 @@ fib_entry_alloc (u32 fib_index,
     ASSERT (vm->thread_index == 0);
 
     if (need_barrier_sync)
-        vlib_worker_thread_barrier_sync (vm);
+        fib_barrier_sync (vm);
 
     pool_get(fib_entry_pool, fib_entry);
 
     if (need_barrier_sync)
-        vlib_worker_thread_barrier_release (vm);
+        fib_barrier_release (vm);
 
     clib_memset(fib_entry, 0, sizeof(*fib_entry));
 
@@ -751,8 +798,24 @@ fib_entry_post_update_actions (fib_entry_t *fib_entry,
     fib_node_back_walk_ctx_t bw_ctx = {
 	.fnbw_reason = FIB_NODE_BW_REASON_FLAG_EVALUATE,
     };
+    fib_node_index_t fib_entry_index;
 
-    fib_walk_sync(FIB_NODE_TYPE_ENTRY, fib_entry_get_index(fib_entry), &bw_ctx);
+    fib_entry_index = fib_entry_get_index(fib_entry);
+
+    if (fib_entry_batch.feb_active)
+    {
+        if (!clib_bitmap_get(fib_entry_batch.feb_walked, fib_entry_index))
+        {
+            fib_entry_batch.feb_walked =
+                clib_bitmap_set(fib_entry_batch.feb_walked,
+                                fib_entry_index, 1);
+            vec_add1(fib_entry_batch.feb_walks, fib_entry_index);
+        }
+    }
+    else
+    {
+        fib_walk_sync(FIB_NODE_TYPE_ENTRY, fib_entry_index, &bw_ctx);
+    }
 
     /*
      * then inform any covered prefixes
@@ -1778,6 +1841,23 @@ fib_entry_pool_alloc (uword size)
   pool_alloc(fib_entry_pool, size);
 }
 
+void
+fib_entry_pool_reserve (uword n_entries)
+{
+    vlib_main_t *vm = vlib_get_main();
+    uword n_free;
+
+    n_free = pool_free_elts(fib_entry_pool);
+
+    if (n_free >= n_entries)
+        return;
+
+    fib_barrier_sync(vm);
+    pool_alloc(fib_entry_pool,
+               clib_max(n_entries - n_free, pool_len(fib_entry_pool)));
+    fib_barrier_release(vm);
+}
+
 fib_route_path_t *
 fib_entry_encode (fib_node_index_t fib_entry_index)
 {
@@ -481,6 +481,14 @@ extern void fib_entry_set_flow_hash_config(fib_node_index_t fib_entry_index,
 
 extern void fib_entry_module_init(void);
 extern void fib_entry_pool_alloc(uword size);
+extern void fib_entry_pool_reserve(uword n_entries);
+
+/**
+ * @brief While a batch is open, the walks to the children of the updated
+ * entries are deferred to its end, and made once per entry.
+ */
+extern void fib_entry_batch_begin(void);
+extern void fib_entry_batch_end(void);
 
 extern u32 fib_entry_get_stats_index(fib_node_index_t fib_entry_index);
 
@@ -24,6 +24,7 @@
 #include <vnet/fib/fib_path_ext.h>
 #include <vnet/fib/fib_urpf_list.h>
 #include <vnet/fib/fib_entry_delegate.h>
+#include <vnet/fib/fib_epoch.h>
 
 /*
  * per-source type vft
@@ -757,7 +758,12 @@ fib_entry_src_action_uninstall (fib_entry_t *fib_entry)
 	    &fib_entry->fe_prefix,
 	    &fib_entry->fe_lb);
 
-	vlib_worker_wait_one_loop();
+	/*
+	 * in epoch mode the load-balance is reclaimed once the workers
+	 * have moved on, there's no need to wait for them here.
+	 */
+	if (!fib_epoch_is_enabled())
+	    vlib_worker_wait_one_loop();
 	dpo_reset(&fib_entry->fe_lb);
     }
 }
@@ -0,0 +1,407 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#include <vnet/fib/fib_epoch.h>
+#include <vlib/stats/stats.h>
+
+/**
+ * An object retired, and the function to reclaim it
+ */
+typedef struct fib_epoch_item_t_
+{
+    fib_epoch_reclaim_fn_t fei_fn;
+    uword fei_data;
+} fib_epoch_item_t;
+
+/**
+ * The objects retired during an epoch
+ */
+typedef struct fib_epoch_t_
+{
+    fib_epoch_item_t *fe_items;
+    /**
+     * The main loop count of each thread when the epoch closed. The
+     * epoch can be reclaimed once all the workers' counts have moved.
+     */
+    u32 *fe_loop_counts;
+} fib_epoch_t;
+
+/**
+ * Retire this many objects in an epoch before trying to reclaim, so
+ * a long run of updates on the main thread does not accumulate them
+ */
+#define FIB_EPOCH_POLL_INTERVAL 64
+
+typedef struct fib_epoch_main_t_
+{
+    int fem_enabled;
+    /** the epoch being filled */
+    fib_epoch_t fem_current;
+    /** closed epochs, the oldest first */
+    fib_epoch_t *fem_closed;
+    /** set while reclaiming, reclaim functions can retire further objects */
+    int fem_in_poll;
+    fib_epoch_stats_t fem_stats;
+    /** nesting of fib_barrier_sync() and when the outermost started */
+    u32 fem_barrier_depth;
+    f64 fem_barrier_start;
+    /** the process reclaiming the epochs while the main thread is idle */
+    u32 fem_process_node_index;
+    /** stats segment entries */
+    u32 fem_stats_barriers;
+    u32 fem_stats_barrier_usec;
+    u32 fem_stats_pending;
+    u32 fem_stats_reclaimed;
+} fib_epoch_main_t;
+
+static fib_epoch_main_t fib_epoch_main = {
+    .fem_stats_barriers = ~0,
+};
+
+typedef enum fib_epoch_process_event_t_
+{
+    FIB_EPOCH_PROCESS_EVENT_RETIRED,
+} fib_epoch_process_event_t;
+
+static void
+fib_epoch_update_stats (void)
+{
+    fib_epoch_main_t *fem = &fib_epoch_main;
+
+    if (~0 == fem->fem_stats_barriers)
+        return;
+
+    vlib_stats_set_gauge(fem->fem_stats_barriers,
+                         fem->fem_stats.fes_n_barriers);
+    vlib_stats_set_gauge(fem->fem_stats_barrier_usec,
+                         fem->fem_stats.fes_barrier_time * 1e6);
+    vlib_stats_set_gauge(fem->fem_stats_pending,
+                         fem->fem_stats.fes_n_pending);
+    vlib_stats_set_gauge(fem->fem_stats_reclaimed,
+                         fem->fem_stats.fes_n_reclaimed);
+}
+
+static int
+fib_epoch_is_quiescent (const fib_epoch_t *fe)
+{
+    vlib_global_main_t *vgm = vlib_get_global_main();
+    u32 ii;
+
+    /*
+     * workers held at the barrier are between two loops
+     */
+    if (vlib_worker_thread_barrier_held())
+        return (1);
+
+    for (ii = 1; ii < vec_len(fe->fe_loop_counts); ii++)
+    {
+        if (fe->fe_loop_counts[ii] == vgm->vlib_mains[ii]->main_loop_count)
+            return (0);
+    }
+    return (1);
+}
+
+static void
+fib_epoch_reclaim (fib_epoch_t *fe)
+{
+    fib_epoch_main_t *fem = &fib_epoch_main;
+    fib_epoch_item_t *fei;
+
+    vec_foreach(fei, fe->fe_items)
+    {
+        fei->fei_fn(fei->fei_data);
+    }
+    fem->fem_stats.fes_n_reclaimed += vec_len(fe->fe_items);
+    fem->fem_stats.fes_n_pending -= vec_len(fe->fe_items);
+
+    vec_free(fe->fe_items);
+    vec_free(fe->fe_loop_counts);
+}
+
+static void
+fib_epoch_close (void)
+{
+    vlib_global_main_t *vgm = vlib_get_global_main();
+    fib_epoch_main_t *fem = &fib_epoch_main;
+    fib_epoch_t *fe;
+    u32 ii;
+
+    if (0 == vec_len(fem->fem_current.fe_items))
+        return;
+
+    vec_add2(fem->fem_closed, fe, 1);
+    *fe = fem->fem_current;
+    clib_memset(&fem->fem_current, 0, sizeof(fem->fem_current));
+
+    vec_validate(fe->fe_loop_counts, vec_len(vgm->vlib_mains) - 1);
+    vec_foreach_index(ii, vgm->vlib_mains)
+    {
+        fe->fe_loop_counts[ii] = vgm->vlib_mains[ii]->main_loop_count;
+    }
+    fem->fem_stats.fes_n_epochs++;
+}
+
+void
+fib_epoch_poll (void)
+{
+    fib_epoch_main_t *fem = &fib_epoch_main;
+    fib_epoch_t fe;
+
+    ASSERT(0 == vlib_get_thread_index());
+
+    if (fem->fem_in_poll)
+        return;
+    fem->fem_in_poll = 1;
+
+    while (vec_len(fem->fem_closed) &&
+           fib_epoch_is_quiescent(&fem->fem_closed[0]))
+    {
+        fe = fem->fem_closed[0];
+        vec_delete(fem->fem_closed, 1, 0);
+        fib_epoch_reclaim(&fe);
+    }
+    fib_epoch_close();
+
+    fem->fem_in_poll = 0;
+    fib_epoch_update_stats();
+}
+
+void
+fib_epoch_retire (fib_epoch_reclaim_fn_t fn, uword data)
+{
+    fib_epoch_main_t *fem = &fib_epoch_main;
+    fib_epoch_item_t *fei;
+
+    ASSERT(0 == vlib_get_thread_index());
+    fem->fem_stats.fes_n_retired++;
+
+    if (!fem->fem_enabled ||
+        vlib_get_n_threads() < 2 ||
+        vlib_worker_thread_barrier_held())
+    {
+        /*
+         * no worker can be looking
+         */
+        fem->fem_stats.fes_n_reclaimed++;
+        fn(data);
+        return;
+    }
+
+    vec_add2(fem->fem_current.fe_items, fei, 1);
+    fei->fei_fn = fn;
+    fei->fei_data = data;
+
+    if (0 == fem->fem_stats.fes_n_pending++)
+        vlib_process_signal_event(vlib_get_main(),
+                                  fem->fem_process_node_index,
+                                  FIB_EPOCH_PROCESS_EVENT_RETIRED, 0);
+    if (0 == vec_len(fem->fem_current.fe_items) % FIB_EPOCH_POLL_INTERVAL)
+        fib_epoch_poll();
+}
+
+static void
+fib_epoch_vec_free (uword data)
+{
+    void *v = uword_to_pointer(data, void *);
+
+    vec_free(v);
+}
+
+void
+fib_epoch_retire_vec (void *v)
+{
+    if (NULL != v)
+        fib_epoch_retire(fib_epoch_vec_free, pointer_to_uword(v));
+}
+
+void
+fib_epoch_flush (void)
+{
+    fib_epoch_main_t *fem = &fib_epoch_main;
+
+    while (fem->fem_stats.fes_n_pending)
+    {
+        fib_epoch_poll();
+        vlib_worker_wait_one_loop();
+        fib_epoch_poll();
+    }
+}
+
+void
+fib_epoch_enable_disable (int enable)
+{
+    fib_epoch_main_t *fem = &fib_epoch_main;
+
+    if (!enable)
+        fib_epoch_flush();
+    fem->fem_enabled = enable;
+}
+
+int
+fib_epoch_is_enabled (void)
+{
+    return (fib_epoch_main.fem_enabled);
+}
+
+void
+fib_barrier_sync (vlib_main_t *vm)
+{
+    fib_epoch_main_t *fem = &fib_epoch_main;
+
+    /*
+     * only the outermost sync is accounted, and only when the FIB is the
+     * one stopping the workers
+     */
+    if (0 == fem->fem_barrier_depth++)
+        fem->fem_barrier_start = (vlib_worker_thread_barrier_held() ?
+                                  0 : vlib_time_now(vm));
+
+    vlib_worker_thread_barrier_sync(vm);
+}
+
+void
+fib_barrier_release (vlib_main_t *vm)
+{
+    fib_epoch_main_t *fem = &fib_epoch_main;
+
+    vlib_worker_thread_barrier_release(vm);
+
+    ASSERT(fem->fem_barrier_depth);
+    if (0 == --fem->fem_barrier_depth && 0 != fem->fem_barrier_start)
+    {
+        fem->fem_stats.fes_n_barriers++;
+        fem->fem_stats.fes_barrier_time +=
+            vlib_time_now(vm) - fem->fem_barrier_start;
+        fib_epoch_update_stats();
+    }
+}
+
+void
+fib_epoch_get_stats (fib_epoch_stats_t *stats)
+{
+    *stats = fib_epoch_main.fem_stats;
+}
+
+u8 *
+format_fib_epoch (u8 *s, va_list *args)
+{
+    fib_epoch_main_t *fem = &fib_epoch_main;
+    fib_epoch_stats_t *st = &fem->fem_stats;
+    u32 indent = format_get_indent(s);
+
+    s = format(s, "epoch reclaim: %s",
+               fem->fem_enabled ? "enabled" : "disabled");
+    s = format(s, "\n%Uretired:%lld reclaimed:%lld pending:%lld epochs:%lld",
+               format_white_space, indent,
+               st->fes_n_retired, st->fes_n_reclaimed,
+               st->fes_n_pending, st->fes_n_epochs);
+    s = format(s, "\n%Ubarrier: syncs:%lld time:%.6fs",
+               format_white_space, indent,
+               st->fes_n_barriers, st->fes_barrier_time);
+
+    return (s);
+}
+
+static uword
+fib_epoch_process (vlib_main_t *vm,
+                   vlib_node_runtime_t *rt,
+                   vlib_frame_t *f)
+{
+    fib_epoch_main_t *fem = &fib_epoch_main;
+
+    while (1)
+    {
+        if (fem->fem_stats.fes_n_pending)
+            vlib_process_wait_for_event_or_clock(vm, 1e-3);
+        else
+            vlib_process_wait_for_event(vm);
+
+        vlib_process_get_events(vm, NULL);
+        fib_epoch_poll();
+    }
+
+    return (0);
+}
+
+VLIB_REGISTER_NODE (fib_epoch_process_node) = {
+    .function = fib_epoch_process,
+    .type = VLIB_NODE_TYPE_PROCESS,
+    .name = "fib-epoch-process",
+};
+
+static clib_error_t *
+fib_epoch_show (vlib_main_t * vm,
+                unformat_input_t * input,
+                vlib_cli_command_t * cmd)
+{
+    vlib_cli_output(vm, "%U", format_fib_epoch);
+    return (NULL);
+}
+
+/*?
+ * This command displays the state of the epoch based reclamation of the
+ * forwarding objects, and the use of the worker barrier by the FIB.
+ *
+ * @cliexpar
+ * @cliexstart{show fib epoch}
+ * epoch reclaim: enabled
+ * retired:1002312 reclaimed:1002312 pending:0 epochs:16040
+ * barrier: syncs:37 time:0.004172s
+ * @cliexend
+?*/
+VLIB_CLI_COMMAND (fib_epoch_show_command, static) = {
+    .path = "show fib epoch",
+    .function = fib_epoch_show,
+    .short_help = "show fib epoch",
+};
+
+static clib_error_t *
+fib_epoch_set (vlib_main_t * vm,
+               unformat_input_t * input,
+               vlib_cli_command_t * cmd)
+{
+    if (unformat (input, "on") || unformat (input, "enable"))
+        fib_epoch_enable_disable(1);
+    else if (unformat (input, "off") || unformat (input, "disable"))
+        fib_epoch_enable_disable(0);
+    else
+        return clib_error_return(0, "unknown input '%U'",
+                                 format_unformat_error, input);
+    return (NULL);
+}
+
+/*?
+ * Enable or disable the epoch based reclamation of the forwarding objects.
+ * When enabled the memory the workers may be reading is retired rather
+ * than freed by route updates, and reclaimed once each worker has been
+ * around its main loop, so route churn does not need to wait for, or
+ * stop, the workers. It can also be enabled from the startup
+ * configuration with 'ip { fib-epoch-reclaim }'.
+ *
+ * @cliexpar
+ * @cliexcmd{set fib epoch on}
+?*/
+VLIB_CLI_COMMAND (fib_epoch_set_command, static) = {
+    .path = "set fib epoch",
+    .function = fib_epoch_set,
+    .short_help = "set fib epoch <on|off>",
+};
+
+static clib_error_t *
+fib_epoch_module_init (vlib_main_t * vm)
+{
+    fib_epoch_main_t *fem = &fib_epoch_main;
+
+    fem->fem_process_node_index = fib_epoch_process_node.index;
+
+    fem->fem_stats_barriers = vlib_stats_add_gauge("/sys/fib/barrier/syncs");
+    fem->fem_stats_barrier_usec = vlib_stats_add_gauge("/sys/fib/barrier/usec");
+    fem->fem_stats_pending = vlib_stats_add_gauge("/sys/fib/epoch/pending");
+    fem->fem_stats_reclaimed = vlib_stats_add_gauge("/sys/fib/epoch/reclaimed");
+    fib_epoch_update_stats();
+
+    return (NULL);
+}
+
+VLIB_INIT_FUNCTION (fib_epoch_module_init);
@@ -0,0 +1,90 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#ifndef __FIB_EPOCH_H__
+#define __FIB_EPOCH_H__
+
+#include <vlib/vlib.h>
+
+/**
+ * @brief Epoch based reclamation of the forwarding objects.
+ *
+ * The control plane publishes changes to the objects the workers read
+ * (load-balance buckets, mtrie plies, DPOs) with atomic stores, so the
+ * workers can continue to forward while routes churn. What cannot be done
+ * under their feet is freeing (or reusing) the memory a worker may still
+ * be reading. In epoch mode such memory is retired instead; the retired
+ * objects of an epoch are reclaimed once each worker has been seen once
+ * around its main loop since the epoch closed, at which point no worker
+ * can hold a reference to them.
+ *
+ * With the mode off, or without workers, retired objects are reclaimed
+ * immediately, which is the historical behaviour.
+ *
+ * The worker barrier is then only needed for structural changes, i.e. the
+ * expansion of the pools and counters the workers index into; the time
+ * spent with the workers stopped on behalf of the FIB is accounted by
+ * fib_barrier_sync()/fib_barrier_release().
+ */
+
+/**
+ * A function reclaiming a retired object, called from the main thread
+ */
+typedef void (*fib_epoch_reclaim_fn_t) (uword data);
+
+/**
+ * @brief Retire an object; fn(data) is called when no worker can see it
+ */
+extern void fib_epoch_retire(fib_epoch_reclaim_fn_t fn, uword data);
+
+/**
+ * @brief Retire a vector, it is freed when no worker can see it
+ */
+extern void fib_epoch_retire_vec(void *v);
+
+/**
+ * @brief Reclaim whatever can be reclaimed and close the current epoch
+ */
+extern void fib_epoch_poll(void);
+
+/**
+ * @brief Wait for all the workers and reclaim all the retired objects
+ */
+extern void fib_epoch_flush(void);
+
+/**
+ * @brief Enable or disable the epoch mode
+ */
+extern void fib_epoch_enable_disable(int enable);
+extern int fib_epoch_is_enabled(void);
+
+/**
+ * @brief Stop the workers on behalf of the FIB, for a structural change.
+ * The time the workers are held is accounted to the FIB.
+ */
+extern void fib_barrier_sync(vlib_main_t *vm);
+extern void fib_barrier_release(vlib_main_t *vm);
+
+/**
+ * @brief Statistics of the epoch reclamation and of the FIB's barrier use
+ */
+typedef struct fib_epoch_stats_t_
+{
+    /** objects retired/reclaimed since start */
+    u64 fes_n_retired;
+    u64 fes_n_reclaimed;
+    /** objects retired and not yet reclaimed */
+    u64 fes_n_pending;
+    /** number of epochs closed */
+    u64 fes_n_epochs;
+    /** number of times, and total time in seconds, the FIB held the workers */
+    u64 fes_n_barriers;
+    f64 fes_barrier_time;
+} fib_epoch_stats_t;
+
+extern void fib_epoch_get_stats(fib_epoch_stats_t *stats);
+
+extern u8 *format_fib_epoch(u8 *s, va_list *args);
+
+#endif
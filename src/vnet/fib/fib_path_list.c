@@ -680,6 +680,86 @@ fib_path_list_flags_fixup (fib_path_list_flags_t flags)
     return (flags);
 }
 
+/**
+ * The last shared path-list created during a batch, and the paths it was
+ * created from. The routes of a batch usually have the same paths, this
+ * saves creating, hashing and destroying a path-list for each.
+ */
+typedef struct fib_path_list_batch_t_
+{
+    int fplb_active;
+    fib_path_list_flags_t fplb_flags;
+    fib_route_path_t *fplb_rpaths;
+    fib_node_index_t fplb_path_list;
+} fib_path_list_batch_t;
+
+static fib_path_list_batch_t fib_path_list_batch = {
+    .fplb_path_list = FIB_NODE_INDEX_INVALID,
+};
+
+void
+fib_path_list_batch_begin (void)
+{
+    fib_path_list_batch.fplb_active = 1;
+}
+
+void
+fib_path_list_batch_end (void)
+{
+    fib_path_list_batch_t *fplb = &fib_path_list_batch;
+
+    fplb->fplb_active = 0;
+
+    if (FIB_NODE_INDEX_INVALID != fplb->fplb_path_list)
+    {
+        fib_path_list_unlock(fplb->fplb_path_list);
+        fplb->fplb_path_list = FIB_NODE_INDEX_INVALID;
+    }
+    vec_free(fplb->fplb_rpaths);
+}
+
+/*
+ * the paths must be identical, as opposed to equivalent, since that's
+ * a cheaper check than the path-list DB's
+ */
+static fib_node_index_t
+fib_path_list_batch_find (fib_path_list_flags_t flags,
+                          const fib_route_path_t *rpaths)
+{
+    fib_path_list_batch_t *fplb = &fib_path_list_batch;
+
+    if (FIB_NODE_INDEX_INVALID != fplb->fplb_path_list &&
+        flags == fplb->fplb_flags &&
+        vec_len(rpaths) == vec_len(fplb->fplb_rpaths) &&
+        0 == memcmp(rpaths, fplb->fplb_rpaths,
+                    vec_len(rpaths) * sizeof(*rpaths)))
+    {
+        return (fplb->fplb_path_list);
+    }
+
+    return (FIB_NODE_INDEX_INVALID);
+}
+
+static void
+fib_path_list_batch_set (fib_path_list_flags_t flags,
+                         const fib_route_path_t *rpaths,
+                         fib_node_index_t path_list_index)
+{
+    fib_path_list_batch_t *fplb = &fib_path_list_batch;
+
+    /*
+     * hold a lock so the index is not reused during the batch
+     */
+    fib_path_list_lock(path_list_index);
+    if (FIB_NODE_INDEX_INVALID != fplb->fplb_path_list)
+        fib_path_list_unlock(fplb->fplb_path_list);
+
+    fplb->fplb_path_list = path_list_index;
+    fplb->fplb_flags = flags;
+    vec_reset_length(fplb->fplb_rpaths);
+    vec_append(fplb->fplb_rpaths, rpaths);
+}
+
 fib_node_index_t
 fib_path_list_create (fib_path_list_flags_t flags,
 		      const fib_route_path_t *rpaths)
@@ -689,6 +769,16 @@ fib_path_list_create (fib_path_list_flags_t flags,
     int i;
 
     flags = fib_path_list_flags_fixup(flags);
+
+    if ((flags & FIB_PATH_LIST_FLAG_SHARED) &&
+        fib_path_list_batch.fplb_active)
+    {
+        path_list_index = fib_path_list_batch_find(flags, rpaths);
+
+        if (FIB_NODE_INDEX_INVALID != path_list_index)
+            return (path_list_index);
+    }
+
     path_list = fib_path_list_alloc(&path_list_index);
     path_list->fpl_flags = flags;
 
@@ -738,6 +828,9 @@ fib_path_list_create (fib_path_list_flags_t flags,
 	    fib_path_list_db_insert(path_list_index);
 	    path_list = fib_path_list_resolve(path_list);
 	}
+
+        if (fib_path_list_batch.fplb_active)
+            fib_path_list_batch_set(flags, rpaths, path_list_index);
     }
     else
     {
@@ -203,6 +203,13 @@ extern void fib_path_list_walk_w_ext(fib_node_index_t pl_index,
 
 extern void fib_path_list_module_init(void);
 
+/**
+ * @brief While a batch is open, consecutive creations of a shared
+ * path-list from the same paths return the same path-list.
+ */
+extern void fib_path_list_batch_begin(void);
+extern void fib_path_list_batch_end(void);
+
 /*
  * functions for testing.
  */
@@ -15,6 +15,7 @@
 
 #include <vlib/vlib.h>
 #include <vnet/dpo/drop_dpo.h>
+#include <vnet/dpo/load_balance.h>
 
 #include <vnet/fib/fib_table.h>
 #include <vnet/fib/fib_entry_cover.h>
@@ -22,6 +23,8 @@
 #include <vnet/fib/ip4_fib.h>
 #include <vnet/fib/ip6_fib.h>
 #include <vnet/fib/mpls_fib.h>
+#include <vnet/fib/fib_path_list.h>
+#include <vnet/fib/fib_epoch.h>
 
 const static char * fib_table_flags_strings[] = FIB_TABLE_ATTRIBUTES;
 
@@ -826,6 +829,66 @@ fib_table_entry_update (u32 fib_index,
     return (fib_entry_index);
 }
 
+static u32 fib_table_batch_depth;
+
+void
+fib_table_batch_begin (u32 n_entries)
+{
+    if (0 == fib_table_batch_depth++)
+    {
+        fib_path_list_batch_begin();
+        fib_entry_batch_begin();
+    }
+
+    /*
+     * a new entry has a load-balance. grow the pools now, so the
+     * workers are stopped once for the batch, if at all.
+     */
+    fib_entry_pool_reserve(n_entries);
+    load_balance_pool_reserve(n_entries);
+}
+
+void
+fib_table_batch_end (void)
+{
+    ASSERT(fib_table_batch_depth);
+
+    if (0 == --fib_table_batch_depth)
+    {
+        fib_entry_batch_end();
+        fib_path_list_batch_end();
+        fib_epoch_poll();
+    }
+}
+
+void
+fib_table_entry_bulk_update (u32 fib_index,
+                             const fib_prefix_t *prefixes,
+                             fib_source_t source,
+                             fib_entry_flag_t flags,
+                             const fib_route_path_t *rpaths)
+{
+    const fib_prefix_t *prefix;
+    fib_route_path_t *paths;
+
+    paths = NULL;
+    fib_table_batch_begin(vec_len(prefixes));
+
+    vec_foreach(prefix, prefixes)
+    {
+        /*
+         * the paths are fixed up and sorted for each prefix
+         */
+        vec_reset_length(paths);
+        vec_append(paths, rpaths);
+
+        fib_table_entry_update(fib_index, prefix, source, flags, paths);
+    }
+
+    fib_table_batch_end();
+    vec_free(paths);
+}
+
 fib_node_index_t
 fib_table_entry_update_one_path (u32 fib_index,
 				 const fib_prefix_t *prefix,
@@ -931,6 +994,23 @@ fib_table_entry_delete (u32 fib_index,
     }
 }
 
+void
+fib_table_entry_bulk_delete (u32 fib_index,
+                             const fib_prefix_t *prefixes,
+                             fib_source_t source)
+{
+    const fib_prefix_t *prefix;
+
+    fib_table_batch_begin(0);
+
+    vec_foreach(prefix, prefixes)
+    {
+        fib_table_entry_delete(fib_index, prefix, source);
+    }
+
+    fib_table_batch_end();
+}
+
 void
 fib_table_entry_delete_index (fib_node_index_t fib_entry_index,
 			      fib_source_t source)
@@ -485,6 +485,46 @@ extern fib_node_index_t fib_table_entry_update(u32 fib_index,
 					       fib_entry_flag_t flags,
 					       fib_route_path_t *paths);
 
+/**
+ * @brief
+ *  Update a batch of entries to have the same new set of paths. Entries
+ *  that do not exist are created. The result is that of a
+ *  fib_table_entry_update() for each prefix, but the path-list is built
+ *  once, the walks to the entries' children are made once per entry at
+ *  the end of the batch, and the pools are grown once for the batch.
+ *
+ * @param fib_index
+ *  The index of the FIB
+ *
+ * @param prefixes
+ *  A vector of the prefixes of the entries
+ *
+ * @param source
+ *  The ID of the client/source adding the entries.
+ *
+ * @param flags
+ *  Flags for the entries.
+ *
+ * @param rpaths
+ *  A vector of paths, each entry is given a copy.
+ */
+extern void fib_table_entry_bulk_update(u32 fib_index,
+                                        const fib_prefix_t *prefixes,
+                                        fib_source_t source,
+                                        fib_entry_flag_t flags,
+                                        const fib_route_path_t *rpaths);
+
+/**
+ * @brief
+ *  Open a batch of updates to the FIB; see fib_table_entry_bulk_update().
+ *  Batches nest, the deferred work is done when the outermost is closed.
+ *
+ * @param n_entries
+ *  The number of entries the batch may create, to reserve for.
+ */
+extern void fib_table_batch_begin(u32 n_entries);
+extern void fib_table_batch_end(void);
+
 /**
  * @brief
  *  Update the entry to have just one path. If the entry does not
@@ -597,6 +637,23 @@ extern void fib_table_entry_delete(u32 fib_index,
 				   const fib_prefix_t *prefix,
 				   fib_source_t source);
 
+/**
+ * @brief
+ *  Delete a batch of FIB entries, as fib_table_entry_delete() on each.
+ *
+ * @param fib_index
+ *  The index of the FIB
+ *
+ * @param prefixes
+ *  A vector of the prefixes of the entries to remove
+ *
+ * @param source
+ *  The ID of the client/source adding the entries.
+ */
+extern void fib_table_entry_bulk_delete(u32 fib_index,
+                                        const fib_prefix_t *prefixes,
+                                        fib_source_t source);
+
 /**
  * @brief
  *  Delete a FIB entry. If the entry has no more sources, then it is
@@ -15,6 +15,7 @@
 
 #include <vnet/fib/fib_urpf_list.h>
 #include <vnet/adj/adj.h>
+#include <vnet/fib/fib_epoch.h>
 
 /**
  * @brief pool of all fib_urpf_list
@@ -60,12 +61,12 @@ fib_urpf_list_alloc_and_lock (void)
     ASSERT (vm->thread_index == 0);
 
     if (need_barrier_sync)
-        vlib_worker_thread_barrier_sync (vm);
+        fib_barrier_sync (vm);
 
     pool_get(fib_urpf_list_pool, urpf);
 
     if (need_barrier_sync)
-        vlib_worker_thread_barrier_release (vm);
+        fib_barrier_release (vm);
 
     clib_memset(urpf, 0, sizeof(*urpf));
 
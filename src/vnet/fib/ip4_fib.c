@@ -16,6 +16,7 @@
 #include <vnet/fib/fib_table.h>
 #include <vnet/fib/fib_entry.h>
 #include <vnet/fib/ip4_fib.h>
+#include <vnet/fib/fib_epoch.h>
 
 /*
  * A table of prefixes to be added to tables and the sources for them
@@ -632,6 +633,8 @@ ip_config (vlib_main_t * vm, unformat_input_t * input)
     {
 	if (unformat (input, "default-table-name %s", &default_name))
 	    ;
+	else if (unformat (input, "fib-epoch-reclaim"))
+	    fib_epoch_enable_disable (1);
 	else
 	    return clib_error_return (0, "unknown input '%U'",
 				      format_unformat_error, input);
@@ -313,4 +313,48 @@ ip4_fib_forwarding_lookup_x4 (u32 fib_index0,
 
 #endif
 
+/**
+ * @brief Forwarding lookup of a vector of addresses.
+ *
+ * Runs of consecutive addresses that are looked up in the same table, which
+ * for a frame received on one interface is all of them, are resolved
+ * together by the mtrie's vector lookup.
+ */
+static_always_inline void
+ip4_fib_forwarding_lookup_x (const u32 *fib_indices,
+                             const ip4_address_t *addrs,
+                             index_t *lbs,
+                             u32 n_left)
+{
+    u32 fib_index, n;
+
+    while (n_left)
+    {
+        fib_index = fib_indices[0];
+
+        for (n = 1; n < n_left && fib_indices[n] == fib_index; n++)
+            ;
+
+#ifdef VPP_IP_FIB_MTRIE_16
+        ip4_mtrie_16_lookup_x (&ip4_fib_get(fib_index)->mtrie, addrs, lbs, n);
+#else
+        ip4_mtrie_8_lookup_x (&ip4_fib_get(fib_index)->mtrie, addrs, lbs, n);
+#endif
+
+        fib_indices += n;
+        addrs += n;
+        lbs += n;
+        n_left -= n;
+    }
+}
+
+/**
+ * @brief Non-inline version of ip4_fib_forwarding_lookup_x, using the
+ * best variant for the CPU. For callers outside of the data-plane nodes.
+ */
+extern void ip4_fib_forwarding_lookup_frame (const u32 *fib_indices,
+                                             const ip4_address_t *addrs,
+                                             index_t *lbs,
+                                             u32 n_left);
+
 #endif
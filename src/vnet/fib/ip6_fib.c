@@ -15,6 +15,7 @@
 
 #include <vnet/fib/ip6_fib.h>
 #include <vnet/fib/fib_table.h>
+#include <vnet/fib/fib_epoch.h>
 #include <vnet/dpo/ip6_ll_dpo.h>
 
 #include <vppinfra/bihash_24_8.h>
@@ -26,6 +27,9 @@ ip6_fib_fwding_table_instance_t ip6_fib_fwding_table;
 u32 ip6_fib_table_nbuckets;
 uword ip6_fib_table_size;
 
+/* Use an mtrie for the forwarding lookups of new (non link-local) tables */
+static u8 ip6_fib_table_mtrie_default;
+
 typedef struct ip6_fib_hash_key_t_
 {
   ip6_address_t addr;
@@ -102,6 +106,9 @@ create_fib_with_table_id (u32 table_id,
 
     v6_fib->fib_entry_by_dst_address = hash_create_mem(2, sizeof(ip6_fib_hash_key_t), sizeof(fib_node_index_t));
 
+    if (ip6_fib_table_mtrie_default && !(flags & FIB_TABLE_FLAG_IP6_LL))
+        v6_fib->mtrie = ip6_mtrie_create();
+
     /*
      * add the special entries into the new FIB
      */
@@ -185,6 +192,7 @@ ip6_fib_table_destroy (u32 fib_index)
     }
     vec_free (fib_table->ft_locks);
     vec_free(fib_table->ft_src_route_counts);
+    ip6_fib_table_mtrie_disable(fib_index);
     hash_free(pool_elt_at_index(ip6_main.v6_fibs, fib_index)->fib_entry_by_dst_address);
     pool_put_index(ip6_main.v6_fibs, fib_table->ft_index);
     pool_put(ip6_main.fibs, fib_table);
@@ -303,8 +311,15 @@ compute_prefix_lengths_in_search_order (ip6_fib_fwding_table_instance_t *table)
     /*
      * let the workers go once round the track before we free the old set
      */
-    vlib_worker_wait_one_loop();
-    vec_free(old);
+    if (fib_epoch_is_enabled())
+    {
+        fib_epoch_retire_vec(old);
+    }
+    else
+    {
+        vlib_worker_wait_one_loop();
+        vec_free(old);
+    }
 }
 
 void
@@ -336,6 +351,55 @@ ip6_fib_table_fwding_dpo_update (u32 fib_index,
                              128 - len, 1);
         compute_prefix_lengths_in_search_order (table);
     }
+
+    if (NULL != ip6_fib_get(fib_index)->mtrie)
+    {
+        ip6_mtrie_route_add(ip6_fib_get(fib_index)->mtrie,
+                            addr, len, dpo->dpoi_index);
+    }
+}
+
+/**
+ * Find the longest prefix, less specific than addr/len, in the forwarding
+ * hash; i.e. what the mtrie slots of addr/len revert to once it is removed.
+ */
+static u32
+ip6_fib_table_fwding_cover (u32 fib_index,
+                            const ip6_address_t *addr,
+                            u32 len,
+                            u32 *cover_len)
+{
+    ip6_fib_fwding_table_instance_t *table;
+    clib_bihash_kv_24_8_t kv, value;
+    ip6_address_t *mask;
+    u64 fib;
+    int i;
+
+    table = &ip6_fib_fwding_table;
+    fib = ((u64)((fib_index))<<32);
+
+    vec_foreach_index (i, table->prefix_lengths_in_search_order)
+    {
+        int cover_address_length = table->prefix_lengths_in_search_order[i];
+
+        if (cover_address_length >= len)
+            continue;
+
+        mask = &ip6_main.fib_masks[cover_address_length];
+        kv.key[0] = addr->as_u64[0] & mask->as_u64[0];
+        kv.key[1] = addr->as_u64[1] & mask->as_u64[1];
+        kv.key[2] = fib | cover_address_length;
+
+        if (0 == clib_bihash_search_24_8(&table->ip6_hash, &kv, &value))
+        {
+            *cover_len = cover_address_length;
+            return (value.value);
+        }
+    }
+
+    /* the default route is being removed, i.e. the table is going away */
+    *cover_len = 0;
+    return (0);
 }
 
 void
@@ -369,6 +433,87 @@ ip6_fib_table_fwding_dpo_remove (u32 fib_index,
                              128 - len, 0);
 	compute_prefix_lengths_in_search_order (table);
     }
+
+    if (NULL != ip6_fib_get(fib_index)->mtrie)
+    {
+        u32 cover_len, cover_lbi;
+
+        cover_lbi = ip6_fib_table_fwding_cover(fib_index, addr, len,
+                                               &cover_len);
+        ip6_mtrie_route_del(ip6_fib_get(fib_index)->mtrie,
+                            addr, len, dpo->dpoi_index,
+                            cover_len, cover_lbi);
+    }
+}
+
+typedef struct ip6_fib_mtrie_populate_ctx_t_
+{
+    u32 fib_index;
+    ip6_mtrie_t *mtrie;
+} ip6_fib_mtrie_populate_ctx_t;
+
+static int
+ip6_fib_mtrie_populate_one (clib_bihash_kv_24_8_t *kv,
+                            void *arg)
+{
+    ip6_fib_mtrie_populate_ctx_t *ctx = arg;
+    ip6_address_t addr;
+
+    if ((kv->key[2] >> 32) != ctx->fib_index)
+        return (BIHASH_WALK_CONTINUE);
+
+    addr.as_u64[0] = kv->key[0];
+    addr.as_u64[1] = kv->key[1];
+
+    ip6_mtrie_route_add(ctx->mtrie, &addr, kv->key[2] & 0xff, kv->value);
+
+    return (BIHASH_WALK_CONTINUE);
+}
+
+void
+ip6_fib_table_mtrie_enable (u32 fib_index)
+{
+    ip6_fib_mtrie_populate_ctx_t ctx = {
+        .fib_index = fib_index,
+    };
+    ip6_fib_t *fib;
+
+    if (NULL != ip6_fib_get(fib_index)->mtrie)
+        return;
+
+    /*
+     * build the trie from the forwarding entries already present,
+     * the order in which they are added does not matter. The workers
+     * continue to use the hash until the trie is complete.
+     */
+    ctx.mtrie = ip6_mtrie_create();
+    clib_bihash_foreach_key_value_pair_24_8(&ip6_fib_fwding_table.ip6_hash,
+                                            ip6_fib_mtrie_populate_one,
+                                            &ctx);
+
+    fib = ip6_fib_get(fib_index);
+    clib_atomic_store_rel_n(&fib->mtrie, ctx.mtrie);
+}
+
+void
+ip6_fib_table_mtrie_disable (u32 fib_index)
+{
+    ip6_mtrie_t *mtrie;
+    ip6_fib_t *fib;
+
+    fib = ip6_fib_get(fib_index);
+    mtrie = fib->mtrie;
+
+    if (NULL == mtrie)
+        return;
+
+    clib_atomic_store_rel_n(&fib->mtrie, NULL);
+
+    /*
+     * let the workers go once round the track before we free the trie
+     */
+    vlib_worker_wait_one_loop();
+    ip6_mtrie_destroy(mtrie);
 }
 
 void
@@ -487,9 +632,16 @@ u8 *
 format_ip6_fib_table_memory (u8 * s, va_list * args)
 {
     uword bytes_inuse;
+    ip6_fib_t *fib;
 
     bytes_inuse = alloc_arena_next(&ip6_fib_fwding_table.ip6_hash);
 
+    pool_foreach (fib, ip6_main.v6_fibs)
+    {
+        if (NULL != fib->mtrie)
+            bytes_inuse += ip6_mtrie_memory_usage(fib->mtrie);
+    }
+
     s = format(s, "%=30s %=6d %=12ld\n",
                "IPv6 unicast",
                pool_elts(ip6_main.fibs),
@@ -567,6 +719,7 @@ ip6_show_fib (vlib_main_t * vm,
     int table_id = -1, fib_index = ~0;
     int detail = 0;
     int hash = 0;
+    int mtrie = 0;
 
     verbose = 1;
     matching = 0;
@@ -587,6 +740,9 @@ ip6_show_fib (vlib_main_t * vm,
                  unformat (input, "memory"))
 	    hash = 1;
 
+	else if (unformat (input, "mtrie"))
+	    mtrie = 1;
+
 	else if (unformat (input, "%U/%d",
 			   unformat_ip6_address, &matching_address, &mask_len))
 	    matching = 1;
@@ -622,6 +778,13 @@ ip6_show_fib (vlib_main_t * vm,
             continue;
 
 	ip6_fib_table_show(vm, fib_table, !verbose);
+
+	if (mtrie)
+	{
+	    if (NULL != fib->mtrie)
+		vlib_cli_output (vm, "%U", format_ip6_mtrie, fib->mtrie, detail);
+	    continue;
+	}
 	if (!verbose)
 	  continue;
 
@@ -734,10 +897,62 @@ ip6_show_fib (vlib_main_t * vm,
  ?*/
 VLIB_CLI_COMMAND (ip6_show_fib_command, static) = {
     .path = "show ip6 fib",
-    .short_help = "show ip6 fib [summary] [table <table-id>] [index <fib-id>] [<ip6-addr>[/<width>]] [detail]",
+    .short_help = "show ip6 fib [summary] [table <table-id>] [index <fib-id>] [<ip6-addr>[/<width>]] [mtrie] [detail]",
     .function = ip6_show_fib,
 };
 
+static clib_error_t *
+ip6_fib_mtrie_cmd (vlib_main_t * vm,
+                   unformat_input_t * input,
+                   vlib_cli_command_t * cmd)
+{
+    u32 table_id = 0, fib_index;
+    int enable = 1;
+
+    while (unformat_check_input (input) != UNFORMAT_END_OF_INPUT)
+    {
+	if (unformat (input, "table %d", &table_id))
+	    ;
+	else if (unformat (input, "disable"))
+	    enable = 0;
+	else if (unformat (input, "enable"))
+	    enable = 1;
+	else
+	    return clib_error_return (0, "unknown input '%U'",
+				      format_unformat_error, input);
+    }
+
+    fib_index = ip6_fib_index_from_table_id(table_id);
+
+    if (~0 == fib_index)
+	return clib_error_return (0, "no such table: %d", table_id);
+
+    if (enable)
+	ip6_fib_table_mtrie_enable(fib_index);
+    else
+	ip6_fib_table_mtrie_disable(fib_index);
+
+    return (NULL);
+}
+
+/*?
+ * This command switches the forwarding lookups of an IPv6 FIB table between
+ * the default per-prefix-length hash and a 16-8-...-8 stride mtrie. The
+ * mtrie costs one memory access per stride traversed regardless of how many
+ * distinct prefix lengths the table contains, at the expense of more memory.
+ * Use the 'mtrie' option of the 'ip6' startup config section to make it the
+ * default for all tables.
+ *
+ * @cliexpar
+ * @cliexcmd{set ip6 fib mtrie table 1}
+ * @cliexcmd{set ip6 fib mtrie table 1 disable}
+ ?*/
+VLIB_CLI_COMMAND (ip6_fib_mtrie_command, static) = {
+    .path = "set ip6 fib mtrie",
+    .short_help = "set ip6 fib mtrie [table <table-id>] [enable|disable]",
+    .function = ip6_fib_mtrie_cmd,
+};
+
 static clib_error_t *
 ip6_config (vlib_main_t * vm, unformat_input_t * input)
 {
@@ -754,6 +969,8 @@ ip6_config (vlib_main_t * vm, unformat_input_t * input)
 	;
       else if (unformat (input, "default-table-name %s", &default_name))
 	;
+      else if (unformat (input, "mtrie"))
+	ip6_fib_table_mtrie_default = 1;
       else
 	return clib_error_return (0, "unknown input '%U'",
 				  format_unformat_error, input);
@@ -77,6 +77,18 @@ extern void ip6_fib_table_fwding_dpo_remove(u32 fib_index,
 					    u32 len,
 					    const dpo_id_t *dpo);
 
+/**
+ * @brief Build an mtrie from the table's current forwarding entries and
+ * switch the table's data-plane lookups to it.
+ */
+extern void ip6_fib_table_mtrie_enable(u32 fib_index);
+
+/**
+ * @brief Switch the table's data-plane lookups back to the forwarding
+ * hash and free the mtrie.
+ */
+extern void ip6_fib_table_mtrie_disable(u32 fib_index);
+
 u32 ip6_fib_table_fwding_lookup_with_if_index(ip6_main_t * im,
 					      u32 sw_if_index,
 					      const ip6_address_t * dst);
@@ -90,9 +102,20 @@ extern void ip6_fib_table_walk(u32 fib_index,
                                fib_table_walk_fn_t fn,
                                void *ctx);
 
+static inline ip6_fib_t *
+ip6_fib_get (fib_node_index_t index)
+{
+    ASSERT(!pool_is_free_index(ip6_main.fibs, index));
+    return (pool_elt_at_index (ip6_main.v6_fibs, index));
+}
+
+/**
+ * @brief Forwarding lookup in the forwarding hash, one probe per
+ * populated prefix length.
+ */
 always_inline u32
-ip6_fib_table_fwding_lookup (u32 fib_index,
-                             const ip6_address_t * dst)
+ip6_fib_table_fwding_hash_lookup (u32 fib_index,
+                                  const ip6_address_t * dst)
 {
     ip6_fib_fwding_table_instance_t *table;
     clib_bihash_kv_24_8_t kv, value;
@@ -128,6 +151,55 @@ ip6_fib_table_fwding_lookup (u32 fib_index,
     return 0;
 }
 
+/**
+ * @brief Forwarding lookup; via the table's mtrie if it has one,
+ * otherwise via the forwarding hash.
+ */
+always_inline u32
+ip6_fib_table_fwding_lookup (u32 fib_index,
+                             const ip6_address_t * dst)
+{
+    const ip6_mtrie_t *mtrie;
+
+    mtrie = ip6_fib_get(fib_index)->mtrie;
+
+    if (NULL != mtrie)
+        return (ip6_mtrie_lookup(mtrie, dst));
+
+    return (ip6_fib_table_fwding_hash_lookup(fib_index, dst));
+}
+
+/**
+ * @brief Forwarding lookup of two addresses. When both tables use an
+ * mtrie the two walks are interleaved.
+ */
+static_always_inline void
+ip6_fib_table_fwding_lookup_x2 (u32 fib_index0,
+                                u32 fib_index1,
+                                const ip6_address_t * dst0,
+                                const ip6_address_t * dst1,
+                                u32 *lbi0,
+                                u32 *lbi1)
+{
+    const ip6_mtrie_t *mtrie0, *mtrie1;
+
+    mtrie0 = ip6_fib_get(fib_index0)->mtrie;
+    mtrie1 = ip6_fib_get(fib_index1)->mtrie;
+
+    if (PREDICT_TRUE(NULL != mtrie0 && NULL != mtrie1))
+    {
+        ip6_mtrie_lookup_x2(mtrie0, mtrie1, dst0, dst1, lbi0, lbi1);
+        return;
+    }
+
+    *lbi0 = (NULL != mtrie0 ?
+             ip6_mtrie_lookup(mtrie0, dst0) :
+             ip6_fib_table_fwding_hash_lookup(fib_index0, dst0));
+    *lbi1 = (NULL != mtrie1 ?
+             ip6_mtrie_lookup(mtrie1, dst1) :
+             ip6_fib_table_fwding_hash_lookup(fib_index1, dst1));
+}
+
 /**
  * @brief Walk all entries in a sub-tree of the FIB table
  * N.B: This is NOT safe to deletes. If you need to delete walk the whole
@@ -188,13 +260,6 @@ extern u32 ip6_fib_table_create_and_lock(fib_source_t src,
 
 extern u8 *format_ip6_fib_table_memory(u8 * s, va_list * args);
 
-static inline ip6_fib_t *
-ip6_fib_get (fib_node_index_t index)
-{
-    ASSERT(!pool_is_free_index(ip6_main.fibs, index));
-    return (pool_elt_at_index (ip6_main.v6_fibs, index));
-}
-
 static inline 
 u32 ip6_fib_index_from_table_id (u32 table_id)
 {
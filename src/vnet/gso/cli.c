@@ -82,6 +82,127 @@ VLIB_CLI_COMMAND (set_interface_feature_gso_command, static) = {
   .function = set_interface_feature_gso_command_fn,
 };
 
+static clib_error_t *
+set_interface_feature_gro_command_fn (vlib_main_t *vm, unformat_input_t *input,
+				      vlib_cli_command_t *cmd)
+{
+  vnet_main_t *vnm = vnet_get_main ();
+  unformat_input_t _line_input, *line_input = &_line_input;
+  clib_error_t *error = 0;
+  u32 sw_if_index = ~0;
+  u8 enable = 1;
+
+  if (!unformat_user (input, unformat_line_input, line_input))
+    return 0;
+
+  while (unformat_check_input (line_input) != UNFORMAT_END_OF_INPUT)
+    {
+      if (unformat (line_input, "%U", unformat_vnet_sw_interface, vnm,
+		    &sw_if_index))
+	;
+      else if (unformat (line_input, "enable"))
+	enable = 1;
+      else if (unformat (line_input, "disable"))
+	enable = 0;
+      else
+	{
+	  error = unformat_parse_error (line_input);
+	  goto done;
+	}
+    }
+
+  if (sw_if_index == ~0)
+    {
+      error = clib_error_return (0, "Interface not specified...");
+      goto done;
+    }
+
+  if (vnet_sw_interface_gro_enable_disable (sw_if_index, enable))
+    error = clib_error_return (0, "invalid interface");
+
+done:
+  unformat_free (line_input);
+  return error;
+}
+
+VLIB_CLI_COMMAND (set_interface_feature_gro_command, static) = {
+  .path = "set interface feature gro",
+  .short_help = "set interface feature gro <intfc> [enable | disable]",
+  .function = set_interface_feature_gro_command_fn,
+};
+
+static clib_error_t *
+set_gro_command_fn (vlib_main_t *vm, unformat_input_t *input,
+		    vlib_cli_command_t *cmd)
+{
+  gso_main_t *gm = &gso_main;
+  u32 max_flows = gm->gro_max_flows;
+  u32 max_segments = gm->gro_max_segments;
+
+  while (unformat_check_input (input) != UNFORMAT_END_OF_INPUT)
+    {
+      if (unformat (input, "flows %u", &max_flows))
+	;
+      else if (unformat (input, "segments %u", &max_segments))
+	;
+      else
+	return clib_error_return (0, "unknown input '%U'",
+				  format_unformat_error, input);
+    }
+
+  if (vnet_gro_set_config (max_flows, max_segments))
+    return clib_error_return (0, "flows must be 1..%u, segments at least 2",
+			      GRO_RX_MAX_FLOWS);
+
+  return 0;
+}
+
+VLIB_CLI_COMMAND (set_gro_command, static) = {
+  .path = "set gro",
+  .short_help = "set gro [flows <n>] [segments <n>]",
+  .function = set_gro_command_fn,
+};
+
+static clib_error_t *
+show_gro_command_fn (vlib_main_t *vm, unformat_input_t *input,
+		     vlib_cli_command_t *cmd)
+{
+  gso_main_t *gm = &gso_main;
+  gro_rx_stats_t *st, total = {};
+  u32 i;
+
+  vlib_cli_output (vm, "flows per frame %u, segments per packet %u",
+		   gm->gro_max_flows, gm->gro_max_segments);
+
+  vec_foreach_index (i, gm->gro_stats)
+    {
+      st = vec_elt_at_index (gm->gro_stats, i);
+      if (!st->n_packets)
+	continue;
+      vlib_cli_output (vm, "thread %u: packets %lu coalesced %lu aggregates %lu",
+		       i, st->n_packets, st->n_coalesced, st->n_aggregates);
+      total.n_packets += st->n_packets;
+      total.n_coalesced += st->n_coalesced;
+      total.n_aggregates += st->n_aggregates;
+    }
+
+  vlib_cli_output (vm, "total: packets %lu coalesced %lu aggregates %lu",
+		   total.n_packets, total.n_coalesced, total.n_aggregates);
+  if (total.n_aggregates)
+    vlib_cli_output (
+      vm, "  segments per aggregate %.2f, packets delivered per received %.3f",
+      (f64) (total.n_coalesced + total.n_aggregates) / total.n_aggregates,
+      (f64) (total.n_packets - total.n_coalesced) / total.n_packets);
+
+  return 0;
+}
+
+VLIB_CLI_COMMAND (show_gro_command, static) = {
+  .path = "show gro",
+  .short_help = "show gro",
+  .function = show_gro_command_fn,
+};
+
 /*
  * fd.io coding-style-patch-verification: ON
  *
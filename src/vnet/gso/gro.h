@@ -37,8 +37,11 @@ typedef union
     u16 dst_port;
   };
 
-  u64 flow_data[5];
-  u32 flow_data_u32;
+  struct
+  {
+    u64 flow_data[5];
+    u32 flow_data_u32;
+  };
 } gro_flow_key_t;
 
 typedef struct
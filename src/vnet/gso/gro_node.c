@@ -0,0 +1,430 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+/*
+ * Receive side GRO.
+ *
+ * A feature on the ip4-local / ip6-local arcs that folds in-order TCP
+ * segments of the same flow, received in the same frame, into a single
+ * chained buffer. The transport then does one connection lookup and one
+ * fifo enqueue per aggregate rather than per segment. It works for any
+ * input interface since nothing is asked of the driver.
+ *
+ * Nothing is held across frames: open flows are flushed when the frame
+ * ends, so no timer is needed and no latency is added. Aggregates keep
+ * the position of their first segment in the frame, so packet order
+ * within a flow is preserved.
+ */
+
+#include <vlib/vlib.h>
+#include <vnet/vnet.h>
+#include <vnet/feature/feature.h>
+#include <vnet/gso/gso.h>
+#include <vnet/gso/gro_func.h>
+#include <vnet/ip/ip4.h>
+#include <vnet/ip/ip6.h>
+#include <vnet/tcp/tcp_packet.h>
+
+#define foreach_gro_rx_error                                                  \
+  _ (COALESCED, "segments coalesced")                                         \
+  _ (AGGREGATES, "coalesced packets delivered")                               \
+  _ (NO_FLOW, "gro flow table full")
+
+static char *gro_rx_error_strings[] = {
+#define _(sym, string) string,
+  foreach_gro_rx_error
+#undef _
+};
+
+typedef enum
+{
+#define _(sym, str) GRO_RX_ERROR_##sym,
+  foreach_gro_rx_error
+#undef _
+    GRO_RX_N_ERROR,
+} gro_rx_error_t;
+
+typedef struct
+{
+  u32 sw_if_index;
+  u32 n_segments;
+  u32 length;
+  u16 gso_size;
+} gro_rx_trace_t;
+
+typedef struct
+{
+  gro_flow_key_t key;
+  u32 head_bi;
+  u32 tail_bi;
+  u32 length;
+  /* host order */
+  u32 next_seq;
+  /* network order, taken from the last segment */
+  u32 ack_number;
+  u16 window;
+  u16 n_segments;
+  u16 gso_size;
+  u16 slot;
+  u8 l4_offset;
+  u8 hdr_sz;
+  u8 tcp_flags;
+} gro_rx_flow_t;
+
+static u8 *
+format_gro_rx_trace (u8 *s, va_list *args)
+{
+  CLIB_UNUSED (vlib_main_t * vm) = va_arg (*args, vlib_main_t *);
+  CLIB_UNUSED (vlib_node_t * node) = va_arg (*args, vlib_node_t *);
+  gro_rx_trace_t *t = va_arg (*args, gro_rx_trace_t *);
+
+  s = format (s, "sw_if_index %d segments %u length %u gso_size %u",
+	      t->sw_if_index, t->n_segments, t->length, t->gso_size);
+  return s;
+}
+
+/**
+ * Check that a packet is a candidate for coalescing: a TCP segment with
+ * payload, only ACK/PSH set, no known bad checksum and no IP padding.
+ */
+static_always_inline int
+gro_rx_parse (vlib_main_t *vm, vlib_buffer_t *b, int is_ip6,
+	      gro_flow_key_t *key, tcp_header_t **tcpp, u8 *l4_offset,
+	      u8 *hdr_sz, u32 *payload_len)
+{
+  u32 sw_if_index[VLIB_N_RX_TX];
+  tcp_header_t *tcp;
+  u32 l3_len, l4_off, hdr;
+
+  if (PREDICT_FALSE (b->flags & VNET_BUFFER_F_GSO))
+    return 0;
+
+  /* the local arcs have already dropped what they validate and found bad */
+  if (PREDICT_FALSE ((b->flags & (VNET_BUFFER_F_L4_CHECKSUM_COMPUTED |
+				  VNET_BUFFER_F_L4_CHECKSUM_CORRECT)) ==
+		     VNET_BUFFER_F_L4_CHECKSUM_COMPUTED))
+    return 0;
+
+  sw_if_index[VLIB_RX] = vnet_buffer (b)->sw_if_index[VLIB_RX];
+  sw_if_index[VLIB_TX] = vnet_buffer (b)->sw_if_index[VLIB_TX];
+
+  if (is_ip6)
+    {
+      ip6_header_t *ip6 = vlib_buffer_get_current (b);
+
+      if (ip6->protocol != IP_PROTOCOL_TCP)
+	return 0;
+      l4_off = sizeof (ip6_header_t);
+      l3_len = clib_net_to_host_u16 (ip6->payload_length) + l4_off;
+      tcp = (tcp_header_t *) (ip6 + 1);
+      if (l4_off + sizeof (tcp_header_t) > b->current_length)
+	return 0;
+      gro_get_ip6_flow_from_packet (sw_if_index, ip6, tcp, key, 0);
+    }
+  else
+    {
+      ip4_header_t *ip4 = vlib_buffer_get_current (b);
+
+      if (ip4->protocol != IP_PROTOCOL_TCP || ip4_is_fragment (ip4))
+	return 0;
+      l4_off = ip4_header_bytes (ip4);
+      l3_len = clib_net_to_host_u16 (ip4->length);
+      tcp = (tcp_header_t *) ((u8 *) ip4 + l4_off);
+      if (l4_off + sizeof (tcp_header_t) > b->current_length)
+	return 0;
+      gro_get_ip4_flow_from_packet (sw_if_index, ip4, tcp, key, 0);
+    }
+
+  if ((tcp->flags & ~(TCP_FLAG_ACK | TCP_FLAG_PSH)) ||
+      !(tcp->flags & TCP_FLAG_ACK))
+    return 0;
+
+  hdr = l4_off + tcp_header_bytes (tcp);
+  if (hdr >= l3_len || hdr > b->current_length ||
+      l3_len != vlib_buffer_length_in_chain (vm, b))
+    return 0;
+
+  *tcpp = tcp;
+  *l4_offset = l4_off;
+  *hdr_sz = hdr;
+  *payload_len = l3_len - hdr;
+  return 1;
+}
+
+static_always_inline void
+gro_rx_flow_start (vlib_main_t *vm, gro_rx_flow_t *f, gro_flow_key_t *key,
+		   vlib_buffer_t *b, u32 bi, tcp_header_t *tcp, u8 l4_offset,
+		   u8 hdr_sz, u32 payload_len, u16 slot)
+{
+  vlib_buffer_t *tail = b;
+
+  if (!(b->flags & VLIB_BUFFER_NEXT_PRESENT))
+    {
+      b->total_length_not_including_first_buffer = 0;
+      b->flags |= VLIB_BUFFER_TOTAL_LENGTH_VALID;
+    }
+  while (tail->flags & VLIB_BUFFER_NEXT_PRESENT)
+    tail = vlib_get_buffer (vm, tail->next_buffer);
+
+  f->key = *key;
+  f->head_bi = bi;
+  f->tail_bi = vlib_get_buffer_index (vm, tail);
+  f->length = hdr_sz + payload_len;
+  f->next_seq = clib_net_to_host_u32 (tcp->seq_number) + payload_len;
+  f->ack_number = tcp->ack_number;
+  f->window = tcp->window;
+  f->n_segments = 1;
+  f->gso_size = payload_len;
+  f->slot = slot;
+  f->l4_offset = l4_offset;
+  f->hdr_sz = hdr_sz;
+  f->tcp_flags = 0;
+}
+
+static_always_inline void
+gro_rx_flow_merge (vlib_main_t *vm, gro_rx_flow_t *f, vlib_buffer_t *b,
+		   u32 bi, tcp_header_t *tcp, u32 payload_len)
+{
+  vlib_buffer_t *head = vlib_get_buffer (vm, f->head_bi);
+  vlib_buffer_t *tail = vlib_get_buffer (vm, f->tail_bi);
+
+  f->ack_number = tcp->ack_number;
+  f->window = tcp->window;
+  f->tcp_flags |= tcp->flags;
+  f->next_seq += payload_len;
+  f->length += payload_len;
+  f->n_segments++;
+
+  vlib_buffer_advance (b, f->hdr_sz);
+  tail->next_buffer = bi;
+  tail->flags |= VLIB_BUFFER_NEXT_PRESENT;
+  head->total_length_not_including_first_buffer += payload_len;
+
+  while (b->flags & VLIB_BUFFER_NEXT_PRESENT)
+    b = vlib_get_buffer (vm, b->next_buffer);
+  f->tail_bi = vlib_get_buffer_index (vm, b);
+}
+
+/**
+ * Rewrite the head's headers to describe the whole aggregate. The
+ * segments' checksums were checked on the way in; the aggregate is
+ * marked GSO with TCP checksum offload so that, should it leave the box
+ * (e.g. punted to a tap), it is segmented or checksummed correctly.
+ */
+static_always_inline void
+gro_rx_flow_fixup (vlib_main_t *vm, gro_rx_flow_t *f, int is_ip6)
+{
+  vlib_buffer_t *head = vlib_get_buffer (vm, f->head_bi);
+  tcp_header_t *tcp;
+
+  if (is_ip6)
+    {
+      ip6_header_t *ip6 = vlib_buffer_get_current (head);
+      ip6->payload_length =
+	clib_host_to_net_u16 (f->length - sizeof (ip6_header_t));
+      head->flags |= VNET_BUFFER_F_IS_IP6;
+    }
+  else
+    {
+      ip4_header_t *ip4 = vlib_buffer_get_current (head);
+      ip4->length = clib_host_to_net_u16 (f->length);
+      ip4->checksum = ip4_header_checksum (ip4);
+      head->flags |= VNET_BUFFER_F_IS_IP4;
+    }
+
+  tcp = vlib_buffer_get_current (head) + f->l4_offset;
+  tcp->ack_number = f->ack_number;
+  tcp->window = f->window;
+  tcp->flags |= f->tcp_flags;
+
+  vnet_buffer (head)->l3_hdr_offset = head->current_data;
+  vnet_buffer (head)->l4_hdr_offset = head->current_data + f->l4_offset;
+  vnet_buffer2 (head)->gso_size = f->gso_size;
+  vnet_buffer2 (head)->gso_l4_hdr_sz = f->hdr_sz - f->l4_offset;
+  head->flags |= (VNET_BUFFER_F_GSO | VNET_BUFFER_F_L3_HDR_OFFSET_VALID |
+		  VNET_BUFFER_F_L4_HDR_OFFSET_VALID);
+  vnet_buffer_offload_flags_set (head, VNET_BUFFER_OFFLOAD_F_TCP_CKSUM);
+}
+
+static_always_inline uword
+gro_rx_inline (vlib_main_t *vm, vlib_node_runtime_t *node,
+	       vlib_frame_t *frame, int is_ip6)
+{
+  gso_main_t *gm = &gso_main;
+  gro_rx_stats_t *stats = vec_elt_at_index (gm->gro_stats, vm->thread_index);
+  vlib_buffer_t *bufs[VLIB_FRAME_SIZE];
+  u32 to[VLIB_FRAME_SIZE];
+  u16 nexts[VLIB_FRAME_SIZE];
+  u16 n_segs[VLIB_FRAME_SIZE];
+  gro_rx_flow_t flows[GRO_RX_MAX_FLOWS];
+  u32 *from, n_left, n_out = 0, n_flows = 0, i;
+  u32 max_flows = gm->gro_max_flows;
+  u32 max_segments = gm->gro_max_segments;
+  u32 n_coalesced = 0, n_aggregates = 0, n_no_flow = 0;
+
+  from = vlib_frame_vector_args (frame);
+  n_left = frame->n_vectors;
+  vlib_get_buffers (vm, from, bufs, n_left);
+
+  for (i = 0; i < n_left; i++)
+    {
+      vlib_buffer_t *b = bufs[i];
+      gro_rx_flow_t *f = 0;
+      gro_flow_key_t key;
+      tcp_header_t *tcp;
+      u32 payload_len, j;
+      u8 l4_offset, hdr_sz;
+      u16 next;
+
+      if (i + 2 < n_left)
+	{
+	  vlib_prefetch_buffer_header (bufs[i + 2], LOAD);
+	  clib_prefetch_load (bufs[i + 2]->data);
+	}
+
+      if (!gro_rx_parse (vm, b, is_ip6, &key, &tcp, &l4_offset, &hdr_sz,
+			 &payload_len))
+	goto emit;
+
+      for (j = 0; j < n_flows; j++)
+	if (gro_flow_is_equal (&key, &flows[j].key))
+	  {
+	    f = &flows[j];
+	    break;
+	  }
+
+      if (f)
+	{
+	  if (PREDICT_TRUE (
+		clib_net_to_host_u32 (tcp->seq_number) == f->next_seq &&
+		hdr_sz == f->hdr_sz && f->n_segments < max_segments &&
+		f->length + payload_len < TCP_MAX_GSO_SZ))
+	    {
+	      gro_rx_flow_merge (vm, f, b, from[i], tcp, payload_len);
+	      n_coalesced++;
+	      if (!(tcp->flags & TCP_FLAG_PSH))
+		continue;
+	      /* a push ends the aggregate */
+	      gro_rx_flow_fixup (vm, f, is_ip6);
+	      n_segs[f->slot] = f->n_segments;
+	      n_aggregates++;
+	      flows[j] = flows[--n_flows];
+	      continue;
+	    }
+
+	  /* out of sequence or full, deliver what we have */
+	  if (f->n_segments > 1)
+	    {
+	      gro_rx_flow_fixup (vm, f, is_ip6);
+	      n_segs[f->slot] = f->n_segments;
+	      n_aggregates++;
+	    }
+	  flows[j] = flows[--n_flows];
+	}
+
+      if (tcp->flags & TCP_FLAG_PSH)
+	goto emit;
+
+      if (PREDICT_FALSE (n_flows >= max_flows))
+	{
+	  n_no_flow++;
+	  goto emit;
+	}
+
+      gro_rx_flow_start (vm, &flows[n_flows++], &key, b, from[i], tcp,
+			 l4_offset, hdr_sz, payload_len, n_out);
+
+    emit:
+      vnet_feature_next_u16 (&next, b);
+      nexts[n_out] = next;
+      n_segs[n_out] = 1;
+      to[n_out++] = from[i];
+    }
+
+  /* flush on frame end */
+  for (i = 0; i < n_flows; i++)
+    if (flows[i].n_segments > 1)
+      {
+	gro_rx_flow_fixup (vm, &flows[i], is_ip6);
+	n_segs[flows[i].slot] = flows[i].n_segments;
+	n_aggregates++;
+      }
+
+  if (PREDICT_FALSE (node->flags & VLIB_NODE_FLAG_TRACE))
+    {
+      for (i = 0; i < n_out; i++)
+	{
+	  vlib_buffer_t *b = vlib_get_buffer (vm, to[i]);
+	  if (b->flags & VLIB_BUFFER_IS_TRACED)
+	    {
+	      gro_rx_trace_t *t = vlib_add_trace (vm, node, b, sizeof (*t));
+	      t->sw_if_index = vnet_buffer (b)->sw_if_index[VLIB_RX];
+	      t->n_segments = n_segs[i];
+	      t->length = vlib_buffer_length_in_chain (vm, b);
+	      t->gso_size = n_segs[i] > 1 ? vnet_buffer2 (b)->gso_size : 0;
+	    }
+	}
+    }
+
+  stats->n_packets += frame->n_vectors;
+  stats->n_coalesced += n_coalesced;
+  stats->n_aggregates += n_aggregates;
+
+  if (n_coalesced)
+    {
+      vlib_node_increment_counter (vm, node->node_index,
+				   GRO_RX_ERROR_COALESCED, n_coalesced);
+      vlib_node_increment_counter (vm, node->node_index,
+				   GRO_RX_ERROR_AGGREGATES, n_aggregates);
+    }
+  if (n_no_flow)
+    vlib_node_increment_counter (vm, node->node_index, GRO_RX_ERROR_NO_FLOW,
+				 n_no_flow);
+
+  vlib_buffer_enqueue_to_next (vm, node, to, nexts, n_out);
+
+  return frame->n_vectors;
+}
+
+VLIB_NODE_FN (gro_ip4_node)
+(vlib_main_t *vm, vlib_node_runtime_t *node, vlib_frame_t *frame)
+{
+  return gro_rx_inline (vm, node, frame, 0 /* is_ip6 */);
+}
+
+VLIB_NODE_FN (gro_ip6_node)
+(vlib_main_t *vm, vlib_node_runtime_t *node, vlib_frame_t *frame)
+{
+  return gro_rx_inline (vm, node, frame, 1 /* is_ip6 */);
+}
+
+VLIB_REGISTER_NODE (gro_ip4_node) = {
+  .name = "gro-ip4",
+  .vector_size = sizeof (u32),
+  .format_trace = format_gro_rx_trace,
+  .type = VLIB_NODE_TYPE_INTERNAL,
+  .n_errors = ARRAY_LEN (gro_rx_error_strings),
+  .error_strings = gro_rx_error_strings,
+};
+
+VLIB_REGISTER_NODE (gro_ip6_node) = {
+  .name = "gro-ip6",
+  .vector_size = sizeof (u32),
+  .format_trace = format_gro_rx_trace,
+  .type = VLIB_NODE_TYPE_INTERNAL,
+  .n_errors = ARRAY_LEN (gro_rx_error_strings),
+  .error_strings = gro_rx_error_strings,
+};
+
+VNET_FEATURE_INIT (gro_ip4_node, static) = {
+  .arc_name = "ip4-local",
+  .node_name = "gro-ip4",
+  .runs_before = VNET_FEATURES ("ip4-local-end-of-arc"),
+};
+
+VNET_FEATURE_INIT (gro_ip6_node, static) = {
+  .arc_name = "ip6-local",
+  .node_name = "gro-ip6",
+  .runs_before = VNET_FEATURES ("ip6-local-end-of-arc"),
+};
@@ -41,14 +41,49 @@ vnet_sw_interface_gso_enable_disable (u32 sw_if_index, u8 enable)
   return (0);
 }
 
+int
+vnet_sw_interface_gro_enable_disable (u32 sw_if_index, u8 enable)
+{
+  vnet_main_t *vnm = vnet_get_main ();
+
+  if (pool_is_free_index (vnm->interface_main.sw_interfaces, sw_if_index))
+    return VNET_API_ERROR_INVALID_SW_IF_INDEX;
+
+  vnet_feature_enable_disable ("ip4-local", "gro-ip4", sw_if_index, enable, 0,
+			       0);
+  vnet_feature_enable_disable ("ip6-local", "gro-ip6", sw_if_index, enable, 0,
+			       0);
+
+  return (0);
+}
+
+int
+vnet_gro_set_config (u32 max_flows, u32 max_segments)
+{
+  gso_main_t *gm = &gso_main;
+
+  if (max_flows == 0 || max_flows > GRO_RX_MAX_FLOWS || max_segments < 2)
+    return VNET_API_ERROR_INVALID_VALUE;
+
+  gm->gro_max_flows = max_flows;
+  gm->gro_max_segments = max_segments;
+
+  return (0);
+}
+
 static clib_error_t *
 gso_init (vlib_main_t * vm)
 {
   gso_main_t *gm = &gso_main;
+  vlib_thread_main_t *tm = vlib_get_thread_main ();
 
   clib_memset (gm, 0, sizeof (gm[0]));
   gm->vlib_main = vm;
   gm->vnet_main = vnet_get_main ();
+  gm->gro_max_flows = GRO_RX_DEFAULT_FLOWS;
+  gm->gro_max_segments = GRO_RX_DEFAULT_SEGMENTS;
+  vec_validate_aligned (gm->gro_stats, tm->n_vlib_mains - 1,
+			CLIB_CACHE_LINE_BYTES);
 
   return 0;
 }
@@ -20,16 +20,38 @@
 #include <vnet/gso/hdr_offset_parser.h>
 #include <vnet/ip/ip_psh_cksum.h>
 
+/* receive side GRO: upper bound on flows tracked in one frame */
+#define GRO_RX_MAX_FLOWS	  64
+#define GRO_RX_DEFAULT_FLOWS	  16
+#define GRO_RX_DEFAULT_SEGMENTS 64
+
+typedef struct
+{
+  /* packets seen, segments folded into another, coalesced packets out */
+  u64 n_packets;
+  u64 n_coalesced;
+  u64 n_aggregates;
+} gro_rx_stats_t;
+
 typedef struct
 {
   vlib_main_t *vlib_main;
   vnet_main_t *vnet_main;
   u16 msg_id_base;
+
+  /* receive side GRO configuration */
+  u32 gro_max_flows;
+  u32 gro_max_segments;
+
+  /* per-thread receive side GRO counters */
+  gro_rx_stats_t *gro_stats;
 } gso_main_t;
 
 extern gso_main_t gso_main;
 
 int vnet_sw_interface_gso_enable_disable (u32 sw_if_index, u8 enable);
+int vnet_sw_interface_gro_enable_disable (u32 sw_if_index, u8 enable);
+int vnet_gro_set_config (u32 max_flows, u32 max_segments);
 u32 gso_segment_buffer (vlib_main_t *vm, vnet_interface_per_thread_data_t *ptd,
 			u32 bi, vlib_buffer_t *b, generic_header_offset_t *gho,
 			u32 n_bytes_b, u8 is_l2, u8 is_ip6);
@@ -0,0 +1,402 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+/*
+ * Per packet latency from device input to interface output.
+ *
+ * The latency-rx feature on the device-input arc stamps each buffer with
+ * the cpu clock and the receiving thread. The latency-tx feature on the
+ * interface-output arc bins the time since that stamp into per-worker
+ * histograms, one per tx interface, and, for packets which were received
+ * on another worker (i.e. passed a frame queue handoff), one per rx and
+ * tx worker pair.
+ *
+ * The histograms are in the stats segment as "/latency/tx-interface" and
+ * "/latency/handoff", with the inclusive upper bound of each bin in
+ * "/latency/le".
+ */
+
+#include <vlib/vlib.h>
+#include <vlib/stats/stats.h>
+#include <vnet/vnet.h>
+#include <vnet/feature/feature.h>
+#include <vnet/interface/latency.h>
+
+vnet_latency_main_t vnet_latency_main;
+
+static void
+vnet_latency_init_counters (vlib_main_t *vm)
+{
+  vnet_latency_main_t *lm = &vnet_latency_main;
+  counter_t **le;
+
+  if (lm->ns_per_clock_q16)
+    return;
+
+  lm->ns_per_clock_q16 = 1e9 * (1 << 16) / vm->clib_time.clocks_per_second;
+
+  lm->tx_counters.name = "latency-tx";
+  lm->tx_counters.stat_segment_name = "/latency/tx-interface";
+  lm->handoff_counters.name = "latency-handoff";
+  lm->handoff_counters.stat_segment_name = "/latency/handoff";
+  vlib_validate_simple_counter (&lm->tx_counters, VNET_LATENCY_N_BINS - 1);
+  vlib_validate_simple_counter (&lm->handoff_counters,
+				vlib_get_n_threads () * VNET_LATENCY_N_BINS -
+				  1);
+
+  lm->le_stats_index = vlib_stats_add_counter_vector ("/latency/le");
+  vlib_stats_validate (lm->le_stats_index, 0, VNET_LATENCY_N_BINS - 1);
+  le = vlib_stats_get_entry_data_pointer (lm->le_stats_index);
+  for (u32 i = 0; i < VNET_LATENCY_N_BINS - 1; i++)
+    le[0][i] = vnet_latency_bin_lower_bound (i + 1) - 1;
+  le[0][VNET_LATENCY_N_BINS - 1] = ~0ULL;
+}
+
+static void
+vnet_latency_clear_interface (u32 sw_if_index)
+{
+  vnet_latency_main_t *lm = &vnet_latency_main;
+  u32 first = sw_if_index * VNET_LATENCY_N_BINS;
+
+  for (int i = 0; i < vec_len (lm->tx_counters.counters); i++)
+    {
+      counter_t *c = lm->tx_counters.counters[i];
+      if (first + VNET_LATENCY_N_BINS <= vec_len (c))
+	clib_memset (c + first, 0, VNET_LATENCY_N_BINS * sizeof (c[0]));
+    }
+}
+
+int
+vnet_latency_enable_disable (u32 sw_if_index, u8 rx, u8 tx, u8 enable)
+{
+  vnet_latency_main_t *lm = &vnet_latency_main;
+  vnet_main_t *vnm = vnet_get_main ();
+  vnet_sw_interface_t *si;
+
+  if (!vnet_sw_interface_is_valid (vnm, sw_if_index))
+    return VNET_API_ERROR_INVALID_SW_IF_INDEX;
+
+  si = vnet_get_sw_interface (vnm, sw_if_index);
+
+  /* device-input features only run on hardware interfaces */
+  if (rx && si->type != VNET_SW_INTERFACE_TYPE_HARDWARE)
+    return VNET_API_ERROR_INVALID_VALUE;
+
+  vnet_latency_init_counters (vlib_get_main ());
+
+  if (rx && enable != clib_bitmap_get (lm->rx_enabled, sw_if_index))
+    {
+      vnet_feature_enable_disable ("device-input", "latency-rx", sw_if_index,
+				   enable, 0, 0);
+      lm->rx_enabled = clib_bitmap_set (lm->rx_enabled, sw_if_index, enable);
+    }
+
+  if (tx && enable != clib_bitmap_get (lm->tx_enabled, sw_if_index))
+    {
+      if (enable)
+	{
+	  vlib_validate_simple_counter (&lm->tx_counters,
+					(sw_if_index + 1) *
+					    VNET_LATENCY_N_BINS -
+					  1);
+	  vnet_latency_clear_interface (sw_if_index);
+	}
+      vnet_feature_enable_disable ("interface-output", "latency-tx",
+				   sw_if_index, enable, 0, 0);
+      lm->tx_enabled = clib_bitmap_set (lm->tx_enabled, sw_if_index, enable);
+    }
+
+  return 0;
+}
+
+void
+vnet_latency_clear (void)
+{
+  vnet_latency_main_t *lm = &vnet_latency_main;
+
+  if (!lm->ns_per_clock_q16)
+    return;
+
+  vlib_clear_simple_counters (&lm->tx_counters);
+  vlib_clear_simple_counters (&lm->handoff_counters);
+}
+
+static clib_error_t *
+vnet_latency_sw_interface_add_del (vnet_main_t *vnm, u32 sw_if_index,
+				   u32 is_add)
+{
+  vnet_latency_main_t *lm = &vnet_latency_main;
+
+  if (is_add)
+    return 0;
+
+  /* The features go away with the interface, forget them here too */
+  lm->rx_enabled = clib_bitmap_set (lm->rx_enabled, sw_if_index, 0);
+  lm->tx_enabled = clib_bitmap_set (lm->tx_enabled, sw_if_index, 0);
+  vnet_latency_clear_interface (sw_if_index);
+
+  return 0;
+}
+
+VNET_SW_INTERFACE_ADD_DEL_FUNCTION (vnet_latency_sw_interface_add_del);
+
+/* Sum of the per-worker histograms of index, across workers */
+static void
+vnet_latency_sum (vlib_simple_counter_main_t *cm, u32 index, u64 *bins,
+		  u32 thread_index)
+{
+  u32 first = index * VNET_LATENCY_N_BINS;
+
+  for (int i = 0; i < vec_len (cm->counters); i++)
+    {
+      counter_t *c = cm->counters[i];
+
+      if (thread_index != ~0 && i != thread_index)
+	continue;
+      if (first + VNET_LATENCY_N_BINS > vec_len (c))
+	continue;
+      for (int j = 0; j < VNET_LATENCY_N_BINS; j++)
+	bins[j] += c[first + j];
+    }
+}
+
+static u8 *
+format_vnet_latency_ns (u8 *s, va_list *args)
+{
+  u64 ns = va_arg (*args, u64);
+
+  if (ns == ~0ULL)
+    return format (s, "inf");
+  if (ns < 10000)
+    return format (s, "%luns", ns);
+  if (ns < 10000000)
+    return format (s, "%.1fus", ns * 1e-3);
+  return format (s, "%.1fms", ns * 1e-6);
+}
+
+/* Upper bound of the bin holding quantile q */
+static u64
+vnet_latency_quantile (u64 *bins, u64 total, f64 q)
+{
+  u64 sum = 0, rank = q * total;
+
+  for (u32 i = 0; i < VNET_LATENCY_N_BINS - 1; i++)
+    {
+      sum += bins[i];
+      if (sum > rank)
+	return vnet_latency_bin_lower_bound (i + 1) - 1;
+    }
+
+  return ~0ULL;
+}
+
+static u8 *
+format_vnet_latency_histogram (u8 *s, va_list *args)
+{
+  u8 *name = va_arg (*args, u8 *);
+  u64 *bins = va_arg (*args, u64 *);
+  int verbose = va_arg (*args, int);
+  u32 indent = format_get_indent (s);
+  u64 total = 0;
+
+  if (name == 0)
+    return format (s, "%-32s%12s%10s%10s%10s%10s", "Name", "Packets", "p50",
+		   "p90", "p99", "p99.9");
+
+  for (u32 i = 0; i < VNET_LATENCY_N_BINS; i++)
+    total += bins[i];
+
+  if (total == 0)
+    return format (s, "%-32v%12lu%10s%10s%10s%10s", name, total, "-", "-",
+		   "-", "-");
+
+  s = format (s, "%-32v%12lu%10U%10U%10U%10U", name, total,
+	      format_vnet_latency_ns, vnet_latency_quantile (bins, total, 0.5),
+	      format_vnet_latency_ns, vnet_latency_quantile (bins, total, 0.9),
+	      format_vnet_latency_ns,
+	      vnet_latency_quantile (bins, total, 0.99),
+	      format_vnet_latency_ns,
+	      vnet_latency_quantile (bins, total, 0.999));
+
+  if (!verbose)
+    return s;
+
+  for (u32 i = 0; i < VNET_LATENCY_N_BINS; i++)
+    {
+      if (bins[i] == 0)
+	continue;
+      s = format (s, "\n%U  %U - %U%12lu", format_white_space, indent,
+		  format_vnet_latency_ns, vnet_latency_bin_lower_bound (i),
+		  format_vnet_latency_ns,
+		  i < VNET_LATENCY_N_BINS - 1 ?
+		    vnet_latency_bin_lower_bound (i + 1) - 1 :
+		    ~0ULL,
+		  bins[i]);
+    }
+
+  return s;
+}
+
+static clib_error_t *
+set_interface_latency_command_fn (vlib_main_t *vm, unformat_input_t *input,
+				  vlib_cli_command_t *cmd)
+{
+  vnet_main_t *vnm = vnet_get_main ();
+  u32 sw_if_index = ~0;
+  u8 rx = 0, tx = 0, enable = 1;
+  int rv;
+
+  while (unformat_check_input (input) != UNFORMAT_END_OF_INPUT)
+    {
+      if (unformat (input, "%U", unformat_vnet_sw_interface, vnm,
+		    &sw_if_index))
+	;
+      else if (unformat (input, "rx"))
+	rx = 1;
+      else if (unformat (input, "tx"))
+	tx = 1;
+      else if (unformat (input, "disable"))
+	enable = 0;
+      else
+	return clib_error_return (0, "unknown input '%U'",
+				  format_unformat_error, input);
+    }
+
+  if (sw_if_index == ~0)
+    return clib_error_return (0, "interface required");
+
+  if (!rx && !tx)
+    rx = tx = 1;
+
+  rv = vnet_latency_enable_disable (sw_if_index, rx, tx, enable);
+
+  switch (rv)
+    {
+    case 0:
+      break;
+    case VNET_API_ERROR_INVALID_VALUE:
+      return clib_error_return (0, "rx stamping needs a hardware interface");
+    default:
+      return clib_error_return (0, "failed: %d", rv);
+    }
+
+  return 0;
+}
+
+/*?
+ * Stamp packets received on an interface ('rx') and/or record the latency
+ * of stamped packets sent on it ('tx'). Without 'rx' or 'tx' both are
+ * configured. Packets are only measured between an rx and a tx enabled
+ * interface.
+ *
+ * @cliexpar
+ * @cliexcmd{set interface latency GigabitEthernet2/0/0}
+ * @cliexcmd{set interface latency GigabitEthernet2/0/0 tx disable}
+?*/
+VLIB_CLI_COMMAND (set_interface_latency_command, static) = {
+  .path = "set interface latency",
+  .short_help = "set interface latency <interface> [rx] [tx] [disable]",
+  .function = set_interface_latency_command_fn,
+};
+
+static clib_error_t *
+show_interface_latency_command_fn (vlib_main_t *vm, unformat_input_t *input,
+				   vlib_cli_command_t *cmd)
+{
+  vnet_latency_main_t *lm = &vnet_latency_main;
+  vnet_main_t *vnm = vnet_get_main ();
+  u64 bins[VNET_LATENCY_N_BINS];
+  u32 sw_if_index = ~0, i;
+  int verbose = 0;
+  u8 *name = 0;
+
+  while (unformat_check_input (input) != UNFORMAT_END_OF_INPUT)
+    {
+      if (unformat (input, "%U", unformat_vnet_sw_interface, vnm,
+		    &sw_if_index))
+	verbose = 1;
+      else if (unformat (input, "verbose"))
+	verbose = 1;
+      else
+	return clib_error_return (0, "unknown input '%U'",
+				  format_unformat_error, input);
+    }
+
+  if (clib_bitmap_is_zero (lm->tx_enabled) &&
+      clib_bitmap_is_zero (lm->rx_enabled))
+    {
+      /* Not an error, that would fall back to plain "show interface" */
+      vlib_cli_output (vm, "latency measurement not enabled");
+      return 0;
+    }
+
+  vlib_cli_output (vm, "%U", format_vnet_latency_histogram, 0, 0, 0);
+
+  clib_bitmap_foreach (i, lm->tx_enabled)
+    {
+      if (sw_if_index != ~0 && i != sw_if_index)
+	continue;
+      clib_memset (bins, 0, sizeof (bins));
+      vnet_latency_sum (&lm->tx_counters, i, bins, ~0);
+      name = format (name, "%U", format_vnet_sw_if_index_name, vnm, i);
+      vlib_cli_output (vm, "%U", format_vnet_latency_histogram, name, bins,
+		       verbose);
+      vec_reset_length (name);
+    }
+
+  /* Handoff paths, rx worker to tx worker */
+  for (u32 tx = 0; tx < vec_len (lm->handoff_counters.counters); tx++)
+    for (u32 rx = 0; rx < vlib_get_n_threads (); rx++)
+      {
+	u64 total = 0;
+
+	clib_memset (bins, 0, sizeof (bins));
+	vnet_latency_sum (&lm->handoff_counters, rx, bins, tx);
+	for (int j = 0; j < VNET_LATENCY_N_BINS; j++)
+	  total += bins[j];
+	if (total == 0)
+	  continue;
+
+	name = format (name, "handoff %u -> %u", rx, tx);
+	vlib_cli_output (vm, "%U", format_vnet_latency_histogram, name, bins,
+			 verbose);
+	vec_reset_length (name);
+      }
+
+  vec_free (name);
+  return 0;
+}
+
+/*?
+ * Show rx to tx packet latency percentiles per tx interface and per
+ * handoff path between workers. Percentiles are the upper bound of the
+ * histogram bin they fall in. 'verbose', or naming an interface, also
+ * shows the histogram bins.
+ *
+ * @cliexpar
+ * @cliexstart{show interface latency}
+ * Name                                 Packets       p50       p90       p99     p99.9
+ * GigabitEthernet2/0/0                 1048576     1279ns    2559ns   11.3us    24.5us
+ * handoff 1 -> 2                        524288     2047ns    4095ns   14.3us    28.6us
+ * @cliexend
+?*/
+VLIB_CLI_COMMAND (show_interface_latency_command, static) = {
+  .path = "show interface latency",
+  .short_help = "show interface latency [<interface>] [verbose]",
+  .function = show_interface_latency_command_fn,
+};
+
+static clib_error_t *
+clear_interface_latency_command_fn (vlib_main_t *vm, unformat_input_t *input,
+				    vlib_cli_command_t *cmd)
+{
+  vnet_latency_clear ();
+  return 0;
+}
+
+VLIB_CLI_COMMAND (clear_interface_latency_command, static) = {
+  .path = "clear interface latency",
+  .short_help = "clear interface latency",
+  .function = clear_interface_latency_command_fn,
+};
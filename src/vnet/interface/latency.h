@@ -0,0 +1,72 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#ifndef __VNET_INTERFACE_LATENCY_H__
+#define __VNET_INTERFACE_LATENCY_H__
+
+#include <vnet/vnet.h>
+
+/*
+ * Packet latency, rx to tx, in log-linear bins of nanoseconds: 4 bins per
+ * power of two, i.e. at most 25% error. The last bin also counts
+ * everything from 2^31 ns up.
+ */
+#define VNET_LATENCY_SUB_BIN_BITS 2
+#define VNET_LATENCY_N_BINS	  120
+
+typedef struct
+{
+  /* per worker, indexed by tx sw_if_index * VNET_LATENCY_N_BINS + bin */
+  vlib_simple_counter_main_t tx_counters;
+
+  /* per tx worker, indexed by rx worker * VNET_LATENCY_N_BINS + bin */
+  vlib_simple_counter_main_t handoff_counters;
+
+  /* bin upper bounds in ns, companion of the histograms above */
+  u32 le_stats_index;
+
+  /* ns = (clocks * ns_per_clock_q16) >> 16 */
+  u64 ns_per_clock_q16;
+
+  uword *rx_enabled;
+  uword *tx_enabled;
+} vnet_latency_main_t;
+
+extern vnet_latency_main_t vnet_latency_main;
+
+static_always_inline u32
+vnet_latency_bin (u64 ns)
+{
+  u32 e, bin;
+
+  if (ns < (1 << VNET_LATENCY_SUB_BIN_BITS))
+    return ns;
+
+  e = min_log2_u64 (ns);
+  bin = (e - VNET_LATENCY_SUB_BIN_BITS + 1) << VNET_LATENCY_SUB_BIN_BITS;
+  bin += (ns >> (e - VNET_LATENCY_SUB_BIN_BITS)) &
+	 pow2_mask (VNET_LATENCY_SUB_BIN_BITS);
+
+  return clib_min (bin, VNET_LATENCY_N_BINS - 1);
+}
+
+/* Smallest latency in ns which falls into bin */
+static_always_inline u64
+vnet_latency_bin_lower_bound (u32 bin)
+{
+  u32 e;
+
+  if (bin < (1 << VNET_LATENCY_SUB_BIN_BITS))
+    return bin;
+
+  e = (bin >> VNET_LATENCY_SUB_BIN_BITS) + VNET_LATENCY_SUB_BIN_BITS - 1;
+  return (u64) ((1 << VNET_LATENCY_SUB_BIN_BITS) |
+		(bin & pow2_mask (VNET_LATENCY_SUB_BIN_BITS)))
+	 << (e - VNET_LATENCY_SUB_BIN_BITS);
+}
+
+int vnet_latency_enable_disable (u32 sw_if_index, u8 rx, u8 tx, u8 enable);
+void vnet_latency_clear (void);
+
+#endif /* __VNET_INTERFACE_LATENCY_H__ */
@@ -0,0 +1,211 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#include <vlib/vlib.h>
+#include <vnet/vnet.h>
+#include <vnet/feature/feature.h>
+#include <vnet/interface/latency.h>
+
+typedef struct
+{
+  u32 sw_if_index;
+  u32 ns;
+  clib_thread_index_t rx_thread_index;
+  u8 is_valid;
+} latency_trace_t;
+
+static u8 *
+format_latency_rx_trace (u8 *s, va_list *args)
+{
+  CLIB_UNUSED (vlib_main_t * vm) = va_arg (*args, vlib_main_t *);
+  CLIB_UNUSED (vlib_node_t * node) = va_arg (*args, vlib_node_t *);
+  latency_trace_t *t = va_arg (*args, latency_trace_t *);
+
+  return format (s, "latency-rx: sw_if_index %u stamped on thread %u",
+		 t->sw_if_index, t->rx_thread_index);
+}
+
+static u8 *
+format_latency_tx_trace (u8 *s, va_list *args)
+{
+  CLIB_UNUSED (vlib_main_t * vm) = va_arg (*args, vlib_main_t *);
+  CLIB_UNUSED (vlib_node_t * node) = va_arg (*args, vlib_node_t *);
+  latency_trace_t *t = va_arg (*args, latency_trace_t *);
+
+  if (!t->is_valid)
+    return format (s, "latency-tx: sw_if_index %u not stamped",
+		   t->sw_if_index);
+
+  return format (s, "latency-tx: sw_if_index %u %u ns from thread %u",
+		 t->sw_if_index, t->ns, t->rx_thread_index);
+}
+
+static_always_inline void
+latency_rx_stamp (vlib_buffer_t *b, u32 now, clib_thread_index_t thread_index)
+{
+  b->flags |= VNET_BUFFER_F_LATENCY_VALID;
+  vnet_buffer2 (b)->latency_rx_time = now;
+  vnet_buffer2 (b)->latency_rx_thread_index = thread_index;
+}
+
+/*
+ * Record the latency of b in the histogram of its tx interface and, if it
+ * was received on another worker, in the one of the handoff path.
+ */
+static_always_inline void
+latency_tx_record (vnet_latency_main_t *lm, vlib_buffer_t *b, u32 now,
+		   clib_thread_index_t thread_index)
+{
+  u32 sw_if_index, bin;
+  u64 ns;
+
+  if (!(b->flags & VNET_BUFFER_F_LATENCY_VALID))
+    return;
+
+  ns = ((u64) (now - vnet_buffer2 (b)->latency_rx_time) *
+	lm->ns_per_clock_q16) >>
+       16;
+  bin = vnet_latency_bin (ns);
+  sw_if_index = vnet_buffer (b)->sw_if_index[VLIB_TX];
+
+  vlib_increment_simple_counter (&lm->tx_counters, thread_index,
+				 sw_if_index * VNET_LATENCY_N_BINS + bin, 1);
+
+  if (vnet_buffer2 (b)->latency_rx_thread_index != thread_index)
+    vlib_increment_simple_counter (
+      &lm->handoff_counters, thread_index,
+      vnet_buffer2 (b)->latency_rx_thread_index * VNET_LATENCY_N_BINS + bin,
+      1);
+}
+
+static_always_inline uword
+latency_inline (vlib_main_t *vm, vlib_node_runtime_t *node,
+		vlib_frame_t *frame, vlib_rx_or_tx_t rxtx)
+{
+  vnet_latency_main_t *lm = &vnet_latency_main;
+  vlib_buffer_t *bufs[VLIB_FRAME_SIZE], **b = bufs;
+  u16 nexts[VLIB_FRAME_SIZE], *next = nexts;
+  clib_thread_index_t thread_index = vm->thread_index;
+  u32 *from, n_left;
+  u32 now;
+
+  from = vlib_frame_vector_args (frame);
+  n_left = frame->n_vectors;
+  vlib_get_buffers (vm, from, bufs, n_left);
+
+  /* All packets of the frame share one timestamp */
+  now = clib_cpu_time_now ();
+
+  while (n_left >= 4)
+    {
+      if (n_left >= 8)
+	{
+	  vlib_prefetch_buffer_header (b[4], STORE);
+	  vlib_prefetch_buffer_header (b[5], STORE);
+	  vlib_prefetch_buffer_header (b[6], STORE);
+	  vlib_prefetch_buffer_header (b[7], STORE);
+	}
+
+      if (rxtx == VLIB_RX)
+	{
+	  latency_rx_stamp (b[0], now, thread_index);
+	  latency_rx_stamp (b[1], now, thread_index);
+	  latency_rx_stamp (b[2], now, thread_index);
+	  latency_rx_stamp (b[3], now, thread_index);
+	}
+      else
+	{
+	  latency_tx_record (lm, b[0], now, thread_index);
+	  latency_tx_record (lm, b[1], now, thread_index);
+	  latency_tx_record (lm, b[2], now, thread_index);
+	  latency_tx_record (lm, b[3], now, thread_index);
+	}
+
+      vnet_feature_next_u16 (next + 0, b[0]);
+      vnet_feature_next_u16 (next + 1, b[1]);
+      vnet_feature_next_u16 (next + 2, b[2]);
+      vnet_feature_next_u16 (next + 3, b[3]);
+
+      b += 4;
+      next += 4;
+      n_left -= 4;
+    }
+
+  while (n_left)
+    {
+      if (rxtx == VLIB_RX)
+	latency_rx_stamp (b[0], now, thread_index);
+      else
+	latency_tx_record (lm, b[0], now, thread_index);
+
+      vnet_feature_next_u16 (next, b[0]);
+
+      b += 1;
+      next += 1;
+      n_left -= 1;
+    }
+
+  if (PREDICT_FALSE (node->flags & VLIB_NODE_FLAG_TRACE))
+    {
+      b = bufs;
+      for (u32 i = 0; i < frame->n_vectors; i++, b++)
+	{
+	  latency_trace_t *t;
+
+	  if (!(b[0]->flags & VLIB_BUFFER_IS_TRACED))
+	    continue;
+
+	  t = vlib_add_trace (vm, node, b[0], sizeof (*t));
+	  t->sw_if_index = vnet_buffer (b[0])->sw_if_index[rxtx];
+	  t->rx_thread_index = vnet_buffer2 (b[0])->latency_rx_thread_index;
+	  t->is_valid = (b[0]->flags & VNET_BUFFER_F_LATENCY_VALID) != 0;
+	  t->ns = ((u64) (now - vnet_buffer2 (b[0])->latency_rx_time) *
+		   lm->ns_per_clock_q16) >>
+		  16;
+	}
+    }
+
+  vlib_buffer_enqueue_to_next (vm, node, from, nexts, frame->n_vectors);
+
+  return frame->n_vectors;
+}
+
+VLIB_NODE_FN (latency_rx_node)
+(vlib_main_t *vm, vlib_node_runtime_t *node, vlib_frame_t *frame)
+{
+  return latency_inline (vm, node, frame, VLIB_RX);
+}
+
+VLIB_NODE_FN (latency_tx_node)
+(vlib_main_t *vm, vlib_node_runtime_t *node, vlib_frame_t *frame)
+{
+  return latency_inline (vm, node, frame, VLIB_TX);
+}
+
+VLIB_REGISTER_NODE (latency_rx_node) = {
+  .name = "latency-rx",
+  .vector_size = sizeof (u32),
+  .format_trace = format_latency_rx_trace,
+  .type = VLIB_NODE_TYPE_INTERNAL,
+};
+
+VLIB_REGISTER_NODE (latency_tx_node) = {
+  .name = "latency-tx",
+  .vector_size = sizeof (u32),
+  .format_trace = format_latency_tx_trace,
+  .type = VLIB_NODE_TYPE_INTERNAL,
+};
+
+VNET_FEATURE_INIT (latency_rx_node, static) = {
+  .arc_name = "device-input",
+  .node_name = "latency-rx",
+  /* Stamp on the receiving worker, before any handoff */
+  .runs_before = VNET_FEATURES ("l2-patch", "worker-handoff", "ethernet-input"),
+};
+
+VNET_FEATURE_INIT (latency_tx_node, static) = {
+  .arc_name = "interface-output",
+  .node_name = "latency-tx",
+  .runs_before = VNET_FEATURES ("interface-output-arc-end"),
+};
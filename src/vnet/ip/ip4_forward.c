@@ -100,6 +100,23 @@ VLIB_NODE_FN (ip4_lookup_node) (vlib_main_t * vm, vlib_node_runtime_t * node,
   return ip4_lookup_inline (vm, node, frame);
 }
 
+CLIB_MARCH_FN (ip4_fib_forwarding_lookup_frame, void, const u32 *fib_indices,
+	       const ip4_address_t *addrs, index_t *lbs, u32 n_left)
+{
+  ip4_fib_forwarding_lookup_x (fib_indices, addrs, lbs, n_left);
+}
+
+#ifndef CLIB_MARCH_VARIANT
+void
+ip4_fib_forwarding_lookup_frame (const u32 *fib_indices,
+				 const ip4_address_t *addrs, index_t *lbs,
+				 u32 n_left)
+{
+  CLIB_MARCH_FN_SELECT (ip4_fib_forwarding_lookup_frame)
+  (fib_indices, addrs, lbs, n_left);
+}
+#endif
+
 static u8 *format_ip4_lookup_trace (u8 * s, va_list * args);
 
 VLIB_REGISTER_NODE (ip4_lookup_node) =
@@ -63,18 +63,43 @@ ip4_lookup_inline (vlib_main_t * vm,
   vlib_buffer_t *bufs[VLIB_FRAME_SIZE];
   vlib_buffer_t **b = bufs;
   u16 nexts[VLIB_FRAME_SIZE], *next;
+  ip4_address_t dst_addrs[VLIB_FRAME_SIZE];
+  u32 fib_indices[VLIB_FRAME_SIZE];
+  index_t lbis[VLIB_FRAME_SIZE], *lbi;
+  ip4_header_t *ip;
+  u32 i;
 
   from = vlib_frame_vector_args (frame);
   n_left = frame->n_vectors;
   next = nexts;
+  lbi = lbis;
   vlib_get_buffers (vm, from, bufs, n_left);
 
+  /*
+   * Collect the table and destination of each packet, then resolve the
+   * whole frame in one pass over the mtrie.
+   */
+  for (i = 0; i < n_left; i++)
+    {
+      if (i + 4 < n_left)
+	{
+	  vlib_prefetch_buffer_header (b[i + 4], LOAD);
+	  CLIB_PREFETCH (b[i + 4]->data, sizeof (ip[0]), LOAD);
+	}
+
+      ip = vlib_buffer_get_current (b[i]);
+      ip_lookup_set_buffer_fib_index (im->fib_index_by_sw_if_index, b[i]);
+      fib_indices[i] = vnet_buffer (b[i])->ip.fib_index;
+      dst_addrs[i] = ip->dst_address;
+    }
+
+  ip4_fib_forwarding_lookup_x (fib_indices, dst_addrs, lbis, n_left);
+
 #if (CLIB_N_PREFETCHES >= 8)
   while (n_left >= 4)
     {
       ip4_header_t *ip0, *ip1, *ip2, *ip3;
       const load_balance_t *lb0, *lb1, *lb2, *lb3;
-      ip4_address_t *dst_addr0, *dst_addr1, *dst_addr2, *dst_addr3;
       u32 lb_index0, lb_index1, lb_index2, lb_index3;
       flow_hash_config_t flow_hash_config0, flow_hash_config1;
       flow_hash_config_t flow_hash_config2, flow_hash_config3;
@@ -100,21 +125,10 @@ ip4_lookup_inline (vlib_main_t * vm,
       ip2 = vlib_buffer_get_current (b[2]);
       ip3 = vlib_buffer_get_current (b[3]);
 
-      dst_addr0 = &ip0->dst_address;
-      dst_addr1 = &ip1->dst_address;
-      dst_addr2 = &ip2->dst_address;
-      dst_addr3 = &ip3->dst_address;
-
-      ip_lookup_set_buffer_fib_index (im->fib_index_by_sw_if_index, b[0]);
-      ip_lookup_set_buffer_fib_index (im->fib_index_by_sw_if_index, b[1]);
-      ip_lookup_set_buffer_fib_index (im->fib_index_by_sw_if_index, b[2]);
-      ip_lookup_set_buffer_fib_index (im->fib_index_by_sw_if_index, b[3]);
-
-      ip4_fib_forwarding_lookup_x4 (
-	vnet_buffer (b[0])->ip.fib_index, vnet_buffer (b[1])->ip.fib_index,
-	vnet_buffer (b[2])->ip.fib_index, vnet_buffer (b[3])->ip.fib_index,
-	dst_addr0, dst_addr1, dst_addr2, dst_addr3, &lb_index0, &lb_index1,
-	&lb_index2, &lb_index3);
+      lb_index0 = lbi[0];
+      lb_index1 = lbi[1];
+      lb_index2 = lbi[2];
+      lb_index3 = lbi[3];
 
       ASSERT (lb_index0 && lb_index1 && lb_index2 && lb_index3);
       lb0 = load_balance_get (lb_index0);
@@ -216,6 +230,7 @@ ip4_lookup_inline (vlib_main_t * vm,
 	 vlib_buffer_length_in_chain (vm, b[3]));
 
       b += 4;
+      lbi += 4;
       next += 4;
       n_left -= 4;
     }
@@ -224,7 +239,6 @@ ip4_lookup_inline (vlib_main_t * vm,
     {
       ip4_header_t *ip0, *ip1;
       const load_balance_t *lb0, *lb1;
-      ip4_address_t *dst_addr0, *dst_addr1;
       u32 lb_index0, lb_index1;
       flow_hash_config_t flow_hash_config0, flow_hash_config1;
       u32 hash_c0, hash_c1;
@@ -242,15 +256,8 @@ ip4_lookup_inline (vlib_main_t * vm,
       ip0 = vlib_buffer_get_current (b[0]);
       ip1 = vlib_buffer_get_current (b[1]);
 
-      dst_addr0 = &ip0->dst_address;
-      dst_addr1 = &ip1->dst_address;
-
-      ip_lookup_set_buffer_fib_index (im->fib_index_by_sw_if_index, b[0]);
-      ip_lookup_set_buffer_fib_index (im->fib_index_by_sw_if_index, b[1]);
-
-      ip4_fib_forwarding_lookup_x2 (
-	vnet_buffer (b[0])->ip.fib_index, vnet_buffer (b[1])->ip.fib_index,
-	dst_addr0, dst_addr1, &lb_index0, &lb_index1);
+      lb_index0 = lbi[0];
+      lb_index1 = lbi[1];
 
       ASSERT (lb_index0 && lb_index1);
       lb0 = load_balance_get (lb_index0);
@@ -306,6 +313,7 @@ ip4_lookup_inline (vlib_main_t * vm,
 	 vlib_buffer_length_in_chain (vm, b[1]));
 
       b += 2;
+      lbi += 2;
       next += 2;
       n_left -= 2;
     }
@@ -314,18 +322,13 @@ ip4_lookup_inline (vlib_main_t * vm,
     {
       ip4_header_t *ip0;
       const load_balance_t *lb0;
-      ip4_address_t *dst_addr0;
       u32 lbi0;
       flow_hash_config_t flow_hash_config0;
       const dpo_id_t *dpo0;
       u32 hash_c0;
 
       ip0 = vlib_buffer_get_current (b[0]);
-      dst_addr0 = &ip0->dst_address;
-      ip_lookup_set_buffer_fib_index (im->fib_index_by_sw_if_index, b[0]);
-
-      lbi0 = ip4_fib_forwarding_lookup (vnet_buffer (b[0])->ip.fib_index,
-					dst_addr0);
+      lbi0 = lbi[0];
 
       ASSERT (lbi0);
       lb0 = load_balance_get (lbi0);
@@ -359,6 +362,7 @@ ip4_lookup_inline (vlib_main_t * vm,
 								    b[0]));
 
       b += 1;
+      lbi += 1;
       next += 1;
       n_left -= 1;
     }
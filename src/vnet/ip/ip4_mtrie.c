@@ -40,6 +40,7 @@
 #include <vnet/ip/ip.h>
 #include <vnet/ip/ip4_mtrie.h>
 #include <vnet/fib/ip4_fib.h>
+#include <vnet/fib/fib_epoch.h>
 
 
 /**
@@ -121,7 +122,7 @@ ply_create (ip4_mtrie_leaf_t init_leaf, u32 leaf_prefix_len, u32 ply_base_len)
   ASSERT (vm->thread_index == 0);
 
   if (need_barrier_sync)
-    vlib_worker_thread_barrier_sync (vm);
+    fib_barrier_sync (vm);
 
   /* Get cache aligned ply. */
   pool_get_aligned (ip4_ply_pool, p, CLIB_CACHE_LINE_BYTES);
@@ -130,7 +131,7 @@ ply_create (ip4_mtrie_leaf_t init_leaf, u32 leaf_prefix_len, u32 ply_base_len)
   l = ip4_mtrie_leaf_set_next_ply_index (p - ip4_ply_pool);
 
   if (need_barrier_sync)
-    vlib_worker_thread_barrier_release (vm);
+    fib_barrier_release (vm);
 
   return l;
 }
@@ -473,6 +474,12 @@ set_root_leaf (ip4_mtrie_16_t *m, const ip4_mtrie_set_unset_leaf_args_t *a)
     }
 }
 
+static void
+ip4_mtrie_ply_reclaim (uword ply_index)
+{
+  pool_put_index (ip4_ply_pool, ply_index);
+}
+
 static uword
 unset_leaf (const ip4_mtrie_set_unset_leaf_args_t *a,
 	    ip4_mtrie_8_ply_t *old_ply, u32 dst_address_byte_index)
@@ -522,7 +529,9 @@ unset_leaf (const ip4_mtrie_set_unset_leaf_args_t *a,
 	  ASSERT (old_ply->n_non_empty_leafs >= 0);
 	  if (old_ply->n_non_empty_leafs == 0 && dst_address_byte_index > 0)
 	    {
-	      pool_put (ip4_ply_pool, old_ply);
+	      /* the parent still points to it, as may the workers */
+	      fib_epoch_retire (ip4_mtrie_ply_reclaim,
+				old_ply - ip4_ply_pool);
 	      /* Old ply was deleted. */
 	      return 1;
 	    }
@@ -268,6 +268,190 @@ ip4_mtrie_8_lookup_step_one (const ip4_mtrie_8_t *m,
   return next_leaf;
 }
 
+/**
+ * The number of leaves between the start of consecutive plies in the pool,
+ * i.e. the scale of a ply index when the pool is addressed as a leaf array.
+ */
+#define IP4_MTRIE_PLY_N_LEAVES                                                \
+  (sizeof (ip4_mtrie_8_ply_t) / sizeof (ip4_mtrie_leaf_t))
+
+#if defined(CLIB_HAVE_VEC256) && defined(__AVX2__)
+/**
+ * The gathers address the ply pool with signed 32 bit leaf offsets, so
+ * they can only be used while the pool is smaller than this.
+ */
+#define IP4_MTRIE_GATHER_MAX_PLIES ((1U << 31) / IP4_MTRIE_PLY_N_LEAVES)
+
+/**
+ * @brief Walk the 8 bit strides of 8 lookups starting at the address bit
+ * 'shift'. Each stride is one masked gather, lanes that have already
+ * reached a terminal leaf are not loaded again.
+ */
+static_always_inline u32x8
+ip4_mtrie_lookup_x8_plies (u32x8 leaf, u32x8 addr, u32 shift)
+{
+  u32x8 non_terminal, offset;
+
+  for (; shift < 32; shift += 8)
+    {
+      non_terminal = (u32x8) ((leaf & 1) == 0);
+
+      if (u32x8_is_all_zero (non_terminal))
+	break;
+
+      offset = (leaf >> 1) * IP4_MTRIE_PLY_N_LEAVES + ((addr >> shift) & 0xff);
+      leaf = u32x8_mask_gather_u32 (leaf, ip4_ply_pool->leaves, offset,
+				    non_terminal, sizeof (ip4_mtrie_leaf_t));
+    }
+
+  return leaf;
+}
+#endif
+
+/**
+ * @brief Lookup a vector of addresses in one 16-8-8 mtrie.
+ *
+ * Rather than walking each address to its terminal leaf in turn, the root
+ * ply is read for a group of addresses, then the second ply for those that
+ * are not yet resolved and so on. The loads of a stride are independent of
+ * one another so their cache misses overlap.
+ */
+static_always_inline void
+ip4_mtrie_16_lookup_x (const ip4_mtrie_16_t *m,
+		       const ip4_address_t *dst_addresses, u32 *lbis,
+		       u32 n_left)
+{
+  ip4_mtrie_leaf_t leaf[4];
+  const ip4_address_t *a = dst_addresses;
+
+#if defined(CLIB_HAVE_VEC256) && defined(__AVX2__)
+  if (PREDICT_TRUE (pool_len (ip4_ply_pool) < IP4_MTRIE_GATHER_MAX_PLIES))
+    while (n_left >= 8)
+      {
+	u32x8 addr, l;
+
+	addr = u32x8_load_unaligned ((void *) a);
+	l = u32x8_gather_u32 (m->root_ply.leaves, (addr & 0xffff),
+			      sizeof (ip4_mtrie_leaf_t));
+	l = ip4_mtrie_lookup_x8_plies (l, addr, 16);
+	u32x8_store_unaligned (l >> 1, lbis);
+
+	a += 8;
+	lbis += 8;
+	n_left -= 8;
+      }
+#endif
+
+  while (n_left >= 4)
+    {
+      leaf[0] = ip4_mtrie_16_lookup_step_one (m, a + 0);
+      leaf[1] = ip4_mtrie_16_lookup_step_one (m, a + 1);
+      leaf[2] = ip4_mtrie_16_lookup_step_one (m, a + 2);
+      leaf[3] = ip4_mtrie_16_lookup_step_one (m, a + 3);
+
+      leaf[0] = ip4_mtrie_16_lookup_step (leaf[0], a + 0, 2);
+      leaf[1] = ip4_mtrie_16_lookup_step (leaf[1], a + 1, 2);
+      leaf[2] = ip4_mtrie_16_lookup_step (leaf[2], a + 2, 2);
+      leaf[3] = ip4_mtrie_16_lookup_step (leaf[3], a + 3, 2);
+
+      leaf[0] = ip4_mtrie_16_lookup_step (leaf[0], a + 0, 3);
+      leaf[1] = ip4_mtrie_16_lookup_step (leaf[1], a + 1, 3);
+      leaf[2] = ip4_mtrie_16_lookup_step (leaf[2], a + 2, 3);
+      leaf[3] = ip4_mtrie_16_lookup_step (leaf[3], a + 3, 3);
+
+      lbis[0] = ip4_mtrie_leaf_get_adj_index (leaf[0]);
+      lbis[1] = ip4_mtrie_leaf_get_adj_index (leaf[1]);
+      lbis[2] = ip4_mtrie_leaf_get_adj_index (leaf[2]);
+      lbis[3] = ip4_mtrie_leaf_get_adj_index (leaf[3]);
+
+      a += 4;
+      lbis += 4;
+      n_left -= 4;
+    }
+
+  while (n_left)
+    {
+      leaf[0] = ip4_mtrie_16_lookup_step_one (m, a);
+      leaf[0] = ip4_mtrie_16_lookup_step (leaf[0], a, 2);
+      leaf[0] = ip4_mtrie_16_lookup_step (leaf[0], a, 3);
+      lbis[0] = ip4_mtrie_leaf_get_adj_index (leaf[0]);
+
+      a += 1;
+      lbis += 1;
+      n_left -= 1;
+    }
+}
+
+/**
+ * @brief Lookup a vector of addresses in one 8-8-8-8 mtrie.
+ * See ip4_mtrie_16_lookup_x.
+ */
+static_always_inline void
+ip4_mtrie_8_lookup_x (const ip4_mtrie_8_t *m,
+		      const ip4_address_t *dst_addresses, u32 *lbis,
+		      u32 n_left)
+{
+  ip4_mtrie_leaf_t leaf[4];
+  const ip4_address_t *a = dst_addresses;
+  u32 i;
+
+#if defined(CLIB_HAVE_VEC256) && defined(__AVX2__)
+  if (PREDICT_TRUE (pool_len (ip4_ply_pool) < IP4_MTRIE_GATHER_MAX_PLIES))
+    while (n_left >= 8)
+      {
+	u32x8 addr, l;
+	u32 root = m->root_ply * IP4_MTRIE_PLY_N_LEAVES;
+
+	addr = u32x8_load_unaligned ((void *) a);
+	l = u32x8_gather_u32 (ip4_ply_pool->leaves, (root + (addr & 0xff)),
+			      sizeof (ip4_mtrie_leaf_t));
+	l = ip4_mtrie_lookup_x8_plies (l, addr, 8);
+	u32x8_store_unaligned (l >> 1, lbis);
+
+	a += 8;
+	lbis += 8;
+	n_left -= 8;
+      }
+#endif
+
+  while (n_left >= 4)
+    {
+      leaf[0] = ip4_mtrie_8_lookup_step_one (m, a + 0);
+      leaf[1] = ip4_mtrie_8_lookup_step_one (m, a + 1);
+      leaf[2] = ip4_mtrie_8_lookup_step_one (m, a + 2);
+      leaf[3] = ip4_mtrie_8_lookup_step_one (m, a + 3);
+
+      for (i = 1; i < 4; i++)
+	{
+	  leaf[0] = ip4_mtrie_8_lookup_step (leaf[0], a + 0, i);
+	  leaf[1] = ip4_mtrie_8_lookup_step (leaf[1], a + 1, i);
+	  leaf[2] = ip4_mtrie_8_lookup_step (leaf[2], a + 2, i);
+	  leaf[3] = ip4_mtrie_8_lookup_step (leaf[3], a + 3, i);
+	}
+
+      lbis[0] = ip4_mtrie_leaf_get_adj_index (leaf[0]);
+      lbis[1] = ip4_mtrie_leaf_get_adj_index (leaf[1]);
+      lbis[2] = ip4_mtrie_leaf_get_adj_index (leaf[2]);
+      lbis[3] = ip4_mtrie_leaf_get_adj_index (leaf[3]);
+
+      a += 4;
+      lbis += 4;
+      n_left -= 4;
+    }
+
+  while (n_left)
+    {
+      leaf[0] = ip4_mtrie_8_lookup_step_one (m, a);
+      for (i = 1; i < 4; i++)
+	leaf[0] = ip4_mtrie_8_lookup_step (leaf[0], a, i);
+      lbis[0] = ip4_mtrie_leaf_get_adj_index (leaf[0]);
+
+      a += 1;
+      lbis += 1;
+      n_left -= 1;
+    }
+}
+
 #endif /* included_ip_ip4_fib_h */
 
 /*
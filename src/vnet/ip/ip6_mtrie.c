@@ -0,0 +1,722 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#include <vnet/ip/ip.h>
+#include <vnet/ip/ip6_mtrie.h>
+#include <vnet/fib/fib_epoch.h>
+
+/**
+ * Global pool of IPv6 8bit PLYs
+ */
+ip6_mtrie_8_ply_t *ip6_ply_pool;
+
+always_inline u32
+ip6_mtrie_leaf_is_non_empty (ip6_mtrie_8_ply_t *p, u8 dst_byte)
+{
+  /*
+   * It's 'non-empty' if the length of the leaf stored is greater than the
+   * length of a leaf in the covering ply. i.e. the leaf is more specific
+   * than it's would be cover in the covering ply
+   */
+  if (p->dst_address_bits_of_leaves[dst_byte] > p->dst_address_bits_base)
+    return (1);
+  return (0);
+}
+
+always_inline ip6_mtrie_leaf_t
+ip6_mtrie_leaf_set_adj_index (u32 adj_index)
+{
+  ip6_mtrie_leaf_t l;
+  l = 1 + 2 * adj_index;
+  ASSERT (ip6_mtrie_leaf_get_adj_index (l) == adj_index);
+  return l;
+}
+
+always_inline u32
+ip6_mtrie_leaf_is_next_ply (ip6_mtrie_leaf_t n)
+{
+  return (n & 1) == 0;
+}
+
+always_inline u32
+ip6_mtrie_leaf_get_next_ply_index (ip6_mtrie_leaf_t n)
+{
+  ASSERT (ip6_mtrie_leaf_is_next_ply (n));
+  return n >> 1;
+}
+
+always_inline ip6_mtrie_leaf_t
+ip6_mtrie_leaf_set_next_ply_index (u32 i)
+{
+  ip6_mtrie_leaf_t l;
+  l = 0 + 2 * i;
+  ASSERT (ip6_mtrie_leaf_get_next_ply_index (l) == i);
+  return l;
+}
+
+static void
+ply_8_init (ip6_mtrie_8_ply_t *p, ip6_mtrie_leaf_t init, uword prefix_len,
+	    u32 ply_base_len)
+{
+  p->n_non_empty_leafs = prefix_len > ply_base_len ? ARRAY_LEN (p->leaves) : 0;
+  clib_memset_u8 (p->dst_address_bits_of_leaves, prefix_len,
+		  sizeof (p->dst_address_bits_of_leaves));
+  p->dst_address_bits_base = ply_base_len;
+
+  clib_memset_u32 (p->leaves, init, ARRAY_LEN (p->leaves));
+}
+
+static void
+ply_16_init (ip6_mtrie_16_ply_t *p, ip6_mtrie_leaf_t init, uword prefix_len)
+{
+  clib_memset_u8 (p->dst_address_bits_of_leaves, prefix_len,
+		  sizeof (p->dst_address_bits_of_leaves));
+  clib_memset_u32 (p->leaves, init, ARRAY_LEN (p->leaves));
+}
+
+static ip6_mtrie_leaf_t
+ply_create (ip6_mtrie_leaf_t init_leaf, u32 leaf_prefix_len, u32 ply_base_len)
+{
+  ip6_mtrie_8_ply_t *p;
+  ip6_mtrie_leaf_t l;
+  u8 need_barrier_sync = pool_get_will_expand (ip6_ply_pool);
+  vlib_main_t *vm = vlib_get_main ();
+  ASSERT (vm->thread_index == 0);
+
+  if (need_barrier_sync)
+    fib_barrier_sync (vm);
+
+  /* Get cache aligned ply. */
+  pool_get_aligned (ip6_ply_pool, p, CLIB_CACHE_LINE_BYTES);
+
+  ply_8_init (p, init_leaf, leaf_prefix_len, ply_base_len);
+  l = ip6_mtrie_leaf_set_next_ply_index (p - ip6_ply_pool);
+
+  if (need_barrier_sync)
+    fib_barrier_release (vm);
+
+  return l;
+}
+
+always_inline ip6_mtrie_8_ply_t *
+get_next_ply_for_leaf (ip6_mtrie_leaf_t l)
+{
+  uword n = ip6_mtrie_leaf_get_next_ply_index (l);
+
+  return pool_elt_at_index (ip6_ply_pool, n);
+}
+
+ip6_mtrie_t *
+ip6_mtrie_create (void)
+{
+  ip6_mtrie_t *m;
+
+  m = clib_mem_alloc_aligned (sizeof (*m), CLIB_CACHE_LINE_BYTES);
+  ply_16_init (&m->root_ply, IP6_MTRIE_LEAF_EMPTY, 0);
+
+  return (m);
+}
+
+static void
+ply_free (ip6_mtrie_8_ply_t *p)
+{
+  u32 i;
+
+  for (i = 0; i < ARRAY_LEN (p->leaves); i++)
+    {
+      if (ip6_mtrie_leaf_is_next_ply (p->leaves[i]))
+	ply_free (get_next_ply_for_leaf (p->leaves[i]));
+    }
+  pool_put (ip6_ply_pool, p);
+}
+
+void
+ip6_mtrie_destroy (ip6_mtrie_t *m)
+{
+  u32 i;
+
+  /*
+   * unlike the IPv4 mtrie, which is only freed once the FIB has emptied
+   * it, this mtrie can be removed from a populated table, so release
+   * whatever plies are still hanging off the root.
+   */
+  for (i = 0; i < ARRAY_LEN (m->root_ply.leaves); i++)
+    {
+      if (ip6_mtrie_leaf_is_next_ply (m->root_ply.leaves[i]))
+	ply_free (get_next_ply_for_leaf (m->root_ply.leaves[i]));
+    }
+  clib_mem_free (m);
+}
+
+typedef struct
+{
+  ip6_address_t dst_address;
+  u32 dst_address_length;
+  u32 adj_index;
+  u32 cover_address_length;
+  u32 cover_adj_index;
+} ip6_mtrie_set_unset_leaf_args_t;
+
+static void
+set_ply_with_more_specific_leaf (ip6_mtrie_8_ply_t *ply,
+				 ip6_mtrie_leaf_t new_leaf,
+				 uword new_leaf_dst_address_bits)
+{
+  ip6_mtrie_leaf_t old_leaf;
+  uword i;
+
+  ASSERT (ip6_mtrie_leaf_is_terminal (new_leaf));
+
+  for (i = 0; i < ARRAY_LEN (ply->leaves); i++)
+    {
+      old_leaf = ply->leaves[i];
+
+      /* Recurse into sub plies. */
+      if (!ip6_mtrie_leaf_is_terminal (old_leaf))
+	{
+	  ip6_mtrie_8_ply_t *sub_ply = get_next_ply_for_leaf (old_leaf);
+	  set_ply_with_more_specific_leaf (sub_ply, new_leaf,
+					   new_leaf_dst_address_bits);
+	}
+
+      /* Replace less specific terminal leaves with new leaf. */
+      else if (new_leaf_dst_address_bits >=
+	       ply->dst_address_bits_of_leaves[i])
+	{
+	  ply->n_non_empty_leafs -= ip6_mtrie_leaf_is_non_empty (ply, i);
+	  clib_atomic_store_rel_n (&ply->leaves[i], new_leaf);
+	  ply->dst_address_bits_of_leaves[i] = new_leaf_dst_address_bits;
+	  ply->n_non_empty_leafs += ip6_mtrie_leaf_is_non_empty (ply, i);
+	}
+    }
+}
+
+static void
+set_leaf (const ip6_mtrie_set_unset_leaf_args_t *a, u32 old_ply_index,
+	  u32 dst_address_byte_index)
+{
+  ip6_mtrie_leaf_t old_leaf, new_leaf;
+  i32 n_dst_bits_next_plies;
+  u8 dst_byte;
+  ip6_mtrie_8_ply_t *old_ply;
+
+  old_ply = pool_elt_at_index (ip6_ply_pool, old_ply_index);
+
+  ASSERT (a->dst_address_length <= 128);
+  ASSERT (dst_address_byte_index < ARRAY_LEN (a->dst_address.as_u8));
+
+  /* how many bits of the destination address are in the next PLY */
+  n_dst_bits_next_plies =
+    a->dst_address_length - BITS (u8) * (dst_address_byte_index + 1);
+
+  dst_byte = a->dst_address.as_u8[dst_address_byte_index];
+
+  /* Number of bits next plies <= 0 => insert leaves this ply. */
+  if (n_dst_bits_next_plies <= 0)
+    {
+      /* The mask length of the address to insert maps to this ply */
+      uword old_leaf_is_terminal;
+      u32 i, n_dst_bits_this_ply;
+
+      /* The number of bits, and hence slots/buckets, we will fill */
+      n_dst_bits_this_ply = clib_min (8, -n_dst_bits_next_plies);
+      ASSERT ((a->dst_address.as_u8[dst_address_byte_index] &
+	       pow2_mask (n_dst_bits_this_ply)) == 0);
+
+      /* Starting at the value of the byte at this section of the v6 address
+       * fill the buckets/slots of the ply */
+      for (i = dst_byte; i < dst_byte + (1 << n_dst_bits_this_ply); i++)
+	{
+	  ip6_mtrie_8_ply_t *new_ply;
+
+	  old_leaf = old_ply->leaves[i];
+	  old_leaf_is_terminal = ip6_mtrie_leaf_is_terminal (old_leaf);
+
+	  if (a->dst_address_length >= old_ply->dst_address_bits_of_leaves[i])
+	    {
+	      /* The new leaf is more or equally specific than the one currently
+	       * occupying the slot */
+	      new_leaf = ip6_mtrie_leaf_set_adj_index (a->adj_index);
+
+	      if (old_leaf_is_terminal)
+		{
+		  /* The current leaf is terminal, we can replace it with
+		   * the new one */
+		  old_ply->n_non_empty_leafs -=
+		    ip6_mtrie_leaf_is_non_empty (old_ply, i);
+
+		  old_ply->dst_address_bits_of_leaves[i] =
+		    a->dst_address_length;
+		  clib_atomic_store_rel_n (&old_ply->leaves[i], new_leaf);
+
+		  old_ply->n_non_empty_leafs +=
+		    ip6_mtrie_leaf_is_non_empty (old_ply, i);
+		  ASSERT (old_ply->n_non_empty_leafs <=
+			  ARRAY_LEN (old_ply->leaves));
+		}
+	      else
+		{
+		  /* Existing leaf points to another ply.  We need to place
+		   * new_leaf into all more specific slots. */
+		  new_ply = get_next_ply_for_leaf (old_leaf);
+		  set_ply_with_more_specific_leaf (new_ply, new_leaf,
+						   a->dst_address_length);
+		}
+	    }
+	  else if (!old_leaf_is_terminal)
+	    {
+	      /* The current leaf is less specific and not termial (i.e. a ply),
+	       * recurse on down the trie */
+	      new_ply = get_next_ply_for_leaf (old_leaf);
+	      set_leaf (a, new_ply - ip6_ply_pool, dst_address_byte_index + 1);
+	    }
+	  /*
+	   * else
+	   *  the route we are adding is less specific than the leaf currently
+	   *  occupying this slot. leave it there
+	   */
+	}
+    }
+  else
+    {
+      /* The address to insert requires us to move down at a lower level of
+       * the trie - recurse on down */
+      ip6_mtrie_8_ply_t *new_ply;
+      u8 ply_base_len;
+
+      ply_base_len = 8 * (dst_address_byte_index + 1);
+
+      old_leaf = old_ply->leaves[dst_byte];
+
+      if (ip6_mtrie_leaf_is_terminal (old_leaf))
+	{
+	  /* There is a leaf occupying the slot. Replace it with a new ply */
+	  old_ply->n_non_empty_leafs -=
+	    ip6_mtrie_leaf_is_non_empty (old_ply, dst_byte);
+
+	  new_leaf = ply_create (old_leaf,
+				 old_ply->dst_address_bits_of_leaves[dst_byte],
+				 ply_base_len);
+	  new_ply = get_next_ply_for_leaf (new_leaf);
+
+	  /* Refetch since ply_create may move pool. */
+	  old_ply = pool_elt_at_index (ip6_ply_pool, old_ply_index);
+
+	  clib_atomic_store_rel_n (&old_ply->leaves[dst_byte], new_leaf);
+	  old_ply->dst_address_bits_of_leaves[dst_byte] = ply_base_len;
+
+	  old_ply->n_non_empty_leafs +=
+	    ip6_mtrie_leaf_is_non_empty (old_ply, dst_byte);
+	  ASSERT (old_ply->n_non_empty_leafs >= 0);
+	}
+      else
+	new_ply = get_next_ply_for_leaf (old_leaf);
+
+      set_leaf (a, new_ply - ip6_ply_pool, dst_address_byte_index + 1);
+    }
+}
+
+static void
+set_root_leaf (ip6_mtrie_t *m, const ip6_mtrie_set_unset_leaf_args_t *a)
+{
+  ip6_mtrie_leaf_t old_leaf, new_leaf;
+  ip6_mtrie_16_ply_t *old_ply;
+  i32 n_dst_bits_next_plies;
+  u16 dst_byte;
+
+  old_ply = &m->root_ply;
+
+  ASSERT (a->dst_address_length <= 128);
+
+  /* how many bits of the destination address are in the next PLY */
+  n_dst_bits_next_plies = a->dst_address_length - BITS (u16);
+
+  dst_byte = a->dst_address.as_u16[0];
+
+  /* Number of bits next plies <= 0 => insert leaves this ply. */
+  if (n_dst_bits_next_plies <= 0)
+    {
+      /* The mask length of the address to insert maps to this ply */
+      uword old_leaf_is_terminal;
+      u32 i, n_dst_bits_this_ply;
+
+      /* The number of bits, and hence slots/buckets, we will fill */
+      n_dst_bits_this_ply = 16 - a->dst_address_length;
+      ASSERT ((clib_host_to_net_u16 (a->dst_address.as_u16[0]) &
+	       pow2_mask (n_dst_bits_this_ply)) == 0);
+
+      /* Starting at the value of the first 2 bytes of the v6 address
+       * fill the buckets/slots of the ply */
+      for (i = 0; i < (1 << n_dst_bits_this_ply); i++)
+	{
+	  ip6_mtrie_8_ply_t *new_ply;
+	  u16 slot;
+
+	  slot = clib_net_to_host_u16 (dst_byte);
+	  slot += i;
+	  slot = clib_host_to_net_u16 (slot);
+
+	  old_leaf = old_ply->leaves[slot];
+	  old_leaf_is_terminal = ip6_mtrie_leaf_is_terminal (old_leaf);
+
+	  if (a->dst_address_length >=
+	      old_ply->dst_address_bits_of_leaves[slot])
+	    {
+	      /* The new leaf is more or equally specific than the one currently
+	       * occupying the slot */
+	      new_leaf = ip6_mtrie_leaf_set_adj_index (a->adj_index);
+
+	      if (old_leaf_is_terminal)
+		{
+		  /* The current leaf is terminal, we can replace it with
+		   * the new one */
+		  old_ply->dst_address_bits_of_leaves[slot] =
+		    a->dst_address_length;
+		  clib_atomic_store_rel_n (&old_ply->leaves[slot], new_leaf);
+		}
+	      else
+		{
+		  /* Existing leaf points to another ply.  We need to place
+		   * new_leaf into all more specific slots. */
+		  new_ply = get_next_ply_for_leaf (old_leaf);
+		  set_ply_with_more_specific_leaf (new_ply, new_leaf,
+						   a->dst_address_length);
+		}
+	    }
+	  else if (!old_leaf_is_terminal)
+	    {
+	      /* The current leaf is less specific and not termial (i.e. a ply),
+	       * recurse on down the trie */
+	      new_ply = get_next_ply_for_leaf (old_leaf);
+	      set_leaf (a, new_ply - ip6_ply_pool, 2);
+	    }
+	  /*
+	   * else
+	   *  the route we are adding is less specific than the leaf currently
+	   *  occupying this slot. leave it there
+	   */
+	}
+    }
+  else
+    {
+      /* The address to insert requires us to move down at a lower level of
+       * the trie - recurse on down */
+      ip6_mtrie_8_ply_t *new_ply;
+      u8 ply_base_len;
+
+      ply_base_len = 16;
+
+      old_leaf = old_ply->leaves[dst_byte];
+
+      if (ip6_mtrie_leaf_is_terminal (old_leaf))
+	{
+	  /* There is a leaf occupying the slot. Replace it with a new ply */
+	  new_leaf = ply_create (old_leaf,
+				 old_ply->dst_address_bits_of_leaves[dst_byte],
+				 ply_base_len);
+	  new_ply = get_next_ply_for_leaf (new_leaf);
+
+	  clib_atomic_store_rel_n (&old_ply->leaves[dst_byte], new_leaf);
+	  old_ply->dst_address_bits_of_leaves[dst_byte] = ply_base_len;
+	}
+      else
+	new_ply = get_next_ply_for_leaf (old_leaf);
+
+      set_leaf (a, new_ply - ip6_ply_pool, 2);
+    }
+}
+
+static void
+ip6_mtrie_ply_reclaim (uword ply_index)
+{
+  pool_put_index (ip6_ply_pool, ply_index);
+}
+
+static uword
+unset_leaf (const ip6_mtrie_set_unset_leaf_args_t *a,
+	    ip6_mtrie_8_ply_t *old_ply, u32 dst_address_byte_index)
+{
+  ip6_mtrie_leaf_t old_leaf, del_leaf;
+  i32 n_dst_bits_next_plies;
+  i32 i, n_dst_bits_this_ply, old_leaf_is_terminal;
+  u8 dst_byte;
+
+  ASSERT (a->dst_address_length <= 128);
+  ASSERT (dst_address_byte_index < ARRAY_LEN (a->dst_address.as_u8));
+
+  n_dst_bits_next_plies =
+    a->dst_address_length - BITS (u8) * (dst_address_byte_index + 1);
+
+  dst_byte = a->dst_address.as_u8[dst_address_byte_index];
+  if (n_dst_bits_next_plies < 0)
+    dst_byte &= ~pow2_mask (-n_dst_bits_next_plies);
+
+  n_dst_bits_this_ply =
+    n_dst_bits_next_plies <= 0 ? -n_dst_bits_next_plies : 0;
+  n_dst_bits_this_ply = clib_min (8, n_dst_bits_this_ply);
+
+  del_leaf = ip6_mtrie_leaf_set_adj_index (a->adj_index);
+
+  for (i = dst_byte; i < dst_byte + (1 << n_dst_bits_this_ply); i++)
+    {
+      old_leaf = old_ply->leaves[i];
+      old_leaf_is_terminal = ip6_mtrie_leaf_is_terminal (old_leaf);
+
+      if (old_leaf == del_leaf ||
+	  (!old_leaf_is_terminal &&
+	   unset_leaf (a, get_next_ply_for_leaf (old_leaf),
+		       dst_address_byte_index + 1)))
+	{
+	  old_ply->n_non_empty_leafs -=
+	    ip6_mtrie_leaf_is_non_empty (old_ply, i);
+
+	  clib_atomic_store_rel_n (
+	    &old_ply->leaves[i],
+	    ip6_mtrie_leaf_set_adj_index (a->cover_adj_index));
+	  old_ply->dst_address_bits_of_leaves[i] = a->cover_address_length;
+
+	  old_ply->n_non_empty_leafs +=
+	    ip6_mtrie_leaf_is_non_empty (old_ply, i);
+
+	  ASSERT (old_ply->n_non_empty_leafs >= 0);
+	  if (old_ply->n_non_empty_leafs == 0)
+	    {
+	      /* the root ply is not in the pool, so every ply here can go */
+	      /* the parent still points to it, as may the workers */
+	      fib_epoch_retire (ip6_mtrie_ply_reclaim,
+				old_ply - ip6_ply_pool);
+	      /* Old ply was deleted. */
+	      return 1;
+	    }
+	}
+    }
+
+  /* Old ply was not deleted. */
+  return 0;
+}
+
+static void
+unset_root_leaf (ip6_mtrie_t *m, const ip6_mtrie_set_unset_leaf_args_t *a)
+{
+  ip6_mtrie_leaf_t old_leaf, del_leaf;
+  i32 n_dst_bits_next_plies;
+  i32 i, n_dst_bits_this_ply, old_leaf_is_terminal;
+  u16 dst_byte;
+  ip6_mtrie_16_ply_t *old_ply;
+
+  ASSERT (a->dst_address_length <= 128);
+
+  old_ply = &m->root_ply;
+  n_dst_bits_next_plies = a->dst_address_length - BITS (u16);
+
+  dst_byte = a->dst_address.as_u16[0];
+
+  n_dst_bits_this_ply =
+    (n_dst_bits_next_plies <= 0 ? (16 - a->dst_address_length) : 0);
+
+  del_leaf = ip6_mtrie_leaf_set_adj_index (a->adj_index);
+
+  /* Starting at the value of the first 2 bytes of the v6 address
+   * fill the buckets/slots of the ply */
+  for (i = 0; i < (1 << n_dst_bits_this_ply); i++)
+    {
+      u16 slot;
+
+      slot = clib_net_to_host_u16 (dst_byte);
+      slot += i;
+      slot = clib_host_to_net_u16 (slot);
+
+      old_leaf = old_ply->leaves[slot];
+      old_leaf_is_terminal = ip6_mtrie_leaf_is_terminal (old_leaf);
+
+      if (old_leaf == del_leaf ||
+	  (!old_leaf_is_terminal &&
+	   unset_leaf (a, get_next_ply_for_leaf (old_leaf), 2)))
+	{
+	  clib_atomic_store_rel_n (
+	    &old_ply->leaves[slot],
+	    ip6_mtrie_leaf_set_adj_index (a->cover_adj_index));
+	  old_ply->dst_address_bits_of_leaves[slot] = a->cover_address_length;
+	}
+    }
+}
+
+void
+ip6_mtrie_route_add (ip6_mtrie_t *m, const ip6_address_t *dst_address,
+		     u32 dst_address_length, u32 adj_index)
+{
+  ip6_mtrie_set_unset_leaf_args_t a;
+  ip6_main_t *im = &ip6_main;
+
+  /* Honor dst_address_length. Fib masks are in network byte order */
+  a.dst_address.as_u64[0] =
+    dst_address->as_u64[0] & im->fib_masks[dst_address_length].as_u64[0];
+  a.dst_address.as_u64[1] =
+    dst_address->as_u64[1] & im->fib_masks[dst_address_length].as_u64[1];
+  a.dst_address_length = dst_address_length;
+  a.adj_index = adj_index;
+
+  set_root_leaf (m, &a);
+}
+
+void
+ip6_mtrie_route_del (ip6_mtrie_t *m, const ip6_address_t *dst_address,
+		     u32 dst_address_length, u32 adj_index,
+		     u32 cover_address_length, u32 cover_adj_index)
+{
+  ip6_mtrie_set_unset_leaf_args_t a;
+  ip6_main_t *im = &ip6_main;
+
+  /* Honor dst_address_length. Fib masks are in network byte order */
+  a.dst_address.as_u64[0] =
+    dst_address->as_u64[0] & im->fib_masks[dst_address_length].as_u64[0];
+  a.dst_address.as_u64[1] =
+    dst_address->as_u64[1] & im->fib_masks[dst_address_length].as_u64[1];
+  a.dst_address_length = dst_address_length;
+  a.adj_index = adj_index;
+  a.cover_adj_index = cover_adj_index;
+  a.cover_address_length = cover_address_length;
+
+  /* the top level ply is never removed */
+  unset_root_leaf (m, &a);
+}
+
+/* Returns number of bytes of memory used by mtrie. */
+static uword
+mtrie_ply_memory_usage (ip6_mtrie_8_ply_t *p)
+{
+  uword bytes, i;
+
+  bytes = sizeof (p[0]);
+  for (i = 0; i < ARRAY_LEN (p->leaves); i++)
+    {
+      ip6_mtrie_leaf_t l = p->leaves[i];
+      if (ip6_mtrie_leaf_is_next_ply (l))
+	bytes += mtrie_ply_memory_usage (get_next_ply_for_leaf (l));
+    }
+
+  return bytes;
+}
+
+/* Returns number of bytes of memory used by mtrie. */
+uword
+ip6_mtrie_memory_usage (ip6_mtrie_t *m)
+{
+  uword bytes, i;
+
+  bytes = sizeof (*m);
+  for (i = 0; i < ARRAY_LEN (m->root_ply.leaves); i++)
+    {
+      ip6_mtrie_leaf_t l = m->root_ply.leaves[i];
+      if (ip6_mtrie_leaf_is_next_ply (l))
+	bytes += mtrie_ply_memory_usage (get_next_ply_for_leaf (l));
+    }
+
+  return bytes;
+}
+
+static u8 *
+format_ip6_mtrie_leaf (u8 *s, va_list *va)
+{
+  ip6_mtrie_leaf_t l = va_arg (*va, ip6_mtrie_leaf_t);
+
+  if (ip6_mtrie_leaf_is_terminal (l))
+    s = format (s, "lb-index %d", ip6_mtrie_leaf_get_adj_index (l));
+  else
+    s = format (s, "next ply %d", ip6_mtrie_leaf_get_next_ply_index (l));
+  return s;
+}
+
+static u8 *
+format_ip6_mtrie_ply (u8 *s, va_list *va)
+{
+  ip6_address_t *base_address = va_arg (*va, ip6_address_t *);
+  u32 indent = va_arg (*va, u32);
+  u32 ply_index = va_arg (*va, u32);
+  ip6_mtrie_8_ply_t *p;
+  ip6_address_t ia;
+  u32 byte_index;
+  int i;
+
+  p = pool_elt_at_index (ip6_ply_pool, ply_index);
+  byte_index = p->dst_address_bits_base / 8;
+  s = format (s, "%Uply index %d, %d non-empty leaves", format_white_space,
+	      indent, ply_index, p->n_non_empty_leafs);
+
+  for (i = 0; i < ARRAY_LEN (p->leaves); i++)
+    {
+      if (!ip6_mtrie_leaf_is_non_empty (p, i))
+	continue;
+
+      ia = *base_address;
+      ia.as_u8[byte_index] = i;
+      s = format (s, "\n%U%U %U", format_white_space, indent + 4,
+		  format_ip6_address_and_length, &ia,
+		  p->dst_address_bits_of_leaves[i], format_ip6_mtrie_leaf,
+		  p->leaves[i]);
+
+      if (ip6_mtrie_leaf_is_next_ply (p->leaves[i]))
+	s = format (s, "\n%U", format_ip6_mtrie_ply, &ia, indent + 8,
+		    ip6_mtrie_leaf_get_next_ply_index (p->leaves[i]));
+    }
+
+  return s;
+}
+
+u8 *
+format_ip6_mtrie (u8 *s, va_list *va)
+{
+  ip6_mtrie_t *m = va_arg (*va, ip6_mtrie_t *);
+  int verbose = va_arg (*va, int);
+  ip6_mtrie_16_ply_t *p;
+  ip6_address_t ia;
+  int i;
+
+  s = format (s, "16-8-...-8: %d plies, memory usage %U\n",
+	      pool_elts (ip6_ply_pool), format_memory_size,
+	      ip6_mtrie_memory_usage (m));
+
+  if (verbose)
+    {
+      s = format (s, "root-ply");
+      p = &m->root_ply;
+
+      for (i = 0; i < ARRAY_LEN (p->leaves); i++)
+	{
+	  u16 slot;
+
+	  slot = clib_host_to_net_u16 (i);
+
+	  if (p->dst_address_bits_of_leaves[slot] > 0)
+	    {
+	      clib_memset (&ia, 0, sizeof (ia));
+	      ia.as_u16[0] = slot;
+	      s = format (s, "\n%U%U %U", format_white_space, 4,
+			  format_ip6_address_and_length, &ia,
+			  p->dst_address_bits_of_leaves[slot],
+			  format_ip6_mtrie_leaf, p->leaves[slot]);
+
+	      if (ip6_mtrie_leaf_is_next_ply (p->leaves[slot]))
+		s = format (s, "\n%U", format_ip6_mtrie_ply, &ia, 8,
+			    ip6_mtrie_leaf_get_next_ply_index (
+			      p->leaves[slot]));
+	    }
+	}
+    }
+
+  return s;
+}
+
+static clib_error_t *
+ip6_mtrie_module_init (vlib_main_t *vm)
+{
+  CLIB_UNUSED (ip6_mtrie_8_ply_t * p);
+
+  /* Burn one ply so index 0 is taken */
+  pool_get_aligned (ip6_ply_pool, p, CLIB_CACHE_LINE_BYTES);
+
+  return (NULL);
+}
+
+VLIB_INIT_FUNCTION (ip6_mtrie_module_init);
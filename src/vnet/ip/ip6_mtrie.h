@@ -0,0 +1,235 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+/**
+ * @brief An IPv6 multi-way trie with a 16-8-8-...-8 stride.
+ *
+ * This is the IPv6 analogue of the ip4_mtrie_16_t. It is an optional
+ * forwarding structure for an IPv6 FIB table; when enabled the data-plane
+ * resolves the longest prefix match with at most one dependent memory
+ * access per populated stride instead of one bihash probe per populated
+ * prefix length. The per-table forwarding bihash is still maintained, it
+ * remains the source of truth for exact-match lookups.
+ */
+
+#ifndef included_ip_ip6_mtrie_h
+#define included_ip_ip6_mtrie_h
+
+#include <vppinfra/cache.h>
+#include <vppinfra/pool.h>
+#include <vnet/ip/ip6_packet.h>
+
+/* ip6 fib leafs:
+   1 + 2*adj_index for terminal leaves.
+   0 + 2*next_ply_index for non-terminals, i.e. PLYs
+   1 => empty (adjacency index of zero is special miss adjacency). */
+typedef u32 ip6_mtrie_leaf_t;
+
+#define IP6_MTRIE_LEAF_EMPTY (1 + 2 * 0)
+
+/**
+ * The root ply consumes the first 16 bits of the address, each subsequent
+ * ply consumes 8. The last ply therefore consumes byte 15.
+ */
+#define IP6_MTRIE_ROOT_PLY_SIZE (1 << 16)
+#define IP6_MTRIE_N_BYTES	16
+
+/**
+ * @brief the 16 way stride that is the top PLY of the mtrie
+ */
+typedef struct ip6_mtrie_16_ply_t_
+{
+  /**
+   * The leaves/slots/buckets to be filed with leafs
+   */
+  ip6_mtrie_leaf_t leaves[IP6_MTRIE_ROOT_PLY_SIZE];
+
+  /**
+   * Prefix length for terminal leaves.
+   */
+  u8 dst_address_bits_of_leaves[IP6_MTRIE_ROOT_PLY_SIZE];
+} ip6_mtrie_16_ply_t;
+
+/**
+ * @brief One 8 bit stride ply of the mtrie.
+ */
+typedef struct ip6_mtrie_8_ply_t_
+{
+  CLIB_CACHE_LINE_ALIGN_MARK (cacheline0);
+  /**
+   * The leaves/slots/buckets to be filed with leafs
+   */
+  ip6_mtrie_leaf_t leaves[256];
+
+  /**
+   * Prefix length for leaves/ply.
+   */
+  u8 dst_address_bits_of_leaves[256];
+
+  /**
+   * Number of non-empty leafs (whether terminal or not).
+   */
+  i32 n_non_empty_leafs;
+
+  /**
+   * The length of the ply's covering prefix. Also a measure of its depth
+   * If a leaf in a slot has a mask length longer than this then it is
+   * 'non-empty'. Otherwise it is the value of the cover.
+   */
+  i32 dst_address_bits_base;
+} ip6_mtrie_8_ply_t;
+
+STATIC_ASSERT (0 == sizeof (ip6_mtrie_8_ply_t) % CLIB_CACHE_LINE_BYTES,
+	       "IP6 Mtrie ply cache line");
+
+/**
+ * @brief The mutiway-TRIE with a 16-8-...-8 stride.
+ */
+typedef struct ip6_mtrie_t_
+{
+  /**
+   * The root PLY is embedded so the data-plane gets to the first
+   * leaf without an indirection.
+   */
+  ip6_mtrie_16_ply_t root_ply;
+} ip6_mtrie_t;
+
+/**
+ * @brief Create an empty mtrie, all leaves resolve to the empty leaf
+ */
+extern ip6_mtrie_t *ip6_mtrie_create (void);
+
+/**
+ * @brief Free an mtrie and all of the plies it references
+ */
+extern void ip6_mtrie_destroy (ip6_mtrie_t *m);
+
+/**
+ * @brief Add a route/entry to the mtrie
+ */
+extern void ip6_mtrie_route_add (ip6_mtrie_t *m,
+				 const ip6_address_t *dst_address,
+				 u32 dst_address_length, u32 adj_index);
+
+/**
+ * @brief remove a route/entry from the mtrie
+ */
+extern void ip6_mtrie_route_del (ip6_mtrie_t *m,
+				 const ip6_address_t *dst_address,
+				 u32 dst_address_length, u32 adj_index,
+				 u32 cover_address_length,
+				 u32 cover_adj_index);
+
+/**
+ * @brief return the memory used by the table
+ */
+extern uword ip6_mtrie_memory_usage (ip6_mtrie_t *m);
+
+/**
+ * @brief Format/display the contents of the mtrie
+ */
+extern format_function_t format_ip6_mtrie;
+
+/**
+ * @brief A global pool of 8bit stride plys
+ */
+extern ip6_mtrie_8_ply_t *ip6_ply_pool;
+
+/**
+ * Is the leaf terminal (i.e. an LB index) or non-terminal (i.e. a PLY index)
+ */
+always_inline u32
+ip6_mtrie_leaf_is_terminal (ip6_mtrie_leaf_t n)
+{
+  return n & 1;
+}
+
+/**
+ * From the stored slot value extract the LB index value
+ */
+always_inline u32
+ip6_mtrie_leaf_get_adj_index (ip6_mtrie_leaf_t n)
+{
+  ASSERT (ip6_mtrie_leaf_is_terminal (n));
+  return n >> 1;
+}
+
+/**
+ * @brief Lookup step one. Processes the first 2 bytes of the address.
+ */
+always_inline ip6_mtrie_leaf_t
+ip6_mtrie_lookup_step_one (const ip6_mtrie_t *m,
+			   const ip6_address_t *dst_address)
+{
+  return (m->root_ply.leaves[dst_address->as_u16[0]]);
+}
+
+/**
+ * @brief Lookup step. Processes 1 byte of the 16 byte address.
+ */
+always_inline ip6_mtrie_leaf_t
+ip6_mtrie_lookup_step (ip6_mtrie_leaf_t current_leaf,
+		       const ip6_address_t *dst_address,
+		       u32 dst_address_byte_index)
+{
+  ip6_mtrie_8_ply_t *ply;
+
+  if (!ip6_mtrie_leaf_is_terminal (current_leaf))
+    {
+      ASSERT (dst_address_byte_index < IP6_MTRIE_N_BYTES);
+      ply = ip6_ply_pool + (current_leaf >> 1);
+      return (ply->leaves[dst_address->as_u8[dst_address_byte_index]]);
+    }
+
+  return current_leaf;
+}
+
+/**
+ * @brief Longest prefix match of one address.
+ */
+always_inline u32
+ip6_mtrie_lookup (const ip6_mtrie_t *m, const ip6_address_t *dst_address)
+{
+  ip6_mtrie_leaf_t leaf;
+  u32 i;
+
+  leaf = ip6_mtrie_lookup_step_one (m, dst_address);
+
+  for (i = 2; !ip6_mtrie_leaf_is_terminal (leaf); i++)
+    leaf = ip6_mtrie_lookup_step (leaf, dst_address, i);
+
+  return (ip6_mtrie_leaf_get_adj_index (leaf));
+}
+
+/**
+ * @brief Longest prefix match of two addresses, possibly in different
+ * tables. The walks are interleaved so the ply fetches of one lookup
+ * are overlapped with those of the other.
+ */
+always_inline void
+ip6_mtrie_lookup_x2 (const ip6_mtrie_t *m0, const ip6_mtrie_t *m1,
+		     const ip6_address_t *dst_address0,
+		     const ip6_address_t *dst_address1, u32 *lbi0, u32 *lbi1)
+{
+  ip6_mtrie_leaf_t leaf0, leaf1;
+  u32 i;
+
+  leaf0 = ip6_mtrie_lookup_step_one (m0, dst_address0);
+  leaf1 = ip6_mtrie_lookup_step_one (m1, dst_address1);
+
+  for (i = 2;
+       !(ip6_mtrie_leaf_is_terminal (leaf0) &
+	 ip6_mtrie_leaf_is_terminal (leaf1));
+       i++)
+    {
+      leaf0 = ip6_mtrie_lookup_step (leaf0, dst_address0, i);
+      leaf1 = ip6_mtrie_lookup_step (leaf1, dst_address1, i);
+    }
+
+  *lbi0 = ip6_mtrie_leaf_get_adj_index (leaf0);
+  *lbi1 = ip6_mtrie_leaf_get_adj_index (leaf1);
+}
+
+#endif /* included_ip_ip6_mtrie_h */
+
@@ -845,6 +845,77 @@ vl_api_ip_route_add_del_v2_t_handler (vl_api_ip_route_add_del_v2_t *mp)
   /* clang-format on */
 }
 
+void
+vl_api_ip_route_add_del_bulk_t_handler (vl_api_ip_route_add_del_bulk_t *mp)
+{
+  vl_api_ip_route_add_del_bulk_reply_t *rmp;
+  fib_route_path_t *rpaths = NULL, *rpath;
+  fib_entry_flag_t entry_flags;
+  fib_prefix_t *pfxs = NULL;
+  fib_source_t src;
+  u32 fib_index, n_prefixes;
+  int rv = 0, ii;
+
+  entry_flags = FIB_ENTRY_FLAG_NONE;
+  n_prefixes = ntohl (mp->n_prefixes);
+
+  if (0 == n_prefixes)
+    goto out;
+  if (mp->n_paths > ARRAY_LEN (mp->paths))
+    {
+      rv = VNET_API_ERROR_INVALID_VALUE;
+      goto out;
+    }
+
+  vec_validate (pfxs, n_prefixes - 1);
+  for (ii = 0; ii < n_prefixes; ii++)
+    {
+      ip_prefix_decode (&mp->prefixes[ii], &pfxs[ii]);
+
+      if (pfxs[ii].fp_proto != pfxs[0].fp_proto)
+	{
+	  rv = VNET_API_ERROR_INVALID_ADDRESS_FAMILY;
+	  goto out;
+	}
+    }
+
+  rv = fib_api_table_id_decode (pfxs[0].fp_proto, ntohl (mp->table_id),
+				&fib_index);
+  if (0 != rv)
+    goto out;
+
+  /*
+   * the paths are decoded once for all the routes
+   */
+  if (0 != mp->n_paths)
+    vec_validate (rpaths, mp->n_paths - 1);
+
+  for (ii = 0; ii < mp->n_paths; ii++)
+    {
+      rpath = &rpaths[ii];
+
+      rv = fib_api_path_decode (&mp->paths[ii], rpath);
+
+      if ((rpath->frp_flags & FIB_ROUTE_PATH_LOCAL) &&
+	  (~0 == rpath->frp_sw_if_index))
+	entry_flags |= (FIB_ENTRY_FLAG_CONNECTED | FIB_ENTRY_FLAG_LOCAL);
+
+      if (0 != rv)
+	goto out;
+    }
+
+  src = (0 == mp->src ? FIB_SOURCE_API : mp->src);
+
+  rv = fib_api_route_add_del_bulk (mp->is_add, mp->is_multipath, fib_index,
+				   pfxs, src, entry_flags, rpaths);
+
+out:
+  vec_free (rpaths);
+  vec_free (pfxs);
+
+  REPLY_MACRO (VL_API_IP_ROUTE_ADD_DEL_BULK_REPLY);
+}
+
 void
 vl_api_ip_route_lookup_t_handler (vl_api_ip_route_lookup_t * mp)
 {
@@ -2183,6 +2254,10 @@ ip_api_hookup (vlib_main_t * vm)
     am, REPLY_MSG_ID_BASE + VL_API_IP_ROUTE_ADD_DEL_V2, 1);
   vl_api_set_msg_thread_safe (
     am, REPLY_MSG_ID_BASE + VL_API_IP_ROUTE_ADD_DEL_V2_REPLY, 1);
+  vl_api_set_msg_thread_safe (
+    am, REPLY_MSG_ID_BASE + VL_API_IP_ROUTE_ADD_DEL_BULK, 1);
+  vl_api_set_msg_thread_safe (
+    am, REPLY_MSG_ID_BASE + VL_API_IP_ROUTE_ADD_DEL_BULK_REPLY, 1);
   vl_api_set_msg_thread_safe (am, REPLY_MSG_ID_BASE + VL_API_IP_ADDRESS_DUMP,
 			      1);
 
@@ -26,6 +26,7 @@
 #include <vnet/ip/ip.api_enum.h>
 #include <vppinfra/fifo.h>
 #include <vppinfra/bihash_16_8.h>
+#include <vppinfra/tw_timer_2t_1w_2048sl.h>
 #include <vnet/ip/reass/ip4_full_reass.h>
 #include <stddef.h>
 
@@ -40,6 +41,12 @@
 #define IP4_REASS_MAX_REASSEMBLY_LENGTH_DEFAULT	  3
 #define IP4_REASS_HT_LOAD_FACTOR (0.75)
 
+/* When fragments are steered, contexts are expired by a per-thread timer
+ * wheel with this tick. A timeout longer than the wheel's span is handled
+ * by re-arming the timer when it fires. */
+#define IP4_REASS_TW_TICK_MS	 10
+#define IP4_REASS_TW_MAX_TICKS	 2047
+
 #define IP4_REASS_DEBUG_BUFFERS 0
 #if IP4_REASS_DEBUG_BUFFERS
 #define IP4_REASS_DEBUG_BUFFER(bi, what)             \
@@ -151,6 +158,8 @@ typedef struct
   // thread which received fragment with offset 0 and which sends out the
   // completed reassembly
   clib_thread_index_t sendout_thread_index;
+  // expiry timer handle when steering, ~0 if no timer is running
+  u32 timer_handle;
 } ip4_full_reass_t;
 
 typedef struct
@@ -161,6 +170,9 @@ typedef struct
   // for pacing the main thread timeouts
   u32 last_id;
   clib_spinlock_t lock;
+  // expiry of the contexts when steering
+  tw_timer_wheel_2t_1w_2048sl_t wheel;
+  u32 *expired_timers;
 } ip4_full_reass_per_thread_t;
 
 typedef struct
@@ -183,6 +195,11 @@ typedef struct
   vlib_main_t *vlib_main;
 
   u32 ip4_full_reass_expire_node_idx;
+  u32 ip4_full_reass_expire_sched_node_idx;
+
+  // whether fragments are steered to a worker chosen by a hash of the key,
+  // so each context is only ever touched by one thread
+  bool steering;
 
   /** Worker handoff */
   u32 fq_index;
@@ -406,6 +423,8 @@ always_inline void
 ip4_full_reass_free_ctx (ip4_full_reass_per_thread_t * rt,
 			 ip4_full_reass_t * reass)
 {
+  if (~0 != reass->timer_handle)
+    tw_timer_stop_2t_1w_2048sl (&rt->wheel, reass->timer_handle);
   pool_put (rt->pool, reass);
   --rt->reass_n;
 }
@@ -540,6 +559,58 @@ ip4_full_reass_init (ip4_full_reass_t * reass)
   reass->data_len = 0;
   reass->next_index = ~0;
   reass->error_next_index = ~0;
+  reass->timer_handle = ~0;
+}
+
+/* all fragments of a datagram hash to the same thread, workers if any */
+always_inline clib_thread_index_t
+ip4_full_reass_steer_thread_index (const ip4_header_t *ip)
+{
+  u32 n_workers = vlib_num_workers ();
+  u64 h;
+
+  if (!n_workers)
+    return 0;
+
+  h = clib_xxhash (clib_mem_unaligned (&ip->src_address, u64) ^
+		   clib_xxhash ((u64) ip->fragment_id << 8 | ip->protocol));
+  return 1 + h % n_workers;
+}
+
+always_inline void
+ip4_full_reass_timer_start (ip4_full_reass_main_t *rm,
+			    ip4_full_reass_per_thread_t *rt,
+			    ip4_full_reass_t *reass, f64 now)
+{
+  f64 left = reass->last_heard + rm->timeout - now;
+  u64 ticks = 1;
+
+  if (left > 0)
+    ticks += left * (MSEC_PER_SEC / IP4_REASS_TW_TICK_MS);
+
+  reass->timer_handle =
+    tw_timer_start_2t_1w_2048sl (&rt->wheel, reass - rt->pool, 0,
+				 clib_min (ticks, IP4_REASS_TW_MAX_TICKS));
+}
+
+always_inline void
+ip4_full_reass_steering_arm (vlib_main_t *vm, ip4_full_reass_main_t *rm,
+			     ip4_full_reass_per_thread_t *rt,
+			     ip4_full_reass_t *reass, f64 now)
+{
+  if (1 == rt->reass_n)
+    {
+      /* the wheel is not advanced while it is empty, catch its clock up
+       * rather than expiring every tick it missed */
+      rt->wheel.last_run_time = now;
+      rt->wheel.next_run_time = now + rt->wheel.timer_interval;
+    }
+
+  ip4_full_reass_timer_start (rm, rt, reass, now);
+
+  if (!vlib_node_is_scheduled (vm, rm->ip4_full_reass_expire_sched_node_idx))
+    vlib_node_schedule (vm, rm->ip4_full_reass_expire_sched_node_idx,
+			(f64) IP4_REASS_TW_TICK_MS / MSEC_PER_SEC);
 }
 
 always_inline ip4_full_reass_t *
@@ -613,6 +684,8 @@ again:
       if (-2 == rv)
 	goto again;
     }
+  else if (rm->steering)
+    ip4_full_reass_steering_arm (vm, rm, rt, reass, now);
 
   return reass;
 }
@@ -1168,8 +1241,11 @@ ip4_full_reass_inline (vlib_main_t *vm, vlib_node_runtime_t *node,
   ip4_full_reass_main_t *rm = &ip4_full_reass_main;
   ip4_full_reass_per_thread_t *rt = &rm->per_thread_data[vm->thread_index];
   u16 nexts[VLIB_FRAME_SIZE];
+  /* steered contexts are private to this thread */
+  bool locked = !rm->steering;
 
-  clib_spinlock_lock (&rt->lock);
+  if (locked)
+    clib_spinlock_lock (&rt->lock);
 
   n_left = frame->n_vectors;
   while (n_left > 0)
@@ -1204,6 +1280,17 @@ ip4_full_reass_inline (vlib_main_t *vm, vlib_node_runtime_t *node,
 	  goto packet_enqueue;
 	}
 
+      if (!locked)
+	{
+	  clib_thread_index_t owner = ip4_full_reass_steer_thread_index (ip0);
+	  if (owner != vm->thread_index)
+	    {
+	      next0 = IP4_FULL_REASS_NEXT_HANDOFF;
+	      vnet_buffer (b0)->ip.reass.owner_thread_index = owner;
+	      goto packet_enqueue;
+	    }
+	}
+
       const u32 fragment_first = ip4_get_fragment_offset_bytes (ip0);
       const u32 fragment_length =
 	clib_net_to_host_u16 (ip0->length) - ip4_header_bytes (ip0);
@@ -1350,7 +1437,8 @@ ip4_full_reass_inline (vlib_main_t *vm, vlib_node_runtime_t *node,
       n_left -= 1;
     }
 
-  clib_spinlock_unlock (&rt->lock);
+  if (locked)
+    clib_spinlock_unlock (&rt->lock);
 
   vlib_buffer_enqueue_to_next (vm, node, to_next, nexts, n_next);
   return frame->n_vectors;
@@ -1589,6 +1677,10 @@ ip4_full_reass_init_function (vlib_main_t * vm)
   ASSERT (node);
   rm->ip4_full_reass_expire_node_idx = node->index;
 
+  node = vlib_get_node_by_name (vm, (u8 *) "ip4-full-reassembly-expire");
+  ASSERT (node);
+  rm->ip4_full_reass_expire_sched_node_idx = node->index;
+
   ip4_full_reass_set_params (IP4_REASS_TIMEOUT_DEFAULT_MS,
 			     IP4_REASS_MAX_REASSEMBLIES_DEFAULT,
 			     IP4_REASS_MAX_REASSEMBLY_LENGTH_DEFAULT,
@@ -1648,7 +1740,8 @@ ip4_full_reass_walk_expired (vlib_main_t *vm, vlib_node_runtime_t *node,
 
       uword thread_index = 0;
       int index;
-      const uword nthreads = vlib_num_workers () + 1;
+      /* steered contexts are expired by their owning thread */
+      const uword nthreads = rm->steering ? 0 : vlib_num_workers () + 1;
 
       for (thread_index = 0; thread_index < nthreads; ++thread_index)
 	{
@@ -1720,6 +1813,57 @@ VLIB_REGISTER_NODE (ip4_full_reass_expire_node) = {
   .error_counters = ip4_error_counters,
 };
 
+static uword
+ip4_full_reass_expire_timers (vlib_main_t *vm, vlib_node_runtime_t *node,
+			      CLIB_UNUSED (vlib_frame_t *f))
+{
+  ip4_full_reass_main_t *rm = &ip4_full_reass_main;
+  ip4_full_reass_per_thread_t *rt = &rm->per_thread_data[vm->thread_index];
+  f64 now = vlib_time_now (vm);
+  u32 *handle, n_expired = 0;
+
+  if (!rm->steering)
+    return 0;
+
+  rt->expired_timers = tw_timer_expire_timers_vec_2t_1w_2048sl (
+    &rt->wheel, now, rt->expired_timers);
+
+  vec_foreach (handle, rt->expired_timers)
+    {
+      ip4_full_reass_t *reass = pool_elt_at_index (rt->pool, handle[0]);
+
+      reass->timer_handle = ~0;
+      if (now > reass->last_heard + rm->timeout)
+	{
+	  ip4_full_reass_drop_all (vm, node, reass);
+	  ip4_full_reass_free (rm, rt, reass);
+	  n_expired++;
+	}
+      else
+	/* heard from since the timer was armed */
+	ip4_full_reass_timer_start (rm, rt, reass, now);
+    }
+  vec_reset_length (rt->expired_timers);
+
+  if (n_expired)
+    vlib_node_increment_counter (vm, node->node_index,
+				 IP4_ERROR_REASS_TIMEOUT, n_expired);
+
+  if (rt->reass_n)
+    vlib_node_schedule (vm, node->node_index,
+			(f64) IP4_REASS_TW_TICK_MS / MSEC_PER_SEC);
+
+  return 0;
+}
+
+VLIB_REGISTER_NODE (ip4_full_reass_expire_sched_node) = {
+  .function = ip4_full_reass_expire_timers,
+  .type = VLIB_NODE_TYPE_SCHED,
+  .name = "ip4-full-reassembly-expire",
+  .n_errors = IP4_N_ERROR,
+  .error_counters = ip4_error_counters,
+};
+
 static u8 *
 format_ip4_full_reass_key (u8 * s, va_list * args)
 {
@@ -1818,6 +1962,8 @@ show_ip4_reass (vlib_main_t * vm,
   vlib_cli_output (vm,
 		   "Maximum configured full IP4 reassembly expire walk interval: %lums\n",
 		   (long unsigned) rm->expire_walk_interval_ms);
+  vlib_cli_output (vm, "Fragment steering: %s\n",
+		   rm->steering ? "enabled" : "disabled");
   return 0;
 }
 
@@ -1835,8 +1981,90 @@ ip4_full_reass_enable_disable (u32 sw_if_index, u8 enable_disable)
 				      "ip4-full-reassembly-feature",
 				      sw_if_index, enable_disable, 0, 0);
 }
+
+static void
+ip4_full_reass_flush (vlib_main_t *vm)
+{
+  ip4_full_reass_main_t *rm = &ip4_full_reass_main;
+  vlib_node_runtime_t *node =
+    vlib_node_get_runtime (vm, rm->ip4_full_reass_expire_node_idx);
+  ip4_full_reass_per_thread_t *rt;
+  ip4_full_reass_t *reass;
+  u32 *indexes = NULL, *i;
+
+  vec_foreach (rt, rm->per_thread_data)
+    {
+      vec_reset_length (indexes);
+      pool_foreach (reass, rt->pool)
+	vec_add1 (indexes, reass - rt->pool);
+
+      vec_foreach (i, indexes)
+	{
+	  reass = pool_elt_at_index (rt->pool, i[0]);
+	  ip4_full_reass_drop_all (vm, node, reass);
+	  ip4_full_reass_free (rm, rt, reass);
+	}
+    }
+  vec_free (indexes);
+}
+
+vnet_api_error_t
+ip4_full_reass_steering_enable_disable (bool enable)
+{
+  ip4_full_reass_main_t *rm = &ip4_full_reass_main;
+  vlib_main_t *vm = vlib_get_main ();
+  ip4_full_reass_per_thread_t *rt;
+
+  if (enable == rm->steering)
+    return 0;
+
+  /* contexts are tracked differently in each mode, start afresh */
+  vlib_worker_thread_barrier_sync (vm);
+  ip4_full_reass_flush (vm);
+
+  vec_foreach (rt, rm->per_thread_data)
+    {
+      if (enable)
+	tw_timer_wheel_init_2t_1w_2048sl (
+	  &rt->wheel, 0, (f64) IP4_REASS_TW_TICK_MS / MSEC_PER_SEC, ~0);
+      else
+	{
+	  tw_timer_wheel_free_2t_1w_2048sl (&rt->wheel);
+	  vec_free (rt->expired_timers);
+	}
+    }
+
+  rm->steering = enable;
+  vlib_worker_thread_barrier_release (vm);
+
+  return 0;
+}
 #endif /* CLIB_MARCH_VARIANT */
 
+static clib_error_t *
+set_ip4_full_reass_steering (vlib_main_t *vm, unformat_input_t *input,
+			     CLIB_UNUSED (vlib_cli_command_t *cmd))
+{
+  bool enable;
+
+  if (unformat (input, "on"))
+    enable = true;
+  else if (unformat (input, "off"))
+    enable = false;
+  else
+    return clib_error_return (0, "expected 'on' or 'off', got `%U'",
+			      format_unformat_error, input);
+
+  ip4_full_reass_steering_enable_disable (enable);
+  return 0;
+}
+
+VLIB_CLI_COMMAND (set_ip4_full_reass_steering_cmd, static) = {
+  .path = "set ip4-full-reassembly steering",
+  .short_help = "set ip4-full-reassembly steering on|off",
+  .function = set_ip4_full_reass_steering,
+};
+
 
 #define foreach_ip4_full_reass_handoff_error                       \
 _(CONGESTION_DROP, "congestion drop")
@@ -49,6 +49,15 @@ int ip4_full_reass_enable_disable_with_refcnt (u32 sw_if_index,
 uword ip4_full_reass_custom_register_next_node (uword node_index);
 
 void ip4_local_full_reass_enable_disable (int enable);
+
+/**
+ * @brief steer fragments to a thread chosen by a hash of the datagram key
+ *
+ * Every fragment of a datagram is then reassembled on the same thread, so
+ * contexts are neither locked nor shared, and are expired by a per-thread
+ * timer wheel. Switching mode drops all the in-progress reassemblies.
+ */
+vnet_api_error_t ip4_full_reass_steering_enable_disable (bool enable);
 int ip4_local_full_reass_enabled ();
 #endif /* __included_ip4_full_reass_h__ */
 
@@ -24,6 +24,7 @@
 #include <vnet/vnet.h>
 #include <vnet/ip/ip.h>
 #include <vppinfra/bihash_48_8.h>
+#include <vppinfra/tw_timer_2t_1w_2048sl.h>
 #include <vnet/ip/reass/ip6_full_reass.h>
 #include <vnet/ip/ip6_inlines.h>
 
@@ -37,6 +38,12 @@
 #define IP6_FULL_REASS_MAX_REASSEMBLY_LENGTH_DEFAULT 3
 #define IP6_FULL_REASS_HT_LOAD_FACTOR (0.75)
 
+/* When fragments are steered, contexts are expired by a per-thread timer
+ * wheel with this tick. A timeout longer than the wheel's span is handled
+ * by re-arming the timer when it fires. */
+#define IP6_FULL_REASS_TW_TICK_MS   10
+#define IP6_FULL_REASS_TW_MAX_TICKS 2047
+
 typedef enum
 {
   IP6_FULL_REASS_RC_OK,
@@ -131,6 +138,8 @@ typedef struct
   // thread which received fragment with offset 0 and which sends out the
   // completed reassembly
   u32 sendout_thread_index;
+  // expiry timer handle when steering, ~0 if no timer is running
+  u32 timer_handle;
 } ip6_full_reass_t;
 
 typedef struct
@@ -141,6 +150,10 @@ typedef struct
   // for pacing the main thread timeouts
   u32 last_id;
   clib_spinlock_t lock;
+  // expiry of the contexts when steering
+  tw_timer_wheel_2t_1w_2048sl_t wheel;
+  u32 *expired_timers;
+  u32 *icmp_bis;
 } ip6_full_reass_per_thread_t;
 
 typedef struct
@@ -165,6 +178,11 @@ typedef struct
 
   u32 ip6_icmp_error_idx;
   u32 ip6_full_reass_expire_node_idx;
+  u32 ip6_full_reass_expire_sched_node_idx;
+
+  // whether fragments are steered to a worker chosen by a hash of the key,
+  // so each context is only ever touched by one thread
+  bool steering;
 
   /** Worker handoff */
   u32 fq_index;
@@ -403,6 +421,8 @@ always_inline void
 ip6_full_reass_free_ctx (ip6_full_reass_per_thread_t * rt,
 			 ip6_full_reass_t * reass)
 {
+  if (~0 != reass->timer_handle)
+    tw_timer_stop_2t_1w_2048sl (&rt->wheel, reass->timer_handle);
   pool_put (rt->pool, reass);
   --rt->reass_n;
 }
@@ -590,6 +610,60 @@ ip6_full_reass_on_timeout (vlib_main_t *vm, vlib_node_runtime_t *node,
   ip6_full_reass_drop_all (vm, node, reass, n_left_to_next, to_next);
 }
 
+/* all fragments of a datagram hash to the same thread, workers if any */
+always_inline u32
+ip6_full_reass_steer_thread_index (const ip6_header_t *ip,
+				   const ip6_frag_hdr_t *frag_hdr)
+{
+  u32 n_workers = vlib_num_workers ();
+  u64 h;
+
+  if (!n_workers)
+    return 0;
+
+  h = clib_xxhash (ip->src_address.as_u64[0] ^ ip->src_address.as_u64[1] ^
+		   clib_xxhash (ip->dst_address.as_u64[0] ^
+				ip->dst_address.as_u64[1] ^
+				frag_hdr->identification));
+  return 1 + h % n_workers;
+}
+
+always_inline void
+ip6_full_reass_timer_start (ip6_full_reass_main_t *rm,
+			    ip6_full_reass_per_thread_t *rt,
+			    ip6_full_reass_t *reass, f64 now)
+{
+  f64 left = reass->last_heard + rm->timeout - now;
+  u64 ticks = 1;
+
+  if (left > 0)
+    ticks += left * (MSEC_PER_SEC / IP6_FULL_REASS_TW_TICK_MS);
+
+  reass->timer_handle =
+    tw_timer_start_2t_1w_2048sl (&rt->wheel, reass - rt->pool, 0,
+				 clib_min (ticks, IP6_FULL_REASS_TW_MAX_TICKS));
+}
+
+always_inline void
+ip6_full_reass_steering_arm (vlib_main_t *vm, ip6_full_reass_main_t *rm,
+			     ip6_full_reass_per_thread_t *rt,
+			     ip6_full_reass_t *reass, f64 now)
+{
+  if (1 == rt->reass_n)
+    {
+      /* the wheel is not advanced while it is empty, catch its clock up
+       * rather than expiring every tick it missed */
+      rt->wheel.last_run_time = now;
+      rt->wheel.next_run_time = now + rt->wheel.timer_interval;
+    }
+
+  ip6_full_reass_timer_start (rm, rt, reass, now);
+
+  if (!vlib_node_is_scheduled (vm, rm->ip6_full_reass_expire_sched_node_idx))
+    vlib_node_schedule (vm, rm->ip6_full_reass_expire_sched_node_idx,
+			(f64) IP6_FULL_REASS_TW_TICK_MS / MSEC_PER_SEC);
+}
+
 always_inline ip6_full_reass_t *
 ip6_full_reass_find_or_create (vlib_main_t *vm, vlib_node_runtime_t *node,
 			       ip6_full_reass_main_t *rm,
@@ -652,6 +726,7 @@ again:
       reass->data_len = 0;
       reass->next_index = ~0;
       reass->error_next_index = ~0;
+      reass->timer_handle = ~0;
       reass->memory_owner_thread_index = vm->thread_index;
       ++rt->reass_n;
     }
@@ -678,6 +753,8 @@ again:
 	  if (-2 == rv)
 	    goto again;
 	}
+      else if (rm->steering)
+	ip6_full_reass_steering_arm (vm, rm, rt, reass, now);
     }
   else
     {
@@ -1193,7 +1270,11 @@ ip6_full_reassembly_inline (vlib_main_t *vm, vlib_node_runtime_t *node,
   u32 n_left_from, n_left_to_next, *to_next, next_index;
   ip6_full_reass_main_t *rm = &ip6_full_reass_main;
   ip6_full_reass_per_thread_t *rt = &rm->per_thread_data[vm->thread_index];
-  clib_spinlock_lock (&rt->lock);
+  /* steered contexts are private to this thread */
+  bool locked = !rm->steering;
+
+  if (locked)
+    clib_spinlock_lock (&rt->lock);
 
   n_left_from = frame->n_vectors;
   next_index = node->cached_next_index;
@@ -1237,11 +1318,24 @@ ip6_full_reassembly_inline (vlib_main_t *vm, vlib_node_runtime_t *node,
 	      goto skip_reass;
 	    }
 
+	  frag_hdr =
+	    ip6_ext_next_header_offset (ip0, hdr_chain.eh[res].offset);
+
+	  if (!locked &&
+	      (ip6_frag_hdr_offset (frag_hdr) || ip6_frag_hdr_more (frag_hdr)))
+	    {
+	      u32 owner = ip6_full_reass_steer_thread_index (ip0, frag_hdr);
+	      if (owner != vm->thread_index)
+		{
+		  next0 = IP6_FULL_REASSEMBLY_NEXT_HANDOFF;
+		  vnet_buffer (b0)->ip.reass.owner_thread_index = owner;
+		  goto skip_reass;
+		}
+	    }
+
 	  /* Keep track of received fragments */
 	  vlib_node_increment_counter (vm, node->node_index,
 				       IP6_ERROR_REASS_FRAGMENTS_RCVD, 1);
-	  frag_hdr =
-	    ip6_ext_next_header_offset (ip0, hdr_chain.eh[res].offset);
 	  vnet_buffer (b0)->ip.reass.ip6_frag_hdr_offset =
 	    hdr_chain.eh[res].offset;
 
@@ -1442,7 +1536,8 @@ ip6_full_reassembly_inline (vlib_main_t *vm, vlib_node_runtime_t *node,
       vlib_put_next_frame (vm, node, next_index, n_left_to_next);
     }
 
-  clib_spinlock_unlock (&rt->lock);
+  if (locked)
+    clib_spinlock_unlock (&rt->lock);
   return frame->n_vectors;
 }
 
@@ -1680,6 +1775,10 @@ ip6_full_reass_init_function (vlib_main_t * vm)
   ASSERT (node);
   rm->ip6_full_reass_expire_node_idx = node->index;
 
+  node = vlib_get_node_by_name (vm, (u8 *) "ip6-full-reassembly-expire");
+  ASSERT (node);
+  rm->ip6_full_reass_expire_sched_node_idx = node->index;
+
   ip6_full_reass_set_params (IP6_FULL_REASS_TIMEOUT_DEFAULT_MS,
 			     IP6_FULL_REASS_MAX_REASSEMBLIES_DEFAULT,
 			     IP6_FULL_REASS_MAX_REASSEMBLY_LENGTH_DEFAULT,
@@ -1714,6 +1813,32 @@ ip6_full_reass_init_function (vlib_main_t * vm)
 VLIB_INIT_FUNCTION (ip6_full_reass_init_function);
 #endif /* CLIB_MARCH_VARIANT */
 
+static void
+ip6_full_reass_send_icmp_errors (vlib_main_t *vm, ip6_full_reass_main_t *rm,
+				 u32 *vec_icmp_bi)
+{
+  while (vec_len (vec_icmp_bi) > 0)
+    {
+      vlib_frame_t *f = vlib_get_frame_to_node (vm, rm->ip6_icmp_error_idx);
+      u32 *to_next = vlib_frame_vector_args (f);
+      u32 n_left_to_next = VLIB_FRAME_SIZE - f->n_vectors;
+      int trace_frame = 0;
+      while (vec_len (vec_icmp_bi) > 0 && n_left_to_next > 0)
+	{
+	  u32 bi = vec_pop (vec_icmp_bi);
+	  vlib_buffer_t *b = vlib_get_buffer (vm, bi);
+	  if (PREDICT_FALSE (b->flags & VLIB_BUFFER_IS_TRACED))
+	    trace_frame = 1;
+	  to_next[0] = bi;
+	  ++f->n_vectors;
+	  to_next += 1;
+	  n_left_to_next -= 1;
+	}
+      f->frame_flags |= (trace_frame * VLIB_FRAME_TRACE);
+      vlib_put_frame_to_node (vm, rm->ip6_icmp_error_idx, f);
+    }
+}
+
 static uword
 ip6_full_reass_walk_expired (vlib_main_t *vm, vlib_node_runtime_t *node,
 			     CLIB_UNUSED (vlib_frame_t *f))
@@ -1747,7 +1872,8 @@ ip6_full_reass_walk_expired (vlib_main_t *vm, vlib_node_runtime_t *node,
 
       uword thread_index = 0;
       int index;
-      const uword nthreads = vlib_num_workers () + 1;
+      /* steered contexts are expired by their owning thread */
+      const uword nthreads = rm->steering ? 0 : vlib_num_workers () + 1;
       u32 *vec_icmp_bi = NULL;
       u32 n_left_to_next, *to_next;
 
@@ -1809,27 +1935,7 @@ ip6_full_reass_walk_expired (vlib_main_t *vm, vlib_node_runtime_t *node,
 					 reass_timeout_cnt);
 	}
 
-      while (vec_len (vec_icmp_bi) > 0)
-	{
-	  vlib_frame_t *f =
-	    vlib_get_frame_to_node (vm, rm->ip6_icmp_error_idx);
-	  u32 *to_next = vlib_frame_vector_args (f);
-	  u32 n_left_to_next = VLIB_FRAME_SIZE - f->n_vectors;
-	  int trace_frame = 0;
-	  while (vec_len (vec_icmp_bi) > 0 && n_left_to_next > 0)
-	    {
-	      u32 bi = vec_pop (vec_icmp_bi);
-	      vlib_buffer_t *b = vlib_get_buffer (vm, bi);
-	      if (PREDICT_FALSE (b->flags & VLIB_BUFFER_IS_TRACED))
-		trace_frame = 1;
-	      to_next[0] = bi;
-	      ++f->n_vectors;
-	      to_next += 1;
-	      n_left_to_next -= 1;
-	    }
-	  f->frame_flags |= (trace_frame * VLIB_FRAME_TRACE);
-	  vlib_put_frame_to_node (vm, rm->ip6_icmp_error_idx, f);
-	}
+      ip6_full_reass_send_icmp_errors (vm, rm, vec_icmp_bi);
 
       vec_free (pool_indexes_to_free);
       vec_free (vec_icmp_bi);
@@ -1852,6 +1958,62 @@ VLIB_REGISTER_NODE (ip6_full_reass_expire_node) = {
   .error_counters = ip6_error_counters,
 };
 
+static uword
+ip6_full_reass_expire_timers (vlib_main_t *vm, vlib_node_runtime_t *node,
+			      CLIB_UNUSED (vlib_frame_t *f))
+{
+  ip6_full_reass_main_t *rm = &ip6_full_reass_main;
+  ip6_full_reass_per_thread_t *rt = &rm->per_thread_data[vm->thread_index];
+  f64 now = vlib_time_now (vm);
+  u32 *handle, n_left_to_next, *to_next, reass_timeout_cnt = 0;
+
+  if (!rm->steering)
+    return 0;
+
+  rt->expired_timers = tw_timer_expire_timers_vec_2t_1w_2048sl (
+    &rt->wheel, now, rt->expired_timers);
+
+  vec_foreach (handle, rt->expired_timers)
+    {
+      ip6_full_reass_t *reass = pool_elt_at_index (rt->pool, handle[0]);
+      u32 icmp_bi = ~0;
+
+      reass->timer_handle = ~0;
+      if (now > reass->last_heard + rm->timeout)
+	{
+	  reass_timeout_cnt += reass->fragments_n;
+	  ip6_full_reass_on_timeout (vm, node, reass, &icmp_bi,
+				     &n_left_to_next, &to_next);
+	  if (~0 != icmp_bi)
+	    vec_add1 (rt->icmp_bis, icmp_bi);
+	  ip6_full_reass_free (rm, rt, reass);
+	}
+      else
+	/* heard from since the timer was armed */
+	ip6_full_reass_timer_start (rm, rt, reass, now);
+    }
+  vec_reset_length (rt->expired_timers);
+
+  if (reass_timeout_cnt)
+    vlib_node_increment_counter (vm, node->node_index,
+				 IP6_ERROR_REASS_TIMEOUT, reass_timeout_cnt);
+  ip6_full_reass_send_icmp_errors (vm, rm, rt->icmp_bis);
+
+  if (rt->reass_n)
+    vlib_node_schedule (vm, node->node_index,
+			(f64) IP6_FULL_REASS_TW_TICK_MS / MSEC_PER_SEC);
+
+  return 0;
+}
+
+VLIB_REGISTER_NODE (ip6_full_reass_expire_sched_node) = {
+  .function = ip6_full_reass_expire_timers,
+  .type = VLIB_NODE_TYPE_SCHED,
+  .name = "ip6-full-reassembly-expire",
+  .n_errors = IP6_N_ERROR,
+  .error_counters = ip6_error_counters,
+};
+
 static u8 *
 format_ip6_full_reass_key (u8 * s, va_list * args)
 {
@@ -1949,6 +2111,8 @@ show_ip6_full_reass (vlib_main_t * vm, unformat_input_t * input,
 		   (long unsigned) rm->expire_walk_interval_ms);
   vlib_cli_output (vm, "Buffers in use: %lu\n",
 		   (long unsigned) sum_buffers_n);
+  vlib_cli_output (vm, "Fragment steering: %s\n",
+		   rm->steering ? "enabled" : "disabled");
   return 0;
 }
 
@@ -1966,8 +2130,92 @@ ip6_full_reass_enable_disable (u32 sw_if_index, u8 enable_disable)
 				      "ip6-full-reassembly-feature",
 				      sw_if_index, enable_disable, 0, 0);
 }
+
+static void
+ip6_full_reass_flush (vlib_main_t *vm)
+{
+  ip6_full_reass_main_t *rm = &ip6_full_reass_main;
+  vlib_node_runtime_t *node =
+    vlib_node_get_runtime (vm, rm->ip6_full_reass_expire_node_idx);
+  ip6_full_reass_per_thread_t *rt;
+  ip6_full_reass_t *reass;
+  u32 *indexes = NULL, *i, n_left_to_next, *to_next;
+
+  vec_foreach (rt, rm->per_thread_data)
+    {
+      vec_reset_length (indexes);
+      pool_foreach (reass, rt->pool)
+	vec_add1 (indexes, reass - rt->pool);
+
+      vec_foreach (i, indexes)
+	{
+	  reass = pool_elt_at_index (rt->pool, i[0]);
+	  ip6_full_reass_drop_all (vm, node, reass, &n_left_to_next,
+				   &to_next);
+	  ip6_full_reass_free (rm, rt, reass);
+	}
+    }
+  vec_free (indexes);
+}
+
+vnet_api_error_t
+ip6_full_reass_steering_enable_disable (bool enable)
+{
+  ip6_full_reass_main_t *rm = &ip6_full_reass_main;
+  vlib_main_t *vm = vlib_get_main ();
+  ip6_full_reass_per_thread_t *rt;
+
+  if (enable == rm->steering)
+    return 0;
+
+  /* contexts are tracked differently in each mode, start afresh */
+  vlib_worker_thread_barrier_sync (vm);
+  ip6_full_reass_flush (vm);
+
+  vec_foreach (rt, rm->per_thread_data)
+    {
+      if (enable)
+	tw_timer_wheel_init_2t_1w_2048sl (
+	  &rt->wheel, 0, (f64) IP6_FULL_REASS_TW_TICK_MS / MSEC_PER_SEC, ~0);
+      else
+	{
+	  tw_timer_wheel_free_2t_1w_2048sl (&rt->wheel);
+	  vec_free (rt->expired_timers);
+	  vec_free (rt->icmp_bis);
+	}
+    }
+
+  rm->steering = enable;
+  vlib_worker_thread_barrier_release (vm);
+
+  return 0;
+}
 #endif /* CLIB_MARCH_VARIANT */
 
+static clib_error_t *
+set_ip6_full_reass_steering (vlib_main_t *vm, unformat_input_t *input,
+			     CLIB_UNUSED (vlib_cli_command_t *cmd))
+{
+  bool enable;
+
+  if (unformat (input, "on"))
+    enable = true;
+  else if (unformat (input, "off"))
+    enable = false;
+  else
+    return clib_error_return (0, "expected 'on' or 'off', got `%U'",
+			      format_unformat_error, input);
+
+  ip6_full_reass_steering_enable_disable (enable);
+  return 0;
+}
+
+VLIB_CLI_COMMAND (set_ip6_full_reass_steering_cmd, static) = {
+  .path = "set ip6-full-reassembly steering",
+  .short_help = "set ip6-full-reassembly steering on|off",
+  .function = set_ip6_full_reass_steering,
+};
+
 #define foreach_ip6_full_reassembly_handoff_error                       \
 _(CONGESTION_DROP, "congestion drop")
 
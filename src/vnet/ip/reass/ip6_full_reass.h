@@ -47,6 +47,15 @@ int ip6_full_reass_enable_disable_with_refcnt (u32 sw_if_index,
 					       int is_enable);
 
 void ip6_local_full_reass_enable_disable (int enable);
+
+/**
+ * @brief steer fragments to a thread chosen by a hash of the datagram key
+ *
+ * Every fragment of a datagram is then reassembled on the same thread, so
+ * contexts are neither locked nor shared, and are expired by a per-thread
+ * timer wheel. Switching mode drops all the in-progress reassemblies.
+ */
+vnet_api_error_t ip6_full_reass_steering_enable_disable (bool enable);
 int ip6_local_full_reass_enabled ();
 #endif /* __included_ip6_full_reass_h */
 
@@ -506,6 +506,9 @@ esp_decrypt_prepare_sync_op (vlib_main_t *vm, ipsec_per_thread_data_t *ptd,
   vnet_crypto_op_t **integ_ops;
   vnet_crypto_op_t _op, *op = &_op;
   const u8 esp_sz = sizeof (esp_header_t);
+  u8 *integ_src = 0, *digest = 0;
+  u32 integ_len = 0;
+  int is_linked = 0;
 
   if (PREDICT_TRUE (irt->integ_op_id != VNET_CRYPTO_OP_NONE))
     {
@@ -568,9 +571,18 @@ esp_decrypt_prepare_sync_op (vlib_main_t *vm, ipsec_per_thread_data_t *ptd,
 	  integ_ops = &ptd->integ_ops;
 	  esp_insert_esn (vm, irt, pd, pd2, &op->len, &op->digest, &len, b,
 			  payload);
+	  if (irt->linked_op_id)
+	    {
+	      /* HMAC check is done by the linked cipher op below */
+	      is_linked = 1;
+	      integ_src = op->src;
+	      integ_len = op->len;
+	      digest = op->digest;
+	    }
 	}
     out:
-      vec_add_aligned (*integ_ops, op, 1, CLIB_CACHE_LINE_BYTES);
+      if (is_linked == 0)
+	vec_add_aligned (*integ_ops, op, 1, CLIB_CACHE_LINE_BYTES);
     }
 
   payload += esp_sz;
@@ -578,8 +590,21 @@ esp_decrypt_prepare_sync_op (vlib_main_t *vm, ipsec_per_thread_data_t *ptd,
 
   if (irt->cipher_op_id != VNET_CRYPTO_OP_NONE)
     {
-      vnet_crypto_op_init (op, irt->cipher_op_id);
-      op->key_index = irt->cipher_key_index;
+      if (is_linked)
+	{
+	  vnet_crypto_op_init (op, irt->linked_op_id);
+	  op->key_index = irt->linked_key_index;
+	  op->flags = VNET_CRYPTO_OP_FLAG_HMAC_CHECK;
+	  op->aad = integ_src;
+	  op->aad_len = integ_len;
+	  op->digest = digest;
+	  op->digest_len = icv_sz;
+	}
+      else
+	{
+	  vnet_crypto_op_init (op, irt->cipher_op_id);
+	  op->key_index = irt->cipher_key_index;
+	}
       op->iv = payload;
 
       if (irt->is_ctr)
@@ -627,6 +652,12 @@ esp_decrypt_prepare_sync_op (vlib_main_t *vm, ipsec_per_thread_data_t *ptd,
 				    &op->n_chunks);
 	  crypto_ops = &ptd->chained_crypto_ops;
 	}
+      else if (is_linked)
+	{
+	  /* processed with the integ ops so a failed check is counted as
+	   * an integrity error */
+	  crypto_ops = &ptd->integ_ops;
+	}
       else
 	{
 	  crypto_ops = &ptd->crypto_ops;
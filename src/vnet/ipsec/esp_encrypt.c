@@ -379,11 +379,15 @@ esp_prepare_sync_op (vlib_main_t *vm, ipsec_per_thread_data_t *ptd,
 		     u8 icv_sz, u32 bi, vlib_buffer_t **b, vlib_buffer_t *lb,
 		     u32 hdr_len, esp_header_t *esp)
 {
+  /* single buffer packets get cipher and HMAC done by one linked op */
+  int is_linked = ort->linked_op_id && lb == b[0];
+
   if (ort->cipher_op_id)
     {
       vnet_crypto_op_t *op;
       vec_add2_aligned (crypto_ops[0], op, 1, CLIB_CACHE_LINE_BYTES);
-      vnet_crypto_op_init (op, ort->cipher_op_id);
+      vnet_crypto_op_init (op,
+			   is_linked ? ort->linked_op_id : ort->cipher_op_id);
       u8 *crypto_start = payload;
       /* esp_add_footer_and_icv() in esp_encrypt_inline() makes sure we always
        * have enough space for ESP header and footer which includes ICV */
@@ -393,7 +397,8 @@ esp_prepare_sync_op (vlib_main_t *vm, ipsec_per_thread_data_t *ptd,
       /* generate the IV in front of the payload */
       void *pkt_iv = esp_generate_iv (ort, payload, iv_sz);
 
-      op->key_index = ort->cipher_key_index;
+      op->key_index =
+	is_linked ? ort->linked_key_index : ort->cipher_key_index;
       op->user_data = bi;
 
       if (ort->is_ctr)
@@ -449,6 +454,22 @@ esp_prepare_sync_op (vlib_main_t *vm, ipsec_per_thread_data_t *ptd,
 	  op->src = op->dst = crypto_start;
 	  op->len = crypto_len;
 	}
+
+      if (is_linked)
+	{
+	  /* HMAC covers ESP header, IV and ciphertext (+ ESN high bits) */
+	  op->aad = payload - iv_sz - sizeof (esp_header_t);
+	  op->aad_len = payload_len - icv_sz + iv_sz + sizeof (esp_header_t);
+	  op->digest = payload + payload_len - icv_sz;
+	  op->digest_len = icv_sz;
+	  if (ort->use_esn)
+	    {
+	      u32 tmp = clib_net_to_host_u32 (seq_hi);
+	      clib_memcpy_fast (op->digest, &tmp, sizeof (seq_hi));
+	      op->aad_len += sizeof (seq_hi);
+	    }
+	  return;
+	}
     }
 
   if (ort->integ_op_id)
@@ -96,8 +96,9 @@ ipsec_sa_stack (ipsec_sa_t * sa)
 void
 ipsec_sa_set_async_mode (ipsec_sa_t *sa, int is_enabled)
 {
-  u32 cipher_key_index, integ_key_index;
+  u32 cipher_key_index, integ_key_index, linked_key_index = ~0;
   vnet_crypto_op_id_t inb_cipher_op_id, outb_cipher_op_id, integ_op_id;
+  vnet_crypto_op_id_t inb_linked_op_id = 0, outb_linked_op_id = 0;
   u32 is_async;
   if (is_enabled)
     {
@@ -120,6 +121,17 @@ ipsec_sa_set_async_mode (ipsec_sa_t *sa, int is_enabled)
       integ_key_index = sa->integ_sync_key_index;
       integ_op_id = sa->integ_sync_op_id;
       is_async = 0;
+
+      /* cipher + HMAC in a single linked op when some engine can do it,
+       * chained buffers still use separate cipher and integ ops */
+      if (sa->linked_key_index != ~0 &&
+	  vnet_crypto_is_set_handler (
+	    vnet_crypto_get_key (sa->linked_key_index)->alg))
+	{
+	  linked_key_index = sa->linked_key_index;
+	  outb_linked_op_id = sa->crypto_async_enc_op_id;
+	  inb_linked_op_id = sa->crypto_async_dec_op_id;
+	}
     }
 
   if (ipsec_sa_get_inb_rt (sa))
@@ -129,6 +141,8 @@ ipsec_sa_set_async_mode (ipsec_sa_t *sa, int is_enabled)
       irt->integ_key_index = integ_key_index;
       irt->cipher_op_id = inb_cipher_op_id;
       irt->integ_op_id = integ_op_id;
+      irt->linked_key_index = linked_key_index;
+      irt->linked_op_id = inb_linked_op_id;
       irt->is_async = is_async;
     }
 
@@ -139,6 +153,8 @@ ipsec_sa_set_async_mode (ipsec_sa_t *sa, int is_enabled)
       ort->integ_key_index = integ_key_index;
       ort->cipher_op_id = outb_cipher_op_id;
       ort->integ_op_id = integ_op_id;
+      ort->linked_key_index = linked_key_index;
+      ort->linked_op_id = outb_linked_op_id;
       ort->is_async = is_async;
     }
 }
@@ -154,6 +154,7 @@ typedef struct
   u16 is_async : 1;
   u16 cipher_op_id;
   u16 integ_op_id;
+  u16 linked_op_id;
   u8 cipher_iv_size;
   u8 integ_icv_size;
   u8 udp_sz;
@@ -163,6 +164,7 @@ typedef struct
   u16 async_op_id;
   vnet_crypto_key_index_t cipher_key_index;
   vnet_crypto_key_index_t integ_key_index;
+  vnet_crypto_key_index_t linked_key_index;
   u32 anti_replay_window_size;
   uword replay_window[];
 } ipsec_sa_inb_rt_t;
@@ -182,6 +184,7 @@ typedef struct
   u16 is_async : 1;
   u16 cipher_op_id;
   u16 integ_op_id;
+  u16 linked_op_id;
   u8 cipher_iv_size;
   u8 esp_block_align;
   u8 integ_icv_size;
@@ -196,6 +199,7 @@ typedef struct
   clib_pcg64i_random_t iv_prng;
   vnet_crypto_key_index_t cipher_key_index;
   vnet_crypto_key_index_t integ_key_index;
+  vnet_crypto_key_index_t linked_key_index;
   union
   {
     ip4_header_t ip4_hdr;
@@ -78,7 +78,8 @@ typedef struct
   u32 scale;			// power-of-2 shift amount for lower rates
   qos_action_type_en action[3];
   ip_dscp_t mark_dscp[3];
-  u8 pad[2];
+  u8 distributed;		// police on each worker, see policer_shared_t
+  u8 pad[1];
 
   // Fields are marked as 2R if they are only used for a 2-rate policer,
   // and MOD if they are modified as part of the update operation.
@@ -215,6 +216,151 @@ vnet_police_packet (policer_t *policer, u32 packet_length,
   return result;
 }
 
+// Distributed mode.
+// A policer is otherwise owned by one thread, and packets that arrive on
+// the other workers are handed off to it. For an aggregate policer fed by
+// many RSS queues that thread becomes the bottleneck. In distributed mode
+// each worker instead polices against its own local buckets, which borrow
+// tokens from the policer's shared buckets a quantum at a time.
+//
+// The shared buckets are kept as token clocks, the total number of tokens
+// borrowed since the policer was started. The tokens available are the
+// difference between the tokens accrued, n_periods * tokens_per_period,
+// and the clock, capped at the limit. A borrow is then a single 64 bit
+// compare-and-swap, no lock is needed.
+//
+// Tokens borrowed by a worker can't be used by the others, so the policer
+// may admit up to one quantum per worker (and bucket) more than a policer
+// owned by a single thread would. The quantum is the accuracy knob.
+//
+// The clocks are relative to start_time, so they cannot overflow in any
+// reasonable up-time, and start at -limit, i.e. with the buckets full.
+
+typedef struct
+{
+  CLIB_CACHE_LINE_ALIGN_MARK (cacheline0);
+  u32 current_bucket;		// MOD
+  u32 extended_bucket;		// MOD
+} policer_local_t;
+
+typedef struct
+{
+  CLIB_CACHE_LINE_ALIGN_MARK (cacheline0);
+  u64 current_clock;		// MOD, atomically
+  u64 extended_clock;		// MOD, atomically, 2R
+  u64 start_time;		// policer periods
+  u32 quantum;			// tokens borrowed at once
+  u32 configured_quantum;	// bytes, 0 = default
+  policer_local_t *locals;	// per-thread
+} policer_shared_t;
+
+// Borrow at least 'want' tokens, or as many as there are, from a shared
+// bucket whose clock would be 'now' were it empty. Returns the number of
+// tokens borrowed.
+static_always_inline u32
+vnet_police_borrow (u64 *clock, u64 now, u32 limit, u32 want)
+{
+  u64 old, base;
+
+  old = clib_atomic_load_relax_n (clock);
+
+  do
+    {
+      // tokens in excess of the limit are lost
+      base = clib_max (old, now - limit);
+
+      if (base >= now)
+	return 0;
+      if (base + want > now)
+	want = now - base;
+    }
+  while (!clib_atomic_cmp_and_swap_acq_relax_n (clock, &old, base + want, 0));
+
+  return want;
+}
+
+// As vnet_police_packet, for a distributed policer. The decision is taken
+// against the thread's local buckets, a bucket that cannot cover the
+// packet is first topped up from the shared one.
+static inline policer_result_e
+vnet_police_packet_distributed (policer_t *policer, policer_shared_t *shared,
+				policer_local_t *local, u32 packet_length,
+				policer_result_e packet_color, u64 time)
+{
+  u64 n_periods, current_now, extended_now;
+  u32 extended_tokens_per_period, want;
+  policer_result_e result;
+
+  packet_length = packet_length << policer->scale;
+
+  n_periods = time - shared->start_time;
+  extended_tokens_per_period = (policer->single_rate ?
+				  policer->cir_tokens_per_period :
+				  policer->pir_tokens_per_period);
+  current_now = policer->current_limit +
+		n_periods * policer->cir_tokens_per_period;
+  extended_now = policer->extended_limit +
+		 n_periods * extended_tokens_per_period;
+
+  if (local->current_bucket < packet_length &&
+      (!policer->color_aware || (packet_color == POLICE_CONFORM)))
+    {
+      want = clib_max (shared->quantum,
+		       packet_length - local->current_bucket);
+      local->current_bucket +=
+	vnet_police_borrow (&shared->current_clock, current_now,
+			    policer->current_limit, want);
+    }
+  if (local->extended_bucket < packet_length &&
+      (!policer->color_aware || (packet_color != POLICE_VIOLATE)))
+    {
+      want = clib_max (shared->quantum,
+		       packet_length - local->extended_bucket);
+      local->extended_bucket +=
+	vnet_police_borrow (&shared->extended_clock, extended_now,
+			    policer->extended_limit, want);
+    }
+
+  if (policer->single_rate)
+    {
+      if ((!policer->color_aware || (packet_color == POLICE_CONFORM))
+	  && (local->current_bucket >= packet_length))
+	{
+	  local->current_bucket -= packet_length;
+	  local->extended_bucket -= clib_min (local->extended_bucket,
+					      packet_length);
+	  result = POLICE_CONFORM;
+	}
+      else if ((!policer->color_aware || (packet_color != POLICE_VIOLATE))
+	       && (local->extended_bucket >= packet_length))
+	{
+	  local->extended_bucket -= packet_length;
+	  result = POLICE_EXCEED;
+	}
+      else
+	result = POLICE_VIOLATE;
+    }
+  else
+    {
+      if ((policer->color_aware && (packet_color == POLICE_VIOLATE))
+	  || (local->extended_bucket < packet_length))
+	result = POLICE_VIOLATE;
+      else if ((policer->color_aware && (packet_color == POLICE_EXCEED))
+	       || (local->current_bucket < packet_length))
+	{
+	  local->extended_bucket -= packet_length;
+	  result = POLICE_EXCEED;
+	}
+      else
+	{
+	  local->current_bucket -= packet_length;
+	  local->extended_bucket -= packet_length;
+	  result = POLICE_CONFORM;
+	}
+    }
+  return result;
+}
+
 #endif // __POLICE_H__
 
 /*
@@ -72,7 +72,8 @@ vnet_policer_police (vlib_main_t *vm, vlib_buffer_t *b, u32 policer_index,
 
   pol = &pm->policers[policer_index];
 
-  if (handoff)
+  /* no thread owns a distributed policer, so there is no handoff */
+  if (handoff && !pol->distributed)
     {
       if (PREDICT_FALSE (pol->thread_index == CLIB_INVALID_THREAD_INDEX))
 	/*
@@ -89,7 +90,17 @@ vnet_policer_police (vlib_main_t *vm, vlib_buffer_t *b, u32 policer_index,
     }
 
   len = vlib_buffer_length_in_chain (vm, b);
-  col = vnet_police_packet (pol, len, packet_color, time_in_policer_periods);
+  if (PREDICT_FALSE (pol->distributed))
+    {
+      policer_shared_t *shared = &pm->shared_policers[policer_index];
+
+      col = vnet_police_packet_distributed (
+	pol, shared, &shared->locals[vm->thread_index], len, packet_color,
+	time_in_policer_periods);
+    }
+  else
+    col =
+      vnet_police_packet (pol, len, packet_color, time_in_policer_periods);
   act = pol->action[col];
   vlib_increment_combined_counter (&policer_counters[col], vm->thread_index,
 				   policer_index, 1, len);
@@ -49,6 +49,22 @@ vlib_combined_counter_main_t policer_counters[] = {
   },
 };
 
+static void
+policer_shared_reset (policer_shared_t *shared)
+{
+  policer_local_t *local;
+
+  shared->start_time = clib_cpu_time_now () >> POLICER_TICKS_PER_PERIOD_SHIFT;
+  shared->current_clock = 0;
+  shared->extended_clock = 0;
+
+  vec_foreach (local, shared->locals)
+    {
+      local->current_bucket = 0;
+      local->extended_bucket = 0;
+    }
+}
+
 int
 policer_add (vlib_main_t *vm, const u8 *name, const qos_pol_cfg_params_st *cfg,
 	     u32 *policer_index)
@@ -118,6 +134,9 @@ policer_del (vlib_main_t *vm, u32 policer_index)
       hash_unset_mem (pm->policer_config_by_name, policer->name);
     }
 
+  if (policer->distributed)
+    policer_distribute (policer_index, false, 0);
+
   /* free policer */
   hash_unset_mem (pm->policer_index_by_name, policer->name);
   vec_free (policer->name);
@@ -136,6 +155,7 @@ policer_update (vlib_main_t *vm, u32 policer_index,
   qos_pol_cfg_params_st *cp;
   uword *p;
   u8 *name;
+  u8 distributed;
   int rv;
   int i;
 
@@ -164,6 +184,7 @@ policer_update (vlib_main_t *vm, u32 policer_index,
     }
 
   name = policer->name;
+  distributed = policer->distributed;
 
   clib_memcpy (cp, cfg, sizeof (*cp));
   clib_memcpy (policer, &test_policer, sizeof (*policer));
@@ -171,6 +192,10 @@ policer_update (vlib_main_t *vm, u32 policer_index,
   policer->name = name;
   policer->thread_index = ~0;
 
+  if (distributed)
+    policer_distribute (policer_index, true,
+			pm->shared_policers[policer_index].configured_quantum);
+
   for (i = 0; i < NUM_POLICE_RESULTS; i++)
     vlib_zero_combined_counter (&policer_counters[i], policer_index);
 
@@ -191,6 +216,9 @@ policer_reset (vlib_main_t *vm, u32 policer_index)
   policer->current_bucket = policer->current_limit;
   policer->extended_bucket = policer->extended_limit;
 
+  if (policer->distributed)
+    policer_shared_reset (&pm->shared_policers[policer_index]);
+
   return 0;
 }
 
@@ -221,6 +249,54 @@ policer_bind_worker (u32 policer_index, u32 worker, bool bind)
   return 0;
 }
 
+int
+policer_distribute (u32 policer_index, bool enable, u32 quantum)
+{
+  vnet_policer_main_t *pm = &vnet_policer_main;
+  policer_shared_t *shared;
+  policer_t *policer;
+
+  if (pool_is_free_index (pm->policers, policer_index))
+    return VNET_API_ERROR_NO_SUCH_ENTRY;
+
+  policer = &pm->policers[policer_index];
+
+  if (enable)
+    {
+      vec_validate_aligned (pm->shared_policers, policer_index,
+			    CLIB_CACHE_LINE_BYTES);
+      shared = &pm->shared_policers[policer_index];
+      vec_validate_aligned (shared->locals, vlib_get_n_threads () - 1,
+			    CLIB_CACHE_LINE_BYTES);
+
+      /*
+       * By default allow the workers to hold half of the committed burst
+       * between them.
+       */
+      shared->configured_quantum = quantum;
+      if (quantum)
+	shared->quantum = quantum << policer->scale;
+      else
+	shared->quantum = policer->current_limit / (2 * vec_len (shared->locals));
+      shared->quantum = clib_max (shared->quantum, 1);
+
+      policer_shared_reset (shared);
+      policer->distributed = 1;
+    }
+  else if (policer->distributed)
+    {
+      policer->distributed = 0;
+      shared = &pm->shared_policers[policer_index];
+      vec_free (shared->locals);
+
+      /* the thread that owns the policer from now on starts afresh */
+      policer->current_bucket = policer->current_limit;
+      policer->extended_bucket = policer->extended_limit;
+    }
+
+  return 0;
+}
+
 int
 policer_input (u32 policer_index, u32 sw_if_index, vlib_dir_t dir, bool apply)
 {
@@ -278,6 +354,20 @@ format_policer_instance (u8 * s, va_list * va)
 	      i->current_limit,
 	      i->current_bucket, i->extended_limit, i->extended_bucket);
   s = format (s, "last update %llu\n", i->last_update_time);
+  if (i->distributed)
+    {
+      policer_shared_t *shared = &pm->shared_policers[policer_index];
+      policer_local_t *local;
+      u32 cur = 0, ext = 0;
+
+      vec_foreach (local, shared->locals)
+	{
+	  cur += local->current_bucket;
+	  ext += local->extended_bucket;
+	}
+      s = format (s, "distributed quantum %u, %u threads hold cur %u ext %u\n",
+		  shared->quantum, vec_len (shared->locals), cur, ext);
+    }
   s = format (s, "conform %llu packets, %llu bytes\n",
 	      counts[POLICE_CONFORM].packets, counts[POLICE_CONFORM].bytes);
   s = format (s, "exceed %llu packets, %llu bytes\n",
@@ -764,6 +854,63 @@ done:
   return error;
 }
 
+static clib_error_t *
+policer_distribute_command_fn (vlib_main_t *vm, unformat_input_t *input,
+			       vlib_cli_command_t *cmd)
+{
+  unformat_input_t _line_input, *line_input = &_line_input;
+  clib_error_t *error = NULL;
+  vnet_policer_main_t *pm = &vnet_policer_main;
+  u8 enable = 1;
+  u8 *name = 0;
+  u32 quantum = 0;
+  u32 policer_index = ~0;
+  uword *p;
+  int rv;
+
+  /* Get a line of input. */
+  if (!unformat_user (input, unformat_line_input, line_input))
+    return 0;
+
+  while (unformat_check_input (line_input) != UNFORMAT_END_OF_INPUT)
+    {
+      if (unformat (line_input, "name %s", &name))
+	;
+      else if (unformat (line_input, "index %u", &policer_index))
+	;
+      else if (unformat (line_input, "quantum %u", &quantum))
+	;
+      else if (unformat (line_input, "disable"))
+	enable = 0;
+      else
+	{
+	  error = clib_error_return (0, "unknown input `%U'",
+				     format_unformat_error, line_input);
+	  goto done;
+	}
+    }
+
+  if (~0 == policer_index && 0 != name)
+    {
+      p = hash_get_mem (pm->policer_index_by_name, name);
+      if (p != NULL)
+	policer_index = p[0];
+    }
+
+  rv = VNET_API_ERROR_NO_SUCH_ENTRY;
+  if (~0 != policer_index)
+    rv = policer_distribute (policer_index, enable, quantum);
+
+  if (rv)
+    error = clib_error_return (0, "failed: `%d'", rv);
+
+done:
+  unformat_free (line_input);
+  vec_free (name);
+
+  return error;
+}
+
 static clib_error_t *
 policer_input_command_fn (vlib_main_t *vm, unformat_input_t *input,
 			  vlib_cli_command_t *cmd)
@@ -923,6 +1070,13 @@ VLIB_CLI_COMMAND (policer_bind_command, static) = {
   .function = policer_bind_command_fn,
 };
 
+VLIB_CLI_COMMAND (policer_distribute_command, static) = {
+  .path = "policer distribute",
+  .short_help = "policer distribute [disable] [name <name> | index <index>] "
+		"[quantum <bytes>]",
+  .function = policer_distribute_command_fn,
+};
+
 VLIB_CLI_COMMAND (policer_input_command, static) = {
   .path = "policer input",
   .short_help =
@@ -28,6 +28,9 @@ typedef struct
   /* policer pool, aligned */
   policer_t *policers;
 
+  /* shared buckets of distributed policers, by policer index */
+  policer_shared_t *shared_policers;
+
   /* config + template h/w policer instance parallel pools */
   qos_pol_cfg_params_st *configs;
   policer_t *policer_templates;
@@ -79,6 +82,7 @@ int policer_update (vlib_main_t *vm, u32 policer_index,
 int policer_del (vlib_main_t *vm, u32 policer_index);
 int policer_reset (vlib_main_t *vm, u32 policer_index);
 int policer_bind_worker (u32 policer_index, u32 worker, bool bind);
+int policer_distribute (u32 policer_index, bool enable, u32 quantum);
 int policer_input (u32 policer_index, u32 sw_if_index, vlib_dir_t dir,
 		   bool apply);
 
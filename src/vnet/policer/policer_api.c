@@ -221,6 +221,18 @@ vl_api_policer_bind_v2_t_handler (vl_api_policer_bind_v2_t *mp)
   REPLY_MACRO (VL_API_POLICER_BIND_V2_REPLY);
 }
 
+static void
+vl_api_policer_distribute_t_handler (vl_api_policer_distribute_t *mp)
+{
+  vl_api_policer_distribute_reply_t *rmp;
+  int rv;
+
+  rv = policer_distribute (ntohl (mp->policer_index), mp->enable,
+			   ntohl (mp->quantum));
+
+  REPLY_MACRO (VL_API_POLICER_DISTRIBUTE_REPLY);
+}
+
 static void
 vl_api_policer_input_t_handler (vl_api_policer_input_t *mp)
 {
@@ -844,6 +844,8 @@ application_alloc_and_init (app_init_args_t *a)
     props->evt_q_size = opts[APP_OPTIONS_EVT_QUEUE_SIZE];
   if (opts[APP_OPTIONS_FLAGS] & APP_OPTIONS_FLAGS_EVT_MQ_USE_EVENTFD)
     props->use_mq_eventfd = 1;
+  if (opts[APP_OPTIONS_FLAGS] & APP_OPTIONS_FLAGS_EVT_MQ_VEC_EVTS)
+    props->use_mq_vec_evts = 1;
   if (opts[APP_OPTIONS_TLS_ENGINE])
     app->tls_engine = opts[APP_OPTIONS_TLS_ENGINE];
   if (opts[APP_OPTIONS_MAX_FIFO_SIZE])
@@ -1098,6 +1100,8 @@ application_alloc_worker_and_init (application_t * app, app_worker_t ** wrk)
   app_wrk->listeners_table = hash_create (0, sizeof (u64));
   app_wrk->event_queue = segment_manager_event_queue (sm);
   app_wrk->app_is_builtin = application_is_builtin (app);
+  app_wrk->mq_vec_evts =
+    application_segment_manager_properties (app)->use_mq_vec_evts;
 
   *wrk = app_wrk;
 
@@ -74,6 +74,9 @@ typedef struct app_worker_
 
   u8 app_is_builtin;
 
+  /** Set if app asked for vectored io events */
+  u8 mq_vec_evts;
+
   /** Pool of half-open session handles. Tracked in case worker detaches */
   session_handle_t *half_open_table;
 
@@ -389,6 +392,11 @@ session_t *app_worker_first_listener (app_worker_t * app,
 				      u8 fib_proto, u8 transport_proto);
 void app_wrk_send_ctrl_evt_fd (app_worker_t *app_wrk, u8 evt_type, void *msg,
 			       u32 msg_len, int fd);
+u8 app_wrk_io_evt_vec_can_add (app_worker_t *app_wrk,
+				clib_thread_index_t thread_index);
+int app_wrk_send_io_evt_vec (app_worker_t *app_wrk, u8 evt_type,
+			     u32 session_index);
+void app_wrk_flush_io_evt_vec (clib_thread_index_t thread_index);
 void app_wrk_send_ctrl_evt (app_worker_t *app_wrk, u8 evt_type, void *msg,
 			    u32 msg_len);
 u8 app_worker_mq_wrk_is_congested (app_worker_t *app_wrk,
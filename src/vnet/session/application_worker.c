@@ -835,6 +835,73 @@ app_wrk_send_ctrl_evt (app_worker_t *app_wrk, u8 evt_type, void *msg,
   app_wrk_send_ctrl_evt_inline (app_wrk, evt_type, msg, msg_len, -1);
 }
 
+u8
+app_wrk_io_evt_vec_can_add (app_worker_t *app_wrk,
+			    clib_thread_index_t thread_index)
+{
+  session_worker_t *wrk = session_main_get_worker (thread_index);
+
+  if (wrk->io_evt_vec_mq)
+    return 1;
+  return !svm_msg_q_or_ring_is_full (app_wrk->event_queue,
+				     SESSION_MQ_IO_VEC_EVT_RING);
+}
+
+/**
+ * Add io event to vectored io event being built for app worker
+ *
+ * Must be called with app worker mq lock held. Event is only added to the mq
+ * once full or when @ref app_wrk_flush_io_evt_vec is called.
+ *
+ * @return 0 if event was added, -1 if no vectored event could be allocated
+ *	   and caller should send a plain io event instead
+ */
+int
+app_wrk_send_io_evt_vec (app_worker_t *app_wrk, u8 evt_type,
+			 u32 session_index)
+{
+  session_worker_t *wrk = session_main_get_worker (vlib_get_thread_index ());
+  svm_msg_q_t *mq = app_wrk->event_queue;
+  session_io_evt_vec_t *ev;
+  session_event_t *evt;
+
+  if (!wrk->io_evt_vec_mq)
+    {
+      if (svm_msg_q_or_ring_is_full (mq, SESSION_MQ_IO_VEC_EVT_RING))
+	return -1;
+      wrk->io_evt_vec_msg =
+	svm_msg_q_alloc_msg_w_ring (mq, SESSION_MQ_IO_VEC_EVT_RING);
+      wrk->io_evt_vec_mq = mq;
+      evt = svm_msg_q_msg_data (mq, &wrk->io_evt_vec_msg);
+      evt->event_type = SESSION_IO_EVT_VEC;
+      ev = (session_io_evt_vec_t *) evt->data;
+      ev->n_evts = 0;
+    }
+
+  ASSERT (wrk->io_evt_vec_mq == mq);
+  evt = svm_msg_q_msg_data (mq, &wrk->io_evt_vec_msg);
+  ev = (session_io_evt_vec_t *) evt->data;
+  ev->evt_types[ev->n_evts] = evt_type;
+  ev->session_indices[ev->n_evts] = session_index;
+
+  if (++ev->n_evts == SESSION_IO_EVT_VEC_LEN)
+    app_wrk_flush_io_evt_vec (wrk->vm->thread_index);
+
+  return 0;
+}
+
+void
+app_wrk_flush_io_evt_vec (clib_thread_index_t thread_index)
+{
+  session_worker_t *wrk = session_main_get_worker (thread_index);
+
+  if (!wrk->io_evt_vec_mq)
+    return;
+
+  svm_msg_q_add_raw (wrk->io_evt_vec_mq, &wrk->io_evt_vec_msg);
+  wrk->io_evt_vec_mq = 0;
+}
+
 u8
 app_worker_mq_wrk_is_congested (app_worker_t *app_wrk,
 				clib_thread_index_t thread_index)
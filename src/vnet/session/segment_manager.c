@@ -959,10 +959,13 @@ segment_manager_alloc_queue (fifo_segment_t * segment,
   notif_q_size = clib_max (16, props->evt_q_size >> 4);
   svm_msg_q_ring_cfg_t rc[SESSION_MQ_N_RINGS] = {
     {props->evt_q_size, fifo_evt_size, 0},
+    {notif_q_size, session_evt_size, 0},
     {notif_q_size, session_evt_size, 0}
   };
   cfg->consumer_pid = 0;
-  cfg->n_rings = 2;
+  /* Vectored io events, if requested, each carry SESSION_IO_EVT_VEC_LEN
+   * events so notif_q_size elements are enough to fit a full io ring */
+  cfg->n_rings = props->use_mq_vec_evts ? 3 : 2;
   cfg->q_nitems = props->evt_q_size;
   cfg->ring_cfgs = rc;
 
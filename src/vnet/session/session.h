@@ -28,6 +28,8 @@ typedef struct session_wrk_stats_
   u32 errors[SESSION_N_ERRORS];
 } session_wrk_stats_t;
 
+#define SESSION_TX_N_FIFO_SEGS 4
+
 typedef struct session_tx_context_
 {
   CLIB_CACHE_LINE_ALIGN_MARK (cacheline0);
@@ -46,6 +48,11 @@ typedef struct session_tx_context_
     CLIB_CACHE_LINE_ALIGN_MARK (cacheline1);
   session_dgram_hdr_t hdr;
 
+  /** Fifo data left to copy in this event, looked up once per event */
+  svm_fifo_seg_t fs[SESSION_TX_N_FIFO_SEGS];
+  u8 n_fs;
+  u8 fs_index;
+
   /** Vector of tx buffer free lists */
   u32 *tx_buffers;
   vlib_buffer_t **transport_pending_bufs;
@@ -151,6 +158,12 @@ typedef struct session_worker_
   /** Per-app-worker bitmap of pending notifications */
   uword *app_wrks_pending_ntf;
 
+  /** App worker mq of vectored io event being built, if any */
+  svm_msg_q_t *io_evt_vec_mq;
+
+  /** Message of vectored io event being built */
+  svm_msg_q_msg_t io_evt_vec_msg;
+
   svm_fifo_seg_t *rx_segs;
 
   int config_index;
@@ -634,16 +634,20 @@ mq_send_io_rx_event (session_t *s)
     return 0;
 
   app_wrk = app_worker_get (s->app_wrk_index);
-  mq = app_wrk->event_queue;
+  (void) svm_fifo_set_event (s->rx_fifo);
 
+  if (app_wrk->mq_vec_evts &&
+      !app_wrk_send_io_evt_vec (app_wrk, SESSION_IO_EVT_RX,
+				s->rx_fifo->app_session_index))
+    return 0;
+
+  mq = app_wrk->event_queue;
   mq_msg = svm_msg_q_alloc_msg_w_ring (mq, SESSION_MQ_IO_EVT_RING);
   mq_evt = svm_msg_q_msg_data (mq, &mq_msg);
 
   mq_evt->event_type = SESSION_IO_EVT_RX;
   mq_evt->session_index = s->rx_fifo->app_session_index;
 
-  (void) svm_fifo_set_event (s->rx_fifo);
-
   svm_msg_q_add_raw (mq, &mq_msg);
 
   return 0;
@@ -657,6 +661,11 @@ mq_send_io_tx_event (session_t *s)
   session_event_t *mq_evt;
   svm_msg_q_msg_t mq_msg;
 
+  if (app_wrk->mq_vec_evts &&
+      !app_wrk_send_io_evt_vec (app_wrk, SESSION_IO_EVT_TX,
+				s->tx_fifo->app_session_index))
+    return 0;
+
   mq_msg = svm_msg_q_alloc_msg_w_ring (mq, SESSION_MQ_IO_EVT_RING);
   mq_evt = svm_msg_q_msg_data (mq, &mq_msg);
 
@@ -30,6 +30,17 @@ mq_event_ring_index (session_evt_type_t et)
 					     SESSION_MQ_IO_EVT_RING);
 }
 
+always_inline u8
+app_worker_mq_is_full (app_worker_t *app_wrk, u8 ring_index,
+		       clib_thread_index_t thread_index)
+{
+  /* Io events fall back to io ring only if they can't be vectored */
+  if (app_wrk->mq_vec_evts && ring_index == SESSION_MQ_IO_EVT_RING &&
+      app_wrk_io_evt_vec_can_add (app_wrk, thread_index))
+    return 0;
+  return svm_msg_q_or_ring_is_full (app_wrk->event_queue, ring_index);
+}
+
 void
 app_worker_del_all_events (app_worker_t *app_wrk)
 {
@@ -109,7 +120,10 @@ app_worker_flush_events_inline (app_worker_t *app_wrk,
       if (!is_builtin)
 	{
 	  ring_index = mq_event_ring_index (evt->event_type);
-	  if (svm_msg_q_or_ring_is_full (mq, ring_index))
+	  /* Io events already vectored must not be overtaken */
+	  if (app_wrk->mq_vec_evts && ring_index != SESSION_MQ_IO_EVT_RING)
+	    app_wrk_flush_io_evt_vec (thread_index);
+	  if (app_worker_mq_is_full (app_wrk, ring_index, thread_index))
 	    {
 	      app_worker_set_mq_wrk_congested (app_wrk, thread_index);
 	      break;
@@ -290,6 +304,8 @@ app_worker_flush_events_inline (app_worker_t *app_wrk,
 
   if (!is_builtin)
     {
+      if (app_wrk->mq_vec_evts)
+	app_wrk_flush_io_evt_vec (thread_index);
       svm_msg_q_unlock (mq);
       if (mq_is_cong && i == n_evts)
 	app_worker_unset_wrk_mq_congested (app_wrk, thread_index);
@@ -927,6 +927,75 @@ session_lookup_half_open_connection (u64 handle, u8 proto, u8 is_ip4)
   return 0;
 }
 
+always_inline transport_connection_t *
+session_lookup_connection_wt4_found (session_kv4_t *kv4, u8 proto,
+				     clib_thread_index_t thread_index,
+				     u8 *result)
+{
+  session_t *s;
+
+  if (PREDICT_FALSE ((u32) (kv4->value >> 32) != thread_index))
+    {
+      *result = SESSION_LOOKUP_RESULT_WRONG_THREAD;
+      return 0;
+    }
+  s = session_get (kv4->value & 0xFFFFFFFFULL, thread_index);
+  return transport_get_connection (proto, s->connection_index, thread_index);
+}
+
+/*
+ * Established session lookup for kv4 missed, try half-opens, session rules
+ * and listeners, in this order
+ */
+static transport_connection_t *
+session_lookup_connection_wt4_not_found (session_table_t *st,
+					 session_kv4_t *kv4,
+					 ip4_address_t *lcl,
+					 ip4_address_t *rmt, u16 lcl_port,
+					 u16 rmt_port, u8 proto, u8 *result)
+{
+  u32 action_index;
+  session_t *s;
+  int rv;
+
+  /*
+   * Try half-open connections
+   */
+  rv = clib_bihash_search_inline_16_8 (&st->v4_half_open_hash, kv4);
+  if (rv == 0)
+    return transport_get_half_open (proto, kv4->value & 0xFFFFFFFF);
+
+  if (st->srtg_handle != SESSION_SRTG_HANDLE_INVALID)
+    {
+      /*
+       * Check the session rules table
+       */
+      action_index = session_rules_table_lookup4 (st->srtg_handle, proto, lcl,
+						  rmt, lcl_port, rmt_port);
+      if (session_lookup_action_index_is_valid (action_index))
+	{
+	  if (action_index == SESSION_RULES_TABLE_ACTION_DROP)
+	    {
+	      *result = SESSION_LOOKUP_RESULT_FILTERED;
+	      return 0;
+	    }
+	  if ((s = session_lookup_action_to_session (action_index,
+						     FIB_PROTOCOL_IP4, proto)))
+	    return transport_get_listener (proto, s->connection_index);
+	  return 0;
+	}
+    }
+
+  /*
+   * If nothing is found, check if any listener is available
+   */
+  s = session_lookup_listener4_i (st, lcl, lcl_port, proto, 1);
+  if (s)
+    return transport_get_listener (proto, s->connection_index);
+
+  return 0;
+}
+
 /**
  * Lookup connection with ip4 and transport layer information
  *
@@ -961,8 +1030,6 @@ session_lookup_connection_wt4 (u32 fib_index, ip4_address_t *lcl,
 {
   session_table_t *st;
   session_kv4_t kv4;
-  session_t *s;
-  u32 action_index;
   int rv;
 
   st = session_table_get_for_fib_index (FIB_PROTOCOL_IP4, fib_index);
@@ -975,53 +1042,84 @@ session_lookup_connection_wt4 (u32 fib_index, ip4_address_t *lcl,
   make_v4_ss_kv (&kv4, lcl, rmt, lcl_port, rmt_port, proto);
   rv = clib_bihash_search_inline_16_8 (&st->v4_session_hash, &kv4);
   if (rv == 0)
+    return session_lookup_connection_wt4_found (&kv4, proto, thread_index,
+						result);
+
+  return session_lookup_connection_wt4_not_found (st, &kv4, lcl, rmt,
+						  lcl_port, rmt_port, proto,
+						  result);
+}
+
+/**
+ * Lookup a burst of connections with thread awareness
+ *
+ * Same as @ref session_lookup_connection_wt4 called for every key, but
+ * lookups of established sessions are done in batches of keys with the
+ * same fib index, so their hash table accesses overlap. Keys that miss
+ * fall back to the half-open, rules table and listener lookups one by one.
+ *
+ * @param keys		connection keys, local and remote as seen by us
+ * @param proto		transport protocol (e.g., tcp, udp)
+ * @param thread_index	thread index for request
+ * @param tcs		one connection per key, 0 if none found
+ * @param results	one lookup result per key, see
+ *			@ref session_lookup_result_t
+ * @param n_keys	number of keys
+ */
+void
+session_lookup_connections_wt4 (session_lookup_key4_t *keys, u8 proto,
+				clib_thread_index_t thread_index,
+				transport_connection_t **tcs, u8 *results,
+				u32 n_keys)
+{
+  session_kv4_t kvs[SESSION_LOOKUP_BATCH_SIZE];
+  u8 is_found[SESSION_LOOKUP_BATCH_SIZE];
+  session_lookup_key4_t *k;
+  session_table_t *st;
+  u32 i, n;
+
+  while (n_keys)
     {
-      if (PREDICT_FALSE ((u32) (kv4.value >> 32) != thread_index))
+      /* Batch keys of the same table, in practice the whole burst */
+      n = 1;
+      while (n < clib_min (n_keys, SESSION_LOOKUP_BATCH_SIZE) &&
+	     keys[n].fib_index == keys[0].fib_index)
+	n++;
+
+      clib_memset_u8 (results, SESSION_LOOKUP_RESULT_NONE, n);
+      st = session_table_get_for_fib_index (FIB_PROTOCOL_IP4,
+					    keys[0].fib_index);
+      if (PREDICT_FALSE (!st))
 	{
-	  *result = SESSION_LOOKUP_RESULT_WRONG_THREAD;
-	  return 0;
+	  clib_memset (tcs, 0, n * sizeof (tcs[0]));
+	  goto next;
 	}
-      s = session_get (kv4.value & 0xFFFFFFFFULL, thread_index);
-      return transport_get_connection (proto, s->connection_index,
-				       thread_index);
-    }
 
-  /*
-   * Try half-open connections
-   */
-  rv = clib_bihash_search_inline_16_8 (&st->v4_half_open_hash, &kv4);
-  if (rv == 0)
-    return transport_get_half_open (proto, kv4.value & 0xFFFFFFFF);
+      for (i = 0; i < n; i++)
+	make_v4_ss_kv (&kvs[i], &keys[i].lcl, &keys[i].rmt, keys[i].lcl_port,
+		       keys[i].rmt_port, proto);
 
-  if (st->srtg_handle != SESSION_SRTG_HANDLE_INVALID)
-    {
-      /*
-       * Check the session rules table
-       */
-      action_index = session_rules_table_lookup4 (st->srtg_handle, proto, lcl,
-						  rmt, lcl_port, rmt_port);
-      if (session_lookup_action_index_is_valid (action_index))
+      clib_bihash_search_batch_16_8 (&st->v4_session_hash, kvs, 0, kvs,
+				     is_found, n);
+
+      for (i = 0; i < n; i++)
 	{
-	  if (action_index == SESSION_RULES_TABLE_ACTION_DROP)
-	    {
-	      *result = SESSION_LOOKUP_RESULT_FILTERED;
-	      return 0;
-	    }
-	  if ((s = session_lookup_action_to_session (action_index,
-						     FIB_PROTOCOL_IP4, proto)))
-	    return transport_get_listener (proto, s->connection_index);
-	  return 0;
+	  k = &keys[i];
+	  if (PREDICT_TRUE (is_found[i]))
+	    tcs[i] = session_lookup_connection_wt4_found (
+	      &kvs[i], proto, thread_index, &results[i]);
+	  else
+	    tcs[i] = session_lookup_connection_wt4_not_found (
+	      st, &kvs[i], &k->lcl, &k->rmt, k->lcl_port, k->rmt_port, proto,
+	      &results[i]);
 	}
-    }
 
-  /*
-   * If nothing is found, check if any listener is available
-   */
-  s = session_lookup_listener4_i (st, lcl, lcl_port, proto, 1);
-  if (s)
-    return transport_get_listener (proto, s->connection_index);
-
-  return 0;
+    next:
+      keys += n;
+      tcs += n;
+      results += n;
+      n_keys -= n;
+    }
 }
 
 /**
@@ -31,6 +31,19 @@ typedef enum session_lookup_result_
   SESSION_LOOKUP_RESULT_FILTERED
 } session_lookup_result_t;
 
+/** Max keys looked up in one bihash batch by the burst lookups */
+#define SESSION_LOOKUP_BATCH_SIZE 64
+
+/** Key of @ref session_lookup_connections_wt4 */
+typedef struct session_lookup_key4_
+{
+  ip4_address_t lcl;
+  ip4_address_t rmt;
+  u16 lcl_port;
+  u16 rmt_port;
+  u32 fib_index;
+} session_lookup_key4_t;
+
 typedef struct session_lookup_main_
 {
   clib_spinlock_t st_alloc_lock;
@@ -46,6 +59,10 @@ session_t *session_lookup_safe6 (u32 fib_index, ip6_address_t * lcl,
 transport_connection_t *session_lookup_connection_wt4 (
   u32 fib_index, ip4_address_t *lcl, ip4_address_t *rmt, u16 lcl_port,
   u16 rmt_port, u8 proto, clib_thread_index_t thread_index, u8 *is_filtered);
+void session_lookup_connections_wt4 (session_lookup_key4_t *keys, u8 proto,
+				     clib_thread_index_t thread_index,
+				     transport_connection_t **tcs,
+				     u8 *results, u32 n_keys);
 transport_connection_t *session_lookup_connection4 (u32 fib_index,
 						    ip4_address_t * lcl,
 						    ip4_address_t * rmt,
@@ -972,14 +972,52 @@ session_tx_fill_dma_transfers_tail (session_worker_t *wrk,
   return len_write;
 }
 
+/**
+ * Copy stream data at tx offset into buffer
+ *
+ * Fifo segments are looked up once for all data to be sent in the event and
+ * consumed as buffers are filled. Avoids chunk lookups and head/tail loads
+ * per buffer, which add up for chained (gso) segments.
+ */
+always_inline int
+session_tx_peek_segs (session_tx_context_t *ctx, u32 len, u8 *dst)
+{
+  svm_fifo_seg_t *fs;
+  u32 n_copied = 0, n_bytes, n_segs;
+  int rv;
+
+  while (n_copied < len)
+    {
+      if (ctx->fs_index == ctx->n_fs)
+	{
+	  n_segs = SESSION_TX_N_FIFO_SEGS;
+	  rv = svm_fifo_segments (ctx->s->tx_fifo, ctx->sp.tx_offset + n_copied,
+				  ctx->fs, &n_segs, ctx->left_to_snd - n_copied);
+	  if (PREDICT_FALSE (rv <= 0))
+	    break;
+	  ctx->n_fs = n_segs;
+	  ctx->fs_index = 0;
+	}
+      fs = &ctx->fs[ctx->fs_index];
+      n_bytes = clib_min (fs->len, len - n_copied);
+      clib_memcpy_fast (dst + n_copied, fs->data, n_bytes);
+      n_copied += n_bytes;
+      fs->data += n_bytes;
+      fs->len -= n_bytes;
+      if (!fs->len)
+	ctx->fs_index += 1;
+    }
+
+  return n_copied;
+}
+
 always_inline int
 session_tx_copy_data (session_worker_t *wrk, session_tx_context_t *ctx,
 		      vlib_buffer_t *b, u32 len_to_deq, u8 *data0)
 {
   int n_bytes_read;
   if (PREDICT_TRUE (!wrk->dma_enabled))
-    n_bytes_read =
-      svm_fifo_peek (ctx->s->tx_fifo, ctx->sp.tx_offset, len_to_deq, data0);
+    n_bytes_read = session_tx_peek_segs (ctx, len_to_deq, data0);
   else
     n_bytes_read = session_tx_fill_dma_transfers (wrk, ctx, b);
   return n_bytes_read;
@@ -991,8 +1029,7 @@ session_tx_copy_data_tail (session_worker_t *wrk, session_tx_context_t *ctx,
 {
   int n_bytes_read;
   if (PREDICT_TRUE (!wrk->dma_enabled))
-    n_bytes_read =
-      svm_fifo_peek (ctx->s->tx_fifo, ctx->sp.tx_offset, len_to_deq, data);
+    n_bytes_read = session_tx_peek_segs (ctx, len_to_deq, data);
   else
     n_bytes_read =
       session_tx_fill_dma_transfers_tail (wrk, ctx, b, len_to_deq, data);
@@ -1517,6 +1554,7 @@ session_tx_fifo_read_and_snd_i (session_worker_t * wrk,
     transport_connection_tx_pacer_update_bytes (ctx->tc, ctx->max_len_to_snd);
 
   ctx->left_to_snd = ctx->max_len_to_snd;
+  ctx->n_fs = ctx->fs_index = 0;
   n_left = ctx->n_segs_per_evt;
 
   vec_validate (ctx->transport_pending_bufs, n_left);
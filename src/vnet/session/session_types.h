@@ -389,6 +389,7 @@ typedef enum
   SESSION_CTRL_EVT_TRANSPORT_ATTR_REPLY,
   SESSION_CTRL_EVT_TRANSPORT_CLOSED,
   SESSION_CTRL_EVT_HALF_CLEANUP,
+  SESSION_IO_EVT_VEC,
 } session_evt_type_t;
 
 #define foreach_session_ctrl_evt                                              \
@@ -428,6 +429,7 @@ typedef enum
 {
   SESSION_MQ_IO_EVT_RING,
   SESSION_MQ_CTRL_EVT_RING,
+  SESSION_MQ_IO_VEC_EVT_RING,
   SESSION_MQ_N_RINGS
 } session_mq_rings_e;
 
@@ -455,6 +457,20 @@ typedef struct
   };
 } __clib_packed session_event_t;
 
+#define SESSION_IO_EVT_VEC_LEN 32
+
+/**
+ * Payload of SESSION_IO_EVT_VEC events. Carries up to SESSION_IO_EVT_VEC_LEN
+ * rx/tx io events, generated for one app worker in one dispatch, in a single
+ * mq message. Only used if app requested vectored io events.
+ */
+typedef struct session_io_evt_vec_
+{
+  u8 n_evts;
+  u8 evt_types[SESSION_IO_EVT_VEC_LEN];
+  u32 session_indices[SESSION_IO_EVT_VEC_LEN];
+} __clib_packed session_io_evt_vec_t;
+
 #define SESSION_MSG_NULL { }
 
 typedef struct session_dgram_pre_hdr_
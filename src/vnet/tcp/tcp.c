@@ -970,6 +970,9 @@ tcp_set_attribute (tcp_connection_t *tc, transport_endpt_attr_t *attr)
       tcp_cc_cleanup (tc);
       tc->cc_algo = tcp_cc_algo_get (attr->cc_algo);
       tcp_cc_init (tc);
+      /* Algorithm may depend on delivery rate samples */
+      if ((tc->cfg_flags & TCP_CFG_F_RATE_SAMPLE) && !tc->bt)
+	tcp_bt_init (tc);
       break;
     default:
       rv = -1;
@@ -1032,11 +1035,21 @@ tcp_session_attribute (u32 conn_index, clib_thread_index_t thread_index,
 static u16
 tcp_session_cal_goal_size (tcp_connection_t * tc)
 {
-  u16 goal_size = tc->snd_mss;
+  u32 goal_size;
 
-  goal_size = tcp_cfg.max_gso_size - tc->snd_mss % tcp_cfg.max_gso_size;
+  /* Headers must also fit in the gso packet */
+  goal_size = tcp_cfg.max_gso_size > TRANSPORT_MAX_HDRS_LEN ?
+		tcp_cfg.max_gso_size - TRANSPORT_MAX_HDRS_LEN : 0;
   goal_size = clib_min (goal_size, tc->snd_wnd / 2);
 
+  /* Paced connections send at most a burst per dispatch. Size segments so
+   * bursts are made of whole segments */
+  if (transport_connection_is_tx_paced (&tc->connection))
+    goal_size = clib_min (goal_size, tc->connection.pacer.max_burst);
+
+  /* Multiple of mss so segmentation does not end in a runt */
+  goal_size -= goal_size % tc->snd_mss;
+
   return goal_size > tc->snd_mss ? goal_size : tc->snd_mss;
 }
 
@@ -1129,6 +1142,14 @@ tcp_session_send_params (transport_connection_t * trans_conn,
   sp->snd_space = clib_min (tcp_snd_space_inline (tc),
 			    tc->snd_wnd - (tc->snd_nxt - tc->snd_una));
 
+  /* Avoid small super segments if enough is in flight for acks to open up
+   * the window. Acks received meanwhile are coalesced and the connection is
+   * rescheduled once they are processed */
+  if (PREDICT_FALSE (tc->cfg_flags & TCP_CFG_F_TSO)
+      && sp->snd_space < sp->snd_mss / 2 && !tcp_in_cong_recovery (tc)
+      && tcp_flight_size (tc) >= sp->snd_mss)
+    sp->snd_space = 0;
+
   ASSERT (seq_geq (tc->snd_nxt, tc->snd_una));
   /* This still works if fast retransmit is on */
   sp->tx_offset = tc->snd_nxt - tc->snd_una;
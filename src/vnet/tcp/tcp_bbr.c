@@ -0,0 +1,608 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+/**
+ * BBR congestion control, version 1 (draft-cardwell-iccrg-bbr-congestion-
+ * control-00).
+ *
+ * Models the path as a bottleneck bandwidth, the windowed max of the
+ * delivery rate samples produced by the byte tracker, and a round trip
+ * propagation delay, the windowed min of the rtt samples. Data is paced at
+ * a gain times the bandwidth estimate and cwnd only bounds the data in
+ * flight to a gain times the estimated bdp. Loss is not a congestion signal,
+ * only PRR bounds sending while in fast recovery.
+ */
+
+#include <vnet/tcp/tcp.h>
+#include <vnet/tcp/tcp_inlines.h>
+
+#define BBR_HIGH_GAIN	     2.885 /* 2/ln(2) */
+#define BBR_DRAIN_GAIN	     (1 / BBR_HIGH_GAIN)
+#define BBR_CWND_GAIN	     2.0
+#define BBR_CYCLE_LEN	     8
+#define BBR_BW_FILTER_ROUNDS 10
+#define BBR_FULL_BW_THRESH   1.25
+#define BBR_FULL_BW_ROUNDS   3
+#define BBR_PROBE_RTT_MS     200
+#define BBR_MIN_CWND_SEGS    4
+#define BBR_INFINITE_SSTHRESH 0x7FFFFFFFU
+
+static const f64 bbr_pacing_gain[BBR_CYCLE_LEN] = {
+  1.25, 0.75, 1, 1, 1, 1, 1, 1,
+};
+
+typedef enum bbr_mode_
+{
+  BBR_STARTUP,
+  BBR_DRAIN,
+  BBR_PROBE_BW,
+  BBR_PROBE_RTT,
+} bbr_mode_e;
+
+typedef enum bbr_flags_
+{
+  BBR_F_ROUND_START = 1 << 0,
+  BBR_F_FILLED_PIPE = 1 << 1,
+  BBR_F_PROBE_RTT_ROUND_DONE = 1 << 2,
+  BBR_F_IDLE_RESTART = 1 << 3,
+} bbr_flags_e;
+
+typedef struct bbr_cfg_
+{
+  /** Time a min rtt sample is valid for before probing rtt (ms) */
+  u32 min_rtt_win_ms;
+} bbr_cfg_t;
+
+static bbr_cfg_t bbr_cfg = {
+  .min_rtt_win_ms = 10000,
+};
+
+typedef struct bbr_data_
+{
+  /** Windowed max filter of delivery rate (bytes/s), best sample first */
+  u64 bw[3];
+  /** tc->delivered at which the next round trip starts */
+  u64 next_round_delivered;
+  /** Max bw at the last startup plateau check */
+  u64 full_bw;
+  /** Round trip count in which each bw sample was taken */
+  u32 bw_round[3];
+  u32 round_count;
+  /** Min rtt estimate (us), ~0 if none yet */
+  u32 min_rtt_us;
+  /** When the min rtt estimate was taken (ms) */
+  u32 min_rtt_stamp;
+  /** When probe rtt may end (ms), 0 if not yet draining to min cwnd */
+  u32 probe_rtt_done_stamp;
+  /** When the current gain cycle phase started (us) */
+  u32 cycle_stamp;
+  /** cwnd before recovery or probe rtt, restored afterwards */
+  u32 prior_cwnd;
+  u8 mode;
+  u8 cycle_index;
+  u8 full_bw_cnt;
+  u8 flags;
+} __clib_packed bbr_data_t;
+
+STATIC_ASSERT (sizeof (bbr_data_t) <= TCP_CC_DATA_SZ, "bbr data len");
+
+static inline f64
+bbr_time (tcp_connection_t *tc)
+{
+  return tcp_time_now_us (tc->c_thread_index);
+}
+
+static inline u32
+bbr_time_ms (tcp_connection_t *tc)
+{
+  return bbr_time (tc) * 1e3;
+}
+
+static inline u32
+bbr_time_us (tcp_connection_t *tc)
+{
+  return bbr_time (tc) * 1e6;
+}
+
+static inline u64
+bbr_max_bw (bbr_data_t *bd)
+{
+  return bd->bw[0];
+}
+
+/**
+ * Windowed max filter, tracks the best, 2nd best and 3rd best samples over
+ * the last BBR_BW_FILTER_ROUNDS round trips (Kathleen Nichols' algorithm)
+ */
+static void
+bbr_bw_filter_update (bbr_data_t *bd, u64 bw)
+{
+  u32 round = bd->round_count, dt;
+
+  if (bw >= bd->bw[0] || round - bd->bw_round[0] > BBR_BW_FILTER_ROUNDS)
+    {
+      bd->bw[0] = bd->bw[1] = bd->bw[2] = bw;
+      bd->bw_round[0] = bd->bw_round[1] = bd->bw_round[2] = round;
+      return;
+    }
+
+  if (bw >= bd->bw[1])
+    {
+      bd->bw[1] = bd->bw[2] = bw;
+      bd->bw_round[1] = bd->bw_round[2] = round;
+    }
+  else if (bw >= bd->bw[2])
+    {
+      bd->bw[2] = bw;
+      bd->bw_round[2] = round;
+    }
+
+  /* Age out the best sample, promoting the others, if it left the window.
+   * Otherwise, make sure the 2nd and 3rd best come from later sub-windows
+   * so they can take over when it does */
+  dt = round - bd->bw_round[0];
+  if (dt > BBR_BW_FILTER_ROUNDS)
+    {
+      bd->bw[0] = bd->bw[1];
+      bd->bw_round[0] = bd->bw_round[1];
+      bd->bw[1] = bd->bw[2];
+      bd->bw_round[1] = bd->bw_round[2];
+      bd->bw[2] = bw;
+      bd->bw_round[2] = round;
+      if (round - bd->bw_round[0] > BBR_BW_FILTER_ROUNDS)
+	{
+	  bd->bw[0] = bd->bw[1];
+	  bd->bw_round[0] = bd->bw_round[1];
+	  bd->bw[1] = bd->bw[2];
+	  bd->bw_round[1] = bd->bw_round[2];
+	}
+    }
+  else if (bd->bw_round[1] == bd->bw_round[0] &&
+	   dt > BBR_BW_FILTER_ROUNDS / 4)
+    {
+      bd->bw[1] = bd->bw[2] = bw;
+      bd->bw_round[1] = bd->bw_round[2] = round;
+    }
+  else if (bd->bw_round[2] == bd->bw_round[1] &&
+	   dt > BBR_BW_FILTER_ROUNDS / 2)
+    {
+      bd->bw[2] = bw;
+      bd->bw_round[2] = round;
+    }
+}
+
+static f64
+bbr_pacing_gain_now (bbr_data_t *bd)
+{
+  switch (bd->mode)
+    {
+    case BBR_STARTUP:
+      return BBR_HIGH_GAIN;
+    case BBR_DRAIN:
+      return BBR_DRAIN_GAIN;
+    case BBR_PROBE_BW:
+      /* Restarting from idle, don't probe on top of the queue we might
+       * build by sending a full window at once */
+      if (bd->flags & BBR_F_IDLE_RESTART)
+	return 1;
+      return bbr_pacing_gain[bd->cycle_index];
+    default:
+      return 1;
+    }
+}
+
+static f64
+bbr_cwnd_gain_now (bbr_data_t *bd)
+{
+  switch (bd->mode)
+    {
+    case BBR_STARTUP:
+    case BBR_DRAIN:
+      return BBR_HIGH_GAIN;
+    case BBR_PROBE_BW:
+      return BBR_CWND_GAIN;
+    default:
+      return 1;
+    }
+}
+
+/**
+ * Data in flight needed to fill gain times the estimated bdp
+ */
+static u32
+bbr_inflight (tcp_connection_t *tc, bbr_data_t *bd, f64 gain)
+{
+  u64 bdp;
+
+  /* No model yet, stick to the initial window */
+  if (bd->min_rtt_us == ~0 || !bbr_max_bw (bd))
+    return tcp_initial_cwnd (tc);
+
+  bdp = bbr_max_bw (bd) * bd->min_rtt_us / 1e6;
+  return clib_min (gain * bdp, BBR_INFINITE_SSTHRESH);
+}
+
+static u32
+bbr_target_cwnd (tcp_connection_t *tc, bbr_data_t *bd, f64 gain)
+{
+  u64 cwnd = bbr_inflight (tc, bd, gain);
+
+  /* Budget for delayed/stretched acks and tx batching so a cwnd limited
+   * flow still keeps the pipe full */
+  cwnd += 3 * tc->snd_mss;
+  return clib_clamp (cwnd, BBR_MIN_CWND_SEGS * tc->snd_mss,
+		     BBR_INFINITE_SSTHRESH);
+}
+
+static void
+bbr_save_cwnd (tcp_connection_t *tc, bbr_data_t *bd)
+{
+  /* Don't overwrite the value saved before probe rtt or recovery */
+  if (bd->mode != BBR_PROBE_RTT && !tcp_in_cong_recovery (tc))
+    bd->prior_cwnd = tc->cwnd;
+  else
+    bd->prior_cwnd = clib_max (bd->prior_cwnd, tc->cwnd);
+}
+
+static void
+bbr_enter_startup (bbr_data_t *bd)
+{
+  bd->mode = BBR_STARTUP;
+}
+
+static void
+bbr_enter_probe_bw (tcp_connection_t *tc, bbr_data_t *bd)
+{
+  bd->mode = BBR_PROBE_BW;
+  /* Start at a random phase, but not the draining one, so flows sharing
+   * a bottleneck don't probe in lock step */
+  bd->cycle_index =
+    (2 + clib_cpu_time_now () % (BBR_CYCLE_LEN - 1)) % BBR_CYCLE_LEN;
+  bd->cycle_stamp = bbr_time_us (tc);
+}
+
+static void
+bbr_update_round (tcp_connection_t *tc, bbr_data_t *bd,
+		  tcp_rate_sample_t *rs)
+{
+  bd->flags &= ~BBR_F_ROUND_START;
+  if (rs->delivered && rs->prior_delivered >= bd->next_round_delivered)
+    {
+      bd->next_round_delivered = tc->delivered;
+      bd->round_count++;
+      bd->flags |= BBR_F_ROUND_START;
+    }
+}
+
+static void
+bbr_update_bw (tcp_connection_t *tc, bbr_data_t *bd, tcp_rate_sample_t *rs)
+{
+  u64 bw;
+
+  /* Samples taken across a retransmit timeout measure the timer, not the
+   * path */
+  if (!rs->delivered || rs->interval_time <= 0 || tcp_in_recovery (tc))
+    return;
+
+  /* Acks compressed into an interval shorter than the min rtt would
+   * overestimate the delivery rate */
+  if (bd->min_rtt_us != ~0 && rs->interval_time * 1e6 < bd->min_rtt_us)
+    return;
+
+  bw = rs->delivered / rs->interval_time;
+
+  /* App limited samples underestimate the path so only use them if they
+   * show more bandwidth than we already know of */
+  if (!(rs->flags & TCP_BTS_IS_APP_LIMITED) || bw >= bbr_max_bw (bd))
+    bbr_bw_filter_update (bd, bw);
+}
+
+static int
+bbr_is_next_cycle_phase (tcp_connection_t *tc, bbr_data_t *bd,
+			 tcp_rate_sample_t *rs)
+{
+  f64 gain = bbr_pacing_gain[bd->cycle_index];
+  u32 inflight = tcp_flight_size (tc);
+  int is_full_length;
+
+  is_full_length =
+    (i32) (bbr_time_us (tc) - bd->cycle_stamp) > (i32) bd->min_rtt_us;
+
+  if (gain == 1)
+    return is_full_length;
+
+  /* Probing up lasts until losses or the extra data is in flight */
+  if (gain > 1)
+    return is_full_length &&
+	   (rs->lost || inflight >= bbr_inflight (tc, bd, gain));
+
+  /* Draining ends early once the queue we built is gone */
+  return is_full_length || inflight <= bbr_inflight (tc, bd, 1);
+}
+
+static void
+bbr_update_cycle_phase (tcp_connection_t *tc, bbr_data_t *bd,
+			tcp_rate_sample_t *rs)
+{
+  if (bd->mode != BBR_PROBE_BW || !bbr_is_next_cycle_phase (tc, bd, rs))
+    return;
+
+  bd->cycle_index = (bd->cycle_index + 1) % BBR_CYCLE_LEN;
+  bd->cycle_stamp = bbr_time_us (tc);
+}
+
+static void
+bbr_check_full_bw_reached (bbr_data_t *bd, tcp_rate_sample_t *rs)
+{
+  if ((bd->flags & BBR_F_FILLED_PIPE) || !(bd->flags & BBR_F_ROUND_START) ||
+      (rs->flags & TCP_BTS_IS_APP_LIMITED))
+    return;
+
+  /* Still growing by 25% or more per round, not at the bottleneck yet */
+  if (bbr_max_bw (bd) >= bd->full_bw * BBR_FULL_BW_THRESH)
+    {
+      bd->full_bw = bbr_max_bw (bd);
+      bd->full_bw_cnt = 0;
+      return;
+    }
+
+  if (++bd->full_bw_cnt >= BBR_FULL_BW_ROUNDS)
+    bd->flags |= BBR_F_FILLED_PIPE;
+}
+
+static void
+bbr_check_drain (tcp_connection_t *tc, bbr_data_t *bd)
+{
+  if (bd->mode == BBR_STARTUP && (bd->flags & BBR_F_FILLED_PIPE))
+    bd->mode = BBR_DRAIN;
+
+  if (bd->mode == BBR_DRAIN &&
+      tcp_flight_size (tc) <= bbr_inflight (tc, bd, 1))
+    bbr_enter_probe_bw (tc, bd);
+}
+
+static void
+bbr_update_min_rtt (tcp_connection_t *tc, bbr_data_t *bd,
+		    tcp_rate_sample_t *rs)
+{
+  u32 now_ms = bbr_time_ms (tc), rtt_us;
+  int expired;
+
+  expired = (i32) (now_ms - bd->min_rtt_stamp) > (i32) bbr_cfg.min_rtt_win_ms;
+  /* Karn's algorithm, the ack might be for the original transmission */
+  if (rs->rtt_time > 0 && !(rs->flags & TCP_BTS_IS_RXT))
+    {
+      rtt_us = clib_max (rs->rtt_time * 1e6, 1);
+      if (rtt_us < bd->min_rtt_us || expired)
+	{
+	  bd->min_rtt_us = rtt_us;
+	  bd->min_rtt_stamp = now_ms;
+	}
+    }
+
+  if (expired && !(bd->flags & BBR_F_IDLE_RESTART) &&
+      bd->mode != BBR_PROBE_RTT)
+    {
+      bbr_save_cwnd (tc, bd);
+      bd->mode = BBR_PROBE_RTT;
+      bd->probe_rtt_done_stamp = 0;
+    }
+
+  if (bd->mode == BBR_PROBE_RTT)
+    {
+      /* Hold the min cwnd for at least a round and BBR_PROBE_RTT_MS once
+       * the queue drained, so the rtt sample sees an empty queue */
+      if (!bd->probe_rtt_done_stamp &&
+	  tcp_flight_size (tc) <= BBR_MIN_CWND_SEGS * tc->snd_mss)
+	{
+	  bd->probe_rtt_done_stamp = (now_ms + BBR_PROBE_RTT_MS) | 1;
+	  bd->flags &= ~BBR_F_PROBE_RTT_ROUND_DONE;
+	  bd->next_round_delivered = tc->delivered;
+	}
+      else if (bd->probe_rtt_done_stamp)
+	{
+	  if (bd->flags & BBR_F_ROUND_START)
+	    bd->flags |= BBR_F_PROBE_RTT_ROUND_DONE;
+	  if ((bd->flags & BBR_F_PROBE_RTT_ROUND_DONE) &&
+	      (i32) (now_ms - bd->probe_rtt_done_stamp) >= 0)
+	    {
+	      bd->min_rtt_stamp = now_ms;
+	      tc->cwnd = clib_max (tc->cwnd, bd->prior_cwnd);
+	      if (bd->flags & BBR_F_FILLED_PIPE)
+		bbr_enter_probe_bw (tc, bd);
+	      else
+		bbr_enter_startup (bd);
+	    }
+	}
+    }
+
+  if (rs->delivered)
+    bd->flags &= ~BBR_F_IDLE_RESTART;
+}
+
+static void
+bbr_update_model (tcp_connection_t *tc, bbr_data_t *bd, tcp_rate_sample_t *rs)
+{
+  bbr_update_round (tc, bd, rs);
+  bbr_update_bw (tc, bd, rs);
+  bbr_update_cycle_phase (tc, bd, rs);
+  bbr_check_full_bw_reached (bd, rs);
+  bbr_check_drain (tc, bd);
+  bbr_update_min_rtt (tc, bd, rs);
+}
+
+static void
+bbr_set_cwnd (tcp_connection_t *tc, bbr_data_t *bd, u32 acked)
+{
+  u32 target = bbr_target_cwnd (tc, bd, bbr_cwnd_gain_now (bd));
+
+  if (bd->flags & BBR_F_FILLED_PIPE)
+    tc->cwnd = clib_min (tc->cwnd + acked, target);
+  else if (tc->cwnd < target || tc->delivered < tcp_initial_cwnd (tc))
+    tc->cwnd += acked;
+
+  tc->cwnd = clib_max (tc->cwnd, BBR_MIN_CWND_SEGS * tc->snd_mss);
+  if (bd->mode == BBR_PROBE_RTT)
+    tc->cwnd = clib_min (tc->cwnd, BBR_MIN_CWND_SEGS * tc->snd_mss);
+
+  /* Constrained by tx fifo, can't grow further */
+  tc->cwnd = clib_min (tc->cwnd, tc->tx_fifo_size);
+}
+
+static void
+bbr_rcv_ack (tcp_connection_t *tc, tcp_rate_sample_t *rs)
+{
+  bbr_data_t *bd = (bbr_data_t *) tcp_cc_data (tc);
+
+  bbr_update_model (tc, bd, rs);
+  bbr_set_cwnd (tc, bd, rs->acked_and_sacked);
+}
+
+static void
+bbr_rcv_cong_ack (tcp_connection_t *tc, tcp_cc_ack_t ack_type,
+		  tcp_rate_sample_t *rs)
+{
+  bbr_data_t *bd = (bbr_data_t *) tcp_cc_data (tc);
+
+  /* Keep the model fresh while prr paces the retransmits */
+  bbr_update_model (tc, bd, rs);
+  newreno_rcv_cong_ack (tc, ack_type, rs);
+}
+
+static void
+bbr_congestion (tcp_connection_t *tc)
+{
+  bbr_data_t *bd = (bbr_data_t *) tcp_cc_data (tc);
+
+  /* Loss is not a congestion signal for bbr, but conserve packets while
+   * recovering. With ssthresh at the data in flight, prr only sends as much
+   * as is delivered and is not reducing the rate any further */
+  bbr_save_cwnd (tc, bd);
+  tc->ssthresh = clib_clamp (tcp_flight_size (tc),
+			     BBR_MIN_CWND_SEGS * tc->snd_mss, tc->cwnd);
+}
+
+static void
+bbr_loss (tcp_connection_t *tc)
+{
+  bbr_data_t *bd = (bbr_data_t *) tcp_cc_data (tc);
+
+  tc->cwnd = tcp_loss_wnd (tc);
+  tc->ssthresh = BBR_INFINITE_SSTHRESH;
+
+  /* Bandwidth found before the timeout may no longer be there, redo the
+   * startup plateau check from the next round */
+  bd->full_bw = 0;
+  bd->full_bw_cnt = 0;
+  bd->flags |= BBR_F_ROUND_START;
+}
+
+static void
+bbr_recovered (tcp_connection_t *tc)
+{
+  bbr_data_t *bd = (bbr_data_t *) tcp_cc_data (tc);
+
+  tc->cwnd = clib_max (tc->cwnd, bd->prior_cwnd);
+  tc->ssthresh = BBR_INFINITE_SSTHRESH;
+}
+
+static void
+bbr_undo_recovery (tcp_connection_t *tc)
+{
+  tc->ssthresh = BBR_INFINITE_SSTHRESH;
+}
+
+static void
+bbr_event (tcp_connection_t *tc, tcp_cc_event_t evt)
+{
+  bbr_data_t *bd = (bbr_data_t *) tcp_cc_data (tc);
+
+  if (evt != TCP_CC_EVT_START_TX)
+    return;
+
+  /* Restarting after the app left us idle */
+  if (tc->app_limited)
+    bd->flags |= BBR_F_IDLE_RESTART;
+}
+
+static u64
+bbr_get_pacing_rate (tcp_connection_t *tc)
+{
+  bbr_data_t *bd = (bbr_data_t *) tcp_cc_data (tc);
+  f64 srtt;
+  u64 bw;
+
+  bw = bbr_max_bw (bd);
+  if (!bw)
+    {
+      srtt = clib_min ((f64) tc->srtt * TCP_TICK, tc->mrtt_us);
+      bw = (f64) tc->cwnd / clib_max (srtt, 1e-6);
+    }
+
+  return clib_max (bbr_pacing_gain_now (bd) * bw, 1);
+}
+
+static void
+bbr_conn_init (tcp_connection_t *tc)
+{
+  bbr_data_t *bd = (bbr_data_t *) tcp_cc_data (tc);
+
+  clib_memset (bd, 0, sizeof (*bd));
+  bd->min_rtt_us = ~0;
+  bd->min_rtt_stamp = bbr_time_ms (tc);
+  bd->next_round_delivered = tc->delivered;
+  bbr_enter_startup (bd);
+
+  tc->ssthresh = BBR_INFINITE_SSTHRESH;
+  tc->cwnd = tcp_initial_cwnd (tc);
+
+  /* The model is built from delivery rate samples */
+  tc->cfg_flags |= TCP_CFG_F_RATE_SAMPLE;
+}
+
+static uword
+bbr_unformat_config (unformat_input_t *input)
+{
+  u32 win;
+
+  if (!input)
+    return 0;
+
+  unformat_skip_white_space (input);
+
+  while (unformat_check_input (input) != UNFORMAT_END_OF_INPUT)
+    {
+      if (unformat (input, "min-rtt-window %u", &win))
+	bbr_cfg.min_rtt_win_ms = win;
+      else
+	return 0;
+    }
+  return 1;
+}
+
+const static tcp_cc_algorithm_t tcp_bbr = {
+  .name = "bbr",
+  .unformat_cfg = bbr_unformat_config,
+  .congestion = bbr_congestion,
+  .loss = bbr_loss,
+  .recovered = bbr_recovered,
+  .undo_recovery = bbr_undo_recovery,
+  .rcv_ack = bbr_rcv_ack,
+  .rcv_cong_ack = bbr_rcv_cong_ack,
+  .event = bbr_event,
+  .get_pacing_rate = bbr_get_pacing_rate,
+  .init = bbr_conn_init,
+};
+
+clib_error_t *
+bbr_init (vlib_main_t *vm)
+{
+  clib_error_t *error = 0;
+
+  tcp_cc_algo_register (TCP_CC_BBR, &tcp_bbr);
+
+  return error;
+}
+
+VLIB_INIT_FUNCTION (bbr_init);
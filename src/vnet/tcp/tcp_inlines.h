@@ -255,9 +255,53 @@ tcp_update_time_now (tcp_worker_ctx_t *wrk)
   tcp_set_time_now (wrk, now);
 }
 
+/**
+ * Fill in session lookup keys for a burst of ip4 tcp buffers
+ *
+ * Keys of buffers too short to hold the headers are zeroed. Such buffers
+ * are dropped by @ref tcp_input_lookup_buffer, whatever their lookup
+ * finds.
+ */
+always_inline void
+tcp4_input_lookup_keys (vlib_buffer_t **b, session_lookup_key4_t *keys,
+			u32 n_bufs)
+{
+  session_lookup_key4_t *k;
+  ip4_header_t *ip4;
+  tcp_header_t *tcp;
+  u32 i;
+
+  for (i = 0; i < n_bufs; i++)
+    {
+      k = &keys[i];
+      ip4 = vlib_buffer_get_current (b[i]);
+      if (PREDICT_FALSE (b[i]->current_length <
+			 ip4_header_bytes (ip4) + sizeof (*tcp)))
+	{
+	  clib_memset (k, 0, sizeof (*k));
+	  continue;
+	}
+      tcp = ip4_next_header (ip4);
+      k->lcl.as_u32 = ip4->dst_address.as_u32;
+      k->rmt.as_u32 = ip4->src_address.as_u32;
+      k->lcl_port = tcp->dst_port;
+      k->rmt_port = tcp->src_port;
+      k->fib_index = vnet_buffer (b[i])->ip.fib_index;
+    }
+}
+
+/**
+ * Parse tcp header of b and find its connection
+ *
+ * For ip4, unless is_nolookup is set, the connection must have already been
+ * looked up with @ref tcp4_input_lookup_keys and
+ * session_lookup_connections_wt4, its result being passed in tc4 and
+ * result4.
+ */
 always_inline tcp_connection_t *
-tcp_input_lookup_buffer (vlib_buffer_t * b, u8 thread_index, u32 * error,
-			 u8 is_ip4, u8 is_nolookup)
+tcp_input_lookup_buffer (vlib_buffer_t *b, u8 thread_index, u32 *error,
+			 u8 is_ip4, u8 is_nolookup, transport_connection_t *tc4,
+			 u8 result4)
 {
   u32 fib_index = vnet_buffer (b)->ip.fib_index;
   int n_advance_bytes, n_data_bytes;
@@ -287,11 +331,10 @@ tcp_input_lookup_buffer (vlib_buffer_t * b, u8 thread_index, u32 * error,
 	}
 
       if (!is_nolookup)
-	tc = session_lookup_connection_wt4 (fib_index, &ip4->dst_address,
-					    &ip4->src_address, tcp->dst_port,
-					    tcp->src_port,
-					    TRANSPORT_PROTO_TCP, thread_index,
-					    &result);
+	{
+	  tc = tc4;
+	  result = result4;
+	}
     }
   else
     {
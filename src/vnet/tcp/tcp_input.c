@@ -1711,6 +1711,12 @@ tcp_check_tx_offload (tcp_connection_t * tc, int is_ipv4)
   hw_if = vnet_get_sup_hw_interface (vnm, sw_if_idx);
   if (hw_if->caps & VNET_HW_IF_CAP_TCP_GSO)
     tc->cfg_flags |= TCP_CFG_F_TSO;
+  /* No hw support but interface segments in software on output. Still
+   * cheaper than building and routing the segments one by one */
+  else if (vnet_feature_is_enabled (is_ipv4 ? "ip4-output" : "ip6-output",
+				    is_ipv4 ? "gso-ip4" : "gso-ip6",
+				    sw_if_idx) == 1)
+    tc->cfg_flags |= TCP_CFG_F_TSO;
 }
 
 static void
@@ -2831,6 +2837,8 @@ tcp46_input_inline (vlib_main_t * vm, vlib_node_runtime_t * node,
   vlib_buffer_t *bufs[VLIB_FRAME_SIZE], **b;
   u16 nexts[VLIB_FRAME_SIZE], *next;
   u16 err_counters[TCP_N_ERROR] = { 0 };
+  transport_connection_t *tcs[VLIB_FRAME_SIZE], **tc = tcs;
+  u8 results[VLIB_FRAME_SIZE], *result = results;
 
   tcp_update_time_now (tcp_get_worker (thread_index));
 
@@ -2838,6 +2846,16 @@ tcp46_input_inline (vlib_main_t * vm, vlib_node_runtime_t * node,
   n_left_from = frame->n_vectors;
   vlib_get_buffers (vm, from, bufs, n_left_from);
 
+  /* Look up the whole frame at once, hash table accesses overlap */
+  if (is_ip4 && !is_nolookup)
+    {
+      session_lookup_key4_t keys[VLIB_FRAME_SIZE];
+
+      tcp4_input_lookup_keys (bufs, keys, n_left_from);
+      session_lookup_connections_wt4 (keys, TRANSPORT_PROTO_TCP, thread_index,
+				      tcs, results, n_left_from);
+    }
+
   b = bufs;
   next = nexts;
 
@@ -2855,9 +2873,9 @@ tcp46_input_inline (vlib_main_t * vm, vlib_node_runtime_t * node,
       }
 
       tc0 = tcp_input_lookup_buffer (b[0], thread_index, &error0, is_ip4,
-				     is_nolookup);
+				     is_nolookup, tc[0], result[0]);
       tc1 = tcp_input_lookup_buffer (b[1], thread_index, &error1, is_ip4,
-				     is_nolookup);
+				     is_nolookup, tc[1], result[1]);
 
       if (PREDICT_TRUE (!tc0 + !tc1 == 0))
 	{
@@ -2901,6 +2919,8 @@ tcp46_input_inline (vlib_main_t * vm, vlib_node_runtime_t * node,
 
       b += 2;
       next += 2;
+      tc += 2;
+      result += 2;
       n_left_from -= 2;
     }
   while (n_left_from > 0)
@@ -2915,7 +2935,7 @@ tcp46_input_inline (vlib_main_t * vm, vlib_node_runtime_t * node,
 	}
 
       tc0 = tcp_input_lookup_buffer (b[0], thread_index, &error0, is_ip4,
-				     is_nolookup);
+				     is_nolookup, tc[0], result[0]);
       if (PREDICT_TRUE (tc0 != 0))
 	{
 	  ASSERT (tcp_lookup_is_valid (tc0, b[0], tcp_buffer_hdr (b[0])));
@@ -2930,6 +2950,8 @@ tcp46_input_inline (vlib_main_t * vm, vlib_node_runtime_t * node,
 
       b += 1;
       next += 1;
+      tc += 1;
+      result += 1;
       n_left_from -= 1;
     }
 
@@ -31,7 +31,7 @@
 
 #define TCP_FIB_RECHECK_PERIOD	1 * THZ	/**< Recheck every 1s */
 #define TCP_MAX_OPTION_SPACE 40
-#define TCP_CC_DATA_SZ 24
+#define TCP_CC_DATA_SZ 80
 #define TCP_RXT_MAX_BURST 10
 
 #define TCP_DUPACK_THRESHOLD 	3
@@ -247,7 +247,8 @@ typedef enum _tcp_cc_algorithm_type
 {
   TCP_CC_NEWRENO,
   TCP_CC_CUBIC,
-  TCP_CC_LAST = TCP_CC_CUBIC
+  TCP_CC_BBR,
+  TCP_CC_LAST = TCP_CC_BBR
 } tcp_cc_algorithm_type_e;
 
 typedef struct _tcp_cc_algorithm tcp_cc_algorithm_t;
@@ -0,0 +1,358 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+/** @cond DOCUMENTATION_IS_IN_BIHASH_DOC_H */
+
+typedef struct
+{
+  u64 index;
+  i16 parent;
+  u8 parent_slot;
+} BVT (clib_bihash_cuckoo_bfs_node);
+
+void BV (clib_bihash_cuckoo_init) (BVT (clib_bihash_cuckoo) * h, char *name,
+				   u32 nbuckets)
+{
+  uword size;
+
+  clib_memset (h, 0, sizeof (*h));
+
+  /* Need at least two buckets for alternates to differ */
+  nbuckets = 1 << max_log2 (clib_max (nbuckets, 2));
+  h->nbuckets = nbuckets;
+  h->log2_nbuckets = max_log2 (nbuckets);
+  h->bucket_mask = nbuckets - 1;
+  h->name = (u8 *) name;
+  h->fmt_fn = BV (format_bihash_cuckoo);
+
+  /* Zero-filled anonymous memory, i.e., all tags are free */
+  size = (uword) nbuckets * sizeof (BVT (clib_bihash_cuckoo_bucket));
+  h->buckets = clib_mem_vm_alloc (size);
+  if (h->buckets == 0)
+    clib_panic ("bihash cuckoo '%s' failed to allocate %llu bytes", name,
+		size);
+
+  clib_spinlock_init (&h->writer_lock);
+}
+
+void BV (clib_bihash_cuckoo_free) (BVT (clib_bihash_cuckoo) * h)
+{
+  if (h->buckets)
+    clib_mem_vm_free (h->buckets, BV (clib_bihash_cuckoo_memory_size) (h));
+  clib_spinlock_free (&h->writer_lock);
+  clib_memset (h, 0, sizeof (*h));
+}
+
+uword BV (clib_bihash_cuckoo_memory_size) (BVT (clib_bihash_cuckoo) * h)
+{
+  return (uword) h->nbuckets * sizeof (BVT (clib_bihash_cuckoo_bucket));
+}
+
+static inline void BV (clib_bihash_cuckoo_bucket_lock)
+  (BVT (clib_bihash_cuckoo_bucket) * b)
+{
+  ASSERT (!(b->version & 1));
+  b->version += 1;
+  __atomic_thread_fence (__ATOMIC_RELEASE);
+}
+
+static inline void BV (clib_bihash_cuckoo_bucket_unlock)
+  (BVT (clib_bihash_cuckoo_bucket) * b)
+{
+  clib_atomic_store_rel_n (&b->version, b->version + 1);
+}
+
+static inline void BV (clib_bihash_cuckoo_slot_set)
+  (BVT (clib_bihash_cuckoo_bucket) * b, int slot, BVT (clib_bihash_kv) * kv,
+   u8 tag)
+{
+  BV (clib_bihash_cuckoo_bucket_lock) (b);
+  b->kvp[slot] = *kv;
+  b->tags[slot] = tag;
+  BV (clib_bihash_cuckoo_bucket_unlock) (b);
+}
+
+static inline void BV (clib_bihash_cuckoo_slot_clear)
+  (BVT (clib_bihash_cuckoo_bucket) * b, int slot)
+{
+  BV (clib_bihash_cuckoo_bucket_lock) (b);
+  b->tags[slot] = 0;
+  clib_memset_u8 (&b->kvp[slot], 0xff, sizeof (b->kvp[slot]));
+  BV (clib_bihash_cuckoo_bucket_unlock) (b);
+}
+
+static inline int BV (clib_bihash_cuckoo_free_slot)
+  (BVT (clib_bihash_cuckoo_bucket) * b)
+{
+  u64 match = BV (clib_bihash_cuckoo_tag_match) (b->tags_as_u64, 0);
+  return match ? get_lowest_set_bit_index (match) >> 3 : -1;
+}
+
+static inline int BV (clib_bihash_cuckoo_find_key)
+  (BVT (clib_bihash_cuckoo_bucket) * b, u8 tag, BVT (clib_bihash_kv) * kv)
+{
+  u64 match;
+  int i;
+
+  match = BV (clib_bihash_cuckoo_tag_match) (b->tags_as_u64, tag);
+  while (match)
+    {
+      i = get_lowest_set_bit_index (match) >> 3;
+      if (BV (clib_bihash_key_compare) (b->kvp[i].key, kv->key))
+	return i;
+      match = clear_lowest_set_bit (match);
+    }
+  return -1;
+}
+
+/*
+ * Breadth-first search, starting from the two candidate buckets of the new
+ * key, for an entry whose alternate bucket has a free slot. Each bucket is
+ * visited at most once so every slot on the resulting path moves only once.
+ * Returns index of last node on the path and the slot in that node's bucket
+ * to be displaced, or -1 if none was found within bounds.
+ */
+static int BV (clib_bihash_cuckoo_find_path)
+  (BVT (clib_bihash_cuckoo) * h, BVT (clib_bihash_cuckoo_bfs_node) * q,
+   u64 index0, u64 index1, u8 *slot)
+{
+  BVT (clib_bihash_cuckoo_bucket) * b;
+  int head = 0, tail = 0, depth_end, depth = 0, i, j;
+  u64 alt;
+
+  q[tail++] = (BVT (clib_bihash_cuckoo_bfs_node)){ index0, -1, 0 };
+  q[tail++] = (BVT (clib_bihash_cuckoo_bfs_node)){ index1, -1, 0 };
+  depth_end = tail;
+
+  while (head < tail)
+    {
+      if (head == depth_end)
+	{
+	  if (++depth >= BIHASH_CUCKOO_MAX_PATH_LEN)
+	    break;
+	  depth_end = tail;
+	}
+
+      b = BV (clib_bihash_cuckoo_get_bucket) (h, q[head].index);
+      for (i = 0; i < BIHASH_CUCKOO_BUCKET_SIZE; i++)
+	{
+	  alt = BV (clib_bihash_cuckoo_alt_index) (h, q[head].index,
+						   b->tags[i]);
+	  if (BV (clib_bihash_cuckoo_free_slot) (h->buckets + alt) >= 0)
+	    {
+	      *slot = i;
+	      return head;
+	    }
+	  if (tail == BIHASH_CUCKOO_MAX_BFS_NODES)
+	    continue;
+	  for (j = 0; j < tail; j++)
+	    if (q[j].index == alt)
+	      break;
+	  if (j < tail)
+	    continue;
+	  q[tail++] = (BVT (clib_bihash_cuckoo_bfs_node)){ alt, head, i };
+	}
+      head++;
+    }
+
+  return -1;
+}
+
+/*
+ * Move entries along the path, starting from its end so that every entry
+ * is always present in at least one bucket. Returns the slot freed in the
+ * path's root bucket.
+ */
+static int BV (clib_bihash_cuckoo_move_path)
+  (BVT (clib_bihash_cuckoo) * h, BVT (clib_bihash_cuckoo_bfs_node) * q,
+   int node, u8 slot)
+{
+  BVT (clib_bihash_cuckoo_bucket) * src, *dst;
+  int dst_slot;
+  u64 alt;
+
+  h->move_seq += 1;
+  __atomic_thread_fence (__ATOMIC_RELEASE);
+
+  while (1)
+    {
+      src = BV (clib_bihash_cuckoo_get_bucket) (h, q[node].index);
+      alt = BV (clib_bihash_cuckoo_alt_index) (h, q[node].index,
+					       src->tags[slot]);
+      dst = BV (clib_bihash_cuckoo_get_bucket) (h, alt);
+      dst_slot = BV (clib_bihash_cuckoo_free_slot) (dst);
+      ASSERT (dst_slot >= 0 && src->tags[slot]);
+
+      BV (clib_bihash_cuckoo_slot_set) (dst, dst_slot, &src->kvp[slot],
+					src->tags[slot]);
+      BV (clib_bihash_cuckoo_slot_clear) (src, slot);
+      h->n_moves += 1;
+
+      if (q[node].parent < 0)
+	break;
+      slot = q[node].parent_slot;
+      node = q[node].parent;
+    }
+
+  clib_atomic_store_rel_n (&h->move_seq, h->move_seq + 1);
+
+  return slot;
+}
+
+int BV (clib_bihash_cuckoo_add_del_with_hash) (BVT (clib_bihash_cuckoo) * h,
+					       BVT (clib_bihash_kv) * add_v,
+					       u64 hash, int is_add)
+{
+  BVT (clib_bihash_cuckoo_bfs_node) q[BIHASH_CUCKOO_MAX_BFS_NODES];
+  BVT (clib_bihash_cuckoo_bucket) * b0, *b1, *b;
+  u64 index0, index1;
+  int slot, node, rv = 0;
+  u8 tag, path_slot;
+
+  index0 = hash & h->bucket_mask;
+  tag = BV (clib_bihash_cuckoo_tag) (hash);
+  index1 = BV (clib_bihash_cuckoo_alt_index) (h, index0, tag);
+  b0 = BV (clib_bihash_cuckoo_get_bucket) (h, index0);
+  b1 = BV (clib_bihash_cuckoo_get_bucket) (h, index1);
+
+  clib_spinlock_lock (&h->writer_lock);
+
+  b = b0;
+  slot = BV (clib_bihash_cuckoo_find_key) (b, tag, add_v);
+  if (slot < 0)
+    {
+      b = b1;
+      slot = BV (clib_bihash_cuckoo_find_key) (b, tag, add_v);
+    }
+
+  if (!is_add)
+    {
+      if (slot < 0)
+	{
+	  rv = -1;
+	  goto done;
+	}
+      BV (clib_bihash_cuckoo_slot_clear) (b, slot);
+      h->n_elts -= 1;
+      goto done;
+    }
+
+  /* Overwrite existing value */
+  if (slot >= 0)
+    {
+      BV (clib_bihash_cuckoo_slot_set) (b, slot, add_v, tag);
+      goto done;
+    }
+
+  b = b0;
+  slot = BV (clib_bihash_cuckoo_free_slot) (b);
+  if (slot < 0)
+    {
+      b = b1;
+      slot = BV (clib_bihash_cuckoo_free_slot) (b);
+    }
+
+  if (slot < 0)
+    {
+      node = BV (clib_bihash_cuckoo_find_path) (h, q, index0, index1,
+						&path_slot);
+      if (node < 0)
+	{
+	  h->n_add_fails += 1;
+	  rv = -2;
+	  goto done;
+	}
+      slot = BV (clib_bihash_cuckoo_move_path) (h, q, node, path_slot);
+      /* Path root is one of the two candidate buckets */
+      while (q[node].parent >= 0)
+	node = q[node].parent;
+      b = BV (clib_bihash_cuckoo_get_bucket) (h, q[node].index);
+    }
+
+  BV (clib_bihash_cuckoo_slot_set) (b, slot, add_v, tag);
+  h->n_elts += 1;
+
+done:
+  clib_spinlock_unlock (&h->writer_lock);
+  return rv;
+}
+
+int BV (clib_bihash_cuckoo_add_del) (BVT (clib_bihash_cuckoo) * h,
+				     BVT (clib_bihash_kv) * add_v, int is_add)
+{
+  return BV (clib_bihash_cuckoo_add_del_with_hash) (
+    h, add_v, BV (clib_bihash_hash) (add_v), is_add);
+}
+
+void BV (clib_bihash_cuckoo_foreach_key_value_pair) (
+  BVT (clib_bihash_cuckoo) * h,
+  BV (clib_bihash_foreach_key_value_pair_cb) cb, void *arg)
+{
+  BVT (clib_bihash_cuckoo_bucket) * b;
+  u64 i;
+  int j;
+
+  for (i = 0; i < h->nbuckets; i++)
+    {
+      b = BV (clib_bihash_cuckoo_get_bucket) (h, i);
+      for (j = 0; j < BIHASH_CUCKOO_BUCKET_SIZE; j++)
+	{
+	  if (!b->tags[j])
+	    continue;
+	  if (BIHASH_WALK_STOP == cb (&b->kvp[j], arg))
+	    return;
+	}
+    }
+}
+
+u8 *BV (format_bihash_cuckoo) (u8 * s, va_list * args)
+{
+  BVT (clib_bihash_cuckoo) * h = va_arg (*args, BVT (clib_bihash_cuckoo) *);
+  int verbose = va_arg (*args, int);
+  u64 occupancy[BIHASH_CUCKOO_BUCKET_SIZE + 1] = {};
+  BVT (clib_bihash_cuckoo_bucket) * b;
+  u64 i, n_slots, memory;
+  int j, n;
+
+  s = format (s, "Cuckoo hash table '%s'\n",
+	      h->name ? h->name : (u8 *) "(unnamed)");
+
+  n_slots = (u64) h->nbuckets * BIHASH_CUCKOO_BUCKET_SIZE;
+  memory = BV (clib_bihash_cuckoo_memory_size) (h);
+
+  s = format (s, "    %lld active elements in %d buckets, load %.2f%%\n",
+	      h->n_elts, h->nbuckets,
+	      n_slots ? 100.0 * h->n_elts / n_slots : 0.0);
+  s = format (s, "    %U, %.1f bytes per element\n", format_memory_size,
+	      memory, h->n_elts ? (f64) memory / h->n_elts : 0.0);
+  s = format (s, "    %lld displacements, %lld failed adds\n", h->n_moves,
+	      h->n_add_fails);
+
+  if (!verbose)
+    return s;
+
+  for (i = 0; i < h->nbuckets; i++)
+    {
+      b = BV (clib_bihash_cuckoo_get_bucket) (h, i);
+      n = 0;
+      for (j = 0; j < BIHASH_CUCKOO_BUCKET_SIZE; j++)
+	{
+	  if (!b->tags[j])
+	    continue;
+	  n++;
+	  if (verbose > 1)
+	    s = format (s, "[%lld][%d]: %U\n", i, j, BV (format_bihash_kvp),
+			&b->kvp[j]);
+	}
+      occupancy[n]++;
+    }
+
+  s = format (s, "    bucket occupancy:\n");
+  for (j = 0; j <= BIHASH_CUCKOO_BUCKET_SIZE; j++)
+    s = format (s, "      %d: %lld\n", j, occupancy[j]);
+
+  return s;
+}
+
+/** @endcond */
@@ -0,0 +1,240 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+/*
+ * Bucketized cuckoo variant of the bounded-index extensible hash.
+ *
+ * Instantiated from the same per-type headers as the classic bihash, e.g.
+ *
+ *   #include <vppinfra/bihash_16_8.h>
+ *   #include <vppinfra/bihash_cuckoo_template.h>
+ *
+ * and, in exactly one translation unit, bihash_cuckoo_template.c. Key/value
+ * types, hash, key compare and kvp format functions are shared with the
+ * classic variant, so a table can be switched between the two by replacing
+ * clib_bihash with clib_bihash_cuckoo in the BV()/BVT() names.
+ *
+ * Every key lives in one of two candidate buckets of
+ * BIHASH_CUCKOO_BUCKET_SIZE slots, so a lookup never touches more than two
+ * buckets. Slots carry an 8-bit tag derived from the hash and compared for
+ * all slots of a bucket at once before any key is looked at. Readers are
+ * lock-free: buckets are protected by a sequence counter and cuckoo moves
+ * by a table-wide one, so readers retry instead of waiting. Writers are
+ * serialized by a spinlock. The table does not grow; adds fail with -2 if no
+ * displacement path can be found, which in practice happens only above
+ * ~95% load.
+ *
+ * Note: to instantiate the template multiple times in a single file,
+ * #undef __included_bihash_cuckoo_template_h__...
+ */
+#ifndef __included_bihash_cuckoo_template_h__
+#define __included_bihash_cuckoo_template_h__
+
+#include <vppinfra/bihash_template.h>
+
+/* Slots per bucket, one byte of tags per slot in a u64 */
+#define BIHASH_CUCKOO_BUCKET_SIZE 8
+
+/* Bounds on the breadth-first search for a displacement path */
+#define BIHASH_CUCKOO_MAX_BFS_NODES 512
+#define BIHASH_CUCKOO_MAX_PATH_LEN  5
+
+typedef struct
+{
+  CLIB_CACHE_LINE_ALIGN_MARK (cacheline0);
+
+  /** Sequence counter, odd while bucket is being written */
+  volatile u32 version;
+  u32 pad;
+
+  /** Per slot hash tag, 0 if slot is free */
+  union
+  {
+    u8 tags[BIHASH_CUCKOO_BUCKET_SIZE];
+    u64 tags_as_u64;
+  };
+
+  BVT (clib_bihash_kv) kvp[BIHASH_CUCKOO_BUCKET_SIZE];
+} BVT (clib_bihash_cuckoo_bucket);
+
+typedef struct
+{
+  BVT (clib_bihash_cuckoo_bucket) * buckets;
+  u32 nbuckets;
+  u32 log2_nbuckets;
+  u64 bucket_mask;
+
+  /** Sequence counter, odd while entries are being displaced */
+  volatile u64 move_seq;
+
+  /** Serializes writers */
+  clib_spinlock_t writer_lock;
+
+  u64 n_elts;
+  u64 n_moves;
+  u64 n_add_fails;
+
+  u8 *name;
+  format_function_t *fmt_fn;
+} BVT (clib_bihash_cuckoo);
+
+void BV (clib_bihash_cuckoo_init) (BVT (clib_bihash_cuckoo) * h, char *name,
+				   u32 nbuckets);
+void BV (clib_bihash_cuckoo_free) (BVT (clib_bihash_cuckoo) * h);
+int BV (clib_bihash_cuckoo_add_del) (BVT (clib_bihash_cuckoo) * h,
+				     BVT (clib_bihash_kv) * add_v, int is_add);
+int BV (clib_bihash_cuckoo_add_del_with_hash) (BVT (clib_bihash_cuckoo) * h,
+					       BVT (clib_bihash_kv) * add_v,
+					       u64 hash, int is_add);
+void BV (clib_bihash_cuckoo_foreach_key_value_pair) (
+  BVT (clib_bihash_cuckoo) * h,
+  BV (clib_bihash_foreach_key_value_pair_cb) cb, void *arg);
+uword BV (clib_bihash_cuckoo_memory_size) (BVT (clib_bihash_cuckoo) * h);
+
+format_function_t BV (format_bihash_cuckoo);
+
+/*
+ * Tag is taken from a multiplicative remix of the hash as some of the per
+ * type hash functions, e.g., crc32c, only produce 32 bits
+ */
+static inline u8 BV (clib_bihash_cuckoo_tag) (u64 hash)
+{
+  u8 tag = (hash * 0x9E3779B97F4A7C15ULL) >> 56;
+  return tag ? tag : 1;
+}
+
+/*
+ * Alternate bucket depends only on current bucket and tag, so entries can
+ * be displaced without rehashing their keys. Never equal to current bucket.
+ */
+static inline u64 BV (clib_bihash_cuckoo_alt_index)
+  (BVT (clib_bihash_cuckoo) * h, u64 index, u8 tag)
+{
+  return (index ^ (((tag * 0x5bd1e995ULL) & h->bucket_mask) | 1)) &
+	 h->bucket_mask;
+}
+
+/*
+ * Compare all tags of a bucket against tag in one go. Returns a mask with
+ * the msb of matching bytes set
+ */
+static inline u64 BV (clib_bihash_cuckoo_tag_match) (u64 tags, u8 tag)
+{
+  u64 x = tags ^ (tag * 0x0101010101010101ULL);
+  u64 t = ((x & 0x7f7f7f7f7f7f7f7fULL) + 0x7f7f7f7f7f7f7f7fULL) | x;
+  return ~t & 0x8080808080808080ULL;
+}
+
+static inline BVT (clib_bihash_cuckoo_bucket) *
+  BV (clib_bihash_cuckoo_get_bucket) (BVT (clib_bihash_cuckoo) * h,
+				      u64 index)
+{
+  return h->buckets + index;
+}
+
+static inline int BV (clib_bihash_cuckoo_search_bucket)
+  (BVT (clib_bihash_cuckoo_bucket) * b, u8 tag,
+   BVT (clib_bihash_kv) * key_result)
+{
+  BVT (clib_bihash_kv) rv;
+  u32 version;
+  u64 match;
+  int i;
+
+again:
+  version = clib_atomic_load_acq_n (&b->version);
+  if (PREDICT_FALSE (version & 1))
+    {
+      CLIB_PAUSE ();
+      goto again;
+    }
+
+  match = BV (clib_bihash_cuckoo_tag_match) (b->tags_as_u64, tag);
+  while (match)
+    {
+      i = get_lowest_set_bit_index (match) >> 3;
+      if (BV (clib_bihash_key_compare) (b->kvp[i].key, key_result->key))
+	{
+	  rv = b->kvp[i];
+	  __atomic_thread_fence (__ATOMIC_ACQUIRE);
+	  if (PREDICT_FALSE (b->version != version))
+	    goto again;
+	  *key_result = rv;
+	  return 0;
+	}
+      match = clear_lowest_set_bit (match);
+    }
+
+  __atomic_thread_fence (__ATOMIC_ACQUIRE);
+  if (PREDICT_FALSE (b->version != version))
+    goto again;
+
+  return -1;
+}
+
+static inline int BV (clib_bihash_cuckoo_search_inline_with_hash)
+  (BVT (clib_bihash_cuckoo) * h, u64 hash, BVT (clib_bihash_kv) * key_result)
+{
+  u64 index, seq;
+  u8 tag;
+
+  index = hash & h->bucket_mask;
+  tag = BV (clib_bihash_cuckoo_tag) (hash);
+
+again:
+  seq = clib_atomic_load_acq_n (&h->move_seq);
+
+  if (!BV (clib_bihash_cuckoo_search_bucket) (h->buckets + index, tag,
+					      key_result))
+    return 0;
+
+  if (!BV (clib_bihash_cuckoo_search_bucket) (
+	h->buckets + BV (clib_bihash_cuckoo_alt_index) (h, index, tag), tag,
+	key_result))
+    return 0;
+
+  /* Entry may have been moved between the two buckets while we looked */
+  __atomic_thread_fence (__ATOMIC_ACQUIRE);
+  if (PREDICT_FALSE ((seq & 1) || h->move_seq != seq))
+    {
+      CLIB_PAUSE ();
+      goto again;
+    }
+
+  return -1;
+}
+
+static inline int BV (clib_bihash_cuckoo_search_inline)
+  (BVT (clib_bihash_cuckoo) * h, BVT (clib_bihash_kv) * key_result)
+{
+  u64 hash;
+
+  hash = BV (clib_bihash_hash) (key_result);
+
+  return BV (clib_bihash_cuckoo_search_inline_with_hash) (h, hash,
+							  key_result);
+}
+
+static inline int BV (clib_bihash_cuckoo_search)
+  (BVT (clib_bihash_cuckoo) * h, BVT (clib_bihash_kv) * search_key,
+   BVT (clib_bihash_kv) * valuep)
+{
+  *valuep = *search_key;
+  return BV (clib_bihash_cuckoo_search_inline) (h, valuep);
+}
+
+static inline void BV (clib_bihash_cuckoo_prefetch_bucket)
+  (BVT (clib_bihash_cuckoo) * h, u64 hash)
+{
+  u64 index = hash & h->bucket_mask;
+  u8 tag = BV (clib_bihash_cuckoo_tag) (hash);
+
+  CLIB_PREFETCH (h->buckets + index,
+		 sizeof (BVT (clib_bihash_cuckoo_bucket)), LOAD);
+  CLIB_PREFETCH (h->buckets + BV (clib_bihash_cuckoo_alt_index) (h, index,
+								 tag),
+		 sizeof (BVT (clib_bihash_cuckoo_bucket)), LOAD);
+}
+
+#endif /* __included_bihash_cuckoo_template_h__ */
@@ -109,6 +109,10 @@ static inline void *BV (alloc_aligned) (BVT (clib_bihash) * h, uword nbytes)
 #if __linux__
       int mmap_flags_huge = (mmap_flags | MAP_HUGETLB | MAP_LOCKED |
 			     BIHASH_LOG2_HUGEPAGE_SIZE << MAP_HUGE_SHIFT);
+
+      /* fault normal pages in now, while the numa policy is set */
+      if (h->numa_node != CLIB_U8_MAX)
+	mmap_flags |= MAP_POPULATE;
 #endif /* __linux__ */
 
       /* new allocation is 25% of existing one */
@@ -120,6 +124,9 @@ static inline void *BV (alloc_aligned) (BVT (clib_bihash) * h, uword nbytes)
 
       base = (void *) (uword) (alloc_arena (h) + alloc_arena_mapped (h));
 
+      if (h->numa_node != CLIB_U8_MAX)
+	clib_mem_set_numa_affinity (h->numa_node, 0 /* force */);
+
 #if __linux__
       rv = mmap (base, alloc, PROT_READ | PROT_WRITE, mmap_flags_huge, -1, 0);
 #elif __FreeBSD__
@@ -130,6 +137,9 @@ static inline void *BV (alloc_aligned) (BVT (clib_bihash) * h, uword nbytes)
       if (rv == MAP_FAILED || mlock (base, alloc) != 0)
 	rv = mmap (base, alloc, PROT_READ | PROT_WRITE, mmap_flags, -1, 0);
 
+      if (h->numa_node != CLIB_U8_MAX)
+	clib_mem_set_default_numa_affinity ();
+
       if (rv == MAP_FAILED)
 	os_out_of_memory ();
 
@@ -141,11 +151,16 @@ static inline void *BV (alloc_aligned) (BVT (clib_bihash) * h, uword nbytes)
 
 static void BV (clib_bihash_instantiate) (BVT (clib_bihash) * h)
 {
-  uword bucket_size;
+  uword bucket_size, bucket_array_size;
 
   if (BIHASH_USE_HEAP)
     {
-      h->heap = clib_mem_get_heap ();
+      h->heap = 0;
+      if (h->numa_node != CLIB_U8_MAX)
+	h->heap = clib_mem_get_per_numa_heap (h->numa_node);
+      /* No per-numa heap (yet), stick to the current one */
+      if (h->heap == 0)
+	h->heap = clib_mem_get_heap ();
       h->chunks = 0;
       alloc_arena (h) = (uword) clib_mem_get_heap_base (h->heap);
     }
@@ -166,7 +181,15 @@ static void BV (clib_bihash_instantiate) (BVT (clib_bihash) * h)
     bucket_size +=
       h->nbuckets * BIHASH_KVP_PER_PAGE * sizeof (BVT (clib_bihash_kv));
 
-  h->buckets = BV (alloc_aligned) (h, bucket_size);
+  /*
+   * Resizable tables reserve the bucket array for max_log2_nbuckets up
+   * front, so buckets never move while readers look at them. The extra
+   * space is initialized by the splits that bring it into use.
+   */
+  bucket_array_size = bucket_size
+		      << (h->max_log2_nbuckets - h->log2_nbuckets);
+
+  h->buckets = BV (alloc_aligned) (h, bucket_array_size);
   clib_memset_u8 (h->buckets, 0, bucket_size);
 
   if (BIHASH_KVP_AT_BUCKET_LEVEL)
@@ -209,6 +232,18 @@ void BV (clib_bihash_init2) (BVT (clib_bihash_init2_args) * a)
   h->name = (u8 *) a->name;
   h->nbuckets = a->nbuckets;
   h->log2_nbuckets = max_log2 (a->nbuckets);
+  h->geometry = h->log2_nbuckets;
+  h->max_log2_nbuckets = h->log2_nbuckets;
+  h->resize_pending = 0;
+  h->resize_lock = 0;
+  h->n_bucket_pages = 0;
+  clib_memset_u8 (h->probe_depth_histogram, 0,
+		  sizeof (h->probe_depth_histogram));
+
+  if (a->max_nbuckets > a->nbuckets)
+    h->max_log2_nbuckets = max_log2 (a->max_nbuckets);
+
+  h->numa_node = a->use_numa_node ? a->numa_node : CLIB_U8_MAX;
   h->memory_size = BIHASH_USE_HEAP ? 0 : a->memory_size;
   h->instantiated = 0;
   h->dont_add_to_all_bihash_list = a->dont_add_to_all_bihash_list;
@@ -319,6 +354,8 @@ void BV (clib_bihash_initiator_init_svm)
   h->name = (u8 *) name;
   h->sh->nbuckets = h->nbuckets = nbuckets;
   h->log2_nbuckets = max_log2 (nbuckets);
+  h->geometry = h->max_log2_nbuckets = h->log2_nbuckets;
+  h->numa_node = CLIB_U8_MAX;
 
   alloc_arena (h) = (u64) (uword) mmap_addr;
   alloc_arena_next (h) = CLIB_CACHE_LINE_BYTES;
@@ -391,6 +428,8 @@ void BV (clib_bihash_responder_init_svm)
   h->buckets = BV (clib_bihash_get_value) (h, h->sh->buckets_as_u64);
   h->nbuckets = h->sh->nbuckets;
   h->log2_nbuckets = max_log2 (h->nbuckets);
+  h->geometry = h->max_log2_nbuckets = h->log2_nbuckets;
+  h->numa_node = CLIB_U8_MAX;
 
   h->alloc_lock = BV (clib_bihash_get_value) (h, h->sh->alloc_lock_as_u64);
   h->freelists = BV (clib_bihash_get_value) (h, h->sh->freelists_as_u64);
@@ -436,6 +475,8 @@ void BV (clib_bihash_free) (BVT (clib_bihash) * h)
 
   vec_free (h->working_copies);
   vec_free (h->working_copy_lengths);
+  vec_free (h->resize_kvs[0]);
+  vec_free (h->resize_kvs[1]);
   clib_mem_free ((void *) h->alloc_lock);
 #if BIHASH_32_64_SVM == 0
   vec_free (h->freelists);
@@ -538,6 +579,50 @@ BV (value_free) (BVT (clib_bihash) * h, BVT (clib_bihash_value) * v,
   h->freelists[log2_pages] = (u64) BV (clib_bihash_get_offset) (h, v);
 }
 
+/*
+ * Account for a value page group being attached to (is_add = 1) or
+ * detached from a bucket, for the resize heuristic and the probe depth
+ * histogram.
+ */
+static inline void
+BV (bucket_pages_update) (BVT (clib_bihash) * h, BVT (clib_bihash_bucket) * b,
+			  int is_add)
+{
+  u32 bin = clib_min ((u32) b->log2_pages, BIHASH_PROBE_DEPTH_N_BINS - 2);
+
+  ASSERT (h->alloc_lock[0]);
+
+  /* Lookups scan all pages of linear search buckets */
+  if (b->linear_search)
+    bin = BIHASH_PROBE_DEPTH_N_BINS - 1;
+
+  if (is_add)
+    {
+      h->n_bucket_pages += 1ULL << b->log2_pages;
+      h->probe_depth_histogram[bin]++;
+    }
+  else
+    {
+      h->n_bucket_pages -= 1ULL << b->log2_pages;
+      h->probe_depth_histogram[bin]--;
+    }
+}
+
+static inline void
+BV (resize_check) (BVT (clib_bihash) * h)
+{
+  u64 nbuckets = BV (clib_bihash_geometry_nbuckets) (h->geometry);
+
+  ASSERT (h->alloc_lock[0]);
+
+  if (PREDICT_TRUE (h->n_bucket_pages <=
+		    nbuckets * BIHASH_RESIZE_PAGES_PER_BUCKET))
+    return;
+
+  if (h->resize_pending == 0 && h->log2_nbuckets < h->max_log2_nbuckets)
+    h->resize_pending = 1;
+}
+
 static inline void
 BV (make_working_copy) (BVT (clib_bihash) * h, BVT (clib_bihash_bucket) * b)
 {
@@ -596,7 +681,7 @@ BVT (clib_bihash_value) *
 BV (split_and_rehash)
   (BVT (clib_bihash) * h,
    BVT (clib_bihash_value) * old_values, u32 old_log2_pages,
-   u32 new_log2_pages)
+   u32 new_log2_pages, u32 log2_nbuckets)
 {
   BVT (clib_bihash_value) * new_values, *new_v;
   int i, j, length_in_kvs;
@@ -616,7 +701,7 @@ BV (split_and_rehash)
 
       /* rehash the item onto its new home-page */
       new_hash = BV (clib_bihash_hash) (&(old_values->kvp[i]));
-      new_hash = extract_bits (new_hash, h->log2_nbuckets, new_log2_pages);
+      new_hash = extract_bits (new_hash, log2_nbuckets, new_log2_pages);
       new_v = &new_values[new_hash];
 
       /* Across the new home-page */
@@ -686,6 +771,235 @@ BV (split_and_rehash_linear)
   return new_values;
 }
 
+/*
+ * Online resize. The bucket array is doubled one bucket at a time, in the
+ * manner of linear hashing: bucket i of 2**log2_nbuckets is split into
+ * buckets i and i + 2**log2_nbuckets using one more bit of the hash, and
+ * the split cursor in h->geometry is advanced. Readers never wait for a
+ * resize, they pick the bucket from the geometry they loaded and retry
+ * misses if the geometry changed meanwhile.
+ */
+static void
+BV (rehash_bucket) (BVT (clib_bihash) * h, BVT (clib_bihash_kv) * kvs,
+		    u32 log2_nbuckets, BVT (clib_bihash_bucket) * b,
+		    BVT (clib_bihash_bucket) * rv)
+{
+  BVT (clib_bihash_value) * values, *v;
+  u32 n_kvs = vec_len (kvs), min_log2_pages, log2_pages;
+  int i, j;
+
+  rv->as_u64 = 0;
+
+#if BIHASH_KVP_AT_BUCKET_LEVEL
+  /* Fits the bucket level kvps, caller makes sure nobody looks at them */
+  if (n_kvs <= BIHASH_KVP_PER_PAGE)
+    {
+      BVT (clib_bihash_kv) *kv = (void *) (b + 1);
+
+      for (i = 0; i < BIHASH_KVP_PER_PAGE; i++)
+	{
+	  if (i < n_kvs)
+	    clib_memcpy_fast (&kv[i], &kvs[i], sizeof (kvs[i]));
+	  else
+	    BV (clib_bihash_mark_free) (&kv[i]);
+	}
+      rv->offset = BV (clib_bihash_get_offset) (h, kv);
+      rv->refcnt = n_kvs + 1;
+      return;
+    }
+  /* Value pages hang off buckets with log2_pages > 0 only */
+  min_log2_pages = 1;
+#else
+  if (n_kvs == 0)
+    return;
+  min_log2_pages = 0;
+#endif
+
+  min_log2_pages = clib_max (min_log2_pages,
+			     max_log2 ((n_kvs + BIHASH_KVP_PER_PAGE - 1) /
+				       BIHASH_KVP_PER_PAGE));
+
+  /* Like adds, try once more with twice the pages, then go linear */
+  for (log2_pages = min_log2_pages; log2_pages < min_log2_pages + 2;
+       log2_pages++)
+    {
+      values = BV (value_alloc) (h, log2_pages);
+
+      for (i = 0; i < n_kvs; i++)
+	{
+	  u64 hash = BV (clib_bihash_hash) (&kvs[i]);
+
+	  v = values + extract_bits (hash, log2_nbuckets, log2_pages);
+	  for (j = 0; j < BIHASH_KVP_PER_PAGE; j++)
+	    {
+	      if (BV (clib_bihash_is_free) (&v->kvp[j]))
+		{
+		  clib_memcpy_fast (&v->kvp[j], &kvs[i], sizeof (kvs[i]));
+		  break;
+		}
+	    }
+	  if (j == BIHASH_KVP_PER_PAGE)
+	    break;
+	}
+
+      if (i == n_kvs)
+	goto done;
+
+      BV (value_free) (h, values, log2_pages);
+    }
+
+  /* pinned collisions, use linear search */
+  log2_pages = min_log2_pages;
+  values = BV (value_alloc) (h, log2_pages);
+  clib_memcpy_fast (values->kvp, kvs, n_kvs * sizeof (kvs[0]));
+  rv->linear_search = 1;
+  BV (clib_bihash_increment_stat) (h, BIHASH_STAT_linear, 1);
+
+done:
+  rv->offset = BV (clib_bihash_get_offset) (h, values);
+  rv->log2_pages = log2_pages;
+  rv->refcnt = n_kvs + BIHASH_KVP_AT_BUCKET_LEVEL;
+  BV (bucket_pages_update) (h, rv, 1 /* is_add */);
+}
+
+static void
+BV (split_bucket) (BVT (clib_bihash) * h)
+{
+  BVT (clib_bihash_bucket) * b, *b_hi, lo, hi, old;
+  BVT (clib_bihash_value) * v;
+  u64 geometry = h->geometry, cursor, hash;
+  u32 log2_nbuckets, unused;
+  int i, has_pages;
+
+  log2_nbuckets = BV (clib_bihash_geometry_log2_nbuckets) (geometry);
+  cursor = BV (clib_bihash_geometry_split_cursor) (geometry);
+  b = BV (clib_bihash_get_bucket_with_geometry) (h, cursor, log2_nbuckets,
+						 &unused);
+  b_hi = BV (clib_bihash_get_bucket_with_geometry)
+    (h, cursor + (1ULL << log2_nbuckets), log2_nbuckets + 1, &unused);
+
+  BV (clib_bihash_lock_bucket) (b);
+  BV (clib_bihash_alloc_lock) (h);
+
+  old.as_u64 = b->as_u64;
+  old.lock = 0;
+  has_pages = BIHASH_KVP_AT_BUCKET_LEVEL ? old.log2_pages > 0 :
+					   old.offset != 0;
+  vec_reset_length (h->resize_kvs[0]);
+  vec_reset_length (h->resize_kvs[1]);
+
+  if (!BV (clib_bihash_bucket_is_empty) (&old))
+    {
+      v = BV (clib_bihash_get_value) (h, old.offset);
+      for (i = 0; i < (BIHASH_KVP_PER_PAGE << old.log2_pages); i++)
+	{
+	  if (BV (clib_bihash_is_free) (&v->kvp[i]))
+	    continue;
+	  hash = BV (clib_bihash_hash) (&v->kvp[i]);
+	  vec_add1 (h->resize_kvs[(hash >> log2_nbuckets) & 1], v->kvp[i]);
+	}
+    }
+
+  /* Upper half first, nobody looks at it until the cursor moves */
+  BV (rehash_bucket) (h, h->resize_kvs[1], log2_nbuckets + 1, b_hi, &hi);
+  CLIB_MEMORY_STORE_BARRIER ();
+  b_hi->as_u64 = hi.as_u64;
+
+  if (cursor + 1 == (1ULL << log2_nbuckets))
+    {
+      /* Last one, the table has doubled */
+      geometry = log2_nbuckets + 1;
+      h->nbuckets <<= 1;
+      h->log2_nbuckets++;
+      h->resize_pending = 0;
+    }
+  else
+    geometry += 1ULL << BIHASH_GEOMETRY_LOG2_BITS;
+
+  clib_atomic_store_rel_n (&h->geometry, geometry);
+
+  /*
+   * Lower half. Entries may only disappear from pages readers can see
+   * after the cursor moved, so they retry.
+   */
+  if (BIHASH_KVP_AT_BUCKET_LEVEL && !has_pages)
+    {
+      /* Entries staying behind are already in place, drop the others */
+      v = BV (clib_bihash_get_value) (h, old.offset);
+      for (i = 0; i < BIHASH_KVP_PER_PAGE; i++)
+	{
+	  if (BV (clib_bihash_is_free) (&v->kvp[i]))
+	    continue;
+	  hash = BV (clib_bihash_hash) (&v->kvp[i]);
+	  if ((hash >> log2_nbuckets) & 1)
+	    BV (clib_bihash_mark_free) (&v->kvp[i]);
+	}
+      lo.as_u64 = old.as_u64;
+      lo.refcnt = vec_len (h->resize_kvs[0]) + 1;
+    }
+  else
+    BV (rehash_bucket) (h, h->resize_kvs[0], log2_nbuckets + 1, b, &lo);
+
+  /* Replace the original bucket, which also unlocks it */
+  CLIB_MEMORY_STORE_BARRIER ();
+  b->as_u64 = lo.as_u64;
+
+  if (has_pages)
+    {
+      v = BV (clib_bihash_get_value) (h, old.offset);
+      BV (bucket_pages_update) (h, &old, 0 /* is_add */);
+      BV (value_free) (h, v, old.log2_pages);
+    }
+
+  BV (clib_bihash_alloc_unlock) (h);
+}
+
+/*
+ * Split up to n_buckets buckets of a pending resize. Adds do a few each,
+ * owners of rarely written tables may want to call this from a process.
+ * Returns 1 if the resize is still pending.
+ */
+int BV (clib_bihash_resize_step) (BVT (clib_bihash) * h, u32 n_buckets)
+{
+  if (h->resize_pending == 0)
+    return 0;
+
+  /* Somebody else is splitting buckets, let them */
+  if (clib_atomic_test_and_set (&h->resize_lock))
+    return 1;
+
+  while (n_buckets-- && h->resize_pending)
+    BV (split_bucket) (h);
+
+  clib_atomic_release (&h->resize_lock);
+
+  return h->resize_pending;
+}
+
+/*
+ * Start doubling the table, if it was initialized with max_nbuckets
+ * larger than its current size
+ */
+int BV (clib_bihash_grow) (BVT (clib_bihash) * h)
+{
+  int rv = 0;
+
+  if (h->instantiated == 0)
+    return -1;
+
+  BV (clib_bihash_alloc_lock) (h);
+  if (h->resize_pending == 0)
+    {
+      if (h->log2_nbuckets < h->max_log2_nbuckets)
+	h->resize_pending = 1;
+      else
+	rv = -1;
+    }
+  BV (clib_bihash_alloc_unlock) (h);
+
+  return rv;
+}
+
 static_always_inline int BV (clib_bihash_add_del_inline_with_hash) (
   BVT (clib_bihash) * h, BVT (clib_bihash_kv) * add_v, u64 hash, int is_add,
   int (*is_stale_cb) (BVT (clib_bihash_kv) *, void *), void *is_stale_arg,
@@ -699,6 +1013,8 @@ static_always_inline int BV (clib_bihash_add_del_inline_with_hash) (
   clib_thread_index_t thread_index = os_get_thread_index ();
   int mark_bucket_linear;
   int resplit_once;
+  u64 geometry;
+  u32 log2_nbuckets;
 
   static const BVT (clib_bihash_bucket) mask = {
     .linear_search = 1,
@@ -731,10 +1047,24 @@ static_always_inline int BV (clib_bihash_add_del_inline_with_hash) (
    */
   ASSERT ((is_add && BV (clib_bihash_is_free) (add_v)) == 0);
 
-  b = BV (clib_bihash_get_bucket) (h, hash);
+  /* Move a pending resize along before taking any locks */
+  if (PREDICT_FALSE (h->resize_pending) && is_add)
+    BV (clib_bihash_resize_step) (h, BIHASH_RESIZE_BUCKETS_PER_ADD);
+
+again:
+  geometry = clib_atomic_load_acq_n (&h->geometry);
+  b = BV (clib_bihash_get_bucket_with_geometry) (h, hash, geometry,
+						 &log2_nbuckets);
 
   BV (clib_bihash_lock_bucket) (b);
 
+  /* Bucket split by a resize while we waited for the lock? */
+  if (PREDICT_FALSE (BV (clib_bihash_get_bucket) (h, hash) != b))
+    {
+      BV (clib_bihash_unlock_bucket) (b);
+      goto again;
+    }
+
   /* First elt in the bucket? */
   if (BIHASH_KVP_AT_BUCKET_LEVEL == 0 && BV (clib_bihash_bucket_is_empty) (b))
     {
@@ -746,12 +1076,13 @@ static_always_inline int BV (clib_bihash_add_del_inline_with_hash) (
 
       BV (clib_bihash_alloc_lock) (h);
       v = BV (value_alloc) (h, 0);
-      BV (clib_bihash_alloc_unlock) (h);
-
-      *v->kvp = *add_v;
       tmp_b.as_u64 = 0;		/* clears bucket lock */
       tmp_b.offset = BV (clib_bihash_get_offset) (h, v);
       tmp_b.refcnt = 1;
+      BV (bucket_pages_update) (h, &tmp_b, 1 /* is_add */);
+      BV (clib_bihash_alloc_unlock) (h);
+
+      *v->kvp = *add_v;
       CLIB_MEMORY_STORE_BARRIER ();
 
       b->as_u64 = tmp_b.as_u64;	/* unlocks the bucket */
@@ -769,7 +1100,7 @@ static_always_inline int BV (clib_bihash_add_del_inline_with_hash) (
       if (PREDICT_FALSE (b->linear_search))
 	limit <<= b->log2_pages;
       else
-	v += extract_bits (hash, h->log2_nbuckets, b->log2_pages);
+	v += extract_bits (hash, log2_nbuckets, b->log2_pages);
     }
 
   if (is_add)
@@ -902,6 +1233,7 @@ static_always_inline int BV (clib_bihash_add_del_inline_with_hash) (
 		  BV (clib_bihash_alloc_lock) (h);
 		  /* Note: v currently points into the middle of the bucket */
 		  v = BV (clib_bihash_get_value) (h, tmp_b.offset);
+		  BV (bucket_pages_update) (h, &tmp_b, 0 /* is_add */);
 		  BV (value_free) (h, v, tmp_b.log2_pages);
 		  BV (clib_bihash_alloc_unlock) (h);
 		  BV (clib_bihash_increment_stat) (h, BIHASH_STAT_del_free,
@@ -932,7 +1264,7 @@ static_always_inline int BV (clib_bihash_add_del_inline_with_hash) (
   BV (clib_bihash_increment_stat) (h, BIHASH_STAT_splits, 1);
 
   new_v = BV (split_and_rehash) (h, working_copy, old_log2_pages,
-				 new_log2_pages);
+				 new_log2_pages, log2_nbuckets);
   if (new_v == 0)
     {
     try_resplit:
@@ -940,7 +1272,7 @@ static_always_inline int BV (clib_bihash_add_del_inline_with_hash) (
       new_log2_pages++;
       /* Try re-splitting. If that fails, fall back to linear search */
       new_v = BV (split_and_rehash) (h, working_copy, old_log2_pages,
-				     new_log2_pages);
+				     new_log2_pages, log2_nbuckets);
       if (new_v == 0)
 	{
 	mark_linear:
@@ -964,7 +1296,7 @@ static_always_inline int BV (clib_bihash_add_del_inline_with_hash) (
   if (mark_bucket_linear)
     limit <<= new_log2_pages;
   else
-    new_v += extract_bits (new_hash, h->log2_nbuckets, new_log2_pages);
+    new_v += extract_bits (new_hash, log2_nbuckets, new_log2_pages);
 
   for (i = 0; i < limit; i++)
     {
@@ -999,6 +1331,7 @@ expand_ok:
   tmp_b.lock = 0;
   CLIB_MEMORY_STORE_BARRIER ();
   b->as_u64 = tmp_b.as_u64;
+  BV (bucket_pages_update) (h, &tmp_b, 1 /* is_add */);
 
 #if BIHASH_KVP_AT_BUCKET_LEVEL
   if (h->saved_bucket.log2_pages > 0)
@@ -1007,12 +1340,15 @@ expand_ok:
 
       /* free the old bucket, except at the bucket level if so configured */
       v = BV (clib_bihash_get_value) (h, h->saved_bucket.offset);
+      BV (bucket_pages_update) (h, &h->saved_bucket, 0 /* is_add */);
       BV (value_free) (h, v, h->saved_bucket.log2_pages);
 
 #if BIHASH_KVP_AT_BUCKET_LEVEL
     }
 #endif
 
+  /* Bucket chains getting long, time to grow the table? */
+  BV (resize_check) (h);
 
   BV (clib_bihash_alloc_unlock) (h);
   return (0);
@@ -1082,7 +1418,7 @@ u8 *BV (format_bihash) (u8 * s, va_list * args)
     return format (s, "    empty, uninitialized");
 #endif
 
-  for (i = 0; i < h->nbuckets; i++)
+  for (i = 0; i < BV (clib_bihash_geometry_nbuckets) (h->geometry); i++)
     {
       b = BV (clib_bihash_get_bucket) (h, i);
       if (BV (clib_bihash_bucket_is_empty) (b))
@@ -1159,6 +1495,21 @@ u8 *BV (format_bihash) (u8 * s, va_list * args)
     }
 
   s = format (s, "    %lld linear search buckets\n", linear_buckets);
+
+  s = format (s, "    probe depth, buckets by log2 pages:");
+  for (i = 0; i < BIHASH_PROBE_DEPTH_N_BINS - 1; i++)
+    s = format (s, " [%d] %lld", i, h->probe_depth_histogram[i]);
+  s = format (s, " [linear] %lld\n",
+	      h->probe_depth_histogram[BIHASH_PROBE_DEPTH_N_BINS - 1]);
+
+  if (h->max_log2_nbuckets > h->log2_nbuckets || h->resize_pending)
+    s = format (s, "    resize: %u buckets, %lld split, max %llu\n",
+		h->nbuckets,
+		BV (clib_bihash_geometry_split_cursor) (h->geometry),
+		1ULL << h->max_log2_nbuckets);
+
+  if (h->numa_node != CLIB_U8_MAX)
+    s = format (s, "    numa node %u\n", h->numa_node);
   if (BIHASH_USE_HEAP)
     {
       BVT (clib_bihash_alloc_chunk) * c = h->chunks;
@@ -1204,7 +1555,7 @@ void BV (clib_bihash_foreach_key_value_pair)
     return;
 #endif
 
-  for (i = 0; i < h->nbuckets; i++)
+  for (i = 0; i < BV (clib_bihash_geometry_nbuckets) (h->geometry); i++)
     {
       b = BV (clib_bihash_get_bucket) (h, i);
       if (BV (clib_bihash_bucket_is_empty) (b))
@@ -48,6 +48,26 @@
 #define BIHASH_LOG2_HUGEPAGE_SIZE 21
 #endif
 
+/* Resizable tables start doubling at this many pages per bucket */
+#ifndef BIHASH_RESIZE_PAGES_PER_BUCKET
+#define BIHASH_RESIZE_PAGES_PER_BUCKET 2
+#endif
+
+/* Buckets split by each add while a resize is in progress */
+#ifndef BIHASH_RESIZE_BUCKETS_PER_ADD
+#define BIHASH_RESIZE_BUCKETS_PER_ADD 4
+#endif
+
+/* Keys between the hash / bucket prefetch, data prefetch and compare
+ * stages of clib_bihash_search_batch */
+#ifndef BIHASH_SEARCH_BATCH_STRIDE
+#define BIHASH_SEARCH_BATCH_STRIDE 4
+#endif
+
+/* Same for all types, "show bihash" and the stats segment rely on it */
+#define BIHASH_PROBE_DEPTH_N_BINS 8
+#define BIHASH_GEOMETRY_LOG2_BITS 8
+
 #define _bv(a,b) a##b
 #define __bv(a,b) _bv(a,b)
 #define BV(a) __bv(a,BIHASH_TYPE)
@@ -151,10 +171,35 @@ BVS (clib_bihash)
 
   u32 nbuckets;
   u32 log2_nbuckets;
+
+  /*
+   * Bucket array geometry as seen by readers: log2 of the base number of
+   * buckets in the low BIHASH_GEOMETRY_LOG2_BITS, online resize split
+   * cursor above. Buckets below the cursor have been split in two, their
+   * upper halves live at bucket index + base number of buckets.
+   */
+  volatile u64 geometry;
+
+  /* Online resize state, serialized by resize_lock */
+  u32 max_log2_nbuckets;
+  volatile u32 resize_lock;
+  u8 resize_pending;
+  BVT (clib_bihash_kv) * resize_kvs[2];
+
+  /* Number of value pages currently attached to buckets */
+  u64 n_bucket_pages;
+
+  /*
+   * Buckets with value pages by log2 pages, linear search buckets in the
+   * last bin. Buckets using only their bucket level kvps are not counted.
+   */
+  u64 probe_depth_histogram[BIHASH_PROBE_DEPTH_N_BINS];
+
   u64 memory_size;
   u8 *name;
   format_function_t *fmt_fn;
   void *heap;
+  u8 numa_node;
   BVT (clib_bihash_alloc_chunk) * chunks;
 
   u64 *freelists;
@@ -194,6 +239,11 @@ typedef struct
   format_function_t *kvp_fmt_fn;
   u8 instantiate_immediately;
   u8 dont_add_to_all_bihash_list;
+  /* allow the bucket array to grow online up to max_nbuckets */
+  u32 max_nbuckets;
+  /* allocate from numa_node's heap / memory instead of the current one */
+  u8 use_numa_node;
+  u8 numa_node;
 } BVT (clib_bihash_init2_args);
 
 extern void **clib_all_bihashes;
@@ -381,6 +431,8 @@ void BV (clib_bihash_foreach_key_value_pair) (BVT (clib_bihash) * h,
 					      BV
 					      (clib_bihash_foreach_key_value_pair_cb)
 					      cb, void *arg);
+int BV (clib_bihash_grow) (BVT (clib_bihash) * h);
+int BV (clib_bihash_resize_step) (BVT (clib_bihash) * h, u32 n_buckets);
 void *clib_all_bihash_set_heap (void);
 void clib_bihash_copied (void *dst, void *src);
 
@@ -388,21 +440,70 @@ format_function_t BV (format_bihash);
 format_function_t BV (format_bihash_kvp);
 format_function_t BV (format_bihash_lru);
 
+static inline u32 BV (clib_bihash_geometry_log2_nbuckets) (u64 geometry)
+{
+  return geometry & pow2_mask (BIHASH_GEOMETRY_LOG2_BITS);
+}
+
+static inline u64 BV (clib_bihash_geometry_split_cursor) (u64 geometry)
+{
+  return geometry >> BIHASH_GEOMETRY_LOG2_BITS;
+}
+
+/* Number of buckets in use, including the split halves of a resize */
+static inline u64 BV (clib_bihash_geometry_nbuckets) (u64 geometry)
+{
+  return (1ULL << BV (clib_bihash_geometry_log2_nbuckets) (geometry)) +
+	 BV (clib_bihash_geometry_split_cursor) (geometry);
+}
+
 static inline
 BVT (clib_bihash_bucket) *
-BV (clib_bihash_get_bucket) (BVT (clib_bihash) * h, u64 hash)
+BV (clib_bihash_get_bucket_with_geometry) (BVT (clib_bihash) * h, u64 hash,
+					   u64 geometry, u32 * log2_nbuckets)
 {
+  u32 log2 = BV (clib_bihash_geometry_log2_nbuckets) (geometry);
+  u64 index = hash & pow2_mask (log2);
+
+  /* Already split by an online resize, use one more bit of the hash */
+  if (PREDICT_FALSE (index < BV (clib_bihash_geometry_split_cursor)
+		     (geometry)))
+    index = hash & pow2_mask (++log2);
+
+  *log2_nbuckets = log2;
+
 #if BIHASH_KVP_AT_BUCKET_LEVEL
   uword offset;
-  offset = (hash & (h->nbuckets - 1));
-  offset = offset * (sizeof (BVT (clib_bihash_bucket))
-		     + (BIHASH_KVP_PER_PAGE * sizeof (BVT (clib_bihash_kv))));
+  offset = index * (sizeof (BVT (clib_bihash_bucket))
+		    + (BIHASH_KVP_PER_PAGE * sizeof (BVT (clib_bihash_kv))));
   return ((BVT (clib_bihash_bucket) *) (((u8 *) h->buckets) + offset));
 #else
-  return h->buckets + (hash & (h->nbuckets - 1));
+  return h->buckets + index;
 #endif
 }
 
+static inline
+BVT (clib_bihash_bucket) *
+BV (clib_bihash_get_bucket) (BVT (clib_bihash) * h, u64 hash)
+{
+  u32 log2_nbuckets;
+
+  return BV (clib_bihash_get_bucket_with_geometry) (h, hash, h->geometry,
+						    &log2_nbuckets);
+}
+
+/*
+ * Lookups that miss while a resize is splitting their bucket retry with
+ * the new geometry. Splits publish the upper half bucket before, and the
+ * lower half after advancing the cursor.
+ */
+static inline int BV (clib_bihash_geometry_changed) (BVT (clib_bihash) * h,
+						     u64 geometry)
+{
+  __atomic_thread_fence (__ATOMIC_ACQUIRE);
+  return h->geometry != geometry;
+}
+
 static inline int BV (clib_bihash_search_inline_with_hash)
   (BVT (clib_bihash) * h, u64 hash, BVT (clib_bihash_kv) * key_result)
 {
@@ -410,6 +511,8 @@ static inline int BV (clib_bihash_search_inline_with_hash)
   BVT (clib_bihash_value) * v;
   BVT (clib_bihash_bucket) * b;
   int i, limit;
+  u64 geometry;
+  u32 log2_nbuckets;
 
   static const BVT (clib_bihash_bucket) mask = {
     .linear_search = 1,
@@ -421,10 +524,13 @@ static inline int BV (clib_bihash_search_inline_with_hash)
     return -1;
 #endif
 
-  b = BV (clib_bihash_get_bucket) (h, hash);
+again:
+  geometry = clib_atomic_load_acq_n (&h->geometry);
+  b = BV (clib_bihash_get_bucket_with_geometry) (h, hash, geometry,
+						 &log2_nbuckets);
 
   if (PREDICT_FALSE (BV (clib_bihash_bucket_is_empty) (b)))
-    return -1;
+    goto miss;
 
   if (PREDICT_FALSE (b->lock))
     {
@@ -443,7 +549,7 @@ static inline int BV (clib_bihash_search_inline_with_hash)
       if (PREDICT_FALSE (b->linear_search))
 	limit <<= b->log2_pages;
       else
-	v += extract_bits (hash, h->log2_nbuckets, b->log2_pages);
+	v += extract_bits (hash, log2_nbuckets, b->log2_pages);
     }
 
   for (i = 0; i < limit; i++)
@@ -452,11 +558,15 @@ static inline int BV (clib_bihash_search_inline_with_hash)
 	{
 	  rv = v->kvp[i];
 	  if (BV (clib_bihash_is_free) (&rv))
-	    return -1;
+	    goto miss;
 	  *key_result = rv;
 	  return 0;
 	}
     }
+
+miss:
+  if (PREDICT_FALSE (BV (clib_bihash_geometry_changed) (h, geometry)))
+    goto again;
   return -1;
 }
 
@@ -483,13 +593,15 @@ static inline void BV (clib_bihash_prefetch_data)
 {
   BVT (clib_bihash_value) * v;
   BVT (clib_bihash_bucket) * b;
+  u32 log2_nbuckets;
 
 #if BIHASH_LAZY_INSTANTIATE
   if (PREDICT_FALSE (h->instantiated == 0))
     return;
 #endif
 
-  b = BV (clib_bihash_get_bucket) (h, hash);
+  b = BV (clib_bihash_get_bucket_with_geometry) (h, hash, h->geometry,
+						 &log2_nbuckets);
 
   if (PREDICT_FALSE (BV (clib_bihash_bucket_is_empty) (b)))
     return;
@@ -497,7 +609,7 @@ static inline void BV (clib_bihash_prefetch_data)
   v = BV (clib_bihash_get_value) (h, b->offset);
 
   if (PREDICT_FALSE (b->log2_pages && b->linear_search == 0))
-    v += extract_bits (hash, h->log2_nbuckets, b->log2_pages);
+    v += extract_bits (hash, log2_nbuckets, b->log2_pages);
 
   CLIB_PREFETCH (v, BIHASH_KVP_PER_PAGE * sizeof (BVT (clib_bihash_kv)),
 		 LOAD);
@@ -511,6 +623,8 @@ static inline int BV (clib_bihash_search_inline_2_with_hash)
   BVT (clib_bihash_value) * v;
   BVT (clib_bihash_bucket) * b;
   int i, limit;
+  u64 geometry;
+  u32 log2_nbuckets;
 
   static const BVT (clib_bihash_bucket) mask = {
     .linear_search = 1,
@@ -524,10 +638,13 @@ static inline int BV (clib_bihash_search_inline_2_with_hash)
     return -1;
 #endif
 
-  b = BV (clib_bihash_get_bucket) (h, hash);
+again:
+  geometry = clib_atomic_load_acq_n (&h->geometry);
+  b = BV (clib_bihash_get_bucket_with_geometry) (h, hash, geometry,
+						 &log2_nbuckets);
 
   if (PREDICT_FALSE (BV (clib_bihash_bucket_is_empty) (b)))
-    return -1;
+    goto miss;
 
   if (PREDICT_FALSE (b->lock))
     {
@@ -546,7 +663,7 @@ static inline int BV (clib_bihash_search_inline_2_with_hash)
       if (PREDICT_FALSE (b->linear_search))
 	limit <<= b->log2_pages;
       else
-	v += extract_bits (hash, h->log2_nbuckets, b->log2_pages);
+	v += extract_bits (hash, log2_nbuckets, b->log2_pages);
     }
 
   for (i = 0; i < limit; i++)
@@ -555,11 +672,15 @@ static inline int BV (clib_bihash_search_inline_2_with_hash)
 	{
 	  rv = v->kvp[i];
 	  if (BV (clib_bihash_is_free) (&rv))
-	    return -1;
+	    goto miss;
 	  *valuep = rv;
 	  return 0;
 	}
     }
+
+miss:
+  if (PREDICT_FALSE (BV (clib_bihash_geometry_changed) (h, geometry)))
+    goto again;
   return -1;
 }
 
@@ -576,6 +697,77 @@ static inline int BV (clib_bihash_search_inline_2)
 }
 
 
+/**
+ * Search for n_keys keys, e.g. one per packet of a frame.
+ *
+ * Pipelines the lookups: while key i is compared, the data page of key
+ * i + BIHASH_SEARCH_BATCH_STRIDE is prefetched and key i + 2 *
+ * BIHASH_SEARCH_BATCH_STRIDE is hashed and has its bucket prefetched.
+ * Callers that already have the hashes pass them in hashes, otherwise
+ * hashes must be 0 and they are computed here.
+ *
+ * values[i] is written on a hit and left untouched on a miss, so it can
+ * be the same array as search_keys. is_found[i] is set to 1 on a hit and
+ * 0 on a miss.
+ *
+ * @return number of keys found
+ */
+static inline u32 BV (clib_bihash_search_batch)
+  (BVT (clib_bihash) * h, BVT (clib_bihash_kv) * search_keys, u64 * hashes,
+   BVT (clib_bihash_kv) * values, u8 * is_found, u32 n_keys)
+{
+  const u32 stride = BIHASH_SEARCH_BATCH_STRIDE;
+  u64 ring[4 * BIHASH_SEARCH_BATCH_STRIDE], *hp = hashes;
+  u32 i, j, mask = ~0, n_found = 0;
+
+#if BIHASH_LAZY_INSTANTIATE
+  if (PREDICT_FALSE (h->instantiated == 0))
+    {
+      clib_memset_u8 (is_found, 0, n_keys);
+      return 0;
+    }
+#endif
+
+  /* Without caller provided hashes, keep the ones in flight in a ring */
+  if (hashes == 0)
+    {
+      hp = ring;
+      mask = ARRAY_LEN (ring) - 1;
+    }
+
+  for (j = 0; j < clib_min (n_keys, 2 * stride); j++)
+    {
+      if (hashes == 0)
+	hp[j & mask] = BV (clib_bihash_hash) (search_keys + j);
+      BV (clib_bihash_prefetch_bucket) (h, hp[j & mask]);
+    }
+
+  for (j = 0; j < clib_min (n_keys, stride); j++)
+    BV (clib_bihash_prefetch_data) (h, hp[j & mask]);
+
+  for (i = 0; i < n_keys; i++)
+    {
+      j = i + 2 * stride;
+      if (j < n_keys)
+	{
+	  if (hashes == 0)
+	    hp[j & mask] = BV (clib_bihash_hash) (search_keys + j);
+	  BV (clib_bihash_prefetch_bucket) (h, hp[j & mask]);
+	}
+
+      j = i + stride;
+      if (j < n_keys)
+	BV (clib_bihash_prefetch_data) (h, hp[j & mask]);
+
+      is_found[i] = BV (clib_bihash_search_inline_2_with_hash)
+	(h, hp[i & mask], search_keys + i, values + i) == 0;
+      n_found += is_found[i];
+    }
+
+  return n_found;
+}
+
+
 #endif /* __included_bihash_template_h__ */
 
 /** @endcond */
@@ -0,0 +1,179 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#ifndef __clib_chacha20_h__
+#define __clib_chacha20_h__
+
+#include <vppinfra/clib.h>
+#include <vppinfra/vector.h>
+#include <vppinfra/string.h>
+
+/*
+ * ChaCha20 as specified in RFC 8439.
+ *
+ * The state is kept vertically: vector i holds state word i of
+ * N_CHACHA20_LANES independent blocks. Each lane has its own key, counter
+ * and nonce, so lanes can be consecutive blocks of one message or blocks
+ * of different messages, whatever keeps all lanes busy.
+ */
+
+#if defined(CLIB_HAVE_VEC512)
+#define N_CHACHA20_LANES 16
+typedef u32x16 chacha20_word_t;
+#elif defined(CLIB_HAVE_VEC256)
+#define N_CHACHA20_LANES 8
+typedef u32x8 chacha20_word_t;
+#elif defined(CLIB_HAVE_VEC128)
+#define N_CHACHA20_LANES 4
+typedef u32x4 chacha20_word_t;
+#else
+#define N_CHACHA20_LANES 1
+typedef u32 chacha20_word_t;
+#endif
+
+#define CHACHA20_BLOCK_BYTES 64
+
+/* input words 4 - 15 (key, counter, nonce) of each lane */
+typedef struct
+{
+  u32 w[12][N_CHACHA20_LANES] __clib_aligned (sizeof (chacha20_word_t));
+} chacha20_lanes_t;
+
+typedef struct
+{
+  u8 b[N_CHACHA20_LANES][CHACHA20_BLOCK_BYTES] __clib_aligned (64);
+} chacha20_keystream_t;
+
+static_always_inline void
+chacha20_lane_set (chacha20_lanes_t *l, u32 lane, const u8 *key,
+		   const u8 *nonce, u32 counter)
+{
+  for (int i = 0; i < 8; i++)
+    l->w[i][lane] = ((u32u *) key)[i];
+  l->w[8][lane] = counter;
+  for (int i = 0; i < 3; i++)
+    l->w[9 + i][lane] = ((u32u *) nonce)[i];
+}
+
+#define chacha20_rotl(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+#define chacha20_quarter_round(x, a, b, c, d)                                 \
+  do                                                                          \
+    {                                                                         \
+      x[a] += x[b];                                                           \
+      x[d] = chacha20_rotl (x[d] ^ x[a], 16);                                 \
+      x[c] += x[d];                                                           \
+      x[b] = chacha20_rotl (x[b] ^ x[c], 12);                                 \
+      x[a] += x[b];                                                           \
+      x[d] = chacha20_rotl (x[d] ^ x[a], 8);                                  \
+      x[c] += x[d];                                                           \
+      x[b] = chacha20_rotl (x[b] ^ x[c], 7);                                  \
+    }                                                                         \
+  while (0)
+
+/* One keystream block for each lane */
+static_always_inline void
+chacha20_blocks (const chacha20_lanes_t *l, chacha20_keystream_t *ks)
+{
+  chacha20_word_t x[16], s[16];
+
+  /* "expand 32-byte k" */
+  s[0] = (chacha20_word_t) {} + 0x61707865;
+  s[1] = (chacha20_word_t) {} + 0x3320646e;
+  s[2] = (chacha20_word_t) {} + 0x79622d32;
+  s[3] = (chacha20_word_t) {} + 0x6b206574;
+  for (int i = 0; i < 12; i++)
+    s[4 + i] = *(chacha20_word_t *) l->w[i];
+
+  for (int i = 0; i < 16; i++)
+    x[i] = s[i];
+
+  for (int i = 0; i < 10; i++)
+    {
+      chacha20_quarter_round (x, 0, 4, 8, 12);
+      chacha20_quarter_round (x, 1, 5, 9, 13);
+      chacha20_quarter_round (x, 2, 6, 10, 14);
+      chacha20_quarter_round (x, 3, 7, 11, 15);
+      chacha20_quarter_round (x, 0, 5, 10, 15);
+      chacha20_quarter_round (x, 1, 6, 11, 12);
+      chacha20_quarter_round (x, 2, 7, 8, 13);
+      chacha20_quarter_round (x, 3, 4, 9, 14);
+    }
+
+  for (int i = 0; i < 16; i++)
+    x[i] += s[i];
+
+  /* back to one block per lane */
+#if N_CHACHA20_LANES == 16
+  u32x16_transpose (x);
+  for (int i = 0; i < 16; i++)
+    *(u32x16u *) ks->b[i] = x[i];
+#elif N_CHACHA20_LANES == 8
+  u32x8_transpose (x);
+  u32x8_transpose (x + 8);
+  for (int i = 0; i < 8; i++)
+    {
+      *(u32x8u *) ks->b[i] = x[i];
+      *(u32x8u *) (ks->b[i] + 32) = x[8 + i];
+    }
+#elif N_CHACHA20_LANES == 4
+  for (int i = 0; i < 16; i += 4)
+    {
+      u32x4_transpose (x + i);
+      for (int j = 0; j < 4; j++)
+	*(u32x4u *) (ks->b[j] + 4 * i) = x[i + j];
+    }
+#else
+  for (int i = 0; i < 16; i++)
+    ((u32u *) ks->b[0])[i] = x[i];
+#endif
+}
+
+static_always_inline void
+chacha20_xor_block (u8 *dst, const u8 *src, const u8 *ks, u32 n_bytes)
+{
+  if (PREDICT_TRUE (n_bytes == CHACHA20_BLOCK_BYTES))
+    {
+      for (int i = 0; i < 4; i++)
+	((u8x16u *) dst)[i] = ((u8x16u *) src)[i] ^ ((u8x16 *) ks)[i];
+      return;
+    }
+
+  for (u32 i = 0; i < n_bytes; i++)
+    dst[i] = src[i] ^ ks[i];
+}
+
+/*
+ * Encrypt or decrypt n_bytes of one message, starting at block counter.
+ * Consecutive blocks go to consecutive lanes.
+ */
+static_always_inline void
+clib_chacha20 (const u8 *key, const u8 *nonce, u32 counter, const u8 *src,
+	       u8 *dst, u32 n_bytes)
+{
+  chacha20_lanes_t l;
+  chacha20_keystream_t ks;
+
+  for (int i = 0; i < N_CHACHA20_LANES; i++)
+    chacha20_lane_set (&l, i, key, nonce, counter + i);
+
+  while (n_bytes)
+    {
+      chacha20_blocks (&l, &ks);
+
+      for (int i = 0; i < N_CHACHA20_LANES && n_bytes; i++)
+	{
+	  u32 n = clib_min (n_bytes, CHACHA20_BLOCK_BYTES);
+	  chacha20_xor_block (dst, src, ks.b[i], n);
+	  src += n;
+	  dst += n;
+	  n_bytes -= n;
+	}
+
+      for (int i = 0; i < N_CHACHA20_LANES; i++)
+	l.w[8][i] += N_CHACHA20_LANES;
+    }
+}
+
+#endif /* __clib_chacha20_h__ */
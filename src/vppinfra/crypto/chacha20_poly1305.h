@@ -0,0 +1,190 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#ifndef __clib_chacha20_poly1305_h__
+#define __clib_chacha20_poly1305_h__
+
+#include <vppinfra/crypto/chacha20.h>
+#include <vppinfra/crypto/poly1305.h>
+
+/*
+ * ChaCha20-Poly1305 AEAD (RFC 8439) over a batch of messages.
+ *
+ * Messages are processed N_CHACHA20_LANES at a time: first the one-time
+ * Poly1305 keys of all of them are generated in one pass, then all their
+ * keystream blocks are packed back to back into the lanes, so short
+ * packets of different flows keep all lanes busy the same way one long
+ * packet does.
+ */
+
+typedef struct
+{
+  const u8 *key;   /* 32 bytes */
+  const u8 *nonce; /* 12 bytes */
+  const u8 *aad;
+  const u8 *src;
+  u8 *dst;
+  u8 *tag; /* written on encrypt, compared on decrypt */
+  u32 aad_len;
+  u32 len;
+  u8 tag_len;
+  u8 is_bad; /* set on decrypt if tag doesn't match, dst is not written */
+} clib_chacha20_poly1305_op_t;
+
+static_always_inline void
+chacha20_poly1305_mac (const u8 *poly_key, const u8 *aad, u32 aad_len,
+		       const u8 *ct, u32 len, u8 *tag)
+{
+  static const u8 zero[16] = {};
+  clib_poly1305_ctx ctx;
+  u64 lens[2] = { clib_host_to_little_u64 (aad_len),
+		  clib_host_to_little_u64 (len) };
+
+  clib_poly1305_init (&ctx, poly_key);
+  clib_poly1305_update (&ctx, aad, aad_len);
+  clib_poly1305_update (&ctx, zero, (16 - aad_len) & 15);
+  clib_poly1305_update (&ctx, ct, len);
+  clib_poly1305_update (&ctx, zero, (16 - len) & 15);
+  clib_poly1305_update (&ctx, (u8 *) lens, sizeof (lens));
+  clib_poly1305_final (&ctx, tag);
+}
+
+static_always_inline void
+chacha20_poly1305_ops_inline (clib_chacha20_poly1305_op_t *ops, u32 n_ops,
+			      int is_enc)
+{
+  chacha20_lanes_t l;
+  chacha20_keystream_t ks;
+
+  while (n_ops)
+    {
+      u32 n = clib_min (n_ops, N_CHACHA20_LANES);
+      u8 *dst[N_CHACHA20_LANES];
+      const u8 *src[N_CHACHA20_LANES];
+      u32 n_bytes[N_CHACHA20_LANES];
+      u8 poly_keys[N_CHACHA20_LANES][32];
+      u32 op = 0, off = 0, lane;
+
+      /* block 0 of each message is its Poly1305 key */
+      for (u32 i = 0; i < n; i++)
+	{
+	  chacha20_lane_set (&l, i, ops[i].key, ops[i].nonce, 0);
+	  ops[i].is_bad = 0;
+	}
+      chacha20_blocks (&l, &ks);
+
+      if (!is_enc)
+	for (u32 i = 0; i < n; i++)
+	  {
+	    u8 tag[16], diff = 0;
+	    chacha20_poly1305_mac (ks.b[i], ops[i].aad, ops[i].aad_len,
+				   ops[i].src, ops[i].len, tag);
+	    for (u32 j = 0; j < ops[i].tag_len; j++)
+	      diff |= tag[j] ^ ops[i].tag[j];
+	    ops[i].is_bad = diff != 0;
+	  }
+
+      /* keep the poly keys, ks is reused for the payload */
+      if (is_enc)
+	for (u32 i = 0; i < n; i++)
+	  clib_memcpy_fast (poly_keys[i], ks.b[i], 32);
+
+      /* payload blocks of all messages, counter from 1 */
+      while (1)
+	{
+	  for (lane = 0; lane < N_CHACHA20_LANES; lane++)
+	    {
+	      while (op < n && (off >= ops[op].len || ops[op].is_bad))
+		{
+		  op++;
+		  off = 0;
+		}
+
+	      if (op == n)
+		break;
+
+	      chacha20_lane_set (&l, lane, ops[op].key, ops[op].nonce,
+				 1 + off / CHACHA20_BLOCK_BYTES);
+	      src[lane] = ops[op].src + off;
+	      dst[lane] = ops[op].dst + off;
+	      n_bytes[lane] =
+		clib_min (ops[op].len - off, CHACHA20_BLOCK_BYTES);
+	      off += CHACHA20_BLOCK_BYTES;
+	    }
+
+	  if (lane == 0)
+	    break;
+
+	  chacha20_blocks (&l, &ks);
+	  for (u32 i = 0; i < lane; i++)
+	    chacha20_xor_block (dst[i], src[i], ks.b[i], n_bytes[i]);
+	}
+
+      if (is_enc)
+	for (u32 i = 0; i < n; i++)
+	  {
+	    u8 tag[16];
+	    chacha20_poly1305_mac (poly_keys[i], ops[i].aad, ops[i].aad_len,
+				   ops[i].dst, ops[i].len, tag);
+	    clib_memcpy_fast (ops[i].tag, tag, ops[i].tag_len);
+	  }
+
+      ops += n;
+      n_ops -= n;
+    }
+}
+
+static_always_inline void
+clib_chacha20_poly1305_enc_ops (clib_chacha20_poly1305_op_t *ops, u32 n_ops)
+{
+  chacha20_poly1305_ops_inline (ops, n_ops, /* is_enc */ 1);
+}
+
+static_always_inline void
+clib_chacha20_poly1305_dec_ops (clib_chacha20_poly1305_op_t *ops, u32 n_ops)
+{
+  chacha20_poly1305_ops_inline (ops, n_ops, /* is_enc */ 0);
+}
+
+static_always_inline void
+clib_chacha20_poly1305_enc (const u8 *key, const u8 *nonce, const u8 *aad,
+			    u32 aad_len, const u8 *src, u32 len, u8 *dst,
+			    u8 *tag)
+{
+  clib_chacha20_poly1305_op_t op = {
+    .key = key,
+    .nonce = nonce,
+    .aad = aad,
+    .aad_len = aad_len,
+    .src = src,
+    .dst = dst,
+    .len = len,
+    .tag = tag,
+    .tag_len = 16,
+  };
+  clib_chacha20_poly1305_enc_ops (&op, 1);
+}
+
+/* returns 1 if tag matches */
+static_always_inline int
+clib_chacha20_poly1305_dec (const u8 *key, const u8 *nonce, const u8 *aad,
+			    u32 aad_len, const u8 *src, u32 len, u8 *dst,
+			    const u8 *tag)
+{
+  clib_chacha20_poly1305_op_t op = {
+    .key = key,
+    .nonce = nonce,
+    .aad = aad,
+    .aad_len = aad_len,
+    .src = src,
+    .dst = dst,
+    .len = len,
+    .tag = (u8 *) tag,
+    .tag_len = 16,
+  };
+  clib_chacha20_poly1305_dec_ops (&op, 1);
+  return op.is_bad == 0;
+}
+
+#endif /* __clib_chacha20_poly1305_h__ */
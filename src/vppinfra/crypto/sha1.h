@@ -0,0 +1,278 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#ifndef included_sha1_h
+#define included_sha1_h
+
+#include <vppinfra/clib.h>
+#include <vppinfra/vector.h>
+#include <vppinfra/string.h>
+
+/*
+ * SHA-1 (FIPS 180-4). Only kept around for HMAC-SHA1-96 used by legacy
+ * IPsec tunnels, don't use it for anything new.
+ */
+
+#define CLIB_SHA1_BLOCK_SIZE  64
+#define CLIB_SHA1_DIGEST_SIZE 20
+
+#define SHA1_ROTL(x, y) ((x << y) | (x >> (32 - y)))
+
+#define SHA1_F0(b, c, d) (d ^ (b & (c ^ d)))
+#define SHA1_F1(b, c, d) (b ^ c ^ d)
+#define SHA1_F2(b, c, d) ((b & c) | (d & (b | c)))
+#define SHA1_F3(b, c, d) (b ^ c ^ d)
+
+#define SHA1_K0 0x5a827999
+#define SHA1_K1 0x6ed9eba1
+#define SHA1_K2 0x8f1bbcdc
+#define SHA1_K3 0xca62c1d6
+
+/* w is a 16 entry circular buffer, valid for rounds >= 16 */
+#define SHA1_MSG_SCHED(w, i)                                                  \
+  {                                                                           \
+    __typeof__ (w[0]) x = w[(i - 3) & 15] ^ w[(i - 8) & 15];                  \
+    x ^= w[(i - 14) & 15] ^ w[i & 15];                                        \
+    w[i & 15] = SHA1_ROTL (x, 1);                                             \
+  }
+
+#define SHA1_TRANSFORM(s, w, i, f, k)                                         \
+  {                                                                           \
+    __typeof__ (s[0]) t;                                                      \
+    t = SHA1_ROTL (s[0], 5) + f (s[1], s[2], s[3]) + s[4] + k + w[i & 15];    \
+    s[4] = s[3];                                                              \
+    s[3] = s[2];                                                              \
+    s[2] = SHA1_ROTL (s[1], 30);                                              \
+    s[1] = s[0];                                                              \
+    s[0] = t;                                                                 \
+  }
+
+/* all 80 rounds of a block, w holds message words 0 - 15 on entry */
+#define SHA1_ROUNDS(s, w)                                                     \
+  {                                                                           \
+    for (int i = 0; i < 16; i++)                                              \
+      SHA1_TRANSFORM (s, w, i, SHA1_F0, SHA1_K0);                             \
+    for (int i = 16; i < 20; i++)                                             \
+      {                                                                       \
+	SHA1_MSG_SCHED (w, i);                                                \
+	SHA1_TRANSFORM (s, w, i, SHA1_F0, SHA1_K0);                           \
+      }                                                                       \
+    for (int i = 20; i < 40; i++)                                             \
+      {                                                                       \
+	SHA1_MSG_SCHED (w, i);                                                \
+	SHA1_TRANSFORM (s, w, i, SHA1_F1, SHA1_K1);                           \
+      }                                                                       \
+    for (int i = 40; i < 60; i++)                                             \
+      {                                                                       \
+	SHA1_MSG_SCHED (w, i);                                                \
+	SHA1_TRANSFORM (s, w, i, SHA1_F2, SHA1_K2);                           \
+      }                                                                       \
+    for (int i = 60; i < 80; i++)                                             \
+      {                                                                       \
+	SHA1_MSG_SCHED (w, i);                                                \
+	SHA1_TRANSFORM (s, w, i, SHA1_F3, SHA1_K3);                           \
+      }                                                                       \
+  }
+
+static const u32 sha1_h[5] = { 0x67452301, 0xefcdab89, 0x98badcfe,
+			       0x10325476, 0xc3d2e1f0 };
+
+typedef struct
+{
+  u64 total_bytes;
+  u16 n_pending;
+  u32 h[5];
+  union
+  {
+    u8 as_u8[CLIB_SHA1_BLOCK_SIZE];
+    u64 as_u64[CLIB_SHA1_BLOCK_SIZE / sizeof (u64)];
+  } pending;
+} clib_sha1_ctx_t;
+
+static_always_inline void
+clib_sha1_block (u32 h[5], const u8 *msg, uword n_blocks)
+{
+  u32 w[16], s[5];
+
+  for (; n_blocks; msg += CLIB_SHA1_BLOCK_SIZE, n_blocks--)
+    {
+      for (int i = 0; i < 5; i++)
+	s[i] = h[i];
+
+      for (int i = 0; i < 16; i++)
+	w[i] = clib_net_to_host_u32 (((u32u *) msg)[i]);
+
+      SHA1_ROUNDS (s, w);
+
+      for (int i = 0; i < 5; i++)
+	h[i] += s[i];
+    }
+}
+
+static_always_inline void
+clib_sha1_init (clib_sha1_ctx_t *ctx)
+{
+  *ctx = (clib_sha1_ctx_t){};
+  for (int i = 0; i < 5; i++)
+    ctx->h[i] = sha1_h[i];
+}
+
+static_always_inline void
+clib_sha1_update (clib_sha1_ctx_t *ctx, const u8 *msg, uword n_bytes)
+{
+  uword n_blocks;
+
+  if (ctx->n_pending)
+    {
+      uword n_left = CLIB_SHA1_BLOCK_SIZE - ctx->n_pending;
+      if (n_bytes < n_left)
+	{
+	  clib_memcpy_fast (ctx->pending.as_u8 + ctx->n_pending, msg, n_bytes);
+	  ctx->n_pending += n_bytes;
+	  return;
+	}
+      clib_memcpy_fast (ctx->pending.as_u8 + ctx->n_pending, msg, n_left);
+      clib_sha1_block (ctx->h, ctx->pending.as_u8, 1);
+      ctx->n_pending = 0;
+      ctx->total_bytes += CLIB_SHA1_BLOCK_SIZE;
+      n_bytes -= n_left;
+      msg += n_left;
+    }
+
+  if ((n_blocks = n_bytes / CLIB_SHA1_BLOCK_SIZE))
+    {
+      clib_sha1_block (ctx->h, msg, n_blocks);
+      n_bytes -= n_blocks * CLIB_SHA1_BLOCK_SIZE;
+      msg += n_blocks * CLIB_SHA1_BLOCK_SIZE;
+      ctx->total_bytes += n_blocks * CLIB_SHA1_BLOCK_SIZE;
+    }
+
+  if (n_bytes)
+    {
+      clib_memset_u8 (ctx->pending.as_u8, 0, CLIB_SHA1_BLOCK_SIZE);
+      clib_memcpy_fast (ctx->pending.as_u8, msg, n_bytes);
+    }
+  ctx->n_pending = n_bytes;
+}
+
+static_always_inline void
+clib_sha1_final (clib_sha1_ctx_t *ctx, u8 *digest)
+{
+  ctx->total_bytes += ctx->n_pending;
+  if (ctx->n_pending == 0)
+    clib_memset (ctx->pending.as_u8, 0, CLIB_SHA1_BLOCK_SIZE);
+  ctx->pending.as_u8[ctx->n_pending] = 0x80;
+
+  if (ctx->n_pending + sizeof (u64) + sizeof (u8) > CLIB_SHA1_BLOCK_SIZE)
+    {
+      clib_sha1_block (ctx->h, ctx->pending.as_u8, 1);
+      clib_memset (ctx->pending.as_u8, 0, CLIB_SHA1_BLOCK_SIZE);
+    }
+
+  ctx->pending.as_u64[CLIB_SHA1_BLOCK_SIZE / 8 - 1] =
+    clib_net_to_host_u64 (ctx->total_bytes * 8);
+  clib_sha1_block (ctx->h, ctx->pending.as_u8, 1);
+
+  for (int i = 0; i < 5; i++)
+    ((u32u *) digest)[i] = clib_net_to_host_u32 (ctx->h[i]);
+}
+
+static_always_inline void
+clib_sha1 (const u8 *msg, uword len, u8 *digest)
+{
+  clib_sha1_ctx_t ctx;
+  clib_sha1_init (&ctx);
+  clib_sha1_update (&ctx, msg, len);
+  clib_sha1_final (&ctx, digest);
+}
+
+/*
+ *  HMAC
+ */
+
+typedef struct
+{
+  u32 ipad_h[5];
+  u32 opad_h[5];
+} clib_sha1_hmac_key_data_t;
+
+typedef struct
+{
+  clib_sha1_ctx_t ipad_ctx;
+  clib_sha1_ctx_t opad_ctx;
+} clib_sha1_hmac_ctx_t;
+
+static_always_inline void
+clib_sha1_hmac_key_data (const u8 *key, uword key_len,
+			 clib_sha1_hmac_key_data_t *kd)
+{
+  u8 data[CLIB_SHA1_BLOCK_SIZE] = {};
+  u8 ikey[CLIB_SHA1_BLOCK_SIZE];
+  u8 okey[CLIB_SHA1_BLOCK_SIZE];
+
+  /* key is longer than block, calculate hash of key */
+  if (key_len > CLIB_SHA1_BLOCK_SIZE)
+    clib_sha1 (key, key_len, data);
+  else
+    clib_memcpy_fast (data, key, key_len);
+
+  for (int i = 0; i < CLIB_SHA1_BLOCK_SIZE / sizeof (u64); i++)
+    {
+      ((u64u *) ikey)[i] = ((u64u *) data)[i] ^ 0x3636363636363636UL;
+      ((u64u *) okey)[i] = ((u64u *) data)[i] ^ 0x5c5c5c5c5c5c5c5cUL;
+    }
+
+  for (int i = 0; i < 5; i++)
+    kd->ipad_h[i] = kd->opad_h[i] = sha1_h[i];
+
+  clib_sha1_block (kd->ipad_h, ikey, 1);
+  clib_sha1_block (kd->opad_h, okey, 1);
+}
+
+static_always_inline void
+clib_sha1_hmac_init (clib_sha1_hmac_ctx_t *ctx,
+		     const clib_sha1_hmac_key_data_t *kd)
+{
+  *ctx = (clib_sha1_hmac_ctx_t){
+    .ipad_ctx.total_bytes = CLIB_SHA1_BLOCK_SIZE,
+    .opad_ctx.total_bytes = CLIB_SHA1_BLOCK_SIZE,
+  };
+
+  for (int i = 0; i < 5; i++)
+    {
+      ctx->ipad_ctx.h[i] = kd->ipad_h[i];
+      ctx->opad_ctx.h[i] = kd->opad_h[i];
+    }
+}
+
+static_always_inline void
+clib_sha1_hmac_update (clib_sha1_hmac_ctx_t *ctx, const u8 *msg, uword len)
+{
+  clib_sha1_update (&ctx->ipad_ctx, msg, len);
+}
+
+static_always_inline void
+clib_sha1_hmac_final (clib_sha1_hmac_ctx_t *ctx, u8 *digest)
+{
+  u8 i_digest[CLIB_SHA1_DIGEST_SIZE];
+
+  clib_sha1_final (&ctx->ipad_ctx, i_digest);
+  clib_sha1_update (&ctx->opad_ctx, i_digest, sizeof (i_digest));
+  clib_sha1_final (&ctx->opad_ctx, digest);
+}
+
+static_always_inline void
+clib_hmac_sha1 (const u8 *key, uword key_len, const u8 *msg, uword len,
+		u8 *digest)
+{
+  clib_sha1_hmac_ctx_t ctx;
+  clib_sha1_hmac_key_data_t kd;
+
+  clib_sha1_hmac_key_data (key, key_len, &kd);
+  clib_sha1_hmac_init (&ctx, &kd);
+  clib_sha1_hmac_update (&ctx, msg, len);
+  clib_sha1_hmac_final (&ctx, digest);
+}
+
+#endif /* included_sha1_h */
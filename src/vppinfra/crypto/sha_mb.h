@@ -0,0 +1,272 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#ifndef included_sha_mb_h
+#define included_sha_mb_h
+
+#include <vppinfra/crypto/sha1.h>
+#include <vppinfra/crypto/sha2.h>
+
+/*
+ * HMAC-SHA1 and HMAC-SHA224/256 over a batch of independent messages.
+ *
+ * Each SIMD lane hashes a different message, state is kept vertically
+ * (vector i holds state word i of all lanes). When a lane finishes its
+ * message the next message of the batch is started in it, so lanes stay
+ * busy even when message lengths differ. Inner padding, outer hash and
+ * digest check are done per lane in the same loop, so the whole HMAC of
+ * a batch is one pass over the data.
+ */
+
+#if defined(CLIB_HAVE_VEC512)
+#define N_SHA_MB_LANES 16
+typedef u32x16 sha_mb_word_t;
+#elif defined(CLIB_HAVE_VEC256)
+#define N_SHA_MB_LANES 8
+typedef u32x8 sha_mb_word_t;
+#elif defined(CLIB_HAVE_VEC128)
+#define N_SHA_MB_LANES 4
+typedef u32x4 sha_mb_word_t;
+#else
+#define N_SHA_MB_LANES 1
+typedef u32 sha_mb_word_t;
+#endif
+
+#define SHA_MB_BLOCK_SIZE 64
+
+typedef enum
+{
+  CLIB_SHA_MB_SHA1,
+  CLIB_SHA_MB_SHA224,
+  CLIB_SHA_MB_SHA256,
+} clib_sha_mb_type_t;
+
+typedef struct
+{
+  const u8 *src;
+  /* precomputed inner and outer state, ipad_h/opad_h of
+   * clib_sha1_hmac_key_data_t or clib_sha2_hmac_key_data_t */
+  const u32 *ipad_h;
+  const u32 *opad_h;
+  u8 *digest; /* written, or compared if check is set */
+  u32 len;
+  u8 digest_len; /* truncated digest length, 0 for full */
+  u8 check;
+  u8 is_bad; /* set if check is set and digest doesn't match */
+} clib_sha_mb_hmac_op_t;
+
+static_always_inline void
+sha_mb_load_block (sha_mb_word_t w[16], const u8 *p[N_SHA_MB_LANES])
+{
+#if N_SHA_MB_LANES == 16
+  for (int i = 0; i < 16; i++)
+    w[i] = *(u32x16u *) p[i];
+  u32x16_transpose (w);
+  for (int i = 0; i < 16; i++)
+    w[i] = u32x16_byte_swap (w[i]);
+#elif N_SHA_MB_LANES == 8
+  for (int i = 0; i < 8; i++)
+    {
+      w[i] = *(u32x8u *) p[i];
+      w[8 + i] = *(u32x8u *) (p[i] + 32);
+    }
+  u32x8_transpose (w);
+  u32x8_transpose (w + 8);
+  for (int i = 0; i < 16; i++)
+    w[i] = u32x8_byte_swap (w[i]);
+#elif N_SHA_MB_LANES == 4
+  for (int i = 0; i < 16; i += 4)
+    {
+      for (int j = 0; j < 4; j++)
+	w[i + j] = *(u32x4u *) (p[j] + 4 * i);
+      u32x4_transpose (w + i);
+    }
+  for (int i = 0; i < 16; i++)
+    w[i] = u32x4_byte_swap (w[i]);
+#else
+  for (int i = 0; i < 16; i++)
+    w[i] = clib_net_to_host_u32 (((u32u *) p[0])[i]);
+#endif
+}
+
+static_always_inline void
+sha_mb_compress (u32 h[8][N_SHA_MB_LANES], const u8 *p[N_SHA_MB_LANES],
+		 int is_sha1)
+{
+  sha_mb_word_t w[64], s[8];
+
+  sha_mb_load_block (w, p);
+
+  for (int i = 0; i < 8; i++)
+    s[i] = *(sha_mb_word_t *) h[i];
+
+  if (is_sha1)
+    {
+      SHA1_ROUNDS (s, w);
+      for (int i = 0; i < 5; i++)
+	*(sha_mb_word_t *) h[i] += s[i];
+      return;
+    }
+
+  for (int i = 0; i < 16; i++)
+    SHA256_TRANSFORM (s, w, i, clib_sha2_256_k[i]);
+
+  for (int i = 16; i < 64; i++)
+    {
+      SHA256_MSG_SCHED (w, i);
+      SHA256_TRANSFORM (s, w, i, clib_sha2_256_k[i]);
+    }
+
+  for (int i = 0; i < 8; i++)
+    *(sha_mb_word_t *) h[i] += s[i];
+}
+
+static_always_inline void
+sha_mb_hmac_inline (clib_sha_mb_hmac_op_t *ops, u32 n_ops,
+		    clib_sha_mb_type_t type)
+{
+  static const u8 idle_block[SHA_MB_BLOCK_SIZE];
+  const int is_sha1 = type == CLIB_SHA_MB_SHA1;
+  const u32 n_words = is_sha1 ? 5 : 8;
+  const u32 digest_size = is_sha1		  ? CLIB_SHA1_DIGEST_SIZE :
+			  type == CLIB_SHA_MB_SHA224 ? 28 :
+						       32;
+  u32 h[8][N_SHA_MB_LANES] __clib_aligned (sizeof (sha_mb_word_t)) = {};
+  /* padded last inner block(s) of each lane, reused for outer block */
+  u8 tail[N_SHA_MB_LANES][2 * SHA_MB_BLOCK_SIZE];
+  const u8 *p[N_SHA_MB_LANES];
+  clib_sha_mb_hmac_op_t *op[N_SHA_MB_LANES];
+  u32 n_full[N_SHA_MB_LANES];
+  u8 n_tail[N_SHA_MB_LANES];
+  u8 is_outer[N_SHA_MB_LANES];
+  u32 next = 0, n_active = 0;
+
+  for (u32 l = 0; l < N_SHA_MB_LANES; l++)
+    {
+      op[l] = 0;
+      p[l] = idle_block;
+    }
+
+  while (1)
+    {
+      /* start new messages in idle lanes */
+      for (u32 l = 0; l < N_SHA_MB_LANES && next < n_ops; l++)
+	{
+	  clib_sha_mb_hmac_op_t *o;
+	  u32 r;
+	  u64 n_bits;
+
+	  if (op[l])
+	    continue;
+
+	  o = op[l] = ops + next++;
+	  o->is_bad = 0;
+	  n_full[l] = o->len / SHA_MB_BLOCK_SIZE;
+	  r = o->len % SHA_MB_BLOCK_SIZE;
+	  n_tail[l] = r + 1 + sizeof (u64) > SHA_MB_BLOCK_SIZE ? 2 : 1;
+	  is_outer[l] = 0;
+
+	  clib_memset_u8 (tail[l], 0, sizeof (tail[l]));
+	  clib_memcpy_fast (tail[l], o->src + o->len - r, r);
+	  tail[l][r] = 0x80;
+	  n_bits = (SHA_MB_BLOCK_SIZE + (u64) o->len) * 8;
+	  *(u64u *) (tail[l] + n_tail[l] * SHA_MB_BLOCK_SIZE - 8) =
+	    clib_host_to_net_u64 (n_bits);
+
+	  p[l] = n_full[l] ? o->src : tail[l];
+	  for (u32 i = 0; i < n_words; i++)
+	    h[i][l] = o->ipad_h[i];
+	  n_active++;
+	}
+
+      if (n_active == 0)
+	break;
+
+      sha_mb_compress (h, p, is_sha1);
+
+      for (u32 l = 0; l < N_SHA_MB_LANES; l++)
+	{
+	  clib_sha_mb_hmac_op_t *o = op[l];
+	  u8 digest[32];
+	  u32 n;
+
+	  if (o == 0)
+	    continue;
+
+	  if (is_outer[l] == 0)
+	    {
+	      if (n_full[l])
+		{
+		  if (--n_full[l])
+		    p[l] += SHA_MB_BLOCK_SIZE;
+		  else
+		    p[l] = tail[l];
+		  continue;
+		}
+
+	      if (--n_tail[l])
+		{
+		  p[l] += SHA_MB_BLOCK_SIZE;
+		  continue;
+		}
+
+	      /* inner hash done, outer block is opad state + inner digest */
+	      clib_memset_u8 (tail[l], 0, SHA_MB_BLOCK_SIZE);
+	      for (u32 i = 0; i < digest_size / 4; i++)
+		{
+		  ((u32u *) tail[l])[i] = clib_host_to_net_u32 (h[i][l]);
+		  h[i][l] = o->opad_h[i];
+		}
+	      for (u32 i = digest_size / 4; i < n_words; i++)
+		h[i][l] = o->opad_h[i];
+	      tail[l][digest_size] = 0x80;
+	      *(u64u *) (tail[l] + SHA_MB_BLOCK_SIZE - 8) =
+		clib_host_to_net_u64 ((SHA_MB_BLOCK_SIZE + digest_size) * 8);
+	      p[l] = tail[l];
+	      is_outer[l] = 1;
+	      continue;
+	    }
+
+	  for (u32 i = 0; i < digest_size / 4; i++)
+	    ((u32u *) digest)[i] = clib_host_to_net_u32 (h[i][l]);
+
+	  n = o->digest_len ? o->digest_len : digest_size;
+	  if (o->check)
+	    o->is_bad = memcmp (o->digest, digest, n) != 0;
+	  else
+	    clib_memcpy_fast (o->digest, digest, n);
+
+	  op[l] = 0;
+	  p[l] = idle_block;
+	  n_active--;
+	}
+    }
+}
+
+static_always_inline void
+clib_sha_mb_hmac (clib_sha_mb_hmac_op_t *ops, u32 n_ops,
+		  clib_sha_mb_type_t type)
+{
+  sha_mb_hmac_inline (ops, n_ops, type);
+}
+
+static_always_inline void
+clib_sha1_mb_hmac (clib_sha_mb_hmac_op_t *ops, u32 n_ops)
+{
+  sha_mb_hmac_inline (ops, n_ops, CLIB_SHA_MB_SHA1);
+}
+
+static_always_inline void
+clib_sha224_mb_hmac (clib_sha_mb_hmac_op_t *ops, u32 n_ops)
+{
+  sha_mb_hmac_inline (ops, n_ops, CLIB_SHA_MB_SHA224);
+}
+
+static_always_inline void
+clib_sha256_mb_hmac (clib_sha_mb_hmac_op_t *ops, u32 n_ops)
+{
+  sha_mb_hmac_inline (ops, n_ops, CLIB_SHA_MB_SHA256);
+}
+
+#endif /* included_sha_mb_h */
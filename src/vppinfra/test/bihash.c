@@ -0,0 +1,194 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#include <vppinfra/format.h>
+#include <vppinfra/random.h>
+#include <vppinfra/test/test.h>
+#include <vppinfra/bihash_16_8.h>
+#include <vppinfra/bihash_template.h>
+
+#ifndef CLIB_MARCH_VARIANT
+#include <vppinfra/bihash_template.c>
+#endif
+
+#define N_LOOKUPS 1024
+
+static void
+test_bihash_key (clib_bihash_kv_16_8_t *kv, u64 i)
+{
+  kv->key[0] = i;
+  kv->key[1] = i ^ 0x5555555555555555ULL;
+  kv->value = i + 1;
+}
+
+static void
+test_bihash_table_init (clib_bihash_16_8_t *h, u32 n_entries)
+{
+  clib_bihash_kv_16_8_t kv;
+
+  clib_bihash_init_16_8 (h, "test", clib_max (n_entries >> 2, 64),
+			 (uword) clib_max (n_entries, 1024) << 7);
+  for (u32 i = 0; i < n_entries; i++)
+    {
+      test_bihash_key (&kv, i);
+      clib_bihash_add_del_16_8 (h, &kv, 1 /* is_add */);
+    }
+}
+
+/* Every other key is in the table */
+static clib_bihash_kv_16_8_t *
+test_bihash_lookup_keys (u32 n_entries, u32 n_keys)
+{
+  clib_bihash_kv_16_8_t *kvs;
+  u32 seed = 0x1234;
+
+  kvs = test_mem_alloc (n_keys * sizeof (kvs[0]));
+  for (u32 i = 0; i < n_keys; i++)
+    test_bihash_key (kvs + i, (random_u32 (&seed) % n_entries) +
+				(i & 1) * n_entries);
+  return kvs;
+}
+
+static clib_error_t *
+test_clib_bihash_search_batch (clib_error_t *err)
+{
+  clib_bihash_16_8_t _h = {}, *h = &_h;
+  clib_bihash_kv_16_8_t *kvs, *vals, kv;
+  u32 n_entries = 4096, n_found;
+  u64 hashes[N_LOOKUPS];
+  u8 is_found[N_LOOKUPS];
+
+  test_bihash_table_init (h, n_entries);
+  kvs = test_bihash_lookup_keys (n_entries, N_LOOKUPS);
+  vals = test_mem_alloc (N_LOOKUPS * sizeof (vals[0]));
+
+  for (int with_hashes = 0; with_hashes < 2; with_hashes++)
+    {
+      for (u32 i = 0; i < N_LOOKUPS; i++)
+	{
+	  hashes[i] = clib_bihash_hash_16_8 (kvs + i);
+	  vals[i].value = ~0ULL;
+	}
+
+      /* Odd sizes exercise the pipeline prologue and epilogue */
+      n_found = clib_bihash_search_batch_16_8 (
+	h, kvs, with_hashes ? hashes : 0, vals, is_found, N_LOOKUPS - 3);
+
+      for (u32 i = 0; i < N_LOOKUPS - 3; i++)
+	{
+	  int rv = clib_bihash_search_16_8 (h, kvs + i, &kv);
+	  if ((rv == 0) != is_found[i])
+	    {
+	      err = clib_error_return (err,
+				       "key %u: search returned %d, batch "
+				       "search is_found %u",
+				       i, rv, is_found[i]);
+	      goto done;
+	    }
+	  if (rv == 0 && vals[i].value != kv.value)
+	    {
+	      err = clib_error_return (err,
+				       "key %u: value 0x%lx, expected 0x%lx", i,
+				       vals[i].value, kv.value);
+	      goto done;
+	    }
+	  if (rv && vals[i].value != ~0ULL)
+	    {
+	      err = clib_error_return (err, "key %u: value written on miss",
+				       i);
+	      goto done;
+	    }
+	  n_found -= !rv;
+	}
+
+      if (n_found)
+	{
+	  err = clib_error_return (err, "wrong number of keys found");
+	  goto done;
+	}
+    }
+
+  /* In place search, values overwrite the keys */
+  clib_memcpy_fast (vals, kvs, N_LOOKUPS * sizeof (vals[0]));
+  clib_bihash_search_batch_16_8 (h, vals, 0, vals, is_found, 1);
+  if (is_found[0] && (vals[0].key[0] != kvs[0].key[0] ||
+		      vals[0].value != kvs[0].key[0] + 1))
+    err = clib_error_return (err, "in place search failed");
+
+done:
+  clib_bihash_free_16_8 (h);
+  return err;
+}
+
+static void
+test_bihash_perf (test_perf_t *tp, int batch)
+{
+  clib_bihash_16_8_t _h = {}, *h = &_h;
+  clib_bihash_kv_16_8_t *kvs, *vals;
+  u32 n = tp->n_ops, n_entries = tp->arg0;
+  u8 *is_found = test_mem_alloc (n);
+
+  test_bihash_table_init (h, n_entries);
+  kvs = test_bihash_lookup_keys (n_entries, n);
+  vals = test_mem_alloc (n * sizeof (vals[0]));
+
+  test_perf_event_enable (tp);
+  if (batch)
+    {
+      /* One frame at a time, as a dataplane node would */
+      for (u32 i = 0; i < n; i += 256)
+	clib_bihash_search_batch_16_8 (h, kvs + i, 0, vals + i, is_found + i,
+				       clib_min (256, n - i));
+    }
+  else
+    {
+      for (u32 i = 0; i < n; i++)
+	is_found[i] = clib_bihash_search_16_8 (h, kvs + i, vals + i) == 0;
+    }
+  test_perf_event_disable (tp);
+
+  clib_bihash_free_16_8 (h);
+}
+
+void __test_perf_fn
+perftest_scalar (test_perf_t *tp)
+{
+  test_bihash_perf (tp, 0);
+}
+
+void __test_perf_fn
+perftest_batch (test_perf_t *tp)
+{
+  test_bihash_perf (tp, 1);
+}
+
+REGISTER_TEST (clib_bihash_search_batch) = {
+  .name = "clib_bihash_search_batch",
+  .fn = test_clib_bihash_search_batch,
+  .perf_tests = PERF_TESTS (
+    { .name = "scalar, 4k entries",
+      .n_ops = 65536,
+      .arg0 = 4096,
+      .fn = perftest_scalar },
+    { .name = "batch, 4k entries",
+      .n_ops = 65536,
+      .arg0 = 4096,
+      .fn = perftest_batch },
+    { .name = "scalar, 256k entries",
+      .n_ops = 65536,
+      .arg0 = 256 << 10,
+      .fn = perftest_scalar },
+    { .name = "batch, 256k entries",
+      .n_ops = 65536,
+      .arg0 = 256 << 10,
+      .fn = perftest_batch },
+    { .name = "scalar, 4M entries",
+      .n_ops = 65536,
+      .arg0 = 4 << 20,
+      .fn = perftest_scalar },
+    { .name = "batch, 4M entries",
+      .n_ops = 65536,
+      .arg0 = 4 << 20,
+      .fn = perftest_batch }),
+};
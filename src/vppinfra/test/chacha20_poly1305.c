@@ -0,0 +1,396 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#include <vppinfra/format.h>
+#include <vppinfra/test/test.h>
+#include <vppinfra/crypto/chacha20_poly1305.h>
+
+/* RFC 8439 2.4.2 and 2.8.2 plaintext */
+static const u8 sunscreen[114] = {
+  0x4c, 0x61, 0x64, 0x69, 0x65, 0x73, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x47,
+  0x65, 0x6e, 0x74, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x20, 0x6f, 0x66, 0x20,
+  0x74, 0x68, 0x65, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x20, 0x6f, 0x66,
+  0x20, 0x27, 0x39, 0x39, 0x3a, 0x20, 0x49, 0x66, 0x20, 0x49, 0x20, 0x63,
+  0x6f, 0x75, 0x6c, 0x64, 0x20, 0x6f, 0x66, 0x66, 0x65, 0x72, 0x20, 0x79,
+  0x6f, 0x75, 0x20, 0x6f, 0x6e, 0x6c, 0x79, 0x20, 0x6f, 0x6e, 0x65, 0x20,
+  0x74, 0x69, 0x70, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x74, 0x68, 0x65, 0x20,
+  0x66, 0x75, 0x74, 0x75, 0x72, 0x65, 0x2c, 0x20, 0x73, 0x75, 0x6e, 0x73,
+  0x63, 0x72, 0x65, 0x65, 0x6e, 0x20, 0x77, 0x6f, 0x75, 0x6c, 0x64, 0x20,
+  0x62, 0x65, 0x20, 0x69, 0x74, 0x2e
+};
+
+/* RFC 8439 2.4.2 */
+static const u8 tv_chacha20_key[32] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b,
+  0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+  0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+static const u8 tv_chacha20_nonce[12] = {
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4a, 0x00, 0x00, 0x00, 0x00
+};
+static const u8 tv_chacha20_ct[114] = {
+  0x6e, 0x2e, 0x35, 0x9a, 0x25, 0x68, 0xf9, 0x80, 0x41, 0xba, 0x07, 0x28,
+  0xdd, 0x0d, 0x69, 0x81, 0xe9, 0x7e, 0x7a, 0xec, 0x1d, 0x43, 0x60, 0xc2,
+  0x0a, 0x27, 0xaf, 0xcc, 0xfd, 0x9f, 0xae, 0x0b, 0xf9, 0x1b, 0x65, 0xc5,
+  0x52, 0x47, 0x33, 0xab, 0x8f, 0x59, 0x3d, 0xab, 0xcd, 0x62, 0xb3, 0x57,
+  0x16, 0x39, 0xd6, 0x24, 0xe6, 0x51, 0x52, 0xab, 0x8f, 0x53, 0x0c, 0x35,
+  0x9f, 0x08, 0x61, 0xd8, 0x07, 0xca, 0x0d, 0xbf, 0x50, 0x0d, 0x6a, 0x61,
+  0x56, 0xa3, 0x8e, 0x08, 0x8a, 0x22, 0xb6, 0x5e, 0x52, 0xbc, 0x51, 0x4d,
+  0x16, 0xcc, 0xf8, 0x06, 0x81, 0x8c, 0xe9, 0x1a, 0xb7, 0x79, 0x37, 0x36,
+  0x5a, 0xf9, 0x0b, 0xbf, 0x74, 0xa3, 0x5b, 0xe6, 0xb4, 0x0b, 0x8e, 0xed,
+  0xf2, 0x78, 0x5e, 0x42, 0x87, 0x4d
+};
+
+/* RFC 8439 2.8.2 */
+static const u8 tv_aead_key[32] = {
+  0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b,
+  0x8c, 0x8d, 0x8e, 0x8f, 0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+  0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f
+};
+static const u8 tv_aead_nonce[12] = {
+  0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47
+};
+static const u8 tv_aead_aad[12] = {
+  0x50, 0x51, 0x52, 0x53, 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7
+};
+static const u8 tv_aead_ct[114] = {
+  0xd3, 0x1a, 0x8d, 0x34, 0x64, 0x8e, 0x60, 0xdb, 0x7b, 0x86, 0xaf, 0xbc,
+  0x53, 0xef, 0x7e, 0xc2, 0xa4, 0xad, 0xed, 0x51, 0x29, 0x6e, 0x08, 0xfe,
+  0xa9, 0xe2, 0xb5, 0xa7, 0x36, 0xee, 0x62, 0xd6, 0x3d, 0xbe, 0xa4, 0x5e,
+  0x8c, 0xa9, 0x67, 0x12, 0x82, 0xfa, 0xfb, 0x69, 0xda, 0x92, 0x72, 0x8b,
+  0x1a, 0x71, 0xde, 0x0a, 0x9e, 0x06, 0x0b, 0x29, 0x05, 0xd6, 0xa5, 0xb6,
+  0x7e, 0xcd, 0x3b, 0x36, 0x92, 0xdd, 0xbd, 0x7f, 0x2d, 0x77, 0x8b, 0x8c,
+  0x98, 0x03, 0xae, 0xe3, 0x28, 0x09, 0x1b, 0x58, 0xfa, 0xb3, 0x24, 0xe4,
+  0xfa, 0xd6, 0x75, 0x94, 0x55, 0x85, 0x80, 0x8b, 0x48, 0x31, 0xd7, 0xbc,
+  0x3f, 0xf4, 0xde, 0xf0, 0x8e, 0x4b, 0x7a, 0x9d, 0xe5, 0x76, 0xd2, 0x65,
+  0x86, 0xce, 0xc6, 0x4b, 0x61, 0x16
+};
+static const u8 tv_aead_tag[16] = {
+  0x1a, 0xe1, 0x0b, 0x59, 0x4f, 0x09, 0xe2, 0x6a, 0x7e, 0x90, 0x2e, 0xcb,
+  0xd0, 0x60, 0x06, 0x91
+};
+
+/* key 0x00..0x1f, nonce 0x80..0x8b, aad 0x40..0x47, data 0x00, 0x01, ... */
+static const u8 inc_key[32] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b,
+  0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+  0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+static const u8 inc_nonce[12] = {
+  0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b
+};
+static const u8 inc_aad[8] = {
+  0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47
+};
+
+static const struct
+{
+  u16 n_bytes;
+  u8 tag[16];
+} inc_test_cases[] = {
+  { .n_bytes = 0,
+    .tag = { 0xb3, 0xdf, 0xe8, 0xd9, 0xbf, 0x17, 0xd5, 0x65,
+	     0x06, 0x03, 0xf1, 0x02, 0x9b, 0x72, 0x38, 0x3c } },
+  { .n_bytes = 1,
+    .tag = { 0x52, 0x95, 0x5c, 0x47, 0xbe, 0xeb, 0x2d, 0x38,
+	     0xc6, 0x15, 0x64, 0xa6, 0x49, 0xf7, 0xb6, 0xde } },
+  { .n_bytes = 15,
+    .tag = { 0x63, 0x64, 0x38, 0xba, 0x0e, 0x90, 0x51, 0x95,
+	     0x17, 0x77, 0xed, 0x7c, 0xa9, 0x50, 0xa1, 0x3f } },
+  { .n_bytes = 16,
+    .tag = { 0x1e, 0x96, 0xc0, 0xe5, 0x1f, 0xb9, 0x33, 0xdb,
+	     0x7f, 0x2d, 0xe0, 0x06, 0xab, 0x2d, 0x96, 0x2b } },
+  { .n_bytes = 17,
+    .tag = { 0x6c, 0x6d, 0x77, 0x09, 0x5d, 0x6b, 0x40, 0x8e,
+	     0xd3, 0xb5, 0x14, 0x82, 0x40, 0xd2, 0x3b, 0xd8 } },
+  { .n_bytes = 63,
+    .tag = { 0xef, 0xe8, 0x13, 0x72, 0x45, 0x6d, 0x44, 0x96,
+	     0x1c, 0x76, 0x7d, 0x0a, 0x95, 0x23, 0x46, 0xf2 } },
+  { .n_bytes = 64,
+    .tag = { 0x33, 0x99, 0xd8, 0x5c, 0x65, 0xcf, 0x4b, 0xbc,
+	     0xc2, 0xdc, 0xd8, 0x2e, 0x3b, 0xb9, 0x7d, 0x7f } },
+  { .n_bytes = 65,
+    .tag = { 0x8c, 0x4d, 0x68, 0x80, 0x0b, 0x6d, 0x87, 0x98,
+	     0x9e, 0x46, 0x4c, 0x0f, 0x2d, 0x19, 0xf8, 0xb0 } },
+  { .n_bytes = 127,
+    .tag = { 0x5a, 0x75, 0x48, 0x1f, 0x7c, 0x12, 0xd1, 0x2d,
+	     0xe8, 0x2d, 0xba, 0xb1, 0x76, 0xc1, 0xf8, 0xdf } },
+  { .n_bytes = 128,
+    .tag = { 0xe2, 0x28, 0x83, 0xa2, 0x44, 0xd5, 0x42, 0x6e,
+	     0x7c, 0x56, 0x85, 0x84, 0x1d, 0xc5, 0xe2, 0xaa } },
+  { .n_bytes = 129,
+    .tag = { 0xc7, 0x70, 0x35, 0x41, 0x5a, 0x8b, 0x74, 0x9c,
+	     0x77, 0xa6, 0xe1, 0x71, 0x95, 0xfb, 0xb8, 0x76 } },
+  { .n_bytes = 255,
+    .tag = { 0xcc, 0xc2, 0x98, 0x0e, 0x86, 0xd3, 0x6f, 0xa6,
+	     0x10, 0x5d, 0x6d, 0xa8, 0x30, 0xc3, 0xc1, 0xca } },
+  { .n_bytes = 256,
+    .tag = { 0x5c, 0x48, 0xe0, 0x4a, 0xda, 0x67, 0xae, 0xd2,
+	     0x4f, 0x93, 0xe8, 0x26, 0xf5, 0x08, 0xf0, 0x97 } },
+  { .n_bytes = 511,
+    .tag = { 0x6e, 0x0d, 0xd0, 0xec, 0xe8, 0x58, 0x05, 0x2a,
+	     0x5e, 0x87, 0xf2, 0x87, 0x6f, 0xba, 0xde, 0xa4 } },
+  { .n_bytes = 512,
+    .tag = { 0x80, 0x21, 0xb3, 0xcb, 0xd0, 0x36, 0xc8, 0xdf,
+	     0x17, 0x15, 0xc4, 0x25, 0x92, 0xff, 0x93, 0xc7 } },
+  { .n_bytes = 1024,
+    .tag = { 0xcd, 0x48, 0x12, 0x3a, 0x48, 0x65, 0xbd, 0x05,
+	     0x7f, 0xc8, 0x13, 0x5c, 0x68, 0xe9, 0xde, 0xa4 } },
+  { .n_bytes = 1500,
+    .tag = { 0x11, 0x51, 0x00, 0xc2, 0xe0, 0x05, 0x9f, 0x17,
+	     0xb1, 0x85, 0x4a, 0x27, 0x7c, 0x18, 0xbd, 0x37 } },
+};
+
+#define MAX_TEST_DATA_LEN 1536
+
+static clib_error_t *
+test_clib_chacha20 (clib_error_t *err)
+{
+  u8 ct[sizeof (sunscreen)];
+
+  clib_chacha20 (tv_chacha20_key, tv_chacha20_nonce, 1, sunscreen, ct,
+		 sizeof (sunscreen));
+
+  if (memcmp (ct, tv_chacha20_ct, sizeof (ct)) != 0)
+    return clib_error_return (err, "RFC8439 2.4.2: invalid ciphertext"
+				   "\nexp: %U\ncalc: %U",
+			      format_hexdump, tv_chacha20_ct, sizeof (ct),
+			      format_hexdump, ct, sizeof (ct));
+
+  return err;
+}
+
+void __test_perf_fn
+perftest_chacha20_var_sz (test_perf_t *tp)
+{
+  u32 n = tp->n_ops;
+  u8 *dst = test_mem_alloc (n);
+  u8 *src = test_mem_alloc_and_fill_inc_u8 (n, 0, 0);
+  u8 *key = test_mem_alloc_and_fill_inc_u8 (32, 0, 0);
+  u8 *nonce = test_mem_alloc_and_fill_inc_u8 (12, 0x80, 0);
+
+  test_perf_event_enable (tp);
+  clib_chacha20 (key, nonce, 1, src, dst, n);
+  test_perf_event_disable (tp);
+}
+
+REGISTER_TEST (clib_chacha20) = {
+  .name = "clib_chacha20",
+  .fn = test_clib_chacha20,
+  .perf_tests = PERF_TESTS ({ .name = "variable size (per byte)",
+			      .n_ops = 1424,
+			      .fn = perftest_chacha20_var_sz },
+			    { .name = "variable size (per byte)",
+			      .n_ops = 1 << 20,
+			      .fn = perftest_chacha20_var_sz }),
+};
+
+static clib_error_t *
+test_clib_chacha20_poly1305_enc (clib_error_t *err)
+{
+  clib_chacha20_poly1305_op_t ops[ARRAY_LEN (inc_test_cases)];
+  u8 pt[MAX_TEST_DATA_LEN];
+  u8 ct[MAX_TEST_DATA_LEN];
+  u8 *batch_ct[ARRAY_LEN (inc_test_cases)];
+  u8 batch_tag[ARRAY_LEN (inc_test_cases)][16];
+  u8 tag[16];
+
+  clib_chacha20_poly1305_enc (tv_aead_key, tv_aead_nonce, tv_aead_aad,
+			      sizeof (tv_aead_aad), sunscreen,
+			      sizeof (sunscreen), ct, tag);
+
+  if (memcmp (tag, tv_aead_tag, 16) != 0)
+    return clib_error_return (err, "RFC8439 2.8.2: invalid tag");
+
+  if (memcmp (ct, tv_aead_ct, sizeof (sunscreen)) != 0)
+    return clib_error_return (err, "RFC8439 2.8.2: invalid ciphertext");
+
+  for (int i = 0; i < sizeof (pt); i++)
+    pt[i] = i;
+
+  FOREACH_ARRAY_ELT (tc, inc_test_cases)
+    {
+      clib_chacha20_poly1305_enc (inc_key, inc_nonce, inc_aad,
+				  sizeof (inc_aad), pt, tc->n_bytes, ct, tag);
+
+      if (memcmp (tc->tag, tag, 16) != 0)
+	return clib_error_return (err, "incremental %u bytes: invalid tag",
+				  tc->n_bytes);
+    }
+
+  /* all sizes in one batch, spread over lanes */
+  for (int i = 0; i < ARRAY_LEN (inc_test_cases); i++)
+    {
+      batch_ct[i] = clib_mem_alloc (MAX_TEST_DATA_LEN);
+      ops[i] = (clib_chacha20_poly1305_op_t){
+	.key = inc_key,
+	.nonce = inc_nonce,
+	.aad = inc_aad,
+	.aad_len = sizeof (inc_aad),
+	.src = pt,
+	.dst = batch_ct[i],
+	.len = inc_test_cases[i].n_bytes,
+	.tag = batch_tag[i],
+	.tag_len = 16,
+      };
+    }
+
+  clib_chacha20_poly1305_enc_ops (ops, ARRAY_LEN (ops));
+
+  for (int i = 0; i < ARRAY_LEN (inc_test_cases); i++)
+    {
+      u32 n_bytes = inc_test_cases[i].n_bytes;
+
+      clib_chacha20_poly1305_enc (inc_key, inc_nonce, inc_aad,
+				  sizeof (inc_aad), pt, n_bytes, ct, tag);
+
+      if (memcmp (inc_test_cases[i].tag, batch_tag[i], 16) != 0)
+	err = clib_error_return (err, "batch %u bytes: invalid tag", n_bytes);
+      else if (memcmp (ct, batch_ct[i], n_bytes) != 0)
+	err = clib_error_return (err, "batch %u bytes: invalid ciphertext",
+				 n_bytes);
+      clib_mem_free (batch_ct[i]);
+    }
+
+  return err;
+}
+
+void __test_perf_fn
+perftest_chacha20_poly1305_enc_var_sz (test_perf_t *tp)
+{
+  u32 n = tp->n_ops;
+  u8 *dst = test_mem_alloc (n);
+  u8 *src = test_mem_alloc_and_fill_inc_u8 (n, 0, 0);
+  u8 *tag = test_mem_alloc (16);
+  u8 *key = test_mem_alloc_and_fill_inc_u8 (32, 0, 0);
+  u8 *nonce = test_mem_alloc_and_fill_inc_u8 (12, 0x80, 0);
+
+  test_perf_event_enable (tp);
+  clib_chacha20_poly1305_enc (key, nonce, 0, 0, src, n, dst, tag);
+  test_perf_event_disable (tp);
+}
+
+/* n_ops packets of 128 bytes, all in one batch */
+void __test_perf_fn
+perftest_chacha20_poly1305_enc_batch_128byte (test_perf_t *tp)
+{
+  u32 n = tp->n_ops;
+  clib_chacha20_poly1305_op_t *ops = test_mem_alloc (n * sizeof (ops[0]));
+  u8 *dst = test_mem_alloc (n * 128);
+  u8 *src = test_mem_alloc_and_fill_inc_u8 (n * 128, 0, 0);
+  u8 *tags = test_mem_alloc (n * 16);
+  u8 *keys = test_mem_alloc_and_fill_inc_u8 (n * 32, 0, 0);
+  u8 *nonces = test_mem_alloc_and_fill_inc_u8 (n * 12, 0x80, 0);
+
+  for (u32 i = 0; i < n; i++)
+    ops[i] = (clib_chacha20_poly1305_op_t){
+      .key = keys + i * 32,
+      .nonce = nonces + i * 12,
+      .src = src + i * 128,
+      .dst = dst + i * 128,
+      .len = 128,
+      .tag = tags + i * 16,
+      .tag_len = 16,
+    };
+
+  test_perf_event_enable (tp);
+  clib_chacha20_poly1305_enc_ops (ops, n);
+  test_perf_event_disable (tp);
+}
+
+REGISTER_TEST (clib_chacha20_poly1305_enc) = {
+  .name = "clib_chacha20_poly1305_enc",
+  .fn = test_clib_chacha20_poly1305_enc,
+  .perf_tests = PERF_TESTS (
+    { .name = "variable size (per byte)",
+      .n_ops = 1424,
+      .fn = perftest_chacha20_poly1305_enc_var_sz },
+    { .name = "variable size (per byte)",
+      .n_ops = 1 << 20,
+      .fn = perftest_chacha20_poly1305_enc_var_sz },
+    { .name = "batch (128 byte)",
+      .n_ops = 256,
+      .fn = perftest_chacha20_poly1305_enc_batch_128byte }),
+};
+
+static clib_error_t *
+test_clib_chacha20_poly1305_dec (clib_error_t *err)
+{
+  clib_chacha20_poly1305_op_t ops[ARRAY_LEN (inc_test_cases)];
+  u8 pt[MAX_TEST_DATA_LEN];
+  u8 ct[MAX_TEST_DATA_LEN];
+  u8 out[MAX_TEST_DATA_LEN];
+  u8 tag[16];
+
+  if (!clib_chacha20_poly1305_dec (tv_aead_key, tv_aead_nonce, tv_aead_aad,
+				   sizeof (tv_aead_aad), tv_aead_ct,
+				   sizeof (tv_aead_ct), out, tv_aead_tag))
+    return clib_error_return (err, "RFC8439 2.8.2: invalid tag");
+
+  if (memcmp (out, sunscreen, sizeof (sunscreen)) != 0)
+    return clib_error_return (err, "RFC8439 2.8.2: invalid plaintext");
+
+  clib_memcpy_fast (tag, tv_aead_tag, 16);
+  tag[15] ^= 1;
+  if (clib_chacha20_poly1305_dec (tv_aead_key, tv_aead_nonce, tv_aead_aad,
+				  sizeof (tv_aead_aad), tv_aead_ct,
+				  sizeof (tv_aead_ct), out, tag))
+    return clib_error_return (err, "RFC8439 2.8.2: bad tag accepted");
+
+  for (int i = 0; i < sizeof (pt); i++)
+    pt[i] = i;
+
+  /* ciphertext of every size is a prefix of the longest one */
+  clib_chacha20_poly1305_enc (inc_key, inc_nonce, inc_aad, sizeof (inc_aad),
+			      pt, sizeof (ct), ct, tag);
+
+  FOREACH_ARRAY_ELT (tc, inc_test_cases)
+    {
+      if (!clib_chacha20_poly1305_dec (inc_key, inc_nonce, inc_aad,
+				       sizeof (inc_aad), ct, tc->n_bytes, out,
+				       tc->tag))
+	return clib_error_return (err, "incremental %u bytes: invalid tag",
+				  tc->n_bytes);
+
+      if (memcmp (out, pt, tc->n_bytes) != 0)
+	return clib_error_return (err,
+				  "incremental %u bytes: invalid plaintext",
+				  tc->n_bytes);
+    }
+
+  /* whole batch, every third op with a bad tag */
+  u8 bad_tag[16] = {};
+  for (int i = 0; i < ARRAY_LEN (inc_test_cases); i++)
+    ops[i] = (clib_chacha20_poly1305_op_t){
+      .key = inc_key,
+      .nonce = inc_nonce,
+      .aad = inc_aad,
+      .aad_len = sizeof (inc_aad),
+      .src = ct,
+      .dst = clib_mem_alloc (MAX_TEST_DATA_LEN),
+      .len = inc_test_cases[i].n_bytes,
+      .tag = i % 3 ? (u8 *) inc_test_cases[i].tag : bad_tag,
+      .tag_len = 16,
+    };
+
+  clib_chacha20_poly1305_dec_ops (ops, ARRAY_LEN (ops));
+
+  for (int i = 0; i < ARRAY_LEN (ops); i++)
+    {
+      if (ops[i].is_bad != (i % 3 == 0))
+	err = clib_error_return (err, "batch %u bytes: wrong tag status",
+				 ops[i].len);
+      else if (!ops[i].is_bad && memcmp (ops[i].dst, pt, ops[i].len) != 0)
+	err = clib_error_return (err, "batch %u bytes: invalid plaintext",
+				 ops[i].len);
+      clib_mem_free (ops[i].dst);
+    }
+
+  return err;
+}
+
+REGISTER_TEST (clib_chacha20_poly1305_dec) = {
+  .name = "clib_chacha20_poly1305_dec",
+  .fn = test_clib_chacha20_poly1305_dec,
+};
@@ -4,6 +4,7 @@
 
 #include <vppinfra/format.h>
 #include <vppinfra/test/test.h>
+#include <vppinfra/random.h>
 #include <vppinfra/vector/mask_compare.h>
 
 __test_funct_fn void
@@ -137,3 +138,70 @@ REGISTER_TEST (clib_mask_compare_u64) = {
   .name = "clib_mask_compare_u64",
   .fn = test_clib_mask_compare_u64,
 };
+
+__test_funct_fn u16
+clib_mask_compare_u32_x16_masked_wrapper (u32 v, u32 m, u32 *a)
+{
+  return clib_mask_compare_u32_x16_masked (v, m, a);
+}
+
+__test_funct_fn u16
+clib_mask_compare_u32_x16_range_wrapper (u32 first, u32 last, u32 *a)
+{
+  return clib_mask_compare_u32_x16_range (first, last, a);
+}
+
+static clib_error_t *
+test_clib_mask_compare_u32_x16 (clib_error_t *err)
+{
+  u32 array[16];
+  u32 seed = 0xdeadbeef;
+  u16 mask, expected;
+  u32 i, j;
+
+  for (i = 0; i < 1000; i++)
+    {
+      u32 m = random_u32 (&seed);
+      u32 v = random_u32 (&seed) & m;
+      u32 first = random_u32 (&seed) & 0xffff;
+      u32 last = first + (random_u32 (&seed) & 0xff);
+
+      for (j = 0; j < 16; j++)
+	{
+	  array[j] = random_u32 (&seed);
+	  /* make a few of the elements match */
+	  if (j & 1)
+	    array[j] = (array[j] & ~m) | v;
+	  if (j & 2)
+	    array[j] = first + (array[j] & 0x1ff) - 0x80;
+	}
+
+      expected = 0;
+      for (j = 0; j < 16; j++)
+	if ((array[j] & m) == v)
+	  expected |= 1 << j;
+      mask = clib_mask_compare_u32_x16_masked_wrapper (v, m, array);
+      if (mask != expected)
+	return clib_error_return (err,
+				  "masked compare v 0x%x m 0x%x is 0x%x, "
+				  "expected 0x%x",
+				  v, m, mask, expected);
+
+      expected = 0;
+      for (j = 0; j < 16; j++)
+	if (array[j] >= first && array[j] <= last)
+	  expected |= 1 << j;
+      mask = clib_mask_compare_u32_x16_range_wrapper (first, last, array);
+      if (mask != expected)
+	return clib_error_return (err,
+				  "range compare [%u, %u] is 0x%x, "
+				  "expected 0x%x",
+				  first, last, mask, expected);
+    }
+  return err;
+}
+
+REGISTER_TEST (clib_mask_compare_u32_x16) = {
+  .name = "clib_mask_compare_u32_x16",
+  .fn = test_clib_mask_compare_u32_x16,
+};
@@ -225,6 +225,23 @@ test_clib_poly1305 (clib_error_t *err)
 	  "\ncalc out: %U\n",
 	  tc->name, format_hexdump, tc->key, 32, format_hexdump, tc->msg,
 	  tc->len, format_hexdump, tc->out, 16, format_hexdump, out, 16);
+
+      /* same message fed in uneven pieces */
+      for (u32 split = 1; split < tc->len; split += 7)
+	{
+	  clib_poly1305_ctx ctx;
+	  clib_poly1305_init (&ctx, tc->key);
+	  for (u32 off = 0; off < tc->len; off += split)
+	    clib_poly1305_update (&ctx, tc->msg + off,
+				  clib_min (split, tc->len - off));
+	  clib_poly1305_final (&ctx, out);
+	  if (memcmp (out, tc->out, 16) != 0)
+	    err = clib_error_return (err, "\ntest:     %s (split %u)"
+					  "\nexp out:  %U"
+					  "\ncalc out: %U\n",
+				     tc->name, split, format_hexdump, tc->out,
+				     16, format_hexdump, out, 16);
+	}
     }
   return err;
 }
@@ -0,0 +1,206 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#include <vppinfra/format.h>
+#include <vppinfra/test/test.h>
+#include <vppinfra/crypto/sha1.h>
+
+typedef struct
+{
+  const char *msg;
+  u8 digest[20];
+} sha1_test_t;
+
+typedef struct
+{
+  int tc;
+  /* key and msg are either given or filled with key_fill / msg_fill */
+  const u8 *key;
+  const char *msg;
+  u32 key_len;
+  u32 msg_len;
+  u8 key_fill;
+  u8 msg_fill;
+  u8 digest[20];
+} hmac_sha1_test_t;
+
+#ifndef CLIB_MARCH_VARIANT
+const sha1_test_t sha1_tests[] = {
+  {
+    .msg = "abc",
+    .digest = { 0xa9, 0x99, 0x3e, 0x36, 0x47, 0x06, 0x81, 0x6a, 0xba, 0x3e,
+		0x25, 0x71, 0x78, 0x50, 0xc2, 0x6c, 0x9c, 0xd0, 0xd8, 0x9d },
+  },
+  {
+    .msg = "",
+    .digest = { 0xda, 0x39, 0xa3, 0xee, 0x5e, 0x6b, 0x4b, 0x0d, 0x32, 0x55,
+		0xbf, 0xef, 0x95, 0x60, 0x18, 0x90, 0xaf, 0xd8, 0x07, 0x09 },
+  },
+  {
+    .msg = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+    .digest = { 0x84, 0x98, 0x3e, 0x44, 0x1c, 0x3b, 0xd2, 0x6e, 0xba, 0xae,
+		0x4a, 0xa1, 0xf9, 0x51, 0x29, 0xe5, 0xe5, 0x46, 0x70, 0xf1 },
+  },
+  {}
+};
+
+static const u8 key4[25] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+			     0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+			     0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15,
+			     0x16, 0x17, 0x18, 0x19 };
+
+/* RFC 2202 */
+const hmac_sha1_test_t hmac_sha1_tests[] = {
+  {
+    .tc = 1,
+    .key_fill = 0x0b,
+    .key_len = 20,
+    .msg = "Hi There",
+    .digest = { 0xb6, 0x17, 0x31, 0x86, 0x55, 0x05, 0x72, 0x64, 0xe2, 0x8b,
+		0xc0, 0xb6, 0xfb, 0x37, 0x8c, 0x8e, 0xf1, 0x46, 0xbe, 0x00 },
+  },
+  {
+    .tc = 2,
+    .key = (const u8 *) "Jefe",
+    .key_len = 4,
+    .msg = "what do ya want for nothing?",
+    .digest = { 0xef, 0xfc, 0xdf, 0x6a, 0xe5, 0xeb, 0x2f, 0xa2, 0xd2, 0x74,
+		0x16, 0xd5, 0xf1, 0x84, 0xdf, 0x9c, 0x25, 0x9a, 0x7c, 0x79 },
+  },
+  {
+    .tc = 3,
+    .key_fill = 0xaa,
+    .key_len = 20,
+    .msg_fill = 0xdd,
+    .msg_len = 50,
+    .digest = { 0x12, 0x5d, 0x73, 0x42, 0xb9, 0xac, 0x11, 0xcd, 0x91, 0xa3,
+		0x9a, 0xf4, 0x8a, 0xa1, 0x7b, 0x4f, 0x63, 0xf1, 0x75, 0xd3 },
+  },
+  {
+    .tc = 4,
+    .key = key4,
+    .key_len = sizeof (key4),
+    .msg_fill = 0xcd,
+    .msg_len = 50,
+    .digest = { 0x4c, 0x90, 0x07, 0xf4, 0x02, 0x62, 0x50, 0xc6, 0xbc, 0x84,
+		0x14, 0xf9, 0xbf, 0x50, 0xc8, 0x6c, 0x2d, 0x72, 0x35, 0xda },
+  },
+  {
+    .tc = 5,
+    .key_fill = 0x0c,
+    .key_len = 20,
+    .msg = "Test With Truncation",
+    .digest = { 0x4c, 0x1a, 0x03, 0x42, 0x4b, 0x55, 0xe0, 0x7f, 0xe7, 0xf2,
+		0x7b, 0xe1, 0xd5, 0x8b, 0xb9, 0x32, 0x4a, 0x9a, 0x5a, 0x04 },
+  },
+  {
+    .tc = 6,
+    .key_fill = 0xaa,
+    .key_len = 80,
+    .msg = "Test Using Larger Than Block-Size Key - Hash Key First",
+    .digest = { 0xaa, 0x4a, 0xe5, 0xe1, 0x52, 0x72, 0xd0, 0x0e, 0x95, 0x70,
+		0x56, 0x37, 0xce, 0x8a, 0x3b, 0x55, 0xed, 0x40, 0x21, 0x12 },
+  },
+  {
+    .tc = 7,
+    .key_fill = 0xaa,
+    .key_len = 80,
+    .msg = "Test Using Larger Than Block-Size Key and Larger Than One "
+	   "Block-Size Data",
+    .digest = { 0xe8, 0xe9, 0x9d, 0x0f, 0x45, 0x23, 0x7d, 0x78, 0x6d, 0x6b,
+		0xba, 0xa7, 0x96, 0x5c, 0x78, 0x08, 0xbb, 0xff, 0x1a, 0x91 },
+  },
+  {}
+};
+#else
+extern const sha1_test_t sha1_tests[];
+extern const hmac_sha1_test_t hmac_sha1_tests[];
+#endif
+
+static clib_error_t *
+test_clib_sha1 (clib_error_t *err)
+{
+  const sha1_test_t *t = sha1_tests;
+  u8 digest[20];
+
+  for (; t->msg; t++)
+    {
+      clib_sha1 ((u8 *) t->msg, strlen (t->msg), digest);
+      if (memcmp (digest, t->digest, sizeof (digest)))
+	return clib_error_return (err, "bad SHA1 digest for '%s'", t->msg);
+    }
+
+  return err;
+}
+
+void __test_perf_fn
+perftest_sha1_byte (test_perf_t *tp)
+{
+  u8 *data = test_mem_alloc_and_fill_inc_u8 (tp->n_ops, 0, 0);
+  u8 *digest = test_mem_alloc (20);
+
+  test_perf_event_enable (tp);
+  clib_sha1 (data, tp->n_ops, digest);
+  test_perf_event_disable (tp);
+}
+
+REGISTER_TEST (clib_sha1) = {
+  .name = "clib_sha1",
+  .fn = test_clib_sha1,
+  .perf_tests = PERF_TESTS ({ .name = "byte",
+			      .n_ops = 16384,
+			      .fn = perftest_sha1_byte }),
+};
+
+static clib_error_t *
+test_clib_hmac_sha1 (clib_error_t *err)
+{
+  const hmac_sha1_test_t *t = hmac_sha1_tests;
+  u8 key[80], msg[80], digest[20];
+
+  for (; t->tc; t++)
+    {
+      u32 msg_len = t->msg ? strlen (t->msg) : t->msg_len;
+
+      if (t->key)
+	clib_memcpy_fast (key, t->key, t->key_len);
+      else
+	clib_memset_u8 (key, t->key_fill, t->key_len);
+
+      if (t->msg)
+	clib_memcpy_fast (msg, t->msg, msg_len);
+      else
+	clib_memset_u8 (msg, t->msg_fill, msg_len);
+
+      clib_hmac_sha1 (key, t->key_len, msg, msg_len, digest);
+      if (memcmp (digest, t->digest, sizeof (digest)))
+	return clib_error_return (err,
+				  "Bad HMAC SHA1 digest for test case "
+				  "%u:\nExpected:\n%U\nCalculated:\n%U\n",
+				  t->tc, format_hexdump, t->digest, 20,
+				  format_hexdump, digest, 20);
+    }
+
+  return err;
+}
+
+void __test_perf_fn
+perftest_hmac_sha1_byte (test_perf_t *tp)
+{
+  u8 *key = test_mem_alloc_and_fill_inc_u8 (20, 32, 0);
+  u8 *data = test_mem_alloc_and_fill_inc_u8 (tp->n_ops, 0, 0);
+  u8 *digest = test_mem_alloc (20);
+
+  test_perf_event_enable (tp);
+  clib_hmac_sha1 (key, 20, data, tp->n_ops, digest);
+  test_perf_event_disable (tp);
+}
+
+REGISTER_TEST (clib_hmac_sha1) = {
+  .name = "clib_hmac_sha1",
+  .fn = test_clib_hmac_sha1,
+  .perf_tests = PERF_TESTS ({ .name = "byte",
+			      .n_ops = 16384,
+			      .fn = perftest_hmac_sha1_byte }),
+};
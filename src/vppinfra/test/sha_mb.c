@@ -0,0 +1,204 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright (c) 2025 Cisco Systems, Inc.
+ */
+
+#include <vppinfra/format.h>
+#include <vppinfra/test/test.h>
+#include <vppinfra/crypto/sha_mb.h>
+
+#define N_TEST_OPS 300
+
+typedef struct
+{
+  clib_sha1_hmac_key_data_t sha1;
+  clib_sha2_hmac_key_data_t sha224;
+  clib_sha2_hmac_key_data_t sha256;
+} test_sha_mb_key_data_t;
+
+static void
+test_sha_mb_key_data (test_sha_mb_key_data_t *kd, const u8 *key, u32 key_len)
+{
+  clib_sha1_hmac_key_data (key, key_len, &kd->sha1);
+  clib_sha2_hmac_key_data (CLIB_SHA2_224, key, key_len, &kd->sha224);
+  clib_sha2_hmac_key_data (CLIB_SHA2_256, key, key_len, &kd->sha256);
+}
+
+static void
+test_sha_mb_ops (clib_sha_mb_type_t type, clib_sha_mb_hmac_op_t *ops,
+		 u32 n_ops)
+{
+  if (type == CLIB_SHA_MB_SHA1)
+    clib_sha1_mb_hmac (ops, n_ops);
+  else if (type == CLIB_SHA_MB_SHA224)
+    clib_sha224_mb_hmac (ops, n_ops);
+  else
+    clib_sha256_mb_hmac (ops, n_ops);
+}
+
+static void
+test_sha_mb_ref (clib_sha_mb_type_t type, const u8 *key, u32 key_len,
+		 const u8 *msg, u32 len, u8 *digest)
+{
+  if (type == CLIB_SHA_MB_SHA1)
+    clib_hmac_sha1 (key, key_len, msg, len, digest);
+  else if (type == CLIB_SHA_MB_SHA224)
+    clib_hmac_sha224 (key, key_len, msg, len, digest);
+  else
+    clib_hmac_sha256 (key, key_len, msg, len, digest);
+}
+
+static clib_error_t *
+test_clib_sha_mb_hmac (clib_error_t *err)
+{
+  static const char *names[] = { "sha1", "sha224", "sha256" };
+  static const u8 digest_sizes[] = { 20, 28, 32 };
+  clib_sha_mb_hmac_op_t ops[N_TEST_OPS];
+  test_sha_mb_key_data_t kd[4];
+  u8 keys[4][100];
+  u32 key_lens[4] = { 12, 20, 64, 100 };
+  u8 digests[N_TEST_OPS][32];
+  u8 *data = clib_mem_alloc (N_TEST_OPS + 2048);
+
+  for (int i = 0; i < N_TEST_OPS + 2048; i++)
+    data[i] = i * 7 + 3;
+
+  for (int i = 0; i < 4; i++)
+    {
+      for (int j = 0; j < key_lens[i]; j++)
+	keys[i][j] = i * 16 + j;
+      test_sha_mb_key_data (kd + i, keys[i], key_lens[i]);
+    }
+
+  for (clib_sha_mb_type_t t = CLIB_SHA_MB_SHA1; t <= CLIB_SHA_MB_SHA256; t++)
+    {
+      /* every length from 0 with 4 different keys and offsets, plus a few
+       * long ones, so lanes get refilled at every possible block */
+      for (u32 i = 0; i < N_TEST_OPS; i++)
+	{
+	  test_sha_mb_key_data_t *k = kd + (i & 3);
+	  const u32 *ipad, *opad;
+
+	  if (t == CLIB_SHA_MB_SHA1)
+	    ipad = k->sha1.ipad_h, opad = k->sha1.opad_h;
+	  else if (t == CLIB_SHA_MB_SHA224)
+	    ipad = k->sha224.ipad_h.h32, opad = k->sha224.opad_h.h32;
+	  else
+	    ipad = k->sha256.ipad_h.h32, opad = k->sha256.opad_h.h32;
+
+	  ops[i] = (clib_sha_mb_hmac_op_t){
+	    .src = data + (i & 15),
+	    .len = i % 7 == 6 ? 1500 + i : i,
+	    .ipad_h = ipad,
+	    .opad_h = opad,
+	    .digest = digests[i],
+	  };
+	}
+
+      test_sha_mb_ops (t, ops, N_TEST_OPS);
+
+      for (u32 i = 0; i < N_TEST_OPS; i++)
+	{
+	  u8 ref[32];
+	  test_sha_mb_ref (t, keys[i & 3], key_lens[i & 3], ops[i].src,
+			   ops[i].len, ref);
+	  if (memcmp (ref, digests[i], digest_sizes[t]))
+	    return clib_error_return (err,
+				      "%s op %u len %u: bad digest\n"
+				      "Expected:\n%U\nCalculated:\n%U\n",
+				      names[t], i, ops[i].len, format_hexdump,
+				      ref, digest_sizes[t], format_hexdump,
+				      digests[i], digest_sizes[t]);
+	}
+
+      /* check mode with truncated digest, every 5th one corrupted */
+      for (u32 i = 0; i < N_TEST_OPS; i++)
+	{
+	  ops[i].check = 1;
+	  ops[i].digest_len = 12;
+	  if (i % 5 == 0)
+	    digests[i][11] ^= 0x40;
+	  else
+	    digests[i][12] ^= 0x40;
+	}
+
+      test_sha_mb_ops (t, ops, N_TEST_OPS);
+
+      for (u32 i = 0; i < N_TEST_OPS; i++)
+	if (ops[i].is_bad != (i % 5 == 0))
+	  return clib_error_return (err, "%s op %u: is_bad is %u", names[t],
+				    i, ops[i].is_bad);
+    }
+
+  clib_mem_free (data);
+  return err;
+}
+
+static void
+perftest_sha_mb_hmac (test_perf_t *tp, clib_sha_mb_type_t type, u32 len)
+{
+  u32 n = tp->n_ops;
+  clib_sha_mb_hmac_op_t *ops = test_mem_alloc (n * sizeof (ops[0]));
+  u8 *data = test_mem_alloc_and_fill_inc_u8 (n * len, 0, 0);
+  u8 *digests = test_mem_alloc (n * 32);
+  u8 *key = test_mem_alloc_and_fill_inc_u8 (32, 0, 0);
+  test_sha_mb_key_data_t *kd = test_mem_alloc (sizeof (*kd));
+
+  test_sha_mb_key_data (kd, key, 32);
+
+  for (u32 i = 0; i < n; i++)
+    ops[i] = (clib_sha_mb_hmac_op_t){
+      .src = data + i * len,
+      .len = len,
+      .ipad_h = type == CLIB_SHA_MB_SHA1 ? kd->sha1.ipad_h :
+					   kd->sha256.ipad_h.h32,
+      .opad_h = type == CLIB_SHA_MB_SHA1 ? kd->sha1.opad_h :
+					   kd->sha256.opad_h.h32,
+      .digest = digests + i * 32,
+      .digest_len = 12,
+    };
+
+  test_perf_event_enable (tp);
+  test_sha_mb_ops (type, ops, n);
+  test_perf_event_disable (tp);
+}
+
+void __test_perf_fn
+perftest_sha1_mb_hmac_64byte (test_perf_t *tp)
+{
+  perftest_sha_mb_hmac (tp, CLIB_SHA_MB_SHA1, 64);
+}
+
+void __test_perf_fn
+perftest_sha1_mb_hmac_1500byte (test_perf_t *tp)
+{
+  perftest_sha_mb_hmac (tp, CLIB_SHA_MB_SHA1, 1500);
+}
+
+void __test_perf_fn
+perftest_sha256_mb_hmac_64byte (test_perf_t *tp)
+{
+  perftest_sha_mb_hmac (tp, CLIB_SHA_MB_SHA256, 64);
+}
+
+void __test_perf_fn
+perftest_sha256_mb_hmac_1500byte (test_perf_t *tp)
+{
+  perftest_sha_mb_hmac (tp, CLIB_SHA_MB_SHA256, 1500);
+}
+
+REGISTER_TEST (clib_sha_mb_hmac) = {
+  .name = "clib_sha_mb_hmac",
+  .fn = test_clib_sha_mb_hmac,
+  .perf_tests = PERF_TESTS ({ .name = "sha1 (64 byte)",
+			      .n_ops = 256,
+			      .fn = perftest_sha1_mb_hmac_64byte },
+			    { .name = "sha1 (1500 byte)",
+			      .n_ops = 256,
+			      .fn = perftest_sha1_mb_hmac_1500byte },
+			    { .name = "sha256 (64 byte)",
+			      .n_ops = 256,
+			      .fn = perftest_sha256_mb_hmac_64byte },
+			    { .name = "sha256 (1500 byte)",
+			      .n_ops = 256,
+			      .fn = perftest_sha256_mb_hmac_1500byte }),
+};
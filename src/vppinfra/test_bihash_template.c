@@ -24,6 +24,9 @@
 
 #include <vppinfra/bihash_template.c>
 
+#include <vppinfra/bihash_cuckoo_template.h>
+#include <vppinfra/bihash_cuckoo_template.c>
+
 typedef struct
 {
   volatile u32 thread_barrier;
@@ -44,6 +47,7 @@ typedef struct
   u64 *keys;
   uword hash_memory_size;
     BVT (clib_bihash) hash;
+  BVT (clib_bihash_cuckoo) cuckoo_hash;
   clib_time_t clib_time;
   void *global_heap;
 
@@ -525,6 +529,272 @@ test_bihash (test_main_t * tm)
   return 0;
 }
 
+static uword
+test_heap_bytes_used (void)
+{
+  clib_mem_usage_t usage;
+
+  clib_mem_get_heap_usage (clib_mem_get_heap (), &usage);
+  return usage.bytes_used;
+}
+
+static void
+test_bihash_report (char *name, char *op, u32 n_ops, f64 delta)
+{
+  if (delta > 0)
+    fformat (stdout, "%-8s %-7s %.2f Mops/s, %.2f nsec per op\n", name, op,
+	     n_ops / delta / 1e6, 1e9 * delta / n_ops);
+}
+
+/*
+ * Compare insert, lookup and delete throughput and memory per entry of the
+ * classic and cuckoo variants for the same set of keys. Keys are a bijective
+ * mix of the item index, so they're unique for any nitems.
+ */
+static clib_error_t *
+test_bihash_cuckoo (test_main_t *tm)
+{
+  BVT (clib_bihash_cuckoo) *ch = &tm->cuckoo_hash;
+  BVT (clib_bihash) *h = &tm->hash;
+  u32 i, j, n_items = tm->nitems, n_fails = 0;
+  uword heap_before, memory;
+  BVT (clib_bihash_kv) kv;
+  u64 *keys = 0, key;
+  f64 before;
+
+  vec_validate (keys, n_items - 1);
+  for (i = 0; i < n_items; i++)
+    {
+      key = (u64) (i + 1) * 0x9E3779B97F4A7C15ULL;
+      keys[i] = key ^ (key >> 31);
+    }
+
+  /*
+   * Classic bihash
+   */
+  heap_before = test_heap_bytes_used ();
+  BV (clib_bihash_init) (h, "classic", clib_max (tm->nbuckets, n_items / 4),
+			 tm->hash_memory_size);
+
+  before = clib_time_now (&tm->clib_time);
+  for (i = 0; i < n_items; i++)
+    {
+      kv.key = keys[i];
+      kv.value = i;
+      BV (clib_bihash_add_del) (h, &kv, 1 /* is_add */);
+    }
+  test_bihash_report ("classic", "add", n_items,
+		      clib_time_now (&tm->clib_time) - before);
+  memory = test_heap_bytes_used () - heap_before;
+
+  before = clib_time_now (&tm->clib_time);
+  for (j = 0; j < tm->search_iter; j++)
+    for (i = 0; i < n_items; i++)
+      {
+	if (i + 8 < n_items)
+	  {
+	    kv.key = keys[i + 8];
+	    BV (clib_bihash_prefetch_bucket) (h, BV (clib_bihash_hash) (&kv));
+	  }
+	kv.key = keys[i];
+	if (BV (clib_bihash_search_inline) (h, &kv) < 0 || kv.value != i)
+	  n_fails++;
+      }
+  test_bihash_report ("classic", "search", n_items * tm->search_iter,
+		      clib_time_now (&tm->clib_time) - before);
+  fformat (stdout, "classic  memory  %U, %.1f bytes per entry\n",
+	   format_memory_size, memory, (f64) memory / n_items);
+
+  before = clib_time_now (&tm->clib_time);
+  for (i = 0; i < n_items; i++)
+    {
+      kv.key = keys[i];
+      if (BV (clib_bihash_add_del) (h, &kv, 0 /* is_add */))
+	n_fails++;
+    }
+  test_bihash_report ("classic", "del", n_items,
+		      clib_time_now (&tm->clib_time) - before);
+  BV (clib_bihash_free) (h);
+
+  /*
+   * Cuckoo bihash, sized for a load of at most 95%
+   */
+  BV (clib_bihash_cuckoo_init) (ch, "cuckoo",
+				(u64) n_items * 100 /
+				  (95 * BIHASH_CUCKOO_BUCKET_SIZE));
+
+  before = clib_time_now (&tm->clib_time);
+  for (i = 0; i < n_items; i++)
+    {
+      kv.key = keys[i];
+      kv.value = i;
+      if (BV (clib_bihash_cuckoo_add_del) (ch, &kv, 1 /* is_add */))
+	n_fails++;
+    }
+  test_bihash_report ("cuckoo", "add", n_items,
+		      clib_time_now (&tm->clib_time) - before);
+
+  before = clib_time_now (&tm->clib_time);
+  for (j = 0; j < tm->search_iter; j++)
+    for (i = 0; i < n_items; i++)
+      {
+	if (i + 8 < n_items)
+	  {
+	    kv.key = keys[i + 8];
+	    BV (clib_bihash_cuckoo_prefetch_bucket)
+	    (ch, BV (clib_bihash_hash) (&kv));
+	  }
+	kv.key = keys[i];
+	if (BV (clib_bihash_cuckoo_search_inline) (ch, &kv) < 0 ||
+	    kv.value != i)
+	  n_fails++;
+      }
+  test_bihash_report ("cuckoo", "search", n_items * tm->search_iter,
+		      clib_time_now (&tm->clib_time) - before);
+  memory = BV (clib_bihash_cuckoo_memory_size) (ch);
+  fformat (stdout, "cuckoo   memory  %U, %.1f bytes per entry\n",
+	   format_memory_size, memory, (f64) memory / n_items);
+  fformat (stdout, "%U", BV (format_bihash_cuckoo), ch, tm->verbose);
+
+  before = clib_time_now (&tm->clib_time);
+  for (i = 0; i < n_items; i++)
+    {
+      kv.key = keys[i];
+      if (BV (clib_bihash_cuckoo_add_del) (ch, &kv, 0 /* is_add */))
+	n_fails++;
+    }
+  test_bihash_report ("cuckoo", "del", n_items,
+		      clib_time_now (&tm->clib_time) - before);
+
+  /* Everything should be gone */
+  kv.key = keys[0];
+  if (ch->n_elts || !BV (clib_bihash_cuckoo_search_inline) (ch, &kv))
+    n_fails++;
+
+  BV (clib_bihash_cuckoo_free) (ch);
+  vec_free (keys);
+
+  if (n_fails)
+    return clib_error_return (0, "%u unexpected failures", n_fails);
+
+  return 0;
+}
+
+static void *
+test_bihash_resize_reader_fn (void *arg)
+{
+  test_main_t *tm = &test_main;
+  BVT (clib_bihash) *h = &tm->hash;
+  BVT (clib_bihash_kv) kv;
+  u32 i, n_items = pointer_to_uword (arg);
+  uword *n_misses = clib_mem_alloc (sizeof (uword));
+
+  *n_misses = 0;
+  while (tm->thread_barrier == 0)
+    for (i = 0; i < n_items; i++)
+      {
+	kv.key = tm->keys[i];
+	if (BV (clib_bihash_search_inline) (h, &kv) < 0 || kv.value != i)
+	  *n_misses += 1;
+      }
+
+  return n_misses;
+}
+
+/*
+ * Let adds grow a table from nbuckets online, then double it once more
+ * with a thread looking up all keys while the buckets are being split
+ */
+static clib_error_t *
+test_bihash_resize (test_main_t *tm)
+{
+  BVT (clib_bihash_init2_args) _a = {}, *a = &_a;
+  BVT (clib_bihash) *h = &tm->hash;
+  u32 i, n_items = tm->nitems, n_fails = 0, n_steps = 0;
+  uword *n_misses = 0;
+  BVT (clib_bihash_kv) kv;
+  pthread_t reader;
+  u64 key, n_buckets;
+
+  vec_validate (tm->keys, n_items - 1);
+  for (i = 0; i < n_items; i++)
+    {
+      key = (u64) (i + 1) * 0x9E3779B97F4A7C15ULL;
+      tm->keys[i] = key ^ (key >> 31);
+    }
+
+  a->h = h;
+  a->name = "resize";
+  a->nbuckets = tm->nbuckets;
+  a->max_nbuckets = (u64) n_items;
+  a->memory_size = tm->hash_memory_size;
+  a->instantiate_immediately = 1;
+  /* no numa heaps here, falls back to the current heap */
+  a->use_numa_node = 1;
+  a->numa_node = 0;
+  BV (clib_bihash_init2) (a);
+
+  for (i = 0; i < n_items; i++)
+    {
+      kv.key = tm->keys[i];
+      kv.value = i;
+      BV (clib_bihash_add_del) (h, &kv, 1 /* is_add */);
+    }
+
+  n_buckets = BV (clib_bihash_geometry_nbuckets) (h->geometry);
+  fformat (stdout, "%u items added, %u -> %llu buckets\n", n_items,
+	   tm->nbuckets, n_buckets);
+
+  for (i = 0; i < n_items; i++)
+    {
+      kv.key = tm->keys[i];
+      if (BV (clib_bihash_search) (h, &kv, &kv) < 0 || kv.value != i)
+	n_fails++;
+    }
+
+  if (BV (clib_bihash_grow) (h))
+    return clib_error_return (0, "table already at max size");
+
+  tm->thread_barrier = 0;
+  if (pthread_create (&reader, NULL, test_bihash_resize_reader_fn,
+		      uword_to_pointer (n_items, void *)))
+    return clib_error_return_unix (0, "pthread_create");
+
+  while (BV (clib_bihash_resize_step) (h, 1))
+    n_steps++;
+
+  tm->thread_barrier = 1;
+  pthread_join (reader, (void **) &n_misses);
+
+  n_buckets = BV (clib_bihash_geometry_nbuckets) (h->geometry);
+  fformat (stdout, "grown to %llu buckets in %u steps, %llu lookup misses\n",
+	   n_buckets, n_steps, (u64) n_misses[0]);
+  fformat (stdout, "%U", BV (format_bihash), h, 0 /* verbose */);
+  n_fails += n_misses[0];
+  clib_mem_free (n_misses);
+
+  for (i = 0; i < n_items; i++)
+    {
+      kv.key = tm->keys[i];
+      if (BV (clib_bihash_add_del) (h, &kv, 0 /* is_add */))
+	n_fails++;
+    }
+
+  /* All pages given back, histogram empty */
+  if (h->n_bucket_pages)
+    n_fails++;
+  for (i = 0; i < BIHASH_PROBE_DEPTH_N_BINS; i++)
+    if (h->probe_depth_histogram[i])
+      n_fails++;
+
+  BV (clib_bihash_free) (h);
+
+  if (n_fails)
+    return clib_error_return (0, "%u unexpected failures", n_fails);
+
+  return 0;
+}
+
 clib_error_t *
 test_bihash_main (test_main_t * tm)
 {
@@ -571,6 +841,10 @@ test_bihash_main (test_main_t * tm)
 	which = 4;
       else if (unformat (i, "value-assert"))
 	which = 5;
+      else if (unformat (i, "cuckoo"))
+	which = 6;
+      else if (unformat (i, "resize"))
+	which = 7;
       else
 	return clib_error_return (0, "unknown input '%U'",
 				  format_unformat_error, i);
@@ -607,6 +881,14 @@ test_bihash_main (test_main_t * tm)
       error = test_bihash_value_assert (tm);
       break;
 
+    case 6:
+      error = test_bihash_cuckoo (tm);
+      break;
+
+    case 7:
+      error = test_bihash_resize (tm);
+      break;
+
     default:
       return clib_error_return (0, "no such test?");
     }
@@ -358,4 +358,78 @@ clib_mask_compare_u64 (u64 v, u64 *a, u64 *bitmap, u32 n_elts)
   bitmap[0] = clib_mask_compare_u64_x64_n (v, a, n_elts) & pow2_mask (n_elts);
 }
 
+/** \brief Compare 16 masked 32-bit elements with provided value
+
+    @param v value to compare elements with
+    @param m mask applied to each element before comparison
+    @param a array of 16 u32 elements
+    @return bitmap, bit i is set if (a[i] & m) == v
+*/
+
+static_always_inline u16
+clib_mask_compare_u32_x16_masked (u32 v, u32 m, u32 *a)
+{
+  u16 mask = 0;
+#if defined(CLIB_HAVE_VEC512)
+  u32x16 x = *(u32x16u *) a;
+  mask = u32x16_is_equal_mask (x & u32x16_splat (m), u32x16_splat (v));
+#elif defined(CLIB_HAVE_VEC256)
+  u32x8 v8 = u32x8_splat (v);
+  u32x8 m8 = u32x8_splat (m);
+  u32x8u *av = (u32x8u *) a;
+  u32x8 p = { 0, 4, 1, 5, 2, 6, 3, 7 };
+  i32x8 zero = {};
+  i8x32 c;
+
+  c = i8x32_pack (i16x16_pack ((i32x8) ((av[0] & m8) == v8),
+			       (i32x8) ((av[1] & m8) == v8)),
+		  i16x16_pack (zero, zero));
+  mask = i8x32_msb_mask ((i8x32) u32x8_permute ((u32x8) c, p));
+#else
+  for (int i = 0; i < 16; i++)
+    if ((a[i] & m) == v)
+      mask |= 1 << i;
+#endif
+  return mask;
+}
+
+/** \brief Check 16 32-bit elements against an inclusive range
+
+    @param first lower bound of the range
+    @param last upper bound of the range, must not be lower than first
+    @param a array of 16 u32 elements
+    @return bitmap, bit i is set if first <= a[i] <= last
+*/
+
+static_always_inline u16
+clib_mask_compare_u32_x16_range (u32 first, u32 last, u32 *a)
+{
+  u16 mask = 0;
+  /* a[i] - first wraps around for a[i] < first, so a single unsigned
+     comparison against the range span covers both bounds */
+#if defined(CLIB_HAVE_VEC512)
+  u32x16 x = *(u32x16u *) a - u32x16_splat (first);
+  mask = u32x16_is_equal_mask (u32x16_min (x, u32x16_splat (last - first)),
+			       x);
+#elif defined(CLIB_HAVE_VEC256)
+  u32x8 f8 = u32x8_splat (first);
+  u32x8 d8 = u32x8_splat (last - first);
+  u32x8u *av = (u32x8u *) a;
+  u32x8 x0 = av[0] - f8, x1 = av[1] - f8;
+  u32x8 p = { 0, 4, 1, 5, 2, 6, 3, 7 };
+  i32x8 zero = {};
+  i8x32 c;
+
+  c = i8x32_pack (i16x16_pack ((i32x8) (u32x8_min (x0, d8) == x0),
+			       (i32x8) (u32x8_min (x1, d8) == x1)),
+		  i16x16_pack (zero, zero));
+  mask = i8x32_msb_mask ((i8x32) u32x8_permute ((u32x8) c, p));
+#else
+  for (int i = 0; i < 16; i++)
+    if (a[i] - first <= last - first)
+      mask |= 1 << i;
+#endif
+  return mask;
+}
+
 #endif
@@ -332,6 +332,11 @@ u32x8_scatter_one (u32x8 r, int index, void *p)
 #define u32x8_gather_u32(base, indices, scale)                                \
   (u32x8) _mm256_i32gather_epi32 ((const int *) base, (__m256i) indices, scale)
 
+#define u32x8_mask_gather_u32(src, base, indices, mask, scale)                \
+  (u32x8) _mm256_mask_i32gather_epi32 ((__m256i) (src), (const int *) (base), \
+				       (__m256i) (indices), (__m256i) (mask), \
+				       scale)
+
 #ifdef __AVX512F__
 #define u32x8_scatter_u32(base, indices, v, scale)                            \
   _mm256_i32scatter_epi32 (base, (__m256i) indices, (__m256i) v, scale)
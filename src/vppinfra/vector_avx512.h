@@ -165,6 +165,12 @@ _ (u16x32, u16x16)
 _ (u8x64, u8x32)
 #undef _
 
+static_always_inline u32x16
+u32x16_min (u32x16 a, u32x16 b)
+{
+  return (u32x16) _mm512_min_epu32 ((__m512i) a, (__m512i) b);
+}
+
 static_always_inline u32
 u32x16_min_scalar (u32x16 v)
 {
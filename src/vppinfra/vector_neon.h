@@ -121,6 +121,21 @@ u32x4_byte_swap (u32x4 v)
   return (u32x4) vrev32q_u8 ((u8x16) v);
 }
 
+static_always_inline void
+u32x4_transpose (u32x4 a[4])
+{
+  u32x4 t0, t1, t2, t3;
+
+  t0 = __builtin_shufflevector (a[0], a[1], 0, 4, 1, 5);
+  t1 = __builtin_shufflevector (a[0], a[1], 2, 6, 3, 7);
+  t2 = __builtin_shufflevector (a[2], a[3], 0, 4, 1, 5);
+  t3 = __builtin_shufflevector (a[2], a[3], 2, 6, 3, 7);
+  a[0] = (u32x4) __builtin_shufflevector ((u64x2) t0, (u64x2) t2, 0, 2);
+  a[1] = (u32x4) __builtin_shufflevector ((u64x2) t0, (u64x2) t2, 1, 3);
+  a[2] = (u32x4) __builtin_shufflevector ((u64x2) t1, (u64x2) t3, 0, 2);
+  a[3] = (u32x4) __builtin_shufflevector ((u64x2) t1, (u64x2) t3, 1, 3);
+}
+
 static_always_inline u32x4
 u32x4_hadd (u32x4 v1, u32x4 v2)
 {
@@ -254,6 +254,40 @@ class TestGRO(VppTestCase):
             self.assertEqual(rx[TCP].ack, (2 * i + 1))
             i += 1
 
+    def test_gro_rx_feature(self):
+        """GRO receive feature on locally terminated TCP"""
+
+        n_segments = 10
+        payload = 100
+        self.vapi.feature_gro_enable_disable(
+            sw_if_index=self.pg0.sw_if_index, enable_disable=1
+        )
+
+        pkts = [
+            Ether(src=self.pg0.remote_mac, dst=self.pg0.local_mac)
+            / IP(src=self.pg0.remote_ip4, dst=self.pg0.local_ip4, flags="DF")
+            / TCP(sport=1234, dport=4321, flags="A", seq=1000 + i * payload)
+            / Raw(b"\xa5" * payload)
+            for i in range(n_segments)
+        ]
+        self.pg_send(self.pg0, pkts)
+
+        # in-order segments of a frame are folded into the first one
+        self.assertEqual(
+            self.statistics.get_err_counter("/err/gro-ip4/segments coalesced"),
+            n_segments - 1,
+        )
+        self.assertEqual(
+            self.statistics.get_err_counter(
+                "/err/gro-ip4/coalesced packets delivered"
+            ),
+            1,
+        )
+
+        self.vapi.feature_gro_enable_disable(
+            sw_if_index=self.pg0.sw_if_index, enable_disable=0
+        )
+
 
 if __name__ == "__main__":
     unittest.main(testRunner=VppTestRunner)
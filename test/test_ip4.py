@@ -831,6 +831,43 @@ class TestIPv4FibCrud(VppTestCase):
         )
         self.verify_not_in_route_dump(self.deleted_routes)
 
+    def test_4_bulk_routes(self):
+        """Add/delete 100 routes in one bulk message"""
+
+        nh = VppRoutePath(self.pg0.remote_ip4, 0xFFFFFFFF)
+        path = nh.encode()
+        routes = [VppIpRoute(self, "10.0.2.%d" % i, 32, [nh]) for i in range(100)]
+        prefixes = [r.prefix for r in routes]
+
+        # the path array is fixed size, only n_paths entries are used
+        self.vapi.ip_route_add_del_bulk(
+            is_add=1,
+            table_id=0,
+            n_paths=1,
+            paths=[path] * 16,
+            n_prefixes=len(prefixes),
+            prefixes=prefixes,
+        )
+        self.verify_route_dump(routes)
+
+        self.stream_1 = self.create_stream(self.pg1, self.pg0, routes, 100)
+        self.pg1.add_stream(self.stream_1)
+        self.pg_enable_capture(self.pg_interfaces)
+        self.pg_start()
+
+        pkts = self.pg0.get_capture(len(self.stream_1))
+        self.verify_capture(self.pg0, pkts, self.stream_1)
+
+        self.vapi.ip_route_add_del_bulk(
+            is_add=0,
+            table_id=0,
+            n_paths=0,
+            paths=[path] * 16,
+            n_prefixes=len(prefixes),
+            prefixes=prefixes,
+        )
+        self.verify_not_in_route_dump(routes)
+
 
 class TestIPNull(VppTestCase):
     """IPv4 routes via NULL"""
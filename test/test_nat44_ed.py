@@ -3018,6 +3018,37 @@ class TestNAT44EDMW(TestNAT44ED):
         self.pg_start()
         self.pg1.get_capture(len(pkts))
 
+    def test_session_expire_walk(self):
+        """NAT44ED idle sessions freed without further traffic"""
+
+        self.nat_add_address(self.nat_addr)
+        self.nat_add_inside_interface(self.pg0)
+        self.nat_add_outside_interface(self.pg1)
+
+        self.vapi.nat_set_timeouts(
+            udp=2, tcp_established=7440, tcp_transitory=240, icmp=60
+        )
+
+        pkts = []
+        for i in range(0, 10):
+            p = (
+                Ether(dst=self.pg0.local_mac, src=self.pg0.remote_mac)
+                / IP(src=self.pg0.remote_ip4, dst=self.pg1.remote_ip4, ttl=64)
+                / UDP(sport=7000 + i, dport=80)
+            )
+            pkts.append(p)
+        self.send_and_expect(self.pg0, pkts, self.pg1)
+
+        sessions = self.statistics["/nat44-ed/total-sessions"]
+        self.assertEqual(sessions[:, 0].sum(), len(pkts))
+
+        self.virtual_sleep(5, "wait for timeouts")
+        # let the expiry process and walk run on the adjusted clock
+        self.sleep(2)
+
+        sessions = self.statistics["/nat44-ed/total-sessions"]
+        self.assertEqual(sessions[:, 0].sum(), 0)
+
     def test_session_rst_timeout(self):
         """NAT44ED session RST timeouts"""
 